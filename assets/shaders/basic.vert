@@ -1,9 +1,12 @@
 #version 330 core
 layout (location = 0) in vec3 aPos;
+layout (location = 8) in mat4 a_InstanceModel;
 
 uniform mat4 u_ViewProjection;
 uniform mat4 u_Model;
+uniform bool u_Instanced;
 
 void main() {
-    gl_Position = u_ViewProjection * u_Model * vec4(aPos, 1.0);
+    mat4 model = u_Instanced ? a_InstanceModel : u_Model;
+    gl_Position = u_ViewProjection * model * vec4(aPos, 1.0);
 }
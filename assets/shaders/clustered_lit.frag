@@ -0,0 +1,62 @@
+#version 330 core
+
+// Clustered point lights, binned on the CPU by LightClusterGrid (see ClusteredLighting.h).
+// Pairs with lit.vert.
+
+in vec2 v_TexCoord;
+in vec3 v_Normal;
+in vec3 v_FragPos;
+
+uniform mat4 u_View;
+uniform vec3 u_ViewPos;
+uniform vec4 u_Color;
+uniform sampler2D u_Texture;
+uniform vec3 u_AmbientColor;
+uniform float u_SpecularStrength;
+uniform float u_Shininess;
+
+uniform samplerBuffer u_LightData;      // Two texels per light: position, radius; colour, intensity
+uniform usamplerBuffer u_ClusterData;   // Offset and count per cluster
+uniform usamplerBuffer u_LightIndices;
+uniform vec3 u_ClusterTiles;            // Tiles across, tiles up, depth slices
+uniform vec2 u_ClusterDepth;            // slice = log(depth) * x + y
+uniform vec2 u_ViewportSize;
+
+out vec4 FragColor;
+
+void main() {
+    vec3 norm = normalize(v_Normal);
+    vec3 viewDir = normalize(u_ViewPos - v_FragPos);
+
+    float depth = -(u_View * vec4(v_FragPos, 1.0)).z;
+    ivec3 tiles = ivec3(u_ClusterTiles);
+    ivec2 tile = clamp(ivec2(gl_FragCoord.xy / u_ViewportSize * u_ClusterTiles.xy),
+                       ivec2(0), tiles.xy - 1);
+    int slice = clamp(int(floor(log(max(depth, 1e-4)) * u_ClusterDepth.x + u_ClusterDepth.y)),
+                      0, tiles.z - 1);
+    uvec2 cluster = texelFetch(u_ClusterData, tile.x + tiles.x * (tile.y + tiles.y * slice)).xy;
+
+    vec3 lighting = u_AmbientColor;
+    for (uint i = 0u; i < cluster.y; ++i) {
+        int light = int(texelFetch(u_LightIndices, int(cluster.x + i)).x);
+        vec4 positionRadius = texelFetch(u_LightData, light * 2);
+        vec4 colorIntensity = texelFetch(u_LightData, light * 2 + 1);
+
+        vec3 toLight = positionRadius.xyz - v_FragPos;
+        float distance = length(toLight);
+        if (distance >= positionRadius.w) continue;
+        vec3 lightDir = toLight / distance;
+
+        // Inverse-square falloff windowed to reach zero at the radius
+        float window = clamp(1.0 - pow(distance / positionRadius.w, 4.0), 0.0, 1.0);
+        float attenuation = window * window / (distance * distance + 1.0);
+        vec3 radiance = colorIntensity.rgb * colorIntensity.a * attenuation;
+
+        float diff = max(dot(norm, lightDir), 0.0);
+        float spec = pow(max(dot(viewDir, reflect(-lightDir, norm)), 0.0), u_Shininess);
+        lighting += (diff + u_SpecularStrength * spec) * radiance;
+    }
+
+    vec4 texColor = texture(u_Texture, v_TexCoord) * u_Color;
+    FragColor = vec4(lighting * texColor.rgb, texColor.a);
+}
@@ -1,13 +1,17 @@
 #version 450 core
 layout(location = 0) in vec3 aPosition;
 layout(location = 1) in vec2 aTexCoord;
+layout(location = 8) in mat4 a_InstanceModel;
 
 uniform mat4 u_ViewProjection;
 uniform mat4 u_Model;
+uniform bool u_Instanced;
 
 out vec2 v_TexCoord;
 
 void main() {
     v_TexCoord = aTexCoord;
-    gl_Position = u_ViewProjection * u_Model * vec4(aPosition, 1.0);
+    mat4 model = u_Instanced ? a_InstanceModel : u_Model;
+    gl_Position = u_ViewProjection * model * vec4(aPosition, 1.0);
 }
+
@@ -72,6 +72,7 @@
 ---@field createCheckerTexture fun() # Create a checkered texture from quads
 --- 3D Render System
 ---@field createCube fun(scene: string) # Creates a cube in the scene
+---@field createCubeField fun(name: string, count: integer, spacing: number): SceneObject # Creates a grid of cubes sharing one mesh and material
 engine = {}
 
 -- Key code constants
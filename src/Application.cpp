@@ -5,6 +5,8 @@
 // Core headers
 #include "Application.h"
 #include "Core/AssetManager.h"
+#include "Core/Config.h"
+#include "Core/TaskSystem.h"
 
 // Event system
 #include "Events/KeyEvent.h"
@@ -15,6 +17,11 @@
 
 // Systems
 #include "Camera/OrthographicCamera.h"
+#include "Renderer/DeferredRelease.h"
+#include "Renderer/RenderState.h"
+#include "Renderer/Renderer2D.h"
+#include "Renderer/TextureCache.h"
+#include "Renderer/TextureLoader.h"
 #include "Scene/SceneManager.h"
 #include "UI/ImGuiOverlay.h"
 
@@ -56,21 +63,46 @@ namespace Engine {
 
     Application* Application::s_Instance = nullptr;
 
+    namespace {
+        using FrameClock = std::chrono::steady_clock;
+
+        float MillisecondsSince(FrameClock::time_point start) {
+            return std::chrono::duration<float, std::milli>(FrameClock::now() - start).count();
+        }
+    }
+
     /**
      * @brief Initialize the application and all subsystems
      */
     Application::Application() 
     {
         s_Instance = this;
+        m_StartTime = FrameClock::now();
         LOG_TRACE("Creating Application");
 
         Engine::Profiler::Get().BeginSession("Runtime");
 
+        // One scheduler for the renderer, noise and asset I/O, sized from conf.ini
+        Config::Get().Load("conf.ini");
+        if (!TaskSystem::Get().IsInitialized()) {
+            TaskSystem::Get().Initialize(TaskSystemConfig::FromConfig(Config::Get()));
+        }
+        TextureCache::Get().Configure(TextureCacheConfig::FromConfig(Config::Get()));
+        m_PipelineFrames = Config::Get().GetBool("VoxelEngine", "enableFramePipelining", true);
+
         InitWindow("Voxel Engine", 1280, 720);
 
         // Initialize renderer before other systems
         m_Renderer = std::make_unique<Renderer>();
         m_Renderer->Initialize();
+        m_Renderer->SetFrustumCullingEnabled(
+            Config::Get().GetBool("VoxelEngine", "frustumCullingEnabled", true));
+        m_Renderer->SetInstancingEnabled(
+            Config::Get().GetBool("VoxelEngine", "instancingEnabled", true));
+        m_CaptureFrameCount = static_cast<uint32_t>(
+            std::max(1, Config::Get().GetInt("VoxelEngine", "frameCaptureFrames", 1)));
+        TextureLoader::Get().SetUploadBudget(static_cast<size_t>(std::max(
+            1, Config::Get().GetInt("VoxelEngine", "textureUploadBudgetKB", 4096))) * 1024);
 
         m_InputSystem = std::make_unique<InputSystem>(m_Window.get(), *m_Renderer);
         if (!m_InputSystem) {
@@ -88,7 +120,7 @@ namespace Engine {
         m_ImGuiLayer->Init(m_Window.get());  // Explicitly call Init
         LOG_TRACE("ImGui initialized");
 
-        m_ImGuiOverlay = std::make_unique<ImGuiOverlay>(m_Window.get());
+        m_ImGuiOverlay = std::make_unique<ImGuiOverlay>(m_Window.get(), *m_Renderer);
 
         if (!m_ImGuiOverlay) {
             LOG_FATAL("ImGui layer init failed");
@@ -135,6 +167,10 @@ namespace Engine {
      * @brief Clean up application resources
      */
     Application::~Application() {
+        WaitForSimulation();
+        TextureLoader::Get().Shutdown();
+        Renderer2D::Get().Shutdown();  // Its state is static; release GL objects with the context
+        DeferredRelease::Get().ReleaseAll();
         if (m_ImGuiLayer) {
             m_ImGuiLayer->Shutdown();
         }
@@ -153,6 +189,11 @@ namespace Engine {
      * - Manages rendering and scene management
      * - Supports performance profiling and debug features
      * 
+     * With frame pipelining enabled the scene update and command recording for
+     * frame N+1 run on a worker while the main thread flushes and presents
+     * frame N. Lua and ImGui still run on the main thread, before the job is
+     * started, so neither sees the scene mid-update.
+     * 
      * @note The loop continues until `m_Running` is false or the window is closed
      * 
      * @pre Application systems must be initialized before calling
@@ -170,14 +211,20 @@ namespace Engine {
         Profiler::Get().BeginSession("Runtime");
         float lastFrameTime = 0.0f;
         while (m_Running && m_Window) {
+            const auto frameStart = FrameClock::now();
             auto time = static_cast<float>(glfwGetTime());
             float deltaTime = time - lastFrameTime;
             lastFrameTime = time;
+
+            FrameTimings timings;
+            timings.pipelined = m_PipelineFrames;
+
             // Update systems
+            auto stageStart = FrameClock::now();
             EventDebugger::Get().UpdateTimestamps(deltaTime);
             ProcessEvents();
             m_InputSystem->Update(deltaTime);
-            SceneManager::Get().Update(deltaTime);
+            timings.eventsMs = MillisecondsSince(stageStart);
             
             // Handle toggles
             if (HandleKeyToggle(GLFW_KEY_F3, time)) {
@@ -186,6 +233,13 @@ namespace Engine {
             if (HandleKeyToggle(GLFW_KEY_F2, time)) {
                 m_ImGuiEnabled = m_KeyToggles[GLFW_KEY_F2].currentValue;
             }
+            if (HandleKeyToggle(GLFW_KEY_F9, time) && !m_Renderer->IsCapturing()) {
+                // Replay with: sandbox --replay <file> [iterations]
+                const auto stamp = std::chrono::duration_cast<std::chrono::seconds>(
+                    std::chrono::system_clock::now().time_since_epoch()).count();
+                m_Renderer->CaptureFrames(m_CaptureFrameCount,
+                                          "capture_" + std::to_string(stamp) + ".vxcap");
+            }
             
             if (m_ShowFPSCounter) { UpdateFPSCounter(deltaTime); };
             
@@ -193,13 +247,79 @@ namespace Engine {
             // Update hot-reloading system
             ShaderHotReload::Get().Update();
             #endif
-            
-            // Render frame
+
+            // The main thread may only touch the scene once the previous simulation is done
+            stageStart = FrameClock::now();
+            WaitForSimulation();
+            timings.simulationWaitMs = MillisecondsSince(stageStart);
+
+            stageStart = FrameClock::now();
+            // Upload textures decoded since the last frame, up to the frame's byte budget
+            TextureLoader::Get().Update(TextureLoader::Get().GetUploadBudget());
             BeginScene();
             OnImGuiRender();
+            timings.mainUpdateMs = MillisecondsSince(stageStart);
+
+            SceneManager::Get().PrepareRender(*m_Renderer);
+            if (timings.pipelined) {
+                // Draw the commands recorded last frame while a worker records the next frame;
+                // the recorded commands hold copied transforms, so they act as a scene snapshot
+                timings.simulationMs = m_LastSimulationMs;
+                m_Renderer->SwapCommandBuffers();
+                // Simulation priority: Present()'s ParallelFor waits never run it inline
+                m_SimulationTask = TaskSystem::Get().Submit(
+                    [this, deltaTime] { RunSimulation(deltaTime); }, TaskPriority::Simulation);
+            } else {
+                RunSimulation(deltaTime);
+                timings.simulationMs = m_LastSimulationMs;
+                m_Renderer->SwapCommandBuffers();
+            }
+
+            // Render frame
+            stageStart = FrameClock::now();
             Present();
+            timings.renderSubmitMs = MillisecondsSince(stageStart);
+
+            stageStart = FrameClock::now();
             EndScene();
+            timings.presentMs = MillisecondsSince(stageStart);
+            DeferredRelease::Get().EndFrame();
+            RenderState::Get().EndFrame();
+
+            timings.totalMs = MillisecondsSince(frameStart);
+            m_FrameTimings = timings;
+            if (!m_TexturesReadyLogged) LogStartupProgress();
+        }
+        WaitForSimulation();
+    }
+
+    void Application::LogStartupProgress() {
+        const float elapsedMs = MillisecondsSince(m_StartTime);
+        if (!m_FirstFrameLogged) {
+            LOG_INFO_CONCAT("First frame after ", elapsedMs, " ms");
+            m_FirstFrameLogged = true;
         }
+        if (TextureLoader::Get().IsIdle()) {
+            const TextureCache::Statistics cache = TextureCache::Get().GetStatistics();
+            LOG_INFO_CONCAT("Textures ready after ", elapsedMs, " ms (texture cache: ", cache.hits,
+                            " hits, ", cache.misses, " misses)");
+            m_TexturesReadyLogged = true;
+        }
+    }
+
+    void Application::RunSimulation(float deltaTime) {
+        PROFILE_FUNCTION();
+        const auto start = FrameClock::now();
+
+        SceneManager::Get().Update(deltaTime);
+        SceneManager::Get().Render(*m_Renderer);
+
+        m_LastSimulationMs = MillisecondsSince(start);
+    }
+
+    void Application::WaitForSimulation() {
+        PROFILE_FUNCTION();
+        TaskSystem::Get().Wait(m_SimulationTask);
     }
 
     /**
@@ -331,6 +451,8 @@ namespace Engine {
         if (m_ImGuiEnabled) {
             // Always show these controls
             m_ImGuiOverlay->RenderProfiler();
+            m_ImGuiOverlay->RenderFrameTimings(m_FrameTimings, m_PipelineFrames);
+            m_ImGuiOverlay->RenderRenderStatistics(m_Renderer->GetStatistics());
             m_ImGuiOverlay->RenderEventDebugger();
 
             if (m_ShowFPSCounter) {
@@ -382,6 +504,7 @@ namespace Engine {
     void Application::InitializeToggleStates() {
         AddToggleState(GLFW_KEY_F2, true);  // ImGui enabled by default
         AddToggleState(GLFW_KEY_F3, true);  // FPS counter enabled by default
+        AddToggleState(GLFW_KEY_F9, false); // Any press starts a frame capture
     }
 
     bool Application::HandleKeyToggle(int key, float currentTime) {
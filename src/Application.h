@@ -5,6 +5,8 @@
 #include "Camera/CameraTypes.h"
 #include "Core/AssetManager.h"
 #include "Core/FPSCounter.h"
+#include "Core/FrameTimings.h"
+#include "Core/TaskSystem.h"
 #include "ImGui/ImGuiLayer.h"
 #include "Input/InputSystem.h"
 #include "Renderer/Light.h"
@@ -70,6 +72,16 @@ class Application {
     }
     CameraType GetCameraType() const { return m_CameraType; }
 
+    /** @return Per-stage timings of the last completed frame */
+    const FrameTimings& GetFrameTimings() const { return m_FrameTimings; }
+
+    /**
+     * @brief Enables or disables overlapping simulation with rendering
+     * @param enabled If true, frame N+1 is simulated on a worker while frame N is drawn
+     */
+    void SetFramePipelining(bool enabled) { m_PipelineFrames = enabled; }
+    bool IsFramePipeliningEnabled() const { return m_PipelineFrames; }
+
    protected:
     /**
      * @brief Initialize the application window
@@ -111,6 +123,19 @@ class Application {
      */
     void ProcessEvents();
 
+    /**
+     * @brief Updates the active scene and records its render commands
+     * @details Runs on a worker when frame pipelining is enabled; must not
+     *          touch GL or the Lua state
+     * @param deltaTime Time since last frame
+     */
+    void RunSimulation(float deltaTime);
+
+    /**
+     * @brief Blocks until the in-flight simulation (if any) has finished
+     */
+    void WaitForSimulation();
+
     void ConfigureForRenderType();
 
     std::unique_ptr<Renderer> m_Renderer;
@@ -194,7 +219,22 @@ class Application {
 
     CameraType m_CameraType = CameraType::Perspective;
 
+    // Frame pipelining
+    bool m_PipelineFrames = true;      ///< Overlap simulation of the next frame with rendering
+    TaskHandle m_SimulationTask;       ///< Simulation running on a worker, if any
+    float m_LastSimulationMs = 0.0f;   ///< Duration of the last RunSimulation()
+    FrameTimings m_FrameTimings;       ///< Timings of the last completed frame
+
+    uint32_t m_CaptureFrameCount = 1;  ///< Frames recorded per F9 capture
+
+    // Startup timing
+    std::chrono::steady_clock::time_point m_StartTime;  ///< Constructor entry
+    bool m_FirstFrameLogged = false;
+    bool m_TexturesReadyLogged = false;
+
     void ConfigureCamera();
+    /** @brief Logs the time to the first frame and to the last startup texture upload */
+    void LogStartupProgress();
 };
 
 // To be defined by client application
@@ -0,0 +1,47 @@
+#pragma once
+#include <pch.h>
+
+namespace Engine {
+    /**
+     * @brief The six clip planes of a view-projection matrix
+     * @details Planes are stored as (normal, distance) with normals pointing
+     *          inwards and normalised, so a point p is inside a plane when
+     *          dot(normal, p) + distance >= 0.
+     */
+    struct Frustum {
+        enum Plane { Left = 0, Right, Bottom, Top, Near, Far, Count };
+
+        std::array<glm::vec4, Plane::Count> planes;
+
+        /**
+         * @brief Extracts the planes from a view-projection matrix (Gribb/Hartmann)
+         * @param viewProjection Combined matrix mapping world space to OpenGL clip space
+         */
+        static Frustum FromViewProjection(const glm::mat4& viewProjection) {
+            // Row i of the matrix; glm is column-major
+            auto row = [&](int i) {
+                return glm::vec4(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i],
+                                 viewProjection[3][i]);
+            };
+
+            Frustum frustum;
+            frustum.planes[Left] = row(3) + row(0);
+            frustum.planes[Right] = row(3) - row(0);
+            frustum.planes[Bottom] = row(3) + row(1);
+            frustum.planes[Top] = row(3) - row(1);
+            frustum.planes[Near] = row(3) + row(2);
+            frustum.planes[Far] = row(3) - row(2);
+
+            for (auto& plane : frustum.planes) {
+                float length = std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+                if (length > 0.0f) {
+                    plane.x /= length;
+                    plane.y /= length;
+                    plane.z /= length;
+                    plane.w /= length;
+                }
+            }
+            return frustum;
+        }
+    };
+}
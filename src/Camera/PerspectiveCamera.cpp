@@ -23,6 +23,7 @@ namespace Engine {
         
         m_ViewMatrix = glm::lookAt(m_Position, m_Position + m_Front, m_Up);
         m_ViewProjectionMatrix = m_ProjectionMatrix * m_ViewMatrix;
+        m_Frustum = Frustum::FromViewProjection(m_ViewProjectionMatrix);
     }
 
     void PerspectiveCamera::MoveForward(float deltaTime) {
@@ -2,6 +2,8 @@
 
 #include <pch.h>
 
+#include "Frustum.h"
+
 namespace Engine {
     /**
      * @brief A perspective camera class for 3D rendering
@@ -66,6 +68,8 @@ namespace Engine {
         const glm::mat4& GetProjectionMatrix() const { return m_ProjectionMatrix; }
         /** @return The combined view-projection matrix */
         const glm::mat4& GetViewProjectionMatrix() const { return m_ViewProjectionMatrix; }
+        /** @return World-space clip planes of the current view-projection matrix */
+        const Frustum& GetFrustum() const { return m_Frustum; }
         /** @return The camera's front vector */
         const glm::vec3& GetFront() const { return m_Front; }
         
@@ -76,6 +80,7 @@ namespace Engine {
         glm::mat4 m_ViewMatrix = glm::mat4(1.0f);
         glm::mat4 m_ProjectionMatrix;
         glm::mat4 m_ViewProjectionMatrix;
+        Frustum m_Frustum;
         
         glm::vec3 m_Position = glm::vec3(0.0f);
         glm::vec3 m_Front = glm::vec3(0.0f, 0.0f, -1.0f);
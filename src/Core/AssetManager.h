@@ -6,8 +6,10 @@
 
 #include "../Renderer/Buffer.h"
 #include "../Renderer/Texture.h"
+#include "../Renderer/TextureLoader.h"
 #include "../Renderer/VertexArray.h"
 #include "Resource.h"
+#include "TaskSystem.h"
 
 namespace Engine {
 
@@ -35,11 +37,15 @@ public:
      */
     template<typename T>
     std::shared_ptr<T> LoadResource(const std::string& path) {
-        // Check cache first
+        // Check cache first; an entry unloaded since it was cached is loaded again
         auto it = m_ResourceCache.find(path);
         if (it != m_ResourceCache.end()) {
             auto resource = std::dynamic_pointer_cast<T>(it->second);
             if (resource) {
+                if (!resource->IsLoaded() && !resource->Load(path)) {
+                    LOG_ERROR_CONCAT("Failed to reload resource: ", path);
+                    return nullptr;
+                }
                 resource->AddRef();
                 return resource;
             }
@@ -112,6 +118,7 @@ public:
         if (it != m_ResourceCache.end()) {
             it->second->Release();
             if (it->second->GetRefCount() <= 0) {
+                m_TextureLoads.erase(path);
                 m_ResourceCache.erase(it);
             }
         }
@@ -122,6 +129,7 @@ public:
         // Only remove non-frequent resources that have no references
         for (auto it = m_ResourceCache.begin(); it != m_ResourceCache.end();) {
             if (it->second->GetRefCount() <= 0 && !IsFrequentlyUsed(it->first)) {
+                m_TextureLoads.erase(it->first);
                 it = m_ResourceCache.erase(it);
             } else {
                 ++it;
@@ -130,18 +138,57 @@ public:
     }
 
     /**
-     * @brief Asynchronously load a resource
-     * @tparam T The resource type to load
+     * @brief Asynchronously load a resource on the TaskSystem's I/O threads
+     * @tparam T The resource type to load; not Texture, whose Load() needs the GL context
      * @param path Path to the resource
      * @return Future containing the loaded resource
      */
     template<typename T>
     std::future<std::shared_ptr<T>> LoadResourceAsync(const std::string& path) {
-        return std::async(std::launch::async, [this, path]() {
+        static_assert(!std::is_base_of_v<Texture, T>, "Load textures with LoadTextureAsync()");
+        return TaskSystem::Get().EnqueueIOTask([this, path]() {
             return LoadResource<T>(path);
         });
     }
 
+    /**
+     * @brief Load a texture in the background through the TextureLoader
+     * @details Loads of the same path share one handle. The texture is a placeholder
+     *          until TextureLoader::Update() uploads it and is cached like LoadResource()
+     *          from the start, so synchronous lookups of the path return the same object.
+     * @param path Path to the image file
+     * @param options Mip generation and placeholder colour, used by the first load only
+     * @return Handle to the loading texture
+     */
+    AsyncTexture LoadTextureAsync(const std::string& path,
+                                  const TextureLoadOptions& options = TextureLoadOptions()) {
+        auto it = m_TextureLoads.find(path);
+        if (it != m_TextureLoads.end()) {
+            it->second.GetTexture()->AddRef();
+            return it->second;
+        }
+
+        AsyncTexture handle;
+        auto cached = m_ResourceCache.find(path);
+        auto texture = cached != m_ResourceCache.end()
+                           ? std::dynamic_pointer_cast<Texture>(cached->second)
+                           : nullptr;
+        if (texture) {
+            // Already loaded synchronously; hand out a finished load
+            auto request = std::make_shared<TextureLoadRequest>();
+            request->path = path;
+            request->texture = texture;
+            request->state = TextureLoadState::Ready;
+            handle = AsyncTexture(std::move(request));
+        } else {
+            handle = TextureLoader::Get().Load(path, options);
+        }
+        handle.GetTexture()->AddRef();
+        m_ResourceCache[path] = handle.GetTexture();
+        m_TextureLoads.emplace(path, handle);
+        return handle;
+    }
+
     /**
      * @brief Get total memory usage of loaded resources
      * @return Size in bytes of memory used
@@ -210,6 +257,7 @@ public:
             vb->SetLayout(layout);
             cubeMesh->AddVertexBuffer(vb);
             cubeMesh->SetIndexBuffer(ib);
+            cubeMesh->SetBounds(AABB::FromVertices(vertices, sizeof(vertices), layout));
         }
         return cubeMesh;
     }
@@ -237,12 +285,14 @@ private:
         m_ResourceCache.clear();
         m_FrequentResourceCache.clear();
         m_FrequentlyUsedPaths.clear();
+        m_TextureLoads.clear();
         m_TotalMemoryUsage = 0;
     }
 
     std::unordered_map<std::string, std::shared_ptr<Resource>> m_ResourceCache; ///< Main resource cache
     std::unordered_map<std::string, std::shared_ptr<Resource>> m_FrequentResourceCache; ///< Cache for frequently used resources
     std::unordered_set<std::string> m_FrequentlyUsedPaths; ///< Set of paths marked as frequently used
+    std::unordered_map<std::string, AsyncTexture> m_TextureLoads; ///< Handles of background texture loads
     size_t m_TotalMemoryUsage = 0; ///< Total memory used by all resources
 };
 
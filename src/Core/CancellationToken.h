@@ -0,0 +1,45 @@
+#pragma once
+#include "../pch.h"
+#include <atomic>
+
+namespace Engine {
+    /**
+     * @brief Shared flag used to cooperatively cancel queued or running tasks
+     *
+     * Copies of a token share one flag. Queued tasks whose token is cancelled
+     * are skipped by the TaskSystem; running tasks should poll
+     * TaskSystem::IsCancellationRequested() (or the token itself) at natural
+     * break points and return early. A default-constructed token can never be
+     * cancelled and costs nothing; Create() allocates the shared flag once, so
+     * make one per request (e.g. per chunk), not per task.
+     */
+    class CancellationToken {
+    public:
+        CancellationToken() = default;
+
+        /** @return A new token that can be cancelled */
+        static CancellationToken Create() {
+            CancellationToken token;
+            token.m_State = std::make_shared<std::atomic<bool>>(false);
+            return token;
+        }
+
+        /** @brief Requests cancellation of every task holding this token */
+        void Cancel() const {
+            if (m_State) {
+                m_State->store(true, std::memory_order_release);
+            }
+        }
+
+        /** @return Whether Cancel() has been called on this token or a copy of it */
+        bool IsCancelled() const {
+            return m_State && m_State->load(std::memory_order_acquire);
+        }
+
+        /** @return Whether this token was created with Create() */
+        bool CanBeCancelled() const { return m_State != nullptr; }
+
+    private:
+        std::shared_ptr<std::atomic<bool>> m_State;
+    };
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <pch.h>
+#include <cctype>
+
+namespace Engine {
+    /**
+     * @brief Engine settings loaded from an INI file (conf.ini)
+     * @details Values are addressed by section and key. Missing files or keys
+     *          fall back to the defaults passed by the caller, so every setting
+     *          is optional.
+     */
+    class Config {
+    public:
+        /** @return Reference to the singleton Config instance */
+        static Config& Get() {
+            static Config instance;
+            return instance;
+        }
+
+        /**
+         * @brief Parses an INI file, replacing previously loaded values
+         * @param path Path to the INI file
+         * @return true if the file was read
+         */
+        bool Load(const std::string& path) {
+            std::ifstream file(path);
+            if (!file.is_open()) {
+                LOG_WARN_CONCAT("Config file not found: ", path);
+                return false;
+            }
+
+            m_Values.clear();
+            std::string section;
+            std::string line;
+            while (std::getline(file, line)) {
+                line = Trim(line);
+                if (line.empty() || line[0] == ';' || line[0] == '#') continue;
+
+                if (line.front() == '[' && line.back() == ']') {
+                    section = Trim(line.substr(1, line.size() - 2));
+                    continue;
+                }
+
+                size_t separator = line.find('=');
+                if (separator == std::string::npos) continue;
+                m_Values[MakeKey(section, Trim(line.substr(0, separator)))] =
+                    Trim(line.substr(separator + 1));
+            }
+            return true;
+        }
+
+        /** @return Raw value, or defaultValue if the key is missing */
+        std::string GetString(const std::string& section, const std::string& key,
+                              const std::string& defaultValue = "") const {
+            auto it = m_Values.find(MakeKey(section, key));
+            return it != m_Values.end() ? it->second : defaultValue;
+        }
+
+        /** @return Integer value, or defaultValue if missing or malformed */
+        int GetInt(const std::string& section, const std::string& key, int defaultValue) const {
+            auto it = m_Values.find(MakeKey(section, key));
+            if (it == m_Values.end()) return defaultValue;
+            try {
+                return std::stoi(it->second);
+            } catch (const std::exception&) {
+                LOG_WARN_CONCAT("Config value ", section, ".", key, " is not an integer");
+                return defaultValue;
+            }
+        }
+
+        /** @return Boolean value (True/False, 1/0, yes/no), or defaultValue if missing */
+        bool GetBool(const std::string& section, const std::string& key, bool defaultValue) const {
+            auto it = m_Values.find(MakeKey(section, key));
+            if (it == m_Values.end()) return defaultValue;
+
+            std::string value = it->second;
+            std::transform(value.begin(), value.end(), value.begin(),
+                           [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+            if (value == "true" || value == "1" || value == "yes") return true;
+            if (value == "false" || value == "0" || value == "no") return false;
+            LOG_WARN_CONCAT("Config value ", section, ".", key, " is not a boolean");
+            return defaultValue;
+        }
+
+    private:
+        Config() = default;
+
+        static std::string MakeKey(const std::string& section, const std::string& key) {
+            return section + "." + key;
+        }
+
+        static std::string Trim(const std::string& str) {
+            const char* whitespace = " \t\r\n";
+            size_t first = str.find_first_not_of(whitespace);
+            if (first == std::string::npos) return "";
+            size_t last = str.find_last_not_of(whitespace);
+            return str.substr(first, last - first + 1);
+        }
+
+        std::unordered_map<std::string, std::string> m_Values;
+    };
+}
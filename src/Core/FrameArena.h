@@ -0,0 +1,92 @@
+#pragma once
+#include <pch.h>
+
+namespace Engine {
+    /**
+     * @brief Per-frame linear arena of trivially destructible records
+     *
+     * Emplace() bumps an atomic counter and constructs the record in place, so
+     * any number of threads can append without locks. Storage is a table of
+     * fixed-size blocks that are allocated on first use and kept across
+     * Reset(), which makes steady-state frames allocation-free and keeps
+     * references to emplaced records stable until the next Reset().
+     *
+     * Reading (Size(), operator[]) and Reset() must not race with Emplace();
+     * the owner synchronises them with a frame boundary.
+     *
+     * @tparam T Record type; must be trivially destructible since records are
+     *           dropped by Reset() without running destructors
+     */
+    template<typename T, size_t BLOCK_SIZE = 4096, size_t MAX_BLOCKS = 1024>
+    class FrameArena {
+        static_assert(std::is_trivially_destructible_v<T>,
+                      "FrameArena drops records without destroying them");
+
+    public:
+        static constexpr size_t CAPACITY = BLOCK_SIZE * MAX_BLOCKS;   ///< Records per frame
+
+        FrameArena() {
+            for (auto& block : m_Blocks) block.store(nullptr, std::memory_order_relaxed);
+        }
+
+        ~FrameArena() {
+            for (auto& block : m_Blocks) {
+                if (T* storage = block.load(std::memory_order_relaxed)) {
+                    ::operator delete(storage, std::align_val_t(alignof(T)));
+                }
+            }
+        }
+
+        FrameArena(const FrameArena&) = delete;
+        FrameArena& operator=(const FrameArena&) = delete;
+
+        /**
+         * @brief Appends a record; safe to call from multiple threads
+         * @details The slot is claimed only while the arena has room, so a full arena
+         *          asserts without counting a record that was never constructed
+         * @return Reference to the record, valid until Reset()
+         */
+        template<typename... Args>
+        T& Emplace(Args&&... args) {
+            size_t index = m_Size.load(std::memory_order_relaxed);
+            do {
+                ASSERT(index < CAPACITY && "FrameArena capacity exceeded");
+            } while (!m_Size.compare_exchange_weak(index, index + 1, std::memory_order_relaxed));
+            T* block = AcquireBlock(index / BLOCK_SIZE);
+            return *new (block + index % BLOCK_SIZE) T{std::forward<Args>(args)...};
+        }
+
+        /** @return Number of records appended since the last Reset() */
+        size_t Size() const { return m_Size.load(std::memory_order_acquire); }
+        bool Empty() const { return Size() == 0; }
+
+        T& operator[](size_t index) {
+            return m_Blocks[index / BLOCK_SIZE].load(std::memory_order_relaxed)[index % BLOCK_SIZE];
+        }
+        const T& operator[](size_t index) const {
+            return m_Blocks[index / BLOCK_SIZE].load(std::memory_order_relaxed)[index % BLOCK_SIZE];
+        }
+
+        /** @brief Drops all records, keeping the blocks for the next frame */
+        void Reset() { m_Size.store(0, std::memory_order_release); }
+
+    private:
+        T* AcquireBlock(size_t blockIndex) {
+            T* block = m_Blocks[blockIndex].load(std::memory_order_acquire);
+            if (block) return block;
+
+            // First use of this block: race to install a fresh one, losers free theirs
+            T* fresh = static_cast<T*>(
+                ::operator new(sizeof(T) * BLOCK_SIZE, std::align_val_t(alignof(T))));
+            if (m_Blocks[blockIndex].compare_exchange_strong(block, fresh,
+                                                             std::memory_order_acq_rel)) {
+                return fresh;
+            }
+            ::operator delete(fresh, std::align_val_t(alignof(T)));
+            return block;
+        }
+
+        std::atomic<size_t> m_Size{0};
+        std::array<std::atomic<T*>, MAX_BLOCKS> m_Blocks;
+    };
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include <pch.h>
+
+namespace Engine {
+    /**
+     * @brief Per-stage CPU timings of the last frame, in milliseconds
+     *
+     * With frame pipelining the simulation of frame N+1 runs on a worker while
+     * the main thread submits GL for frame N, so simulationMs overlaps the
+     * render stages. The time actually hidden is simulationMs minus
+     * simulationWaitMs.
+     */
+    struct FrameTimings {
+        float eventsMs = 0.0f;          ///< Event processing and input update
+        float mainUpdateMs = 0.0f;      ///< Texture uploads, ImGui and Lua UpdateScene (main thread)
+        float simulationMs = 0.0f;      ///< Scene update and render command recording
+        float simulationWaitMs = 0.0f;  ///< Main thread stalled waiting for the simulation
+        float renderSubmitMs = 0.0f;    ///< Renderer flush (GL submission)
+        float presentMs = 0.0f;         ///< ImGui draw and buffer swap
+        float totalMs = 0.0f;           ///< Whole frame
+        bool pipelined = false;         ///< Whether the simulation overlapped rendering
+
+        /** @return Simulation time hidden behind main thread work */
+        float GetOverlapMs() const {
+            return pipelined ? std::max(0.0f, simulationMs - simulationWaitMs) : 0.0f;
+        }
+    };
+}
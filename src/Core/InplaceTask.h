@@ -0,0 +1,107 @@
+#pragma once
+#include "../pch.h"
+#include <new>
+#include <type_traits>
+
+namespace Engine {
+    /**
+     * @brief Move-only void() callable stored entirely inside the object
+     *
+     * Replacement for std::function on the task submission path. The callable
+     * is placement-constructed into a fixed buffer, so creating, moving and
+     * invoking a task never touches the heap. Callables that do not fit are
+     * rejected at compile time; capture large state by pointer or reference.
+     */
+    class InplaceTask {
+    public:
+        /** @brief Bytes available for the callable and its captures */
+        static constexpr size_t CAPACITY = 48;
+
+        /** @brief Whether a callable of type F can be stored without allocating */
+        template<typename F>
+        static constexpr bool FitsInline = sizeof(std::decay_t<F>) <= CAPACITY &&
+            alignof(std::decay_t<F>) <= alignof(std::max_align_t) &&
+            std::is_nothrow_move_constructible_v<std::decay_t<F>>;
+
+        InplaceTask() = default;
+
+        /**
+         * @brief Stores a callable in the inline buffer
+         * @param fn Callable invoked as fn()
+         */
+        template<typename F,
+                 typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, InplaceTask>>>
+        InplaceTask(F&& fn) {
+            using Fn = std::decay_t<F>;
+            static_assert(sizeof(Fn) <= CAPACITY,
+                          "Task captures exceed InplaceTask::CAPACITY; capture by pointer instead");
+            static_assert(alignof(Fn) <= alignof(std::max_align_t), "Over-aligned task callable");
+            static_assert(std::is_nothrow_move_constructible_v<Fn>,
+                          "Task callables must be nothrow move constructible");
+
+            new (m_Storage) Fn(std::forward<F>(fn));
+            m_Ops = &s_Ops<Fn>;
+        }
+
+        InplaceTask(InplaceTask&& other) noexcept { MoveFrom(other); }
+
+        InplaceTask& operator=(InplaceTask&& other) noexcept {
+            if (this != &other) {
+                Reset();
+                MoveFrom(other);
+            }
+            return *this;
+        }
+
+        InplaceTask(const InplaceTask&) = delete;
+        InplaceTask& operator=(const InplaceTask&) = delete;
+
+        ~InplaceTask() { Reset(); }
+
+        /** @brief Invokes the stored callable */
+        void operator()() {
+            ASSERT(m_Ops && "Invoking an empty InplaceTask!");
+            m_Ops->invoke(m_Storage);
+        }
+
+        /** @return Whether a callable is stored */
+        explicit operator bool() const { return m_Ops != nullptr; }
+
+        /** @brief Destroys the stored callable, leaving the task empty */
+        void Reset() {
+            if (m_Ops) {
+                m_Ops->destroy(m_Storage);
+                m_Ops = nullptr;
+            }
+        }
+
+    private:
+        /** @brief Type-erased operations for one callable type */
+        struct Ops {
+            void (*invoke)(void* storage);
+            void (*move)(void* dst, void* src);
+            void (*destroy)(void* storage);
+        };
+
+        template<typename Fn>
+        static constexpr Ops s_Ops = {
+            [](void* storage) { (*static_cast<Fn*>(storage))(); },
+            [](void* dst, void* src) {
+                new (dst) Fn(std::move(*static_cast<Fn*>(src)));
+                static_cast<Fn*>(src)->~Fn();
+            },
+            [](void* storage) { static_cast<Fn*>(storage)->~Fn(); },
+        };
+
+        void MoveFrom(InplaceTask& other) {
+            if (other.m_Ops) {
+                other.m_Ops->move(m_Storage, other.m_Storage);
+                m_Ops = other.m_Ops;
+                other.m_Ops = nullptr;
+            }
+        }
+
+        alignas(std::max_align_t) unsigned char m_Storage[CAPACITY];
+        const Ops* m_Ops = nullptr;
+    };
+}
@@ -0,0 +1,113 @@
+#pragma once
+#include "../pch.h"
+#include <atomic>
+
+namespace Engine {
+    /**
+     * @brief Bounded lock-free multi-producer multi-consumer queue
+     *
+     * Array-based queue where every cell carries a sequence number telling
+     * producers and consumers whose turn it is (D. Vyukov's design). Push and
+     * pop are a single CAS on the shared position in the uncontended case and
+     * never allocate; the cell array is allocated once at construction.
+     *
+     * @tparam T Element type, must be default and move constructible
+     */
+    template<typename T>
+    class MPMCQueue {
+    public:
+        /**
+         * @brief Creates a queue
+         * @param capacity Maximum number of elements, rounded up to a power of two
+         */
+        explicit MPMCQueue(size_t capacity) {
+            size_t size = 2;
+            while (size < capacity) size <<= 1;
+
+            m_Mask = size - 1;
+            m_Cells = std::make_unique<Cell[]>(size);
+            for (size_t i = 0; i < size; ++i) {
+                m_Cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        MPMCQueue(const MPMCQueue&) = delete;
+        MPMCQueue& operator=(const MPMCQueue&) = delete;
+
+        /**
+         * @brief Appends an element if there is room
+         * @param value Element to move into the queue; left untouched on failure
+         * @return false if the queue is full
+         */
+        template<typename U>
+        bool TryPush(U&& value) {
+            size_t pos = m_EnqueuePos.load(std::memory_order_relaxed);
+            Cell* cell;
+            while (true) {
+                cell = &m_Cells[pos & m_Mask];
+                const size_t seq = cell->sequence.load(std::memory_order_acquire);
+                const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+                if (diff == 0) {
+                    if (m_EnqueuePos.compare_exchange_weak(pos, pos + 1,
+                                                           std::memory_order_relaxed)) {
+                        break;
+                    }
+                } else if (diff < 0) {
+                    return false;
+                } else {
+                    pos = m_EnqueuePos.load(std::memory_order_relaxed);
+                }
+            }
+
+            cell->value = std::forward<U>(value);
+            cell->sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Removes the oldest element if there is one
+         * @param out Receives the element
+         * @return false if the queue is empty
+         */
+        bool TryPop(T& out) {
+            size_t pos = m_DequeuePos.load(std::memory_order_relaxed);
+            Cell* cell;
+            while (true) {
+                cell = &m_Cells[pos & m_Mask];
+                const size_t seq = cell->sequence.load(std::memory_order_acquire);
+                const intptr_t diff =
+                    static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+                if (diff == 0) {
+                    if (m_DequeuePos.compare_exchange_weak(pos, pos + 1,
+                                                           std::memory_order_relaxed)) {
+                        break;
+                    }
+                } else if (diff < 0) {
+                    return false;
+                } else {
+                    pos = m_DequeuePos.load(std::memory_order_relaxed);
+                }
+            }
+
+            out = std::move(cell->value);
+            cell->sequence.store(pos + m_Mask + 1, std::memory_order_release);
+            return true;
+        }
+
+        /** @return Maximum number of elements */
+        size_t GetCapacity() const { return m_Mask + 1; }
+
+    private:
+        static constexpr size_t CACHE_LINE_SIZE = 64;
+
+        struct Cell {
+            std::atomic<size_t> sequence{0};
+            T value;
+        };
+
+        std::unique_ptr<Cell[]> m_Cells;
+        size_t m_Mask = 0;
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_EnqueuePos{0};
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_DequeuePos{0};
+    };
+}
@@ -0,0 +1,64 @@
+/**
+ * @file MappedFile.cpp
+ * @brief Platform implementations of read-only file mapping
+ */
+#include "MappedFile.h"
+
+#ifdef PLATFORM_WINDOWS
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace Engine {
+    std::shared_ptr<MappedFile> MappedFile::Open(const std::string& path) {
+        std::shared_ptr<MappedFile> file(new MappedFile());
+#ifdef PLATFORM_WINDOWS
+        HANDLE handle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                    OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (handle == INVALID_HANDLE_VALUE) return nullptr;
+        file->m_File = handle;
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(handle, &size) || size.QuadPart == 0) return nullptr;
+        file->m_Mapping = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!file->m_Mapping) return nullptr;
+        file->m_Data =
+            static_cast<const uint8_t*>(MapViewOfFile(file->m_Mapping, FILE_MAP_READ, 0, 0, 0));
+        if (!file->m_Data) return nullptr;
+        file->m_Size = static_cast<size_t>(size.QuadPart);
+#else
+        const int descriptor = open(path.c_str(), O_RDONLY);
+        if (descriptor < 0) return nullptr;
+
+        // The mapping keeps the file alive; the descriptor is not needed past mmap()
+        struct stat info;
+        void* data = MAP_FAILED;
+        if (fstat(descriptor, &info) == 0 && info.st_size > 0) {
+            data = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE,
+                        descriptor, 0);
+        }
+        close(descriptor);
+        if (data == MAP_FAILED) return nullptr;
+        file->m_Data = static_cast<const uint8_t*>(data);
+        file->m_Size = static_cast<size_t>(info.st_size);
+#endif
+        return file;
+    }
+
+    MappedFile::~MappedFile() {
+#ifdef PLATFORM_WINDOWS
+        if (m_Data) UnmapViewOfFile(m_Data);
+        if (m_Mapping) CloseHandle(m_Mapping);
+        if (m_File) CloseHandle(m_File);
+#else
+        if (m_Data) munmap(const_cast<uint8_t*>(m_Data), m_Size);
+#endif
+    }
+}
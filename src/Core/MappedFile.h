@@ -0,0 +1,36 @@
+#pragma once
+#include <pch.h>
+
+namespace Engine {
+    /**
+     * @brief Read-only memory mapping of a whole file
+     *
+     * Pages are read from disk when first touched, so opening a large file is
+     * cheap and data can be handed to GL without an intermediate copy. The
+     * file stays mapped, and locked against replacement on Windows, until the
+     * last reference is dropped. Thread-safe to read.
+     */
+    class MappedFile {
+    public:
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        /** @return Mapping of the file, null if it is missing, empty or cannot be mapped */
+        static std::shared_ptr<MappedFile> Open(const std::string& path);
+
+        const uint8_t* GetData() const { return m_Data; }
+        size_t GetSize() const { return m_Size; }
+
+    private:
+        MappedFile() = default;
+
+        const uint8_t* m_Data = nullptr;
+        size_t m_Size = 0;
+#ifdef PLATFORM_WINDOWS
+        void* m_File = nullptr;      ///< HANDLE of the file
+        void* m_Mapping = nullptr;   ///< HANDLE of the file mapping object
+#endif
+    };
+}
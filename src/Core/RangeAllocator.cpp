@@ -0,0 +1,318 @@
+/**
+ * @file RangeAllocator.cpp
+ * @brief TLSF range allocator
+ */
+#include "RangeAllocator.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace Engine {
+    namespace {
+        /** @return Index of the highest set bit; value must not be 0 */
+        uint32_t HighestBit(uint32_t value) {
+#if defined(_MSC_VER)
+            unsigned long index;
+            _BitScanReverse(&index, value);
+            return index;
+#else
+            return 31u - static_cast<uint32_t>(__builtin_clz(value));
+#endif
+        }
+
+        /** @return Index of the lowest set bit; value must not be 0 */
+        uint32_t LowestBit(uint32_t value) {
+#if defined(_MSC_VER)
+            unsigned long index;
+            _BitScanForward(&index, value);
+            return index;
+#else
+            return static_cast<uint32_t>(__builtin_ctz(value));
+#endif
+        }
+    }
+
+    RangeAllocator::RangeAllocator(uint32_t capacity) {
+        for (auto& lists : m_FreeLists) lists.fill(INVALID);
+        Grow(capacity);
+    }
+
+    void RangeAllocator::MapInsert(uint32_t size, uint32_t& fl, uint32_t& sl) {
+        if (size < SL_COUNT) {
+            fl = 0;
+            sl = size;
+            return;
+        }
+        const uint32_t bit = HighestBit(size);
+        sl = (size >> (bit - SL_BITS)) ^ SL_COUNT;
+        fl = bit - SL_BITS + 1;
+    }
+
+    void RangeAllocator::MapSearch(uint32_t size, uint32_t& fl, uint32_t& sl) {
+        if (size >= SL_COUNT) {
+            // Round up to the next class boundary so any block of the class fits
+            const uint64_t rounded =
+                static_cast<uint64_t>(size) + (1u << (HighestBit(size) - SL_BITS)) - 1;
+            size = static_cast<uint32_t>(std::min<uint64_t>(rounded, ~0u));
+        }
+        MapInsert(size, fl, sl);
+    }
+
+    uint32_t RangeAllocator::CreateNode() {
+        if (m_UnusedNodes != INVALID) {
+            const uint32_t node = m_UnusedNodes;
+            m_UnusedNodes = m_Nodes[node].nextFree;
+            m_Nodes[node] = Node{};
+            return node;
+        }
+        m_Nodes.emplace_back();
+        return static_cast<uint32_t>(m_Nodes.size() - 1);
+    }
+
+    void RangeAllocator::ReleaseNode(uint32_t node) {
+        m_Nodes[node] = Node{};
+        m_Nodes[node].nextFree = m_UnusedNodes;
+        m_UnusedNodes = node;
+    }
+
+    void RangeAllocator::InsertFree(uint32_t node) {
+        uint32_t fl, sl;
+        MapInsert(m_Nodes[node].size, fl, sl);
+        const uint32_t head = m_FreeLists[fl][sl];
+        m_Nodes[node].prevFree = INVALID;
+        m_Nodes[node].nextFree = head;
+        m_Nodes[node].free = true;
+        if (head != INVALID) m_Nodes[head].prevFree = node;
+        m_FreeLists[fl][sl] = node;
+        m_FlBitmap |= 1u << fl;
+        m_SlBitmaps[fl] |= 1u << sl;
+        ++m_FreeBlockCount;
+    }
+
+    void RangeAllocator::RemoveFree(uint32_t node) {
+        uint32_t fl, sl;
+        MapInsert(m_Nodes[node].size, fl, sl);
+        Node& block = m_Nodes[node];
+        if (block.prevFree != INVALID) m_Nodes[block.prevFree].nextFree = block.nextFree;
+        if (block.nextFree != INVALID) m_Nodes[block.nextFree].prevFree = block.prevFree;
+        if (m_FreeLists[fl][sl] == node) {
+            m_FreeLists[fl][sl] = block.nextFree;
+            if (block.nextFree == INVALID) {
+                m_SlBitmaps[fl] &= ~(1u << sl);
+                if (!m_SlBitmaps[fl]) m_FlBitmap &= ~(1u << fl);
+            }
+        }
+        block.prevFree = block.nextFree = INVALID;
+        block.free = false;
+        --m_FreeBlockCount;
+    }
+
+    uint32_t RangeAllocator::FindFree(uint32_t fl, uint32_t sl) const {
+        if (fl >= FL_COUNT) return INVALID;
+        uint32_t slMap = sl < SL_COUNT ? m_SlBitmaps[fl] & (~0u << sl) : 0;
+        if (!slMap) {
+            const uint32_t flMap = fl + 1 < 32 ? m_FlBitmap & (~0u << (fl + 1)) : 0;
+            if (!flMap) return INVALID;
+            fl = LowestBit(flMap);
+            slMap = m_SlBitmaps[fl];
+        }
+        return m_FreeLists[fl][LowestBit(slMap)];
+    }
+
+    RangeAllocator::Allocation RangeAllocator::Allocate(uint32_t size) {
+        size = std::max(size, 1u);
+        if (size > GetFree()) return {};
+
+        uint32_t fl, sl;
+        MapSearch(size, fl, sl);
+        const uint32_t node = FindFree(fl, sl);
+        if (node == INVALID) return {};
+        RemoveFree(node);
+
+        // Return the tail of the block to the free lists
+        if (m_Nodes[node].size > size) {
+            const uint32_t remainder = CreateNode();
+            Node& block = m_Nodes[node];
+            Node& rest = m_Nodes[remainder];
+            rest.offset = block.offset + size;
+            rest.size = block.size - size;
+            rest.prevPhysical = node;
+            rest.nextPhysical = block.nextPhysical;
+            if (block.nextPhysical != INVALID) m_Nodes[block.nextPhysical].prevPhysical = remainder;
+            block.nextPhysical = remainder;
+            block.size = size;
+            if (m_LastNode == node) m_LastNode = remainder;
+            InsertFree(remainder);
+        }
+
+        m_Used += size;
+        ++m_AllocationCount;
+        return {m_Nodes[node].offset, size, node};
+    }
+
+    void RangeAllocator::Free(const Allocation& allocation) {
+        ASSERT(allocation.IsValid() && allocation.node < m_Nodes.size() && "Invalid allocation");
+        uint32_t node = allocation.node;
+        ASSERT(!m_Nodes[node].free && m_Nodes[node].offset == allocation.offset &&
+               "Allocation freed twice or stale");
+        m_Used -= m_Nodes[node].size;
+        --m_AllocationCount;
+
+        const uint32_t previous = m_Nodes[node].prevPhysical;
+        if (previous != INVALID && m_Nodes[previous].free) {
+            RemoveFree(previous);
+            m_Nodes[previous].size += m_Nodes[node].size;
+            m_Nodes[previous].nextPhysical = m_Nodes[node].nextPhysical;
+            if (m_Nodes[node].nextPhysical != INVALID) {
+                m_Nodes[m_Nodes[node].nextPhysical].prevPhysical = previous;
+            }
+            if (m_LastNode == node) m_LastNode = previous;
+            ReleaseNode(node);
+            node = previous;
+        }
+
+        const uint32_t next = m_Nodes[node].nextPhysical;
+        if (next != INVALID && m_Nodes[next].free) {
+            RemoveFree(next);
+            m_Nodes[node].size += m_Nodes[next].size;
+            m_Nodes[node].nextPhysical = m_Nodes[next].nextPhysical;
+            if (m_Nodes[next].nextPhysical != INVALID) {
+                m_Nodes[m_Nodes[next].nextPhysical].prevPhysical = node;
+            }
+            if (m_LastNode == next) m_LastNode = node;
+            ReleaseNode(next);
+        }
+
+        InsertFree(node);
+    }
+
+    void RangeAllocator::Grow(uint32_t newCapacity) {
+        ASSERT(newCapacity >= m_Capacity && "RangeAllocator cannot shrink");
+        if (newCapacity <= m_Capacity) return;
+        const uint32_t extra = newCapacity - m_Capacity;
+
+        if (m_LastNode != INVALID && m_Nodes[m_LastNode].free) {
+            RemoveFree(m_LastNode);
+            m_Nodes[m_LastNode].size += extra;
+            InsertFree(m_LastNode);
+        } else {
+            const uint32_t node = CreateNode();
+            m_Nodes[node].offset = m_Capacity;
+            m_Nodes[node].size = extra;
+            m_Nodes[node].prevPhysical = m_LastNode;
+            if (m_LastNode != INVALID) {
+                m_Nodes[m_LastNode].nextPhysical = node;
+            } else {
+                m_FirstNode = node;
+            }
+            m_LastNode = node;
+            InsertFree(node);
+        }
+        m_Capacity = newCapacity;
+    }
+
+    std::vector<RangeAllocator::Move> RangeAllocator::Defragment() {
+        std::vector<Move> moves;
+        uint32_t cursor = 0;
+        uint32_t previous = INVALID;
+        uint32_t node = m_FirstNode;
+        m_FirstNode = INVALID;
+
+        while (node != INVALID) {
+            const uint32_t next = m_Nodes[node].nextPhysical;
+            if (m_Nodes[node].free) {
+                RemoveFree(node);
+                ReleaseNode(node);
+            } else {
+                Node& block = m_Nodes[node];
+                if (block.offset != cursor) moves.push_back({node, block.offset, cursor, block.size});
+                block.offset = cursor;
+                block.prevPhysical = previous;
+                block.nextPhysical = INVALID;
+                if (previous != INVALID) {
+                    m_Nodes[previous].nextPhysical = node;
+                } else {
+                    m_FirstNode = node;
+                }
+                previous = node;
+                cursor += block.size;
+            }
+            node = next;
+        }
+
+        m_LastNode = previous;
+        if (cursor < m_Capacity) {
+            const uint32_t tail = CreateNode();
+            m_Nodes[tail].offset = cursor;
+            m_Nodes[tail].size = m_Capacity - cursor;
+            m_Nodes[tail].prevPhysical = previous;
+            if (previous != INVALID) {
+                m_Nodes[previous].nextPhysical = tail;
+            } else {
+                m_FirstNode = tail;
+            }
+            m_LastNode = tail;
+            InsertFree(tail);
+        }
+        return moves;
+    }
+
+    uint32_t RangeAllocator::GetLargestFreeBlock() const {
+        if (!m_FlBitmap) return 0;
+        const uint32_t fl = HighestBit(m_FlBitmap);
+        const uint32_t sl = HighestBit(m_SlBitmaps[fl]);
+        uint32_t largest = 0;
+        for (uint32_t node = m_FreeLists[fl][sl]; node != INVALID; node = m_Nodes[node].nextFree) {
+            largest = std::max(largest, m_Nodes[node].size);
+        }
+        return largest;
+    }
+
+    float RangeAllocator::GetFragmentation() const {
+        const uint32_t free = GetFree();
+        if (free == 0) return 0.0f;
+        return 1.0f - static_cast<float>(GetLargestFreeBlock()) / static_cast<float>(free);
+    }
+
+    bool RangeAllocator::Validate() const {
+        uint32_t offset = 0, used = 0, allocations = 0, freeBlocks = 0;
+        uint32_t previous = INVALID;
+        for (uint32_t node = m_FirstNode; node != INVALID; node = m_Nodes[node].nextPhysical) {
+            const Node& block = m_Nodes[node];
+            if (block.offset != offset || block.size == 0 || block.prevPhysical != previous) {
+                return false;
+            }
+            if (block.free) {
+                if (previous != INVALID && m_Nodes[previous].free) return false;
+                uint32_t fl, sl;
+                MapInsert(block.size, fl, sl);
+                bool listed = false;
+                for (uint32_t it = m_FreeLists[fl][sl]; it != INVALID && !listed;
+                     it = m_Nodes[it].nextFree) {
+                    listed = it == node;
+                }
+                if (!listed) return false;
+                ++freeBlocks;
+            } else {
+                used += block.size;
+                ++allocations;
+            }
+            offset += block.size;
+            previous = node;
+        }
+        if (offset != m_Capacity || previous != m_LastNode) return false;
+        if (used != m_Used || allocations != m_AllocationCount || freeBlocks != m_FreeBlockCount) {
+            return false;
+        }
+
+        for (uint32_t fl = 0; fl < FL_COUNT; ++fl) {
+            for (uint32_t sl = 0; sl < SL_COUNT; ++sl) {
+                const bool listed = m_FreeLists[fl][sl] != INVALID;
+                if (listed != ((m_SlBitmaps[fl] >> sl) & 1u)) return false;
+            }
+            if ((m_SlBitmaps[fl] != 0) != ((m_FlBitmap >> fl) & 1u)) return false;
+        }
+        return true;
+    }
+}
@@ -0,0 +1,126 @@
+#pragma once
+#include <pch.h>
+
+namespace Engine {
+    /**
+     * @brief Two-level segregated fit (TLSF) allocator of ranges within a linear space
+     *
+     * Hands out [offset, offset + size) ranges of an abstract space such as the
+     * vertices of a large GPU buffer; it never touches the memory itself, so
+     * it runs and is benchmarked without a GL context. Free blocks are kept in
+     * size-class lists indexed by two bitmaps, making Allocate() and Free() O(1)
+     * with good-fit placement, and freed blocks merge with free neighbours
+     * immediately. Block bookkeeping lives in a recycled node table, so
+     * steady-state churn does not allocate.
+     *
+     * Units are whatever the caller counts in; a mesh pool counts vertices and
+     * indices so offsets are directly usable as base vertex and first index.
+     * Not thread-safe.
+     */
+    class RangeAllocator {
+    public:
+        static constexpr uint32_t INVALID = ~0u;
+
+        /** @brief A live range; node identifies it to Free() and survives Defragment() */
+        struct Allocation {
+            uint32_t offset = INVALID;
+            uint32_t size = 0;
+            uint32_t node = INVALID;
+
+            bool IsValid() const { return node != INVALID; }
+        };
+
+        /** @brief Relocation of one live range by Defragment() */
+        struct Move {
+            uint32_t node;
+            uint32_t from;
+            uint32_t to;
+            uint32_t size;
+        };
+
+        explicit RangeAllocator(uint32_t capacity = 0);
+
+        /**
+         * @brief Allocates a range of at least one unit
+         * @return Invalid allocation if no free block is large enough; Grow() and retry
+         */
+        Allocation Allocate(uint32_t size);
+
+        /** @brief Returns a range; neighbouring free blocks are merged */
+        void Free(const Allocation& allocation);
+
+        /** @brief Extends the space; the new tail merges with a trailing free block */
+        void Grow(uint32_t newCapacity);
+
+        /**
+         * @brief Packs every live range to the front of the space, in offset order
+         * @return Moves in ascending offset order; each has to <= from. Ranges may
+         *         overlap their destination, so copy into fresh storage or with
+         *         memmove semantics in the returned order
+         */
+        std::vector<Move> Defragment();
+
+        /** @return Current offset of a live range, which Defragment() may change */
+        uint32_t GetOffset(uint32_t node) const { return m_Nodes[node].offset; }
+
+        uint32_t GetCapacity() const { return m_Capacity; }
+        uint32_t GetUsed() const { return m_Used; }
+        uint32_t GetFree() const { return m_Capacity - m_Used; }
+        uint32_t GetAllocationCount() const { return m_AllocationCount; }
+        uint32_t GetFreeBlockCount() const { return m_FreeBlockCount; }
+        /**
+         * @return Size of the largest free block
+         * @note Allocate() rounds a request up to its size class before searching, so a
+         *       request slightly smaller than this can still fail
+         */
+        uint32_t GetLargestFreeBlock() const;
+        /** @return 0 when all free space is one block, approaching 1 as it splinters */
+        float GetFragmentation() const;
+
+        /**
+         * @brief Checks the internal invariants: blocks tile the space, no two free
+         *        blocks are adjacent, free lists match the bitmaps and the counters
+         * @return true if consistent; used by the allocator benchmarks and debug checks
+         */
+        bool Validate() const;
+
+    private:
+        static constexpr uint32_t SL_BITS = 4;                        ///< log2 of second-level lists
+        static constexpr uint32_t SL_COUNT = 1u << SL_BITS;
+        static constexpr uint32_t FL_COUNT = 32 - SL_BITS + 1;        ///< First-level classes
+
+        struct Node {
+            uint32_t offset = 0;
+            uint32_t size = 0;
+            uint32_t prevPhysical = INVALID;
+            uint32_t nextPhysical = INVALID;
+            uint32_t prevFree = INVALID;   ///< Also links unused nodes for recycling
+            uint32_t nextFree = INVALID;
+            bool free = false;
+        };
+
+        /** @brief Size class a block of this size is filed under */
+        static void MapInsert(uint32_t size, uint32_t& fl, uint32_t& sl);
+        /** @brief Smallest size class whose every block fits the request */
+        static void MapSearch(uint32_t size, uint32_t& fl, uint32_t& sl);
+
+        uint32_t CreateNode();
+        void ReleaseNode(uint32_t node);
+        void InsertFree(uint32_t node);
+        void RemoveFree(uint32_t node);
+        /** @return A free node in class (fl, sl) or above, INVALID if none */
+        uint32_t FindFree(uint32_t fl, uint32_t sl) const;
+
+        std::vector<Node> m_Nodes;
+        uint32_t m_UnusedNodes = INVALID;                  ///< Recycled node list
+        uint32_t m_FirstNode = INVALID;                    ///< Block at offset 0
+        uint32_t m_LastNode = INVALID;                     ///< Block ending at the capacity
+        uint32_t m_FlBitmap = 0;
+        std::array<uint32_t, FL_COUNT> m_SlBitmaps{};
+        std::array<std::array<uint32_t, SL_COUNT>, FL_COUNT> m_FreeLists;
+        uint32_t m_Capacity = 0;
+        uint32_t m_Used = 0;
+        uint32_t m_AllocationCount = 0;
+        uint32_t m_FreeBlockCount = 0;
+    };
+}
@@ -0,0 +1,192 @@
+#pragma once
+#include "../pch.h"
+#include <atomic>
+#include "CancellationToken.h"
+
+namespace Engine {
+    /**
+     * @brief Fixed pool of task completion records
+     *
+     * Stands in for the shared state behind std::future: each submitted task
+     * borrows a slot that records its cancellation token, completion and any
+     * thrown exception. Slots are reference counted by the running task and
+     * its TaskHandle, and go back to a lock-free free list once both are done
+     * with them.
+     */
+    class TaskCompletionPool {
+    public:
+        /** @brief Index returned by Acquire() when every slot is in use */
+        static constexpr uint32_t INVALID_SLOT = ~0u;
+
+        /**
+         * @brief Allocates the pool up front
+         * @param size Number of tasks that may be in flight at once
+         */
+        explicit TaskCompletionPool(uint32_t size)
+            : m_Slots(std::make_unique<Slot[]>(size)), m_Size(size) {
+            for (uint32_t i = 0; i < size; ++i) {
+                m_Slots[i].next.store(i + 1 < size ? i + 1 : INVALID_SLOT,
+                                      std::memory_order_relaxed);
+            }
+            m_FreeHead.store(PackHead(0, size > 0 ? 0 : INVALID_SLOT), std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Takes a free slot, referenced by both the task and its handle
+         * @param token Cancellation token checked before and during the task
+         * @return Slot index, or INVALID_SLOT if the pool is exhausted
+         */
+        uint32_t Acquire(const CancellationToken& token) {
+            uint64_t head = m_FreeHead.load(std::memory_order_acquire);
+            while (true) {
+                const uint32_t index = static_cast<uint32_t>(head);
+                if (index == INVALID_SLOT) return INVALID_SLOT;
+
+                const uint32_t next = m_Slots[index].next.load(std::memory_order_relaxed);
+                const uint64_t newHead = PackHead(static_cast<uint32_t>(head >> 32) + 1, next);
+                if (m_FreeHead.compare_exchange_weak(head, newHead, std::memory_order_acquire)) {
+                    Slot& slot = m_Slots[index];
+                    slot.done.store(false, std::memory_order_relaxed);
+                    slot.cancelled = false;
+                    slot.exception = nullptr;
+                    slot.token = token;
+                    slot.refs.store(2, std::memory_order_relaxed);
+                    return index;
+                }
+            }
+        }
+
+        /**
+         * @brief Marks a slot's task as finished and drops the task's reference
+         * @param index Slot index
+         * @param exception Exception thrown by the task, if any
+         * @param cancelled Whether the task was skipped or abandoned due to cancellation
+         */
+        void Complete(uint32_t index, std::exception_ptr exception, bool cancelled) {
+            Slot& slot = m_Slots[index];
+            slot.exception = std::move(exception);
+            slot.cancelled = cancelled;
+            slot.done.store(true, std::memory_order_release);
+            Release(index);
+        }
+
+        /** @return Whether the slot's task has finished */
+        bool IsDone(uint32_t index) const {
+            return m_Slots[index].done.load(std::memory_order_acquire);
+        }
+
+        /** @return Whether the slot's finished task was cancelled */
+        bool WasCancelled(uint32_t index) const { return m_Slots[index].cancelled; }
+
+        /** @return Cancellation token the slot's task was submitted with */
+        const CancellationToken& GetToken(uint32_t index) const { return m_Slots[index].token; }
+
+        /** @return Exception thrown by the slot's finished task, if any */
+        std::exception_ptr GetException(uint32_t index) const { return m_Slots[index].exception; }
+
+        /** @brief Drops one reference, returning the slot to the free list on the last one */
+        void Release(uint32_t index) {
+            Slot& slot = m_Slots[index];
+            if (slot.refs.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+
+            slot.exception = nullptr;
+            slot.token = CancellationToken();
+            uint64_t head = m_FreeHead.load(std::memory_order_relaxed);
+            while (true) {
+                slot.next.store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+                const uint64_t newHead = PackHead(static_cast<uint32_t>(head >> 32) + 1, index);
+                if (m_FreeHead.compare_exchange_weak(head, newHead, std::memory_order_release,
+                                                     std::memory_order_relaxed)) {
+                    return;
+                }
+            }
+        }
+
+        /** @return Number of slots */
+        uint32_t GetSize() const { return m_Size; }
+
+    private:
+        struct Slot {
+            std::atomic<uint32_t> refs{0};
+            std::atomic<uint32_t> next{INVALID_SLOT};
+            std::atomic<bool> done{false};
+            bool cancelled = false;
+            std::exception_ptr exception;
+            CancellationToken token;
+        };
+
+        /** @brief Packs an ABA tag and a slot index into the free list head */
+        static uint64_t PackHead(uint32_t tag, uint32_t index) {
+            return (static_cast<uint64_t>(tag) << 32) | index;
+        }
+
+        std::unique_ptr<Slot[]> m_Slots;
+        uint32_t m_Size;
+        std::atomic<uint64_t> m_FreeHead{0};
+    };
+
+    /**
+     * @brief Move-only handle to a task submitted with TaskSystem::Submit
+     *
+     * Lightweight replacement for std::future<void>. A default-constructed
+     * handle counts as already complete, which is also what Submit returns
+     * when it had to run the task inline. Dropping a handle without waiting
+     * is allowed; the task still runs and its slot is recycled afterwards.
+     */
+    class TaskHandle {
+    public:
+        TaskHandle() = default;
+        TaskHandle(TaskCompletionPool* pool, uint32_t slot) : m_Pool(pool), m_Slot(slot) {}
+
+        TaskHandle(TaskHandle&& other) noexcept : m_Pool(other.m_Pool), m_Slot(other.m_Slot) {
+            other.m_Pool = nullptr;
+        }
+
+        TaskHandle& operator=(TaskHandle&& other) noexcept {
+            if (this != &other) {
+                Reset();
+                m_Pool = other.m_Pool;
+                m_Slot = other.m_Slot;
+                other.m_Pool = nullptr;
+            }
+            return *this;
+        }
+
+        TaskHandle(const TaskHandle&) = delete;
+        TaskHandle& operator=(const TaskHandle&) = delete;
+
+        ~TaskHandle() { Reset(); }
+
+        /** @return Whether the task has finished (always true for an empty handle) */
+        bool IsDone() const { return !m_Pool || m_Pool->IsDone(m_Slot); }
+
+        /** @return Whether the finished task was skipped or abandoned due to cancellation */
+        bool WasCancelled() const { return m_Pool && IsDone() && m_Pool->WasCancelled(m_Slot); }
+
+        /**
+         * @brief Releases the handle, rethrowing the task's exception if it failed
+         * @note Only call once IsDone() returns true
+         */
+        void Finish() {
+            if (!m_Pool) return;
+            ASSERT(IsDone() && "TaskHandle finished before its task completed!");
+            std::exception_ptr exception = m_Pool->GetException(m_Slot);
+            Reset();
+            if (exception) {
+                std::rethrow_exception(exception);
+            }
+        }
+
+        /** @brief Detaches from the task without waiting for it */
+        void Reset() {
+            if (m_Pool) {
+                m_Pool->Release(m_Slot);
+                m_Pool = nullptr;
+            }
+        }
+
+    private:
+        TaskCompletionPool* m_Pool = nullptr;
+        uint32_t m_Slot = 0;
+    };
+}
@@ -1,15 +1,101 @@
 #pragma once
 #include "../pch.h"
+#include <atomic>
+#include "CancellationToken.h"
+#include "Config.h"
+#include "InplaceTask.h"
+#include "MPMCQueue.h"
+#include "TaskHandle.h"
+#include "../Threading/ThreadUtils.h"
 
 namespace Engine {
     /**
-     * @brief Thread pool-based task system for concurrent execution
-     * 
+     * @brief Scheduling priority of a task, highest first
+     *
+     * Workers always drain higher priority queues first, so lower levels only
+     * make progress when nothing more urgent is queued.
+     */
+    enum class TaskPriority : uint8_t {
+        FrameCritical,   ///< Work the current frame is waiting on
+        Simulation,      ///< Frame-long jobs overlapping the render; ParallelFor waiters skip these
+        StreamingNear,   ///< Streaming work close to the camera
+        StreamingFar,    ///< Streaming work far from the camera or prefetching
+        Background,      ///< Anything that can wait indefinitely
+        Count
+    };
+
+    /** @return Display name of a task priority */
+    inline const char* TaskPriorityToString(TaskPriority priority) {
+        switch (priority) {
+            case TaskPriority::FrameCritical: return "Frame Critical";
+            case TaskPriority::Simulation: return "Simulation";
+            case TaskPriority::StreamingNear: return "Streaming Near";
+            case TaskPriority::StreamingFar: return "Streaming Far";
+            case TaskPriority::Background: return "Background";
+            default: return "Unknown";
+        }
+    }
+    /**
+     * @brief Thread counts and placement for the TaskSystem
+     */
+    struct TaskSystemConfig {
+        size_t workerThreads = 0;       ///< Compute workers (0: one per physical core minus the main thread)
+        size_t ioThreads = 2;           ///< Threads reserved for blocking file work
+        bool pinWorkerThreads = false;  ///< Pin each compute worker to its own core
+
+        /**
+         * @brief Reads the [TaskSystem] section of the engine config
+         * @details Keys: workerThreads, ioThreads, pinWorkerThreads
+         */
+        static TaskSystemConfig FromConfig(const Config& config) {
+            TaskSystemConfig result;
+            result.workerThreads =
+                static_cast<size_t>(std::max(0, config.GetInt("TaskSystem", "workerThreads", 0)));
+            result.ioThreads =
+                static_cast<size_t>(std::max(0, config.GetInt("TaskSystem", "ioThreads", 2)));
+            result.pinWorkerThreads = config.GetBool("TaskSystem", "pinWorkerThreads", false);
+            return result;
+        }
+    };
+
+    /**
+     * @brief The engine's task scheduler
+     *
      * Provides a simple interface for executing tasks asynchronously using
-     * a pool of worker threads.
+     * a pool of worker threads, plus data-parallel ParallelFor/ParallelReduce
+     * primitives that split an index range across the workers and the caller.
+     *
+     * Tasks are stored as InplaceTask in a bounded lock-free queue and Submit()
+     * tracks completion through a fixed TaskCompletionPool, so submitting work
+     * does not allocate once the system is running. EnqueueTask() remains for
+     * callers that need a std::future result and pays for its shared state.
+     *
+     * Every priority level has its own queue. Submit() also accepts a
+     * CancellationToken: queued tasks whose token was cancelled are skipped,
+     * and running tasks can poll IsCancellationRequested() to stop early.
+     *
+     * Blocking file work goes through EnqueueIOTask(), which runs on a small
+     * separate pool so it never occupies a compute worker. This is the only
+     * thread pool in the engine; worker counts come from conf.ini.
      */
     class TaskSystem {
     public:
+        /** @brief Number of TaskPriority levels */
+        static constexpr size_t PRIORITY_COUNT = static_cast<size_t>(TaskPriority::Count);
+
+        /**
+         * @brief Task counters for one priority level
+         */
+        struct PriorityStatistics {
+            uint64_t submitted = 0;  ///< Tasks queued since the last reset
+            uint64_t completed = 0;  ///< Tasks that ran to completion
+            uint64_t cancelled = 0;  ///< Tasks skipped or abandoned because of cancellation
+            int64_t queued = 0;      ///< Tasks currently waiting in the queue
+        };
+
+        /** @brief Snapshot of task counters for every priority level */
+        using Statistics = std::array<PriorityStatistics, PRIORITY_COUNT>;
+
         /**
          * @brief Gets the singleton instance of the task system
          * @return Reference to the task system instance
@@ -20,104 +106,601 @@ namespace Engine {
         }
 
         /**
-         * @brief Initializes the task system with worker threads
-         * @param threadCount Number of worker threads (0 for automatic)
+         * @brief Starts the compute and I/O worker threads
+         * @param config Thread counts and placement
          */
-        void Initialize(size_t threadCount = 0) {
+        void Initialize(const TaskSystemConfig& config = TaskSystemConfig()) {
             ASSERT(m_Initialized == false && "TaskSystem already initialized!");
+            size_t threadCount = config.workerThreads;
             if (threadCount == 0) {
-                // Use physical cores only, not hyperthreaded
+                // Use physical cores only, not hyperthreaded, and leave one for the main thread
                 threadCount = std::max(1u, std::thread::hardware_concurrency() / 2);
+                threadCount = std::max<size_t>(1, threadCount - 1);
             }
-            
-            m_Running = true;
-            
-            // Create worker threads
+
+            m_Running.store(true);
+
+            // Create worker threads; core 0 is left to the main thread when pinning
             for (size_t i = 0; i < threadCount; ++i) {
-                m_Workers.emplace_back([this] { WorkerThread(); });
+                m_Workers.emplace_back([this, i, pin = config.pinWorkerThreads] {
+                    ThreadUtils::SetCurrentThreadName("Worker " + std::to_string(i));
+                    s_ThreadIndex = static_cast<uint32_t>(i + 1);
+                    if (pin) {
+                        ThreadUtils::SetCurrentThreadAffinity(i + 1);
+                    }
+                    WorkerThread();
+                });
+            }
+            for (size_t i = 0; i < config.ioThreads; ++i) {
+                m_IOWorkers.emplace_back([this, i] {
+                    ThreadUtils::SetCurrentThreadName("IO " + std::to_string(i));
+                    IOWorkerThread();
+                });
             }
             m_Initialized = true;
+
+            LOG_INFO_CONCAT("TaskSystem started with ", threadCount, " workers and ",
+                            config.ioThreads, " I/O threads");
         }
 
+        /** @return Whether Initialize() has been called */
+        bool IsInitialized() const { return m_Initialized; }
+
+        /** @return Number of worker threads (excluding the calling thread) */
+        size_t GetWorkerCount() const { return m_Workers.size(); }
+
+        /** @return Number of I/O threads */
+        size_t GetIOThreadCount() const { return m_IOWorkers.size(); }
+
+        /**
+         * @brief Dense index of the calling thread for per-thread data
+         * @return 1 + worker index on compute workers, 0 on any other thread
+         *         (main, I/O or foreign threads, which must share slot 0 safely)
+         */
+        static uint32_t GetCurrentThreadIndex() { return s_ThreadIndex; }
+
         ~TaskSystem() {
             {
-                std::unique_lock<std::mutex> lock(m_QueueMutex);
-                m_Running = false;
+                std::lock_guard<std::mutex> lock(m_SleepMutex);
+                m_Running.store(false);
             }
             m_Condition.notify_all();
-            
+            {
+                std::lock_guard<std::mutex> lock(m_IOMutex);
+                m_IORunning = false;
+            }
+            m_IOCondition.notify_all();
+
             for (auto& worker : m_Workers) {
                 if (worker.joinable()) {
                     worker.join();
                 }
             }
+            for (auto& worker : m_IOWorkers) {
+                if (worker.joinable()) {
+                    worker.join();
+                }
+            }
         }
 
         /**
          * @brief Submits a task for asynchronous execution
          * @tparam F Function type of the task
          * @param task Task to be executed
+         * @param priority Queue the task is scheduled on
          * @return Future containing the task's result
+         * @note Allocates the future's shared state; prefer Submit() on hot paths
          */
         template<typename F>
-        auto EnqueueTask(F&& task) -> std::future<typename std::invoke_result<F>::type> {
-            using ReturnType = typename std::invoke_result<F>::type;
-            auto promise = std::make_shared<std::promise<ReturnType>>();
-            std::future<ReturnType> future = promise->get_future();
+        auto EnqueueTask(F&& task, TaskPriority priority = TaskPriority::FrameCritical)
+            -> std::future<typename std::invoke_result<F>::type> {
+            ASSERT(m_Initialized && "TaskSystem not initialized!");
+
+            std::future<typename std::invoke_result<F>::type> future;
+            auto& completed = m_Stats[static_cast<size_t>(priority)].completed;
+            PushTask(priority, MakePromiseTask(std::forward<F>(task), future, completed));
+            return future;
+        }
 
+        /**
+         * @brief Runs blocking work (file reads, decoding from disk) on the I/O pool
+         *
+         * I/O threads never run compute tasks and compute workers never run I/O
+         * tasks, so a slow disk cannot stall ParallelFor or frame work.
+         *
+         * @param task Task to be executed
+         * @return Future containing the task's result
+         */
+        template<typename F>
+        auto EnqueueIOTask(F&& task) -> std::future<typename std::invoke_result<F>::type> {
             ASSERT(m_Initialized && "TaskSystem not initialized!");
 
+            std::future<typename std::invoke_result<F>::type> future;
+            InplaceTask ioTask = MakePromiseTask(std::forward<F>(task), future, m_IOCompleted);
+            if (m_IOWorkers.empty()) {
+                // No I/O pool configured; run on a compute worker rather than not at all
+                PushTask(TaskPriority::Background, std::move(ioTask));
+                return future;
+            }
+
             {
-                std::lock_guard<std::mutex> lock(m_QueueMutex);
-                m_Tasks.emplace([promise, task = std::forward<F>(task)]() {
+                std::lock_guard<std::mutex> lock(m_IOMutex);
+                m_IOTasks.push_back(std::move(ioTask));
+            }
+            m_IOCondition.notify_one();
+            return future;
+        }
+
+        /** @return Number of I/O tasks finished since startup */
+        uint64_t GetIOCompletedCount() const {
+            return m_IOCompleted.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Submits a task without allocating
+         *
+         * The callable and its captures must fit in InplaceTask::CAPACITY minus
+         * the bookkeeping this adds (checked at compile time). If every
+         * completion slot is in use, the task runs inline on the calling thread
+         * and an already-complete handle is returned.
+         *
+         * @param task Callable invoked as task()
+         * @param priority Queue the task is scheduled on
+         * @param token Skips the task if cancelled before it starts
+         * @return Handle to wait on with Wait()
+         */
+        template<typename F>
+        TaskHandle Submit(F&& task, TaskPriority priority = TaskPriority::FrameCritical,
+                          const CancellationToken& token = CancellationToken()) {
+            ASSERT(m_Initialized && "TaskSystem not initialized!");
+
+            const uint32_t slot = m_Completions.Acquire(token);
+            if (slot == TaskCompletionPool::INVALID_SLOT) {
+                m_Stats[static_cast<size_t>(priority)].submitted.fetch_add(1);
+                RunCancellable(task, token, priority);
+                return TaskHandle();
+            }
+
+            PushTask(priority,
+                     [this, slot, priority, fn = std::decay_t<F>(std::forward<F>(task))]() mutable {
+                         std::exception_ptr exception;
+                         bool cancelled = false;
+                         try {
+                             cancelled = RunCancellable(fn, m_Completions.GetToken(slot), priority);
+                         } catch (...) {
+                             exception = std::current_exception();
+                         }
+                         m_Completions.Complete(slot, std::move(exception), cancelled);
+                     });
+            return TaskHandle(&m_Completions, slot);
+        }
+
+        /**
+         * @brief Blocks until a submitted task has finished or was cancelled
+         *
+         * The calling thread runs queued tasks while it waits, so waiting from
+         * inside a task cannot deadlock the pool.
+         *
+         * @param handle Handle returned by Submit(); released on return
+         * @throws Rethrows any exception thrown by the task
+         */
+        void Wait(TaskHandle& handle) {
+            while (!handle.IsDone()) {
+                if (!TryRunPendingTask()) {
+                    std::this_thread::yield();
+                }
+            }
+            handle.Finish();
+        }
+
+        /**
+         * @brief Checks the cancellation token of the task running on this thread
+         *
+         * Long-running tasks should call this at natural break points (e.g.
+         * between chunk slices) and return early when it yields true.
+         *
+         * @return true if the current task was submitted with a now-cancelled token
+         */
+        static bool IsCancellationRequested() {
+            return s_CurrentToken && s_CurrentToken->IsCancelled();
+        }
+
+        /** @return Snapshot of the per-priority task counters */
+        Statistics GetStatistics() const {
+            Statistics stats;
+            for (size_t i = 0; i < PRIORITY_COUNT; ++i) {
+                stats[i].submitted = m_Stats[i].submitted.load(std::memory_order_relaxed);
+                stats[i].completed = m_Stats[i].completed.load(std::memory_order_relaxed);
+                stats[i].cancelled = m_Stats[i].cancelled.load(std::memory_order_relaxed);
+                stats[i].queued = m_Stats[i].queued.load(std::memory_order_relaxed);
+            }
+            return stats;
+        }
+
+        /** @brief Zeroes the submitted/completed/cancelled counters */
+        void ResetStatistics() {
+            for (auto& stats : m_Stats) {
+                stats.submitted.store(0, std::memory_order_relaxed);
+                stats.completed.store(0, std::memory_order_relaxed);
+                stats.cancelled.store(0, std::memory_order_relaxed);
+            }
+        }
+
+        /**
+         * @brief Calls fn(i) for every i in [begin, end) across the worker threads
+         *
+         * The range is split into chunks of grainSize indices which are claimed
+         * dynamically by the workers and by the calling thread, so the call
+         * returns only once every index has been processed. Runs serially when
+         * the task system is not initialized or the range fits in one chunk.
+         *
+         * @param begin First index
+         * @param end One past the last index
+         * @param grainSize Indices per chunk (0 picks one automatically)
+         * @param fn Callable invoked as fn(size_t index)
+         */
+        template<typename F>
+        void ParallelFor(size_t begin, size_t end, size_t grainSize, F&& fn) {
+            if (end <= begin) return;
+            const size_t count = end - begin;
+            if (grainSize == 0) grainSize = ComputeGrainSize(count);
+
+            if (!m_Initialized || m_Workers.empty() || count <= grainSize) {
+                for (size_t i = begin; i < end; ++i) fn(i);
+                return;
+            }
+
+            auto body = [&](size_t chunk, size_t /*participant*/) {
+                const size_t chunkBegin = begin + chunk * grainSize;
+                const size_t chunkEnd = std::min(chunkBegin + grainSize, end);
+                for (size_t i = chunkBegin; i < chunkEnd; ++i) fn(i);
+            };
+            RunChunks((count + grainSize - 1) / grainSize, body);
+        }
+
+        /**
+         * @brief Maps every index in [begin, end) and combines the results
+         *
+         * Each participating thread folds its chunks into a private partial
+         * result, and the partials are combined on the calling thread, so
+         * reduce must be associative and identity must be its neutral element.
+         *
+         * @param begin First index
+         * @param end One past the last index
+         * @param grainSize Indices per chunk (0 picks one automatically)
+         * @param identity Neutral element of reduce
+         * @param map Callable invoked as map(size_t index) -> T
+         * @param reduce Callable invoked as reduce(T, T) -> T
+         * @return Reduction of all mapped values
+         */
+        template<typename T, typename MapFn, typename ReduceFn>
+        T ParallelReduce(size_t begin, size_t end, size_t grainSize, T identity, MapFn&& map,
+                         ReduceFn&& reduce) {
+            if (end <= begin) return identity;
+            const size_t count = end - begin;
+            if (grainSize == 0) grainSize = ComputeGrainSize(count);
+
+            if (!m_Initialized || m_Workers.empty() || count <= grainSize) {
+                T result = identity;
+                for (size_t i = begin; i < end; ++i) result = reduce(result, map(i));
+                return result;
+            }
+
+            const size_t chunkCount = (count + grainSize - 1) / grainSize;
+            std::vector<T> partials(std::min(m_Workers.size(), chunkCount - 1) + 1, identity);
+
+            auto body = [&](size_t chunk, size_t participant) {
+                const size_t chunkBegin = begin + chunk * grainSize;
+                const size_t chunkEnd = std::min(chunkBegin + grainSize, end);
+                T local = partials[participant];
+                for (size_t i = chunkBegin; i < chunkEnd; ++i) local = reduce(local, map(i));
+                partials[participant] = local;
+            };
+            RunChunks(chunkCount, body);
+
+            T result = identity;
+            for (const T& partial : partials) result = reduce(result, partial);
+            return result;
+        }
+
+    private:
+        TaskSystem() = default;
+
+        /** @brief Target number of chunks handed to each participating thread */
+        static constexpr size_t CHUNKS_PER_THREAD = 4;
+
+        /**
+         * @brief Shared state of one ParallelFor/ParallelReduce call
+         *
+         * Lives on the caller's stack; helper tasks only capture its address,
+         * which keeps them within InplaceTask's inline storage.
+         */
+        template<typename Body>
+        struct ParallelJob {
+            Body& body;
+            size_t chunkCount;
+            std::atomic<size_t> nextChunk{0};
+            std::atomic<size_t> nextParticipant{0};
+            std::atomic<size_t> pendingHelpers{0};
+            std::exception_ptr exception;
+            std::mutex exceptionMutex;
+
+            ParallelJob(Body& b, size_t chunks) : body(b), chunkCount(chunks) {}
+
+            void Work() {
+                const size_t participant = nextParticipant.fetch_add(1, std::memory_order_relaxed);
+                while (true) {
+                    const size_t chunk = nextChunk.fetch_add(1, std::memory_order_relaxed);
+                    if (chunk >= chunkCount) return;
                     try {
-                        if constexpr (std::is_void_v<ReturnType>) {
-                            task();
-                            promise->set_value();
-                        } else {
-                            promise->set_value(task());
-                        }
+                        body(chunk, participant);
                     } catch (...) {
-                        promise->set_exception(std::current_exception());
+                        std::lock_guard<std::mutex> lock(exceptionMutex);
+                        if (!exception) exception = std::current_exception();
+                        nextChunk.store(chunkCount, std::memory_order_relaxed);
                     }
+                }
+            }
+        };
+
+        /**
+         * @brief Picks a chunk size giving every thread a few chunks to balance load
+         * @param count Number of indices in the range
+         */
+        size_t ComputeGrainSize(size_t count) const {
+            const size_t participants = m_Workers.size() + 1;
+            return std::max<size_t>(1, count / (participants * CHUNKS_PER_THREAD));
+        }
+
+        /**
+         * @brief Runs body(chunk, participant) for every chunk, helping from the calling thread
+         */
+        template<typename Body>
+        void RunChunks(size_t chunkCount, Body& body) {
+            ParallelJob<Body> job(body, chunkCount);
+            const size_t helpers = std::min(m_Workers.size(), chunkCount - 1);
+            job.pendingHelpers.store(helpers, std::memory_order_relaxed);
+
+            for (size_t i = 0; i < helpers; ++i) {
+                PushTask(TaskPriority::FrameCritical, [&job] {
+                    job.Work();
+                    job.pendingHelpers.fetch_sub(1, std::memory_order_release);
                 });
             }
-            
-            m_Condition.notify_one();
-            return future;
+
+            job.Work();
+
+            // Helpers still reference the job, so keep draining the queue until they finish;
+            // running other helpers here also keeps nested ParallelFor calls from deadlocking.
+            // Only frame-critical tasks: picking up a Simulation job would run a whole frame
+            // of simulation inline and serialise the pipelined frame
+            while (job.pendingHelpers.load(std::memory_order_acquire) != 0) {
+                if (!TryRunPendingTask(TaskPriority::FrameCritical)) {
+                    std::this_thread::yield();
+                }
+            }
+
+            if (job.exception) {
+                std::rethrow_exception(job.exception);
+            }
         }
 
-    private:
-        TaskSystem() = default;
-        
+        /** @brief Capacity of each priority's task queue */
+        static constexpr size_t TASK_QUEUE_CAPACITY = 4096;
+
+        /** @brief Number of Submit() tasks that may be in flight at once */
+        static constexpr uint32_t COMPLETION_POOL_SIZE = 1024;
+
+        /** @brief Empty polls a worker makes before going to sleep */
+        static constexpr int WORKER_SPIN_COUNT = 64;
+
+        /** @brief Live counters behind PriorityStatistics */
+        struct AtomicPriorityStatistics {
+            std::atomic<uint64_t> submitted{0};
+            std::atomic<uint64_t> completed{0};
+            std::atomic<uint64_t> cancelled{0};
+            std::atomic<int64_t> queued{0};
+        };
+
         /**
-         * @brief Worker thread function that processes tasks from the queue
+         * @brief Makes a token visible to IsCancellationRequested() for one task
+         *
+         * Restores the previous token on exit, since Wait() can run other tasks
+         * inside a task.
          */
-        void WorkerThread() {
+        struct CancellationScope {
+            explicit CancellationScope(const CancellationToken* token)
+                : previous(s_CurrentToken) {
+                s_CurrentToken = token;
+            }
+            ~CancellationScope() { s_CurrentToken = previous; }
+
+            const CancellationToken* previous;
+        };
+
+        /**
+         * @brief Runs a task unless its token is already cancelled and records the outcome
+         * @return true if the task was skipped or its token was cancelled while it ran
+         */
+        template<typename F>
+        bool RunCancellable(F& fn, const CancellationToken& token, TaskPriority priority) {
+            bool cancelled = token.IsCancelled();
+            if (!cancelled) {
+                CancellationScope scope(token.CanBeCancelled() ? &token : nullptr);
+                try {
+                    fn();
+                } catch (...) {
+                    RecordOutcome(priority, token.IsCancelled());
+                    throw;
+                }
+                cancelled = token.IsCancelled();
+            }
+            RecordOutcome(priority, cancelled);
+            return cancelled;
+        }
+
+        void RecordOutcome(TaskPriority priority, bool cancelled) {
+            auto& stats = m_Stats[static_cast<size_t>(priority)];
+            (cancelled ? stats.cancelled : stats.completed).fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Adds a task to its priority queue and wakes a sleeping worker if needed
+         *
+         * When the queue is full the caller runs queued tasks until a cell frees
+         * up, which both applies back-pressure and guarantees progress.
+         */
+        void PushTask(TaskPriority priority, InplaceTask&& task) {
+            const size_t level = static_cast<size_t>(priority);
+            m_Stats[level].submitted.fetch_add(1, std::memory_order_relaxed);
+            m_Stats[level].queued.fetch_add(1, std::memory_order_relaxed);
+
+            // Count before pushing so a worker that sees zero is guaranteed to find nothing
+            m_QueuedTasks.fetch_add(1);
+            while (!m_Queues[level].TryPush(std::move(task))) {
+                if (!TryRunPendingTask()) {
+                    std::this_thread::yield();
+                }
+            }
+
+            if (m_SleepingWorkers.load() > 0) {
+                // Taking the lock orders this notify after a worker's predicate check
+                { std::lock_guard<std::mutex> lock(m_SleepMutex); }
+                m_Condition.notify_one();
+            }
+        }
+
+        /**
+         * @brief Runs the highest priority queued task on the calling thread, if any
+         * @param lowest Lowest priority the caller is willing to run
+         * @return true if a task was executed
+         */
+        bool TryRunPendingTask(TaskPriority lowest = TaskPriority::Background) {
+            InplaceTask task;
+            for (size_t level = 0; level <= static_cast<size_t>(lowest); ++level) {
+                if (m_Queues[level].TryPop(task)) {
+                    m_Stats[level].queued.fetch_sub(1, std::memory_order_relaxed);
+                    m_QueuedTasks.fetch_sub(1);
+                    task();
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /**
+         * @brief Wraps a callable so its result or exception fulfils a promise
+         * @param task Callable to wrap
+         * @param[out] future Receives the future of the wrapped task
+         * @param completed Counter incremented once the task has run
+         */
+        template<typename F>
+        static InplaceTask MakePromiseTask(F&& task,
+                                           std::future<typename std::invoke_result<F>::type>& future,
+                                           std::atomic<uint64_t>& completed) {
+            using ReturnType = typename std::invoke_result<F>::type;
+            auto promise = std::make_shared<std::promise<ReturnType>>();
+            future = promise->get_future();
+
+            auto run = [promise, counter = &completed](auto& fn) {
+                try {
+                    if constexpr (std::is_void_v<ReturnType>) {
+                        fn();
+                        promise->set_value();
+                    } else {
+                        promise->set_value(fn());
+                    }
+                } catch (...) {
+                    promise->set_exception(std::current_exception());
+                }
+                counter->fetch_add(1, std::memory_order_relaxed);
+            };
+
+            using Fn = std::decay_t<F>;
+            if constexpr (InplaceTask::FitsInline<std::pair<decltype(run), Fn>>) {
+                return InplaceTask([run, fn = Fn(std::forward<F>(task))]() mutable { run(fn); });
+            } else {
+                // Captures too large for the inline buffer are boxed on the heap
+                return InplaceTask([run, fn = std::make_unique<Fn>(std::forward<F>(task))]() mutable {
+                    run(*fn);
+                });
+            }
+        }
+
+        /**
+         * @brief I/O thread function; a plain locked queue is fine for blocking work
+         */
+        void IOWorkerThread() {
             while (true) {
-                std::function<void()> task;
+                InplaceTask task;
                 {
-                    std::unique_lock<std::mutex> lock(m_QueueMutex);
-                    m_Condition.wait(lock, [this] {
-                        return !m_Running || !m_Tasks.empty();
-                    });
-                    
-                    if (!m_Running && m_Tasks.empty()) {
+                    std::unique_lock<std::mutex> lock(m_IOMutex);
+                    m_IOCondition.wait(lock, [this] { return !m_IORunning || !m_IOTasks.empty(); });
+                    if (!m_IORunning && m_IOTasks.empty()) {
                         return;
                     }
-                    
-                    task = std::move(m_Tasks.front());
-                    m_Tasks.pop();
+                    task = std::move(m_IOTasks.front());
+                    m_IOTasks.pop_front();
                 }
                 task();
             }
         }
 
+        /**
+         * @brief Worker thread function that processes tasks from the queue
+         *
+         * Spins briefly on an empty queue before sleeping, so bursts of work
+         * such as ParallelFor helpers are picked up without a wake-up.
+         */
+        void WorkerThread() {
+            int idleSpins = 0;
+            while (true) {
+                if (TryRunPendingTask()) {
+                    idleSpins = 0;
+                    continue;
+                }
+                if (++idleSpins < WORKER_SPIN_COUNT) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                idleSpins = 0;
+
+                std::unique_lock<std::mutex> lock(m_SleepMutex);
+                m_SleepingWorkers.fetch_add(1);
+                m_Condition.wait(lock, [this] {
+                    return !m_Running.load() || m_QueuedTasks.load() > 0;
+                });
+                m_SleepingWorkers.fetch_sub(1);
+
+                if (!m_Running.load() && m_QueuedTasks.load() <= 0) {
+                    return;
+                }
+            }
+        }
+
         std::vector<std::thread> m_Workers;
-        std::queue<std::function<void()>> m_Tasks;
-        std::mutex m_QueueMutex;
+        static_assert(PRIORITY_COUNT == 5, "Update m_Queues when adding task priorities");
+        std::array<MPMCQueue<InplaceTask>, PRIORITY_COUNT> m_Queues{{
+            MPMCQueue<InplaceTask>(TASK_QUEUE_CAPACITY), MPMCQueue<InplaceTask>(TASK_QUEUE_CAPACITY),
+            MPMCQueue<InplaceTask>(TASK_QUEUE_CAPACITY), MPMCQueue<InplaceTask>(TASK_QUEUE_CAPACITY),
+            MPMCQueue<InplaceTask>(TASK_QUEUE_CAPACITY)}};
+        std::array<AtomicPriorityStatistics, PRIORITY_COUNT> m_Stats;
+        TaskCompletionPool m_Completions{COMPLETION_POOL_SIZE};
+        std::atomic<int64_t> m_QueuedTasks{0};
+        std::atomic<int> m_SleepingWorkers{0};
+        std::mutex m_SleepMutex;
         std::condition_variable m_Condition;
-        bool m_Running = false;
+        std::atomic<bool> m_Running{false};
         bool m_Initialized = false;
+
+        std::vector<std::thread> m_IOWorkers;
+        std::deque<InplaceTask> m_IOTasks;
+        std::mutex m_IOMutex;
+        std::condition_variable m_IOCondition;
+        std::atomic<uint64_t> m_IOCompleted{0};
+        bool m_IORunning = true;
+
+        static inline thread_local const CancellationToken* s_CurrentToken = nullptr;
+        static inline thread_local uint32_t s_ThreadIndex = 0;
     };
 }
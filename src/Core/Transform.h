@@ -1,51 +1,122 @@
 #pragma once
 #include <pch.h>
 
+#include <glm/gtc/quaternion.hpp>
+
 namespace Engine {
+/**
+ * @brief Position, rotation and scale of an object, with a cached model matrix
+ *
+ * The rotation is stored as a quaternion and the model matrix is rebuilt from
+ * it only after a setter has run, so reading it every frame costs no trig.
+ * The euler angle API is kept: angles are in degrees, applied about X, then
+ * Y, then Z, and GetRotation() returns the angles last set so scripts can
+ * accumulate them past 360 degrees or through gimbal lock.
+ *
+ * IsDirty() reports a change since the owner's last ClearDirty(); the scene
+ * uses it to recompute only the world matrices of moved subtrees. The first
+ * GetModelMatrix() after a change fills the cache, so a changed transform must
+ * not be read from several threads at once.
+ */
 class Transform {
    public:
     struct TransformData {
         glm::vec3 position{0.0f};
-        glm::vec3 rotation{0.0f};
+        glm::quat rotation{1.0f, 0.0f, 0.0f, 0.0f};
         glm::vec3 scale{1.0f};
     };
 
     Transform() = default;
 
-    TransformData& GetData() { return m_Data; }
     const TransformData& GetData() const { return m_Data; }
 
     // Position methods
-    void SetPosition(float x, float y, float z) { m_Data.position = {x, y, z}; }
-    void SetPosition(const glm::vec3& position) { m_Data.position = position; }
+    void SetPosition(float x, float y, float z) { SetPosition(glm::vec3(x, y, z)); }
+    void SetPosition(const glm::vec3& position) {
+        m_Data.position = position;
+        MarkDirty();
+    }
     glm::vec3 GetPosition() const { return m_Data.position; }
 
-    // Rotation methods
-    void SetRotation(float x, float y, float z) { m_Data.rotation = {x, y, z}; }
-    void SetRotation(const glm::vec3& rotation) { m_Data.rotation = rotation; }
-    glm::vec3 GetRotation() const { return m_Data.rotation; }
+    // Rotation methods, euler angles in degrees
+    void SetRotation(float x, float y, float z) { SetRotation(glm::vec3(x, y, z)); }
+    void SetRotation(const glm::vec3& rotation) {
+        m_EulerDegrees = rotation;
+        m_Data.rotation = EulerToQuaternion(rotation);
+        MarkDirty();
+    }
+    glm::vec3 GetRotation() const { return m_EulerDegrees; }
+
+    void SetOrientation(const glm::quat& orientation) {
+        m_Data.rotation = glm::normalize(orientation);
+        m_EulerDegrees = QuaternionToEuler(m_Data.rotation);
+        MarkDirty();
+    }
+    const glm::quat& GetOrientation() const { return m_Data.rotation; }
 
     // Scale methods
-    void SetScale(float x, float y, float z) { m_Data.scale = {x, y, z}; }
-    void SetScale(const glm::vec3& scale) { m_Data.scale = scale; }
+    void SetScale(float x, float y, float z) { SetScale(glm::vec3(x, y, z)); }
+    void SetScale(const glm::vec3& scale) {
+        m_Data.scale = scale;
+        MarkDirty();
+    }
     glm::vec3 GetScale() const { return m_Data.scale; }
 
-    // Single GetModelMatrix implementation
+    /** @return Translation * rotation * scale, rebuilt only if the transform changed */
     glm::mat4 GetModelMatrix() const {
-        if (m_Data.scale == glm::vec3(0.0f)) {
+        if (m_MatrixDirty) {
+            m_Matrix = ComputeModelMatrix(m_Data);
+            m_MatrixDirty = false;
+        }
+        return m_Matrix;
+    }
+
+    bool IsDirty() const { return m_Dirty; }
+    void ClearDirty() { m_Dirty = false; }
+
+    /**
+     * @brief Builds a model matrix without trig; identity for an all-zero scale
+     * @details TransformBatch::ComputeModelMatrices() builds many at once with SIMD
+     */
+    static glm::mat4 ComputeModelMatrix(const TransformData& data) {
+        if (data.scale == glm::vec3(0.0f)) {
             return glm::mat4(1.0f);  // Return identity if invalid scale
         }
 
-        glm::mat4 model = glm::mat4(1.0f);
-        model = glm::translate(model, m_Data.position);
-        model = glm::rotate(model, glm::radians(m_Data.rotation.x), glm::vec3(1.0f, 0.0f, 0.0f));
-        model = glm::rotate(model, glm::radians(m_Data.rotation.y), glm::vec3(0.0f, 1.0f, 0.0f));
-        model = glm::rotate(model, glm::radians(m_Data.rotation.z), glm::vec3(0.0f, 0.0f, 1.0f));
-        model = glm::scale(model, m_Data.scale);
-        return model;
+        const glm::mat3 rotation = glm::mat3_cast(data.rotation);
+        return glm::mat4(glm::vec4(rotation[0] * data.scale.x, 0.0f),
+                         glm::vec4(rotation[1] * data.scale.y, 0.0f),
+                         glm::vec4(rotation[2] * data.scale.z, 0.0f),
+                         glm::vec4(data.position, 1.0f));
+    }
+
+    /** @brief Rotation about X, then Y, then Z, as rotate(X) * rotate(Y) * rotate(Z) */
+    static glm::quat EulerToQuaternion(const glm::vec3& degrees) {
+        const glm::vec3 radians = glm::radians(degrees);
+        return glm::angleAxis(radians.x, glm::vec3(1.0f, 0.0f, 0.0f)) *
+               glm::angleAxis(radians.y, glm::vec3(0.0f, 1.0f, 0.0f)) *
+               glm::angleAxis(radians.z, glm::vec3(0.0f, 0.0f, 1.0f));
+    }
+
+    /** @brief Inverse of EulerToQuaternion(), with Y in [-90, 90] degrees */
+    static glm::vec3 QuaternionToEuler(const glm::quat& rotation) {
+        const glm::mat3 m = glm::mat3_cast(rotation);
+        const float y = std::asin(glm::clamp(m[2][0], -1.0f, 1.0f));
+        if (std::abs(m[2][0]) > 0.9999f) {
+            // Gimbal lock: X and Z rotate about the same axis, so put it all in X
+            return glm::degrees(glm::vec3(std::atan2(m[1][2], m[1][1]), y, 0.0f));
+        }
+        return glm::degrees(
+            glm::vec3(std::atan2(-m[2][1], m[2][2]), y, std::atan2(-m[1][0], m[0][0])));
     }
 
    private:
+    void MarkDirty() { m_Dirty = m_MatrixDirty = true; }
+
     TransformData m_Data;
+    glm::vec3 m_EulerDegrees{0.0f};
+    mutable glm::mat4 m_Matrix{1.0f};
+    mutable bool m_MatrixDirty = false;
+    bool m_Dirty = true;
 };
-}  // namespace Engine
\ No newline at end of file
+}  // namespace Engine
@@ -0,0 +1,184 @@
+/**
+ * @file TransformBatch.cpp
+ * @brief AVX, SSE and scalar model matrix kernels
+ */
+#include "TransformBatch.h"
+
+#if defined(__AVX__)
+    #include <immintrin.h>
+    #define ENGINE_TRANSFORM_BATCH_AVX 1
+#endif
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+    #include <xmmintrin.h>
+    #define ENGINE_TRANSFORM_BATCH_SSE 1
+#endif
+
+namespace Engine {
+    namespace TransformBatch {
+        namespace {
+            /** @brief One transform, with the arithmetic of the SIMD lanes */
+            void ComputeOne(const Input& in, size_t i, glm::mat4& out) {
+                const float sx = in.scaleX[i], sy = in.scaleY[i], sz = in.scaleZ[i];
+                if (sx == 0.0f && sy == 0.0f && sz == 0.0f) {
+                    out = glm::mat4(1.0f);
+                    return;
+                }
+
+                const float x = in.rotationX[i], y = in.rotationY[i];
+                const float z = in.rotationZ[i], w = in.rotationW[i];
+                const float xx = x * x, yy = y * y, zz = z * z;
+                const float xy = x * y, xz = x * z, yz = y * z;
+                const float wx = w * x, wy = w * y, wz = w * z;
+                out[0] = glm::vec4((1.0f - 2.0f * (yy + zz)) * sx, 2.0f * (xy + wz) * sx,
+                                   2.0f * (xz - wy) * sx, 0.0f);
+                out[1] = glm::vec4(2.0f * (xy - wz) * sy, (1.0f - 2.0f * (xx + zz)) * sy,
+                                   2.0f * (yz + wx) * sy, 0.0f);
+                out[2] = glm::vec4(2.0f * (xz + wy) * sz, 2.0f * (yz - wx) * sz,
+                                   (1.0f - 2.0f * (xx + yy)) * sz, 0.0f);
+                out[3] = glm::vec4(in.positionX[i], in.positionY[i], in.positionZ[i], 1.0f);
+            }
+
+#ifdef ENGINE_TRANSFORM_BATCH_SSE
+            /** @brief Four lanes in an SSE register */
+            struct SseLanes {
+                using Vector = __m128;
+                static constexpr size_t WIDTH = 4;
+
+                static Vector Load(const float* p) { return _mm_loadu_ps(p); }
+                static Vector Set(float value) { return _mm_set1_ps(value); }
+                static Vector Add(Vector a, Vector b) { return _mm_add_ps(a, b); }
+                static Vector Sub(Vector a, Vector b) { return _mm_sub_ps(a, b); }
+                static Vector Mul(Vector a, Vector b) { return _mm_mul_ps(a, b); }
+                static Vector Equal(Vector a, Vector b) { return _mm_cmpeq_ps(a, b); }
+                static Vector And(Vector a, Vector b) { return _mm_and_ps(a, b); }
+                /** @return mask ? a : b, per lane */
+                static Vector Select(Vector mask, Vector a, Vector b) {
+                    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+                }
+
+                /** @brief Transposes the components of a column into WIDTH matrices */
+                static void StoreColumn(Vector x, Vector y, Vector z, Vector w, glm::mat4* out,
+                                        int column) {
+                    _MM_TRANSPOSE4_PS(x, y, z, w);
+                    _mm_storeu_ps(&out[0][column][0], x);
+                    _mm_storeu_ps(&out[1][column][0], y);
+                    _mm_storeu_ps(&out[2][column][0], z);
+                    _mm_storeu_ps(&out[3][column][0], w);
+                }
+            };
+#endif
+
+#ifdef ENGINE_TRANSFORM_BATCH_AVX
+            /** @brief Eight lanes in an AVX register */
+            struct AvxLanes {
+                using Vector = __m256;
+                static constexpr size_t WIDTH = 8;
+
+                static Vector Load(const float* p) { return _mm256_loadu_ps(p); }
+                static Vector Set(float value) { return _mm256_set1_ps(value); }
+                static Vector Add(Vector a, Vector b) { return _mm256_add_ps(a, b); }
+                static Vector Sub(Vector a, Vector b) { return _mm256_sub_ps(a, b); }
+                static Vector Mul(Vector a, Vector b) { return _mm256_mul_ps(a, b); }
+                static Vector Equal(Vector a, Vector b) { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+                static Vector And(Vector a, Vector b) { return _mm256_and_ps(a, b); }
+                static Vector Select(Vector mask, Vector a, Vector b) {
+                    return _mm256_blendv_ps(b, a, mask);
+                }
+
+                /**
+                 * @brief Transposes the components of a column into WIDTH matrices
+                 * @details Unpacks and shuffles work within 128-bit halves, so each
+                 *          result holds lane n in its low half and lane n + 4 in its high half
+                 */
+                static void StoreColumn(Vector x, Vector y, Vector z, Vector w, glm::mat4* out,
+                                        int column) {
+                    const __m256 xy0 = _mm256_unpacklo_ps(x, y);   // x0 y0 x1 y1 | x4 y4 x5 y5
+                    const __m256 xy1 = _mm256_unpackhi_ps(x, y);   // x2 y2 x3 y3 | x6 y6 x7 y7
+                    const __m256 zw0 = _mm256_unpacklo_ps(z, w);
+                    const __m256 zw1 = _mm256_unpackhi_ps(z, w);
+                    const __m256 lanes[4] = {
+                        _mm256_shuffle_ps(xy0, zw0, _MM_SHUFFLE(1, 0, 1, 0)),
+                        _mm256_shuffle_ps(xy0, zw0, _MM_SHUFFLE(3, 2, 3, 2)),
+                        _mm256_shuffle_ps(xy1, zw1, _MM_SHUFFLE(1, 0, 1, 0)),
+                        _mm256_shuffle_ps(xy1, zw1, _MM_SHUFFLE(3, 2, 3, 2)),
+                    };
+                    for (int n = 0; n < 4; ++n) {
+                        _mm_storeu_ps(&out[n][column][0], _mm256_castps256_ps128(lanes[n]));
+                        _mm_storeu_ps(&out[n + 4][column][0], _mm256_extractf128_ps(lanes[n], 1));
+                    }
+                }
+            };
+#endif
+
+            /** @brief Lanes::WIDTH transforms starting at i */
+            template<typename Lanes>
+            void ComputeLanes(const Input& in, size_t i, glm::mat4* out) {
+                using L = Lanes;
+                using V = typename Lanes::Vector;
+                const V zero = L::Set(0.0f);
+                const V one = L::Set(1.0f);
+                const V two = L::Set(2.0f);
+
+                const V sx = L::Load(in.scaleX + i);
+                const V sy = L::Load(in.scaleY + i);
+                const V sz = L::Load(in.scaleZ + i);
+                const V identity =
+                    L::And(L::And(L::Equal(sx, zero), L::Equal(sy, zero)), L::Equal(sz, zero));
+
+                const V x = L::Load(in.rotationX + i);
+                const V y = L::Load(in.rotationY + i);
+                const V z = L::Load(in.rotationZ + i);
+                const V w = L::Load(in.rotationW + i);
+                const V xx = L::Mul(x, x), yy = L::Mul(y, y), zz = L::Mul(z, z);
+                const V xy = L::Mul(x, y), xz = L::Mul(x, z), yz = L::Mul(y, z);
+                const V wx = L::Mul(w, x), wy = L::Mul(w, y), wz = L::Mul(w, z);
+
+                // Rotation columns as in glm::mat3_cast, each scaled by its axis
+                const V m00 = L::Mul(L::Sub(one, L::Mul(two, L::Add(yy, zz))), sx);
+                const V m01 = L::Mul(L::Mul(two, L::Add(xy, wz)), sx);
+                const V m02 = L::Mul(L::Mul(two, L::Sub(xz, wy)), sx);
+                const V m10 = L::Mul(L::Mul(two, L::Sub(xy, wz)), sy);
+                const V m11 = L::Mul(L::Sub(one, L::Mul(two, L::Add(xx, zz))), sy);
+                const V m12 = L::Mul(L::Mul(two, L::Add(yz, wx)), sy);
+                const V m20 = L::Mul(L::Mul(two, L::Add(xz, wy)), sz);
+                const V m21 = L::Mul(L::Mul(two, L::Sub(yz, wx)), sz);
+                const V m22 = L::Mul(L::Sub(one, L::Mul(two, L::Add(xx, yy))), sz);
+
+                L::StoreColumn(L::Select(identity, one, m00), L::Select(identity, zero, m01),
+                               L::Select(identity, zero, m02), zero, out, 0);
+                L::StoreColumn(L::Select(identity, zero, m10), L::Select(identity, one, m11),
+                               L::Select(identity, zero, m12), zero, out, 1);
+                L::StoreColumn(L::Select(identity, zero, m20), L::Select(identity, zero, m21),
+                               L::Select(identity, one, m22), zero, out, 2);
+                L::StoreColumn(L::Select(identity, zero, L::Load(in.positionX + i)),
+                               L::Select(identity, zero, L::Load(in.positionY + i)),
+                               L::Select(identity, zero, L::Load(in.positionZ + i)), one, out, 3);
+            }
+        }
+
+        size_t GetLaneCount() {
+#if defined(ENGINE_TRANSFORM_BATCH_AVX)
+            return AvxLanes::WIDTH;
+#elif defined(ENGINE_TRANSFORM_BATCH_SSE)
+            return SseLanes::WIDTH;
+#else
+            return 1;
+#endif
+        }
+
+        void ComputeModelMatrices(const Input& input, size_t count, glm::mat4* output) {
+            size_t i = 0;
+#ifdef ENGINE_TRANSFORM_BATCH_AVX
+            for (; i + AvxLanes::WIDTH <= count; i += AvxLanes::WIDTH) {
+                ComputeLanes<AvxLanes>(input, i, output + i);
+            }
+#endif
+#ifdef ENGINE_TRANSFORM_BATCH_SSE
+            for (; i + SseLanes::WIDTH <= count; i += SseLanes::WIDTH) {
+                ComputeLanes<SseLanes>(input, i, output + i);
+            }
+#endif
+            for (; i < count; ++i) ComputeOne(input, i, output[i]);
+        }
+    }
+}
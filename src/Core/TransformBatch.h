@@ -0,0 +1,76 @@
+#pragma once
+#include <pch.h>
+
+#include "Transform.h"
+
+namespace Engine {
+    /**
+     * @brief Batched model matrices from transforms in structure-of-arrays form
+     *
+     * ComputeModelMatrices() builds the same matrices as
+     * Transform::ComputeModelMatrix() eight at a time with AVX, four at a time
+     * with SSE, and one at a time for the remainder or on other targets. The
+     * paths are chosen at compile time, so the AVX path needs a build that
+     * targets it. Rotations must be unit quaternions, as Transform stores them.
+     */
+    namespace TransformBatch {
+        /** @brief Component arrays of `count` transforms, one element per transform */
+        struct Input {
+            const float* positionX;
+            const float* positionY;
+            const float* positionZ;
+            const float* rotationX;
+            const float* rotationY;
+            const float* rotationZ;
+            const float* rotationW;
+            const float* scaleX;
+            const float* scaleY;
+            const float* scaleZ;
+        };
+
+        /** @brief Fixed-size staging area for gathering transforms out of Transform objects */
+        struct Chunk {
+            static constexpr size_t SIZE = 64;
+
+            alignas(32) float positionX[SIZE];
+            alignas(32) float positionY[SIZE];
+            alignas(32) float positionZ[SIZE];
+            alignas(32) float rotationX[SIZE];
+            alignas(32) float rotationY[SIZE];
+            alignas(32) float rotationZ[SIZE];
+            alignas(32) float rotationW[SIZE];
+            alignas(32) float scaleX[SIZE];
+            alignas(32) float scaleY[SIZE];
+            alignas(32) float scaleZ[SIZE];
+
+            void Set(size_t index, const Transform::TransformData& data) {
+                positionX[index] = data.position.x;
+                positionY[index] = data.position.y;
+                positionZ[index] = data.position.z;
+                rotationX[index] = data.rotation.x;
+                rotationY[index] = data.rotation.y;
+                rotationZ[index] = data.rotation.z;
+                rotationW[index] = data.rotation.w;
+                scaleX[index] = data.scale.x;
+                scaleY[index] = data.scale.y;
+                scaleZ[index] = data.scale.z;
+            }
+
+            Input GetInput() const {
+                return {positionX, positionY, positionZ, rotationX, rotationY,
+                        rotationZ, rotationW, scaleX,    scaleY,    scaleZ};
+            }
+        };
+
+        /** @return Transforms per SIMD step of this build: 8, 4 or 1 */
+        size_t GetLaneCount();
+
+        /**
+         * @brief Writes translation * rotation * scale of each transform, column-major
+         * @param input Component arrays; need not be aligned
+         * @param count Number of transforms
+         * @param output `count` matrices; an all-zero scale gives the identity
+         */
+        void ComputeModelMatrices(const Input& input, size_t count, glm::mat4* output);
+    }
+}
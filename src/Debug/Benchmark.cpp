@@ -0,0 +1,136 @@
+/**
+ * @file Benchmark.cpp
+ * @brief Implementation of the benchmark registry and runner
+ */
+#include <pch.h>
+#include "Benchmark.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+    std::atomic<bool> s_CountAllocations{false};
+    std::atomic<uint64_t> s_AllocationCount{0};
+}  // namespace
+
+#ifdef ENGINE_BENCHMARK_ALLOCATIONS
+// Global allocation hooks used to report allocations per benchmark iteration. They
+// replace operator new for the whole program, so only benchmark builds define them.
+// Outside Benchmark::Run the only overhead is one relaxed load per allocation.
+void* operator new(std::size_t size) {
+    if (s_CountAllocations.load(std::memory_order_relaxed)) {
+        s_AllocationCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (void* ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+#endif
+
+namespace Engine {
+
+Benchmark& Benchmark::Get() {
+    static Benchmark instance;
+    return instance;
+}
+
+void Benchmark::Register(const std::string& name, uint32_t iterations, BenchmarkFn fn) {
+    for (auto& entry : m_Entries) {
+        if (entry.name == name) {
+            entry.iterations = iterations;
+            entry.fn = std::move(fn);
+            return;
+        }
+    }
+    m_Entries.push_back({name, iterations, std::move(fn)});
+}
+
+void Benchmark::RegisterTeardown(const std::string& name, BenchmarkFn fn) {
+    for (auto& teardown : m_Teardowns) {
+        if (teardown.first == name) {
+            teardown.second = std::move(fn);
+            return;
+        }
+    }
+    m_Teardowns.emplace_back(name, std::move(fn));
+}
+
+/**
+ * @brief Times a callable and reports the result
+ *
+ * Executes one untimed warm-up call so lazily initialised state (caches,
+ * thread pools, allocations) does not skew the first sample.
+ */
+Benchmark::Result Benchmark::Run(const std::string& name, uint32_t iterations,
+                                 const BenchmarkFn& fn) {
+    Result result;
+    result.name = name;
+    result.iterations = std::max(1u, iterations);
+    result.minMs = std::numeric_limits<float>::max();
+
+    fn();
+
+    const uint64_t allocationsBefore = s_AllocationCount.load(std::memory_order_relaxed);
+    s_CountAllocations.store(true, std::memory_order_relaxed);
+
+    float total = 0.0f;
+    for (uint32_t i = 0; i < result.iterations; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        auto end = std::chrono::steady_clock::now();
+
+        float ms = std::chrono::duration<float, std::milli>(end - start).count();
+        total += ms;
+        result.minMs = std::min(result.minMs, ms);
+        result.maxMs = std::max(result.maxMs, ms);
+    }
+    s_CountAllocations.store(false, std::memory_order_relaxed);
+    const uint64_t allocations =
+        s_AllocationCount.load(std::memory_order_relaxed) - allocationsBefore;
+
+    result.averageMs = total / static_cast<float>(result.iterations);
+    result.allocationsPerIteration =
+        static_cast<float>(allocations) / static_cast<float>(result.iterations);
+    Profiler::Get().WriteProfile(name, result.averageMs);
+
+    if (CountsAllocations()) {
+        LOG_INFO_CONCAT("[Benchmark] ", name, ": avg ", result.averageMs, " ms, min ",
+                        result.minMs, " ms, max ", result.maxMs, " ms, ",
+                        result.allocationsPerIteration, " allocs (", result.iterations,
+                        " iterations)");
+    } else {
+        LOG_INFO_CONCAT("[Benchmark] ", name, ": avg ", result.averageMs, " ms, min ",
+                        result.minMs, " ms, max ", result.maxMs, " ms (", result.iterations,
+                        " iterations)");
+    }
+    return result;
+}
+
+uint64_t Benchmark::GetAllocationCount() {
+    return s_AllocationCount.load(std::memory_order_relaxed);
+}
+
+bool Benchmark::CountsAllocations() {
+#ifdef ENGINE_BENCHMARK_ALLOCATIONS
+    return true;
+#else
+    return false;
+#endif
+}
+
+std::vector<Benchmark::Result> Benchmark::RunAll(const std::string& filter) {
+    m_Results.clear();
+    for (const auto& entry : m_Entries) {
+        if (!filter.empty() && entry.name.find(filter) == std::string::npos) continue;
+        m_Results.push_back(Run(entry.name, entry.iterations, entry.fn));
+    }
+    for (const auto& teardown : m_Teardowns) teardown.second();
+    return m_Results;
+}
+
+}  // namespace Engine
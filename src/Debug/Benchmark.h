@@ -0,0 +1,121 @@
+#pragma once
+#include <pch.h>
+
+namespace Engine {
+
+/**
+ * @brief Registry and runner for CPU micro-benchmarks
+ *
+ * Benchmarks are plain callables timed over a fixed number of iterations.
+ * Results are logged and forwarded to the Profiler, so they show up in the
+ * profiler window and JSON output next to regular PROFILE_SCOPE samples.
+ * Builds configured with ENGINE_BENCHMARK_ALLOCATIONS also count heap
+ * allocations made by any thread during a run; that replaces the global
+ * operator new, so other builds leave it out.
+ * Run them headlessly with `sandbox --benchmark [filter]`.
+ */
+class Benchmark {
+public:
+    using BenchmarkFn = std::function<void()>;
+
+    /**
+     * @brief Timing summary of one benchmark run
+     */
+    struct Result {
+        std::string name;         ///< Benchmark name
+        uint32_t iterations = 0;  ///< Number of timed iterations
+        float averageMs = 0.0f;   ///< Mean time per iteration
+        float minMs = 0.0f;       ///< Fastest iteration
+        float maxMs = 0.0f;       ///< Slowest iteration
+        float allocationsPerIteration = 0.0f;  ///< Mean heap allocations per iteration, if counted
+    };
+
+    /** @return Reference to the singleton Benchmark registry */
+    static Benchmark& Get();
+
+    /**
+     * @brief Adds a benchmark to the registry
+     * @param name Unique benchmark name, grouped by "System/Case" convention
+     * @param iterations Number of timed iterations
+     * @param fn Work to time
+     */
+    void Register(const std::string& name, uint32_t iterations, BenchmarkFn fn);
+
+    /**
+     * @brief Adds work run once at the end of every RunAll()
+     * @details Releases state a group of benchmarks sets up lazily, such as GL objects
+     *          that must be deleted while their recording backend is installed
+     * @param name Unique teardown name; registering it again replaces it
+     * @param fn Work to run
+     */
+    void RegisterTeardown(const std::string& name, BenchmarkFn fn);
+
+    /**
+     * @brief Times fn over the given number of iterations after one warm-up call
+     * @param name Name used for logging and the Profiler entry
+     * @param iterations Number of timed iterations
+     * @param fn Work to time
+     * @return Timing summary
+     */
+    Result Run(const std::string& name, uint32_t iterations, const BenchmarkFn& fn);
+
+    /**
+     * @brief Runs every registered benchmark whose name contains filter, then the teardowns
+     * @param filter Substring filter (empty runs all)
+     * @return Results of this invocation
+     */
+    std::vector<Result> RunAll(const std::string& filter = "");
+
+    /** @return Results of the most recent RunAll() */
+    const std::vector<Result>& GetResults() const { return m_Results; }
+
+    /** @return Whether any benchmarks are registered */
+    bool HasBenchmarks() const { return !m_Entries.empty(); }
+
+    /**
+     * @brief Keeps the compiler from discarding a benchmark's result
+     * @param value Pointer to the computed data
+     */
+    static void DoNotOptimize(const void* value) {
+#if defined(__GNUC__) || defined(__clang__)
+        // The pointer escapes into an opaque asm statement that may read any memory
+        asm volatile("" : : "r"(value) : "memory");
+#else
+        static const void* volatile sink = nullptr;
+        sink = value;
+        const void* volatile read = sink;
+        (void)read;
+#endif
+    }
+
+    /**
+     * @brief Heap allocations observed so far while a benchmark is running
+     * @details Only counts inside Run(); compare two readings to check that a
+     *          code path is allocation-free
+     */
+    static uint64_t GetAllocationCount();
+
+    /** @return Whether this build counts allocations; GetAllocationCount() stays 0 otherwise */
+    static bool CountsAllocations();
+
+private:
+    Benchmark() = default;
+
+    struct Entry {
+        std::string name;
+        uint32_t iterations;
+        BenchmarkFn fn;
+    };
+
+    std::vector<Entry> m_Entries;
+    std::vector<std::pair<std::string, BenchmarkFn>> m_Teardowns;
+    std::vector<Result> m_Results;
+};
+
+/**
+ * @brief Registers the engine's built-in benchmarks
+ * @details Defined in EngineBenchmarks.cpp; safe to call more than once
+ */
+void RegisterEngineBenchmarks();
+
+}  // namespace Engine
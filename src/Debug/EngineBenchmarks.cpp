@@ -0,0 +1,2005 @@
+/**
+ * @file EngineBenchmarks.cpp
+ * @brief Built-in CPU benchmarks for engine subsystems
+ *
+ * Each subsystem registers its cases here under a "System/Case" name so
+ * related results sort together. Benchmarks must not require a GL context.
+ */
+#include <pch.h>
+#include "Benchmark.h"
+
+#include "Core/FrameArena.h"
+#include "Core/RangeAllocator.h"
+#include "Core/TaskSystem.h"
+#include "Core/TransformBatch.h"
+#include "Noise/PerlinNoise/PerlinNoise.h"
+#include "Noise/SimplexNoise/SimplexNoise.h"
+#include "Noise/ValueNoise/ValueNoise.h"
+#include "Noise/VoidNoise/VoidNoise.h"
+#include "Renderer/ClusteredLighting.h"
+#include "Renderer/FrameCapture.h"
+#include "Renderer/Material.h"
+#include "Renderer/MeshPool.h"
+#include "Renderer/RecordingRenderAPI.h"
+#include "Renderer/RenderSortKey.h"
+#include "Renderer/RenderState.h"
+#include "Renderer/Renderer.h"
+#include "Renderer/Renderer2D.h"
+#include "Renderer/TextureAtlas.h"
+#include "Renderer/TextureCache.h"
+#include "Renderer/TextureLoader.h"
+#include "Shader/ShaderLibrary.h"
+#include "Renderer/VertexArray.h"
+#include "Scene/Scene.h"
+
+namespace Engine {
+
+namespace {
+    constexpr size_t TASK_BENCH_SIZE = 1 << 20;
+    constexpr int HEIGHTMAP_SIZE = 512;
+    constexpr size_t RENDER_BENCH_OBJECTS = 10000;
+    constexpr size_t SUBMIT_BENCH_COMMANDS = 100000;
+    constexpr size_t CONTENTION_BENCH_THREADS = 8;
+    constexpr size_t CONTENTION_BENCH_COMMANDS = 50000;
+    constexpr uint32_t ALLOCATOR_BENCH_CAPACITY = 1u << 24;
+    constexpr size_t ALLOCATOR_BENCH_OPERATIONS = 100000;
+    constexpr size_t ALLOCATOR_BENCH_LIVE = 2048;
+    constexpr size_t POOL_BENCH_CHUNKS = 1024;
+    constexpr size_t QUAD_BENCH_QUADS = 1000000;
+    constexpr size_t QUAD_BENCH_BATCH = 100000;  ///< Renderer2D batch size
+    constexpr size_t SPRITE_BENCH_SPRITES = 100000;
+    constexpr size_t SPRITE_BENCH_TEXTURES = 64;
+    constexpr int32_t SPRITE_BENCH_LAYERS = 4;
+    constexpr size_t TEXTURE_BENCH_FILES = 16;
+    constexpr uint32_t ATLAS_BENCH_IMAGES = 1000;
+    constexpr size_t SCENE_BENCH_OBJECTS = 100000;
+    constexpr size_t SCENE_BENCH_GROUPS = 10;
+    constexpr size_t TRANSFORM_BENCH_COUNT = 100000;
+
+    /** @brief Per-element work representative of a light transform pass */
+    inline float TaskBenchWork(size_t i) {
+        float x = static_cast<float>(i) * 0.001f;
+        return std::sqrt(x * x + 1.0f) * std::sin(x);
+    }
+
+    void RegisterTaskSystemBenchmarks(Benchmark& bench) {
+        static std::vector<float> data(TASK_BENCH_SIZE);
+
+        bench.Register("TaskSystem/SerialFor 1M", 20, [] {
+            for (size_t i = 0; i < data.size(); ++i) data[i] = TaskBenchWork(i);
+            Benchmark::DoNotOptimize(data.data());
+        });
+
+        // The pattern Renderer::Flush used before ParallelFor: fixed 64-element batches
+        bench.Register("TaskSystem/EnqueueTask batches(64) 1M", 20, [] {
+            std::vector<std::future<void>> futures;
+            for (size_t i = 0; i < data.size(); i += 64) {
+                size_t end = std::min(i + 64, data.size());
+                futures.push_back(TaskSystem::Get().EnqueueTask([i, end] {
+                    for (size_t j = i; j < end; ++j) data[j] = TaskBenchWork(j);
+                }));
+            }
+            for (auto& future : futures) future.wait();
+            Benchmark::DoNotOptimize(data.data());
+        });
+
+        bench.Register("TaskSystem/ParallelFor 1M", 20, [] {
+            TaskSystem::Get().ParallelFor(0, data.size(), 0,
+                                          [](size_t i) { data[i] = TaskBenchWork(i); });
+            Benchmark::DoNotOptimize(data.data());
+        });
+
+        // Submission cost of many tiny tasks: allocating futures vs pooled handles
+        bench.Register("TaskSystem/EnqueueTask+future 1K", 50, [] {
+            static std::atomic<int> counter{0};
+            std::array<std::future<void>, 1024> futures;
+            for (auto& future : futures) {
+                future = TaskSystem::Get().EnqueueTask([] { counter.fetch_add(1); });
+            }
+            for (auto& future : futures) future.wait();
+        });
+
+        bench.Register("TaskSystem/Submit+Wait 1K", 50, [] {
+            static std::atomic<int> counter{0};
+            static std::array<TaskHandle, 1024> handles;
+            for (auto& handle : handles) {
+                handle = TaskSystem::Get().Submit([] { counter.fetch_add(1); });
+            }
+            for (auto& handle : handles) TaskSystem::Get().Wait(handle);
+        });
+
+        bench.Register("TaskSystem/Submit allocation check", 10, [] {
+            static std::array<TaskHandle, 256> handles;
+            static float results[256];
+            const uint64_t before = Benchmark::GetAllocationCount();
+            for (size_t i = 0; i < handles.size(); ++i) {
+                handles[i] = TaskSystem::Get().Submit([i] { results[i] = TaskBenchWork(i); });
+            }
+            for (auto& handle : handles) TaskSystem::Get().Wait(handle);
+            ASSERT((!Benchmark::CountsAllocations() ||
+                    Benchmark::GetAllocationCount() == before) &&
+                   "TaskSystem::Submit allocated!");
+            Benchmark::DoNotOptimize(results);
+        });
+
+        // Tasks queued behind busy workers and cancelled are skipped and counted as cancelled
+        bench.Register("TaskSystem/Cancel queued 64", 10, [] {
+            TaskSystem& tasks = TaskSystem::Get();
+            static std::atomic<size_t> blocked{0};
+            static std::atomic<bool> release{false};
+            static std::atomic<int> ran{0};
+            static std::vector<TaskHandle> blockers;
+            static std::array<TaskHandle, 64> handles;
+            constexpr size_t BACKGROUND = static_cast<size_t>(TaskPriority::Background);
+
+            blocked = 0;
+            release = false;
+            ran = 0;
+            blockers.resize(tasks.GetWorkerCount());
+            for (auto& blocker : blockers) {
+                blocker = tasks.Submit([] {
+                    blocked.fetch_add(1);
+                    while (!release.load()) std::this_thread::yield();
+                });
+            }
+            while (blocked.load() < blockers.size()) std::this_thread::yield();
+
+            const uint64_t cancelledBefore = tasks.GetStatistics()[BACKGROUND].cancelled;
+            const CancellationToken token = CancellationToken::Create();
+            for (auto& handle : handles) {
+                handle = tasks.Submit([] { ran.fetch_add(1); }, TaskPriority::Background, token);
+            }
+            token.Cancel();
+            release = true;
+
+            for (auto& handle : handles) {
+                while (!handle.IsDone()) std::this_thread::yield();
+                ASSERT(handle.WasCancelled() && "Cancelled task not reported as cancelled");
+                tasks.Wait(handle);
+            }
+            for (auto& blocker : blockers) tasks.Wait(blocker);
+            ASSERT(ran.load() == 0 && "Cancelled task ran");
+            ASSERT(tasks.GetStatistics()[BACKGROUND].cancelled - cancelledBefore ==
+                       handles.size() &&
+                   "Cancelled tasks missing from the statistics");
+        });
+
+        bench.Register("TaskSystem/ParallelReduce 1M", 20, [] {
+            static float sum = 0.0f;
+            sum = TaskSystem::Get().ParallelReduce(
+                size_t(0), data.size(), size_t(0), 0.0f, [](size_t i) { return TaskBenchWork(i); },
+                [](float a, float b) { return a + b; });
+            Benchmark::DoNotOptimize(&sum);
+        });
+    }
+
+    /** @brief Draw state of one object in the synthetic render scene */
+    struct BenchDraw {
+        uint32_t shader;
+        uint32_t material;
+        uint32_t vertexArray;
+        float depth;
+    };
+
+    /** @brief Shader, material and vertex array changes when drawing in the given order */
+    struct BenchStateChanges {
+        uint32_t shaders = 0;
+        uint32_t materials = 0;
+        uint32_t vertexArrays = 0;
+    };
+
+    BenchStateChanges CountStateChanges(const std::vector<BenchDraw>& draws,
+                                        const std::vector<RenderSortKey::Entry>& order) {
+        BenchStateChanges changes;
+        const BenchDraw* previous = nullptr;
+        for (const auto& entry : order) {
+            const BenchDraw& draw = draws[entry.index];
+            if (!previous || previous->shader != draw.shader) ++changes.shaders;
+            if (!previous || previous->shader != draw.shader || previous->material != draw.material)
+                ++changes.materials;
+            if (!previous || previous->vertexArray != draw.vertexArray) ++changes.vertexArrays;
+            previous = &draw;
+        }
+        return changes;
+    }
+
+    /**
+     * @brief Renderer::Flush key generation and sorting on a many-object scene
+     * @details 10K draws over 8 shaders, 64 materials and 32 meshes, submitted in
+     *          random order. GL-free, so only the CPU side of Flush is measured;
+     *          state change counts before and after sorting are logged once.
+     */
+    void RegisterRenderSortBenchmarks(Benchmark& bench) {
+        static std::vector<BenchDraw> draws;
+        static std::vector<RenderSortKey::Entry> entries;
+        static std::vector<RenderSortKey::Entry> scratch;
+
+        std::mt19937 rng(42);
+        draws.resize(RENDER_BENCH_OBJECTS);
+        for (auto& draw : draws) {
+            draw.material = rng() % 64;
+            draw.shader = draw.material % 8;  // Materials own a shader
+            draw.vertexArray = rng() % 32;
+            draw.depth = static_cast<float>(rng() % 10000) / 10000.0f;
+        }
+
+        auto buildKeys = [] {
+            entries.resize(draws.size());
+            for (size_t i = 0; i < draws.size(); ++i) {
+                const BenchDraw& draw = draws[i];
+                entries[i] = {RenderSortKey::Encode(RenderPass::Opaque, draw.shader, draw.material,
+                                                    draw.vertexArray, draw.depth),
+                              static_cast<uint32_t>(i)};
+            }
+        };
+
+        bench.Register("Renderer/SortKeys radix 10K", 200, [buildKeys] {
+            buildKeys();
+            RenderSortKey::RadixSort(entries, scratch);
+            Benchmark::DoNotOptimize(entries.data());
+
+            static bool logged = false;
+            if (!logged) {
+                std::vector<RenderSortKey::Entry> submissionOrder(draws.size());
+                for (size_t i = 0; i < draws.size(); ++i) {
+                    submissionOrder[i] = {0, static_cast<uint32_t>(i)};
+                }
+                auto before = CountStateChanges(draws, submissionOrder);
+                auto after = CountStateChanges(draws, entries);
+                LOG_INFO_CONCAT("Render sort 10K draws - shader/material/VAO changes: unsorted ",
+                                before.shaders, "/", before.materials, "/", before.vertexArrays,
+                                ", sorted ", after.shaders, "/", after.materials, "/",
+                                after.vertexArrays);
+                logged = true;
+            }
+        });
+
+        bench.Register("Renderer/SortKeys std::sort 10K", 200, [buildKeys] {
+            buildKeys();
+            std::sort(entries.begin(), entries.end(),
+                      [](const auto& a, const auto& b) { return a.key < b.key; });
+            Benchmark::DoNotOptimize(entries.data());
+        });
+    }
+
+    /**
+     * @brief Render command submission, 100K commands per frame
+     * @details Compares the former storage (two shared_ptr copies pushed into a
+     *          mutex-guarded vector) with the FrameArena of raw handles that
+     *          Renderer::Submit now appends to. Materials and vertex arrays need a
+     *          GL context, so stand-in objects are used; neither path dereferences them.
+     */
+    void RegisterRenderSubmitBenchmarks(Benchmark& bench) {
+        struct LegacyCommand {
+            std::shared_ptr<void> vertexArray;
+            std::shared_ptr<void> material;
+            GLenum primitiveType;
+            glm::mat4 transformMatrix;
+        };
+
+        static auto vertexArray = std::make_shared<int>(0);
+        static auto material = std::make_shared<int>(0);
+        static std::mutex legacyMutex;
+        static std::vector<LegacyCommand> legacyCommands;
+        static FrameArena<RenderCommand> arena;
+
+        auto submitLegacy = [](size_t i) {
+            LegacyCommand command{vertexArray, material, GL_TRIANGLES,
+                                  glm::mat4(static_cast<float>(i))};
+            std::lock_guard<std::mutex> lock(legacyMutex);
+            legacyCommands.push_back(std::move(command));
+        };
+        auto submitArena = [](size_t i) {
+            arena.Emplace(reinterpret_cast<VertexArray*>(vertexArray.get()),
+                          reinterpret_cast<Material*>(material.get()), GLenum(GL_TRIANGLES),
+                          glm::mat4(static_cast<float>(i)), RenderPass::Opaque, DrawRange{});
+        };
+
+        bench.Register("Renderer/Submit shared_ptr+mutex 100K", 50, [submitLegacy] {
+            legacyCommands.clear();
+            for (size_t i = 0; i < SUBMIT_BENCH_COMMANDS; ++i) submitLegacy(i);
+            Benchmark::DoNotOptimize(legacyCommands.data());
+        });
+
+        bench.Register("Renderer/Submit FrameArena 100K", 50, [submitArena] {
+            arena.Reset();
+            for (size_t i = 0; i < SUBMIT_BENCH_COMMANDS; ++i) submitArena(i);
+            Benchmark::DoNotOptimize(&arena[0]);
+
+            // A full arena must assert without counting the rejected record
+            static bool checkedOverflow = false;
+            if (checkedOverflow) return;
+            checkedOverflow = true;
+            FrameArena<uint32_t, 4, 1> small;
+            for (uint32_t i = 0; i < small.CAPACITY; ++i) small.Emplace(i);
+            bool rejected = false;
+            try {
+                small.Emplace(0u);
+            } catch (const AssertLib::AssertionError&) {
+                rejected = true;
+            }
+            ASSERT(rejected && small.Size() == small.CAPACITY && small[3] == 3 &&
+                   "Overflowing FrameArena counted an unconstructed record");
+        });
+
+        // Recording from every worker at once, as the pipelined simulation may
+        bench.Register("Renderer/Submit shared_ptr+mutex 100K parallel", 50, [submitLegacy] {
+            legacyCommands.clear();
+            TaskSystem::Get().ParallelFor(0, SUBMIT_BENCH_COMMANDS, 0, submitLegacy);
+            Benchmark::DoNotOptimize(legacyCommands.data());
+        });
+
+        bench.Register("Renderer/Submit FrameArena 100K parallel", 50, [submitArena] {
+            arena.Reset();
+            TaskSystem::Get().ParallelFor(0, SUBMIT_BENCH_COMMANDS, 0, submitArena);
+            Benchmark::DoNotOptimize(&arena[0]);
+        });
+    }
+
+    /**
+     * @brief Submission contention: 8 threads recording 50K commands each
+     * @details Compares a mutex-guarded vector, one shared FrameArena (a single
+     *          contended atomic counter) and RenderCommandBuckets with a bucket
+     *          per thread, as used by Renderer::Submit.
+     */
+    void RegisterRenderContentionBenchmarks(Benchmark& bench) {
+        static std::mutex mutex;
+        static std::vector<RenderCommand> lockedCommands;
+        static FrameArena<RenderCommand> sharedArena;
+        static RenderCommandBuckets buckets(CONTENTION_BENCH_THREADS);
+
+        auto makeCommand = [](size_t i) {
+            return RenderCommand{nullptr, nullptr, GL_TRIANGLES, glm::mat4(static_cast<float>(i)),
+                                 RenderPass::Opaque, DrawRange{}};
+        };
+        auto runThreads = [](auto&& record) {
+            std::array<std::thread, CONTENTION_BENCH_THREADS> threads;
+            for (size_t t = 0; t < threads.size(); ++t) {
+                threads[t] = std::thread([&record, t] {
+                    for (size_t i = 0; i < CONTENTION_BENCH_COMMANDS; ++i) record(t, i);
+                });
+            }
+            for (auto& thread : threads) thread.join();
+        };
+
+        bench.Register("Renderer/Contention mutex 8x50K", 20, [=] {
+            lockedCommands.clear();
+            runThreads([&](size_t, size_t i) {
+                std::lock_guard<std::mutex> lock(mutex);
+                lockedCommands.push_back(makeCommand(i));
+            });
+            Benchmark::DoNotOptimize(lockedCommands.data());
+        });
+
+        bench.Register("Renderer/Contention shared arena 8x50K", 20, [=] {
+            sharedArena.Reset();
+            runThreads([&](size_t, size_t i) { sharedArena.Emplace(makeCommand(i)); });
+            Benchmark::DoNotOptimize(&sharedArena[0]);
+        });
+
+        bench.Register("Renderer/Contention per-thread buckets 8x50K", 20, [=] {
+            buckets.Reset();
+            runThreads([&](size_t t, size_t i) { buckets.GetBucket(t).Emplace(makeCommand(i)); });
+            static std::vector<const RenderCommand*> merged;
+            buckets.Gather(merged);
+            Benchmark::DoNotOptimize(merged.data());
+        });
+    }
+
+    /**
+     * @brief RenderState filtering of 10K draws that each bind program, texture and vertex array
+     * @details Runs against a fake GLFunctionTable that only counts driver calls, so
+     *          it needs no GPU. Draws are in sort-key order, as Renderer::Flush issues them.
+     */
+    void RegisterRenderStateBenchmarks(Benchmark& bench) {
+        struct Draw {
+            GLuint program, texture, vertexArray;
+        };
+        static std::vector<Draw> draws;
+        static std::atomic<uint32_t> driverCalls{0};
+
+        std::mt19937 rng(42);
+        draws.resize(RENDER_BENCH_OBJECTS);
+        for (auto& draw : draws) {
+            draw = {static_cast<GLuint>(1 + rng() % 8), static_cast<GLuint>(1 + rng() % 32),
+                    static_cast<GLuint>(1 + rng() % 64)};
+        }
+        std::sort(draws.begin(), draws.end(), [](const Draw& a, const Draw& b) {
+            return std::tie(a.program, a.texture, a.vertexArray) <
+                   std::tie(b.program, b.texture, b.vertexArray);
+        });
+
+        GLFunctionTable fake;
+        fake.useProgram = [](GLuint) { driverCalls.fetch_add(1, std::memory_order_relaxed); };
+        fake.bindVertexArray = [](GLuint) { driverCalls.fetch_add(1, std::memory_order_relaxed); };
+        fake.bindBuffer = [](GLenum, GLuint) { driverCalls.fetch_add(1, std::memory_order_relaxed); };
+        fake.activeTexture = [](GLenum) { driverCalls.fetch_add(1, std::memory_order_relaxed); };
+        fake.bindTexture = [](GLenum, GLuint) { driverCalls.fetch_add(1, std::memory_order_relaxed); };
+        fake.enable = [](GLenum) { driverCalls.fetch_add(1, std::memory_order_relaxed); };
+        fake.disable = [](GLenum) { driverCalls.fetch_add(1, std::memory_order_relaxed); };
+
+        bench.Register("Renderer/StateCache 10K draws", 200, [fake] {
+            RenderState& state = RenderState::Get();
+            const GLFunctionTable native = state.GetFunctionTable();
+            state.SetFunctionTable(fake);
+            driverCalls = 0;
+
+            for (const Draw& draw : draws) {
+                state.UseProgram(draw.program);
+                state.BindTexture(0, GL_TEXTURE_2D, draw.texture);
+                state.BindVertexArray(draw.vertexArray);
+            }
+
+            const RenderState::Counters counters = state.GetCurrentCounters();
+            state.EndFrame();
+            state.SetFunctionTable(native);
+
+            static bool logged = false;
+            if (!logged) {
+                LOG_INFO_CONCAT("GL state 10K draws - calls requested ",
+                                counters.TotalIssued() + counters.TotalSkipped(), ", issued ",
+                                counters.TotalIssued(), ", reached driver ", driverCalls.load());
+                logged = true;
+            }
+        });
+    }
+
+    /**
+     * @brief Material uniform upload, 10K applies, on the recording backend
+     * @details Compares the old path, which kept each value type in a name-keyed
+     *          map and looked every uniform up by name on every bind, with
+     *          Material::ApplyProperties(). Two materials share one shader and
+     *          alternate, so each apply uploads all values, as when draws of
+     *          different materials interleave; the unchanged case applies one
+     *          material repeatedly, as after sorting.
+     */
+    void RegisterMaterialBindBenchmarks(Benchmark& bench) {
+        constexpr size_t APPLIES = RENDER_BENCH_OBJECTS;
+        static const char* vertexSource = R"(#version 330 core
+layout (location = 0) in vec3 aPos;
+uniform mat4 u_ViewProjection;
+uniform mat4 u_Model;
+void main() { gl_Position = u_ViewProjection * u_Model * vec4(aPos, 1.0); })";
+        static const char* fragmentSource = R"(#version 330 core
+uniform vec4 u_Color;
+uniform float u_Roughness;
+uniform float u_Metallic;
+uniform int u_Mode;
+uniform sampler2D u_Albedo;
+out vec4 color;
+void main() { color = u_Color * texture(u_Albedo, vec2(u_Roughness, u_Metallic)); })";
+
+        /** @brief Parameter storage and bind of Material before locations were cached */
+        struct LegacyMaterial {
+            std::unordered_map<std::string, glm::vec4> vectors;
+            std::unordered_map<std::string, float> floats;
+            std::unordered_map<std::string, int> ints;
+            std::unordered_map<std::string, glm::mat4> matrices;
+            std::unordered_map<std::string, std::shared_ptr<Texture>> textures;
+
+            void Apply(GLuint program) const {
+                for (const auto& [name, value] : floats) {
+                    glUniform1f(glGetUniformLocation(program, name.c_str()), value);
+                }
+                for (const auto& [name, value] : ints) {
+                    glUniform1i(glGetUniformLocation(program, name.c_str()), value);
+                }
+                for (const auto& [name, value] : vectors) {
+                    glUniform4f(glGetUniformLocation(program, name.c_str()), value.x, value.y,
+                                value.z, value.w);
+                }
+                for (const auto& [name, value] : matrices) {
+                    glUniformMatrix4fv(glGetUniformLocation(program, name.c_str()), 1, GL_FALSE,
+                                       &value[0][0]);
+                }
+                int slot = 0;
+                for (const auto& [name, texture] : textures) {
+                    texture->Bind(slot);
+                    glUniform1i(glGetUniformLocation(program, name.c_str()), slot);
+                    ++slot;
+                }
+            }
+        };
+
+        struct MaterialScene {
+            RecordingRenderAPI api;
+            std::shared_ptr<Shader> shader;
+            std::shared_ptr<Texture> texture;
+            std::array<std::shared_ptr<Material>, 2> materials;
+            std::array<LegacyMaterial, 2> legacy;
+        };
+
+        // Never destroyed: its objects carry recorded names that must not reach a real context
+        auto getScene = []() -> MaterialScene& {
+            static MaterialScene* scene = nullptr;
+            if (!scene) {
+                scene = new MaterialScene();
+                const RenderAPI::API previous = RenderAPI::GetAPI();
+                RenderAPI::SetAPI(RenderAPI::API::None);
+                scene->api.Init();
+                scene->shader = Shader::CreateFromSource(vertexSource, fragmentSource);
+                scene->texture = std::make_shared<Texture>(1, 1);
+                uint8_t white[4] = {255, 255, 255, 255};
+                scene->texture->SetData(white, sizeof(white));
+                for (size_t i = 0; i < scene->materials.size(); ++i) {
+                    const float value = static_cast<float>(i + 1);
+                    auto material = std::make_shared<Material>(scene->shader);
+                    material->SetMatrix4("u_Model", glm::mat4(value));
+                    material->SetVector4("u_Color", glm::vec4(value));
+                    material->SetFloat("u_Roughness", 0.5f * value);
+                    material->SetFloat("u_Metallic", 0.25f * value);
+                    material->SetInt("u_Mode", static_cast<int>(i));
+                    material->SetTexture("u_Albedo", scene->texture);
+                    scene->materials[i] = material;
+
+                    LegacyMaterial& legacy = scene->legacy[i];
+                    legacy.matrices["u_Model"] = glm::mat4(value);
+                    legacy.vectors["u_Color"] = glm::vec4(value);
+                    legacy.floats["u_Roughness"] = 0.5f * value;
+                    legacy.floats["u_Metallic"] = 0.25f * value;
+                    legacy.ints["u_Mode"] = static_cast<int>(i);
+                    legacy.textures["u_Albedo"] = scene->texture;
+                }
+                scene->api.Shutdown();
+                RenderAPI::SetAPI(previous);
+            }
+            return *scene;
+        };
+
+        // Runs apply(i) APPLIES times with the shader bound; returns recorded uniform calls
+        auto runApplies = [getScene](const std::function<void(size_t)>& apply) {
+            MaterialScene& scene = getScene();
+            const RenderAPI::API previous = RenderAPI::GetAPI();
+            RenderAPI::SetAPI(RenderAPI::API::None);
+            scene.api.Init();
+            scene.api.ClearLog();
+            scene.shader->Bind();
+            for (size_t i = 0; i < APPLIES; ++i) apply(i);
+            size_t uniformCalls = 0;
+            for (const RecordingRenderAPI::Call& call : scene.api.GetCalls()) {
+                uniformCalls += std::string_view(call.function).rfind("glUniform", 0) == 0;
+            }
+            scene.api.Shutdown();
+            RenderAPI::SetAPI(previous);
+            return uniformCalls;
+        };
+
+        bench.Register("Renderer/Material bind 10K name lookup", 50, [getScene, runApplies] {
+            MaterialScene& scene = getScene();
+            const size_t calls = runApplies([&scene](size_t i) {
+                scene.legacy[i % 2].Apply(scene.shader->GetProgram());
+            });
+            static bool logged = false;
+            if (!logged) {
+                LOG_INFO_CONCAT("Material bind 10K name lookup - uniform calls ", calls);
+                logged = true;
+            }
+        });
+
+        bench.Register("Renderer/Material bind 10K cached", 50, [getScene, runApplies] {
+            MaterialScene& scene = getScene();
+            uint32_t uploads = 0;
+            const size_t calls = runApplies([&](size_t i) {
+                uploads += scene.materials[i % 2]->ApplyProperties();
+            });
+            // Alternating materials re-upload every parameter, sampler unit included
+            static bool checked = false;
+            if (!checked) {
+                ASSERT(uploads == APPLIES * 6 && "Alternating materials must upload all values");
+                ASSERT(calls == uploads && "Uploads must reach glUniform one call each");
+                LOG_INFO_CONCAT("Material bind 10K cached - uniform calls ", calls);
+                checked = true;
+            }
+        });
+
+        bench.Register("Renderer/Material bind 10K cached, unchanged", 50,
+                       [getScene, runApplies] {
+            MaterialScene& scene = getScene();
+            uint32_t uploads = 0;
+            const size_t calls = runApplies([&](size_t) {
+                uploads += scene.materials[0]->ApplyProperties();
+            });
+            // Only the first apply after the other material used the program uploads
+            static bool checked = false;
+            if (!checked) {
+                ASSERT(uploads <= 6 && calls == uploads && "Clean parameters must not upload");
+                LOG_INFO_CONCAT("Material bind 10K cached, unchanged - uniform calls ", calls);
+                checked = true;
+            }
+        });
+    }
+
+    /**
+     * @brief Whole Renderer frame, 10K cubes, on the recording backend
+     * @details Submit, swap and Flush run unchanged against RecordingRenderAPI, so
+     *          this measures the CPU side of a frame, GL call overhead of the
+     *          engine included, on machines without a GPU. Culling is off so every
+     *          cube reaches the draw loop.
+     */
+    void RegisterHeadlessRenderBenchmarks(Benchmark& bench) {
+        constexpr size_t CUBES = RENDER_BENCH_OBJECTS;
+        static const char* vertexSource = R"(#version 330 core
+layout (location = 0) in vec3 aPos;
+layout (location = 8) in mat4 a_InstanceModel;
+uniform mat4 u_ViewProjection;
+uniform mat4 u_Model;
+uniform bool u_Instanced;
+void main() {
+    mat4 model = u_Instanced ? a_InstanceModel : u_Model;
+    gl_Position = u_ViewProjection * model * vec4(aPos, 1.0);
+})";
+        static const char* fragmentSource = R"(#version 330 core
+uniform vec4 u_Color;
+out vec4 color;
+void main() { color = u_Color; })";
+
+        struct HeadlessScene {
+            RecordingRenderAPI api;
+            Renderer renderer;
+            std::shared_ptr<VertexArray> cube;
+            std::shared_ptr<Material> material;
+            std::vector<std::shared_ptr<VertexArray>> propMeshes;  ///< Cube copies, instance runs
+            std::vector<std::shared_ptr<Material>> propMaterials;
+        };
+
+        // Never destroyed: its objects carry recorded names that must not reach a real context
+        auto getScene = []() -> HeadlessScene& {
+            static HeadlessScene* scene = nullptr;
+            if (!scene) {
+                scene = new HeadlessScene();
+                const RenderAPI::API previous = RenderAPI::GetAPI();
+                RenderAPI::SetAPI(RenderAPI::API::None);
+                scene->api.Init();
+                scene->renderer.Initialize();
+                RenderAPI::SetAPI(previous);
+
+                float vertices[] = {-0.5f, -0.5f, 0.5f,  0.5f, -0.5f, 0.5f,  0.5f, 0.5f, 0.5f,
+                                    -0.5f, 0.5f,  0.5f,  -0.5f, -0.5f, -0.5f, 0.5f, -0.5f, -0.5f,
+                                    0.5f,  0.5f,  -0.5f, -0.5f, 0.5f,  -0.5f};
+                uint32_t indices[] = {0, 1, 2, 2, 3, 0, 1, 5, 6, 6, 2, 1, 5, 4, 7, 7, 6, 5,
+                                      4, 0, 3, 3, 7, 4, 3, 2, 6, 6, 7, 3, 4, 5, 1, 1, 0, 4};
+                BufferLayout layout = {{ShaderDataType::Float3, "aPos"}};
+                auto vertexBuffer =
+                    std::shared_ptr<VertexBuffer>(VertexBuffer::Create(vertices, sizeof(vertices)));
+                vertexBuffer->SetLayout(layout);
+                scene->cube = std::shared_ptr<VertexArray>(VertexArray::Create());
+                scene->cube->AddVertexBuffer(vertexBuffer);
+                scene->cube->SetIndexBuffer(std::shared_ptr<IndexBuffer>(
+                    IndexBuffer::Create(indices, sizeof(indices) / sizeof(uint32_t))));
+                scene->cube->SetBounds(AABB::FromVertices(vertices, sizeof(vertices), layout));
+
+                scene->material = std::make_shared<Material>(
+                    Shader::CreateFromSource(vertexSource, fragmentSource));
+                scene->material->SetVector4("u_Color", glm::vec4(1.0f));
+                scene->renderer.SetFrustumCullingEnabled(false);
+                scene->api.Shutdown();
+            }
+            return *scene;
+        };
+
+        auto runFrame = [getScene](bool instancing) {
+            HeadlessScene* scene = &getScene();
+            scene->api.Init();
+            scene->api.ClearLog();
+            scene->renderer.SetInstancingEnabled(instancing);
+            for (size_t i = 0; i < CUBES; ++i) {
+                glm::vec3 position(static_cast<float>(i % 100), 0.0f, static_cast<float>(i / 100));
+                scene->renderer.Submit(scene->cube, scene->material,
+                                       glm::translate(glm::mat4(1.0f), position));
+            }
+            scene->renderer.SwapCommandBuffers();
+            scene->renderer.Flush();
+            const size_t calls = scene->api.GetCalls().size();
+            scene->api.Shutdown();
+            return calls;
+        };
+
+        bench.Register("Renderer/Headless frame 10K cubes", 50, [runFrame] {
+            static bool logged = false;
+            const size_t calls = runFrame(false);
+            if (!logged) {
+                LOG_INFO_CONCAT("Headless frame 10K cubes - recorded GL calls: ", calls);
+                logged = true;
+            }
+        });
+
+        bench.Register("Renderer/Headless frame 10K cubes instanced", 50, [runFrame] {
+            static bool logged = false;
+            const size_t calls = runFrame(true);
+            if (!logged) {
+                LOG_INFO_CONCAT("Headless frame 10K cubes instanced - recorded GL calls: ", calls);
+                logged = true;
+            }
+        });
+
+        // 100K draws of 16 meshes and 4 materials, as in a field of repeated props, through
+        // Submit and Flush: the sort groups the 64 pairs into runs of one instanced draw each
+        bench.Register("Renderer/Instance runs 100K", 20, [getScene] {
+            constexpr size_t MESHES = 16;
+            constexpr size_t MATERIALS = 4;
+            HeadlessScene& scene = getScene();
+            auto& meshes = scene.propMeshes;
+            auto& materials = scene.propMaterials;
+            scene.api.Init();
+            if (meshes.empty()) {
+                for (size_t i = 0; i < MESHES; ++i) {
+                    auto mesh = std::shared_ptr<VertexArray>(VertexArray::Create());
+                    mesh->AddVertexBuffer(scene.cube->GetVertexBuffers()[0]);
+                    mesh->SetIndexBuffer(scene.cube->GetIndexBuffer());
+                    mesh->SetBounds(scene.cube->GetBounds());
+                    meshes.push_back(std::move(mesh));
+                }
+                for (size_t i = 0; i < MATERIALS; ++i) {
+                    auto material = std::make_shared<Material>(scene.material->GetShader());
+                    material->SetVector4("u_Color", glm::vec4(static_cast<float>(i) / MATERIALS));
+                    materials.push_back(std::move(material));
+                }
+            }
+
+            scene.api.ClearLog();
+            scene.renderer.SetInstancingEnabled(true);
+            for (size_t i = 0; i < SUBMIT_BENCH_COMMANDS; ++i) {
+                scene.renderer.Submit(meshes[(i * 7) % MESHES], materials[(i / MESHES) % MATERIALS],
+                                      glm::mat4(static_cast<float>(i)));
+            }
+            scene.renderer.SwapCommandBuffers();
+            scene.renderer.Flush();
+
+            static bool checked = false;
+            if (!checked) {
+                const RenderStatistics& stats = scene.renderer.GetStatistics();
+                const size_t instancedDraws = scene.api.CountCalls("glDrawElementsInstanced");
+                ASSERT(instancedDraws == MESHES * MATERIALS &&
+                       scene.api.CountCalls("glDrawElements") == 0 &&
+                       stats.instances == SUBMIT_BENCH_COMMANDS &&
+                       "Each mesh/material pair must be one instanced draw");
+                LOG_INFO_CONCAT("Instancing 100K draws - draw calls: per object ",
+                                SUBMIT_BENCH_COMMANDS, ", instanced ", instancedDraws);
+                checked = true;
+            }
+            scene.api.Shutdown();
+        });
+
+        // 1K chunk meshes suballocated from one MeshPool: one vertex array bind per frame
+        bench.Register("Renderer/Headless frame 1K pooled chunks", 50, [getScene] {
+            static std::shared_ptr<MeshPool> pool;
+            static std::vector<MeshPool::Handle> chunks;
+            HeadlessScene& scene = getScene();
+            scene.api.Init();
+            if (!pool) {
+                float vertices[] = {-0.5f, -0.5f, 0.5f,  0.5f, -0.5f, 0.5f,  0.5f, 0.5f, 0.5f,
+                                    -0.5f, 0.5f,  0.5f,  -0.5f, -0.5f, -0.5f, 0.5f, -0.5f, -0.5f,
+                                    0.5f,  0.5f,  -0.5f, -0.5f, 0.5f,  -0.5f};
+                uint32_t indices[] = {0, 1, 2, 2, 3, 0, 1, 5, 6, 6, 2, 1, 5, 4, 7, 7, 6, 5,
+                                      4, 0, 3, 3, 7, 4, 3, 2, 6, 6, 7, 3, 4, 5, 1, 1, 0, 4};
+                BufferLayout layout = {{ShaderDataType::Float3, "aPos"}};
+                const AABB bounds = AABB::FromVertices(vertices, sizeof(vertices), layout);
+                pool = std::make_shared<MeshPool>(layout, 1024, 4096);
+                for (size_t i = 0; i < POOL_BENCH_CHUNKS; ++i) {
+                    chunks.push_back(pool->Allocate(vertices, 8, indices, 36, bounds));
+                }
+            }
+
+            scene.api.ClearLog();
+            scene.renderer.SetInstancingEnabled(false);
+            for (size_t i = 0; i < POOL_BENCH_CHUNKS; ++i) {
+                glm::vec3 position(static_cast<float>(i % 32), 0.0f, static_cast<float>(i / 32));
+                scene.renderer.Submit(pool->GetVertexArray(), scene.material,
+                                      glm::translate(glm::mat4(1.0f), position), GL_TRIANGLES,
+                                      RenderPass::Opaque, pool->GetDrawRange(chunks[i]));
+            }
+            scene.renderer.SwapCommandBuffers();
+            scene.renderer.Flush();
+            static bool logged = false;
+            if (!logged) {
+                const RenderStatistics& stats = scene.renderer.GetStatistics();
+                LOG_INFO_CONCAT("Headless frame 1K pooled chunks - draw calls ", stats.drawCalls,
+                                ", vertex array binds ", stats.vertexArrayBinds,
+                                ", base-vertex draws ",
+                                scene.api.CountCalls("glDrawElementsBaseVertex"));
+                logged = true;
+            }
+            scene.api.Shutdown();
+        });
+
+        // Round-trips a captured 10K cube frame through the file format, then times its replay
+        bench.Register("Renderer/Replay captured frame 10K cubes", 50, [getScene] {
+            static FrameCapture* capture = nullptr;
+            static FrameReplay* replay = nullptr;
+            HeadlessScene& scene = getScene();
+            scene.api.Init();
+            if (!replay) {
+                std::vector<RenderCommand> commands(CUBES);
+                std::vector<const RenderCommand*> pointers(CUBES);
+                for (size_t i = 0; i < CUBES; ++i) {
+                    glm::vec3 position(static_cast<float>(i % 100), 0.0f,
+                                       static_cast<float>(i / 100));
+                    commands[i] = {scene.cube.get(), scene.material.get(), GL_TRIANGLES,
+                                   glm::translate(glm::mat4(1.0f), position), RenderPass::Opaque,
+                                   DrawRange{}};
+                    pointers[i] = &commands[i];
+                }
+                FrameCapture recorded;
+                recorded.RecordFrame(pointers, glm::mat4(1.0f), false, false);
+                const std::vector<uint8_t> bytes = recorded.Serialize();
+
+                capture = new FrameCapture();
+                const bool loaded = capture->Deserialize(bytes.data(), bytes.size());
+                ASSERT(loaded && "Capture round trip failed");
+                (void)loaded;
+
+                // A truncated capture, or one whose frame count is corrupt, must be rejected
+                FrameCapture corrupt;
+                const bool truncated = corrupt.Deserialize(bytes.data(), bytes.size() / 2);
+                std::vector<uint8_t> patched = bytes;
+                const uint32_t frameCount = 0xFFFFFFFFu;
+                std::memcpy(patched.data() + 5 * sizeof(uint32_t), &frameCount, sizeof(frameCount));
+                const bool oversized = corrupt.Deserialize(patched.data(), patched.size());
+                ASSERT(!truncated && !oversized && "Corrupt capture was accepted");
+                (void)truncated;
+                (void)oversized;
+
+                // The last command ends the file: pass, firstIndex, indexCount, baseVertex
+                auto rejects = [&bytes](size_t fromEnd, auto value) {
+                    std::vector<uint8_t> edited = bytes;
+                    std::memcpy(edited.data() + edited.size() - fromEnd, &value, sizeof(value));
+                    FrameCapture rejected;
+                    return !rejected.Deserialize(edited.data(), edited.size());
+                };
+                const bool checked = rejects(13, uint8_t{2}) && rejects(4, int32_t{-1}) &&
+                                     rejects(4, int32_t{1 << 20}) && rejects(8, uint32_t{1000});
+                ASSERT(checked && "Capture with an invalid pass or draw range was accepted");
+                (void)checked;
+                replay = new FrameReplay(*capture);
+                LOG_INFO_CONCAT("Replay captured frame 10K cubes - capture size: ", bytes.size(),
+                                " bytes");
+            }
+            const FrameReplay::FrameTimings timings = replay->ReplayFrame(scene.renderer, 0);
+            Benchmark::DoNotOptimize(&timings);
+            scene.api.Shutdown();
+        });
+
+        // 100K cubes in SCENE_BENCH_GROUPS groups under the root, built through the Scene API.
+        // Never destroyed, like the headless scene whose mesh and material it shares. The first
+        // call checks that cached world matrices follow their parents and match the euler
+        // rotations the matrices used to be built from
+        struct ObjectScene {
+            Scene scene{"Benchmark"};
+            std::vector<std::shared_ptr<SceneObject>> groups;
+            std::vector<std::shared_ptr<SceneObject>> cubes;
+        };
+        auto getObjectScene = [getScene]() -> ObjectScene& {
+            static ObjectScene* objects = nullptr;
+            if (objects) return *objects;
+
+            HeadlessScene& headless = getScene();
+            objects = new ObjectScene();
+            Scene& scene = objects->scene;
+            scene.EnsureCreated(headless.renderer);
+            scene.ReserveObjects(SCENE_BENCH_OBJECTS + SCENE_BENCH_GROUPS);
+            const size_t perGroup = SCENE_BENCH_OBJECTS / SCENE_BENCH_GROUPS;
+            for (size_t g = 0; g < SCENE_BENCH_GROUPS; ++g) {
+                auto group = scene.CreateObject("Group" + std::to_string(g));
+                group->GetTransform().SetPosition(static_cast<float>(g) * 120.0f, 0.0f, 0.0f);
+                objects->groups.push_back(group);
+                for (size_t i = 0; i < perGroup; ++i) {
+                    auto cube = scene.CreateObject("Cube");
+                    cube->SetMesh(headless.cube);
+                    cube->SetMaterial(headless.material);
+                    cube->GetTransform().SetPosition(static_cast<float>(i % 100), 0.0f,
+                                                     static_cast<float>(i / 100));
+                    cube->GetTransform().SetRotation(static_cast<float>(i % 7) * 50.0f,
+                                                     static_cast<float>(i), 0.5f);
+                    group->AddChild(cube);
+                    objects->cubes.push_back(cube);
+                }
+                ASSERT(group->GetChildCount() == perGroup && "Cubes not moved under group");
+            }
+            ASSERT(scene.GetRootObject()->GetChildCount() == SCENE_BENCH_GROUPS &&
+                   scene.GetRegistry().GetSize() == SCENE_BENCH_OBJECTS + SCENE_BENCH_GROUPS + 1 &&
+                   "Unexpected scene hierarchy");
+
+            // The hierarchy does not own children, so an unowned temporary is rejected
+            bool rejected = false;
+            try {
+                objects->groups[0]->AddChild(std::make_shared<SceneObject>("Orphan"));
+            } catch (const AssertLib::AssertionError&) {
+                rejected = true;
+            }
+            ASSERT(rejected && objects->groups[0]->GetChildCount() == perGroup &&
+                   "Unowned child was attached");
+
+            auto maxDifference = [](const glm::mat4& a, const glm::mat4& b) {
+                float difference = 0.0f;
+                for (int c = 0; c < 4; ++c) {
+                    for (int r = 0; r < 4; ++r) {
+                        difference = std::max(difference, std::abs(a[c][r] - b[c][r]));
+                    }
+                }
+                return difference;
+            };
+            const SceneRegistry& registry = scene.GetRegistry();
+            scene.OnUpdate(0.0f);
+            const auto& cube = objects->cubes[perGroup + 123];
+            const glm::vec3 euler = cube->GetTransform().GetRotation();
+            glm::mat4 expected =
+                glm::translate(glm::mat4(1.0f), glm::vec3(120.0f, 0.0f, 0.0f)) *
+                glm::translate(glm::mat4(1.0f), cube->GetTransform().GetPosition());
+            expected = glm::rotate(expected, glm::radians(euler.x), glm::vec3(1.0f, 0.0f, 0.0f));
+            expected = glm::rotate(expected, glm::radians(euler.y), glm::vec3(0.0f, 1.0f, 0.0f));
+            expected = glm::rotate(expected, glm::radians(euler.z), glm::vec3(0.0f, 0.0f, 1.0f));
+            ASSERT(maxDifference(registry.GetWorldMatrix(cube->GetEntity()), expected) < 1e-3f &&
+                   maxDifference(cube->GetWorldTransform(), expected) < 1e-3f &&
+                   "World matrix does not match the euler rotation under its parent");
+
+            // Moving a group must carry its cubes along
+            objects->groups[1]->GetTransform().SetPosition(120.0f, 10.0f, 0.0f);
+            scene.OnUpdate(0.0f);
+            const glm::vec4 origin = registry.GetWorldMatrix(cube->GetEntity())[3];
+            ASSERT(std::abs(origin.y - 10.0f) < 1e-3f && "Cube did not follow its group");
+            ASSERT(!cube->GetTransform().IsDirty() && "Dirty flag not cleared by the update pass");
+            objects->groups[1]->GetTransform().SetPosition(120.0f, 0.0f, 0.0f);
+            scene.OnUpdate(0.0f);
+            return *objects;
+        };
+
+        // One frame of a static scene: the update pass finds nothing to recompute
+        bench.Register("Scene/Update and submit 100K", 20, [getScene, getObjectScene] {
+            HeadlessScene& headless = getScene();
+            Scene& scene = getObjectScene().scene;
+            scene.OnUpdate(1.0f / 60.0f);
+            scene.OnRender(headless.renderer);
+            headless.renderer.SwapCommandBuffers();
+            headless.renderer.SwapCommandBuffers();
+        });
+
+        // Traversal and submission alone, from the world matrices of the last update
+        bench.Register("Scene/Submit 100K", 20, [getScene, getObjectScene] {
+            HeadlessScene& headless = getScene();
+            Scene& scene = getObjectScene().scene;
+            scene.OnRender(headless.renderer);
+            headless.renderer.SwapCommandBuffers();
+            headless.renderer.SwapCommandBuffers();
+        });
+
+        // Update passes after moving every cube, one in a hundred, and one group's subtree
+        bench.Register("Scene/Update 100K, all moved", 20, [getObjectScene] {
+            static float offset = 0.0f;
+            ObjectScene& objects = getObjectScene();
+            offset = offset == 0.0f ? 1.0f : 0.0f;
+            for (const auto& cube : objects.cubes) {
+                glm::vec3 position = cube->GetTransform().GetPosition();
+                position.y = offset;
+                cube->GetTransform().SetPosition(position);
+            }
+            objects.scene.OnUpdate(1.0f / 60.0f);
+        });
+        bench.Register("Scene/Update 100K, 1K moved", 20, [getObjectScene] {
+            static float offset = 0.0f;
+            ObjectScene& objects = getObjectScene();
+            offset = offset == 0.0f ? 1.0f : 0.0f;
+            for (size_t i = 0; i < objects.cubes.size(); i += 100) {
+                glm::vec3 position = objects.cubes[i]->GetTransform().GetPosition();
+                position.y = offset;
+                objects.cubes[i]->GetTransform().SetPosition(position);
+            }
+            objects.scene.OnUpdate(1.0f / 60.0f);
+        });
+        bench.Register("Scene/Update 100K, one group moved", 20, [getObjectScene] {
+            static float offset = 0.0f;
+            ObjectScene& objects = getObjectScene();
+            offset = offset == 0.0f ? 1.0f : 0.0f;
+            objects.groups[0]->GetTransform().SetPosition(0.0f, offset, 0.0f);
+            objects.scene.OnUpdate(1.0f / 60.0f);
+        });
+    }
+
+    /**
+     * @brief TLSF range allocator under chunk-mesh-like churn
+     * @details Ranges of 256 to 4096 units are allocated and freed at random around
+     *          ALLOCATOR_BENCH_LIVE live ranges, then compacted. The first run also
+     *          checks the allocator's invariants and that no live ranges overlap.
+     */
+    void RegisterRangeAllocatorBenchmarks(Benchmark& bench) {
+        bench.Register("Memory/RangeAllocator churn 100K", 20, [] {
+            static bool checked = false;
+            RangeAllocator allocator(ALLOCATOR_BENCH_CAPACITY);
+            std::vector<RangeAllocator::Allocation> live;
+            live.reserve(ALLOCATOR_BENCH_LIVE * 2);
+
+            uint32_t state = 0x9e3779b9u;
+            auto next = [&state] {
+                state ^= state << 13;
+                state ^= state >> 17;
+                state ^= state << 5;
+                return state;
+            };
+            for (size_t i = 0; i < ALLOCATOR_BENCH_OPERATIONS; ++i) {
+                if (live.empty() || (live.size() < ALLOCATOR_BENCH_LIVE * 2 &&
+                                     next() % (ALLOCATOR_BENCH_LIVE * 2) >= live.size())) {
+                    auto allocation = allocator.Allocate(256 + next() % 3841);
+                    if (allocation.IsValid()) live.push_back(allocation);
+                } else {
+                    const size_t index = next() % live.size();
+                    allocator.Free(live[index]);
+                    live[index] = live.back();
+                    live.pop_back();
+                }
+            }
+            const float fragmentation = allocator.GetFragmentation();
+            const auto moves = allocator.Defragment();
+            Benchmark::DoNotOptimize(moves.data());
+
+            if (!checked) {
+                for (auto& allocation : live) allocation.offset = allocator.GetOffset(allocation.node);
+                std::sort(live.begin(), live.end(), [](const auto& a, const auto& b) {
+                    return a.offset < b.offset;
+                });
+                bool valid = allocator.Validate() && allocator.GetFreeBlockCount() <= 1;
+                for (size_t i = 1; i < live.size(); ++i) {
+                    valid = valid && live[i - 1].offset + live[i - 1].size <= live[i].offset;
+                }
+                ASSERT(valid && "RangeAllocator invariants violated");
+                LOG_INFO_CONCAT("RangeAllocator churn 100K - live ranges ", live.size(),
+                                ", fragmentation before compaction ", fragmentation, ", moves ",
+                                moves.size(), valid ? ", invariants hold" : ", INVALID");
+                checked = true;
+            }
+        });
+    }
+
+    /**
+     * @brief Renderer2D vertex generation for 1M quads per frame
+     * @details Quads are written into a batch-sized staging buffer that is reused
+     *          ten times, as Renderer2D flushes every QUAD_BENCH_BATCH quads. The
+     *          matrix case is the former DrawQuad() path, translate * scale applied
+     *          to the four unit corners; the first run checks that the direct corner
+     *          kernel reproduces it.
+     */
+    void RegisterRenderer2DBenchmarks(Benchmark& bench) {
+        struct QuadScene {
+            std::vector<QuadInstance> quads;
+            std::vector<QuadVertex> vertices;
+        };
+        auto getScene = []() -> QuadScene& {
+            static QuadScene scene;
+            if (scene.quads.empty()) {
+                scene.quads.resize(QUAD_BENCH_QUADS);
+                for (size_t i = 0; i < QUAD_BENCH_QUADS; ++i) {
+                    QuadInstance& quad = scene.quads[i];
+                    quad.Position = {static_cast<float>(i % 1000), static_cast<float>(i / 1000),
+                                     0.0f};
+                    quad.Size = {0.5f + static_cast<float>(i % 7) * 0.1f, 0.8f};
+                    quad.Color = {static_cast<float>(i % 3) * 0.5f, 0.25f, 1.0f, 1.0f};
+                }
+                scene.vertices.resize(QUAD_BENCH_BATCH * 4);
+            }
+            return scene;
+        };
+
+        bench.Register("Renderer2D/Quad vertices mat4 1M", 10, [getScene] {
+            static const glm::vec4 corners[4] = {{-0.5f, -0.5f, 0.0f, 1.0f},
+                                                 {0.5f, -0.5f, 0.0f, 1.0f},
+                                                 {0.5f, 0.5f, 0.0f, 1.0f},
+                                                 {-0.5f, 0.5f, 0.0f, 1.0f}};
+            QuadScene& scene = getScene();
+            for (size_t first = 0; first < QUAD_BENCH_QUADS; first += QUAD_BENCH_BATCH) {
+                QuadVertex* vertex = scene.vertices.data();
+                for (size_t i = first; i < first + QUAD_BENCH_BATCH; ++i) {
+                    const QuadInstance& quad = scene.quads[i];
+                    const glm::mat4 transform =
+                        glm::translate(glm::mat4(1.0f), quad.Position) *
+                        glm::scale(glm::mat4(1.0f), {quad.Size.x, quad.Size.y, 1.0f});
+                    for (size_t c = 0; c < 4; ++c) {
+                        vertex->Position = glm::vec3(transform * corners[c]);
+                        vertex->Color = quad.Color;
+                        vertex->TexCoord = {(c == 1 || c == 2) ? 1.0f : 0.0f,
+                                            (c == 2 || c == 3) ? 1.0f : 0.0f};
+                        vertex->TexIndex = 0.0f;
+                        vertex->TilingFactor = 1.0f;
+                        ++vertex;
+                    }
+                }
+                Benchmark::DoNotOptimize(scene.vertices.data());
+            }
+        });
+
+        bench.Register("Renderer2D/Quad vertices 1M", 10, [getScene] {
+            static bool checked = false;
+            QuadScene& scene = getScene();
+            for (size_t first = 0; first < QUAD_BENCH_QUADS; first += QUAD_BENCH_BATCH) {
+                Renderer2D::GenerateQuadVertices(&scene.quads[first], QUAD_BENCH_BATCH, 0.0f, 1.0f,
+                                                 scene.vertices.data());
+                Benchmark::DoNotOptimize(scene.vertices.data());
+            }
+
+            if (!checked) {
+                // The last batch is still in the buffer; compare it with the matrix path
+                float maxError = 0.0f;
+                const size_t first = QUAD_BENCH_QUADS - QUAD_BENCH_BATCH;
+                for (size_t i = 0; i < QUAD_BENCH_BATCH; ++i) {
+                    const QuadInstance& quad = scene.quads[first + i];
+                    for (size_t c = 0; c < 4; ++c) {
+                        const glm::vec2 uv((c == 1 || c == 2) ? 1.0f : 0.0f,
+                                           (c == 2 || c == 3) ? 1.0f : 0.0f);
+                        const glm::vec3 expected =
+                            quad.Position + glm::vec3((uv.x - 0.5f) * quad.Size.x,
+                                                      (uv.y - 0.5f) * quad.Size.y, 0.0f);
+                        const QuadVertex& vertex = scene.vertices[i * 4 + c];
+                        maxError = std::max(maxError, glm::length(vertex.Position - expected));
+                        maxError = std::max(maxError, glm::length(vertex.Color - quad.Color));
+                        maxError = std::max(maxError, std::abs(vertex.TexCoord.x - uv.x) +
+                                                          std::abs(vertex.TexCoord.y - uv.y));
+                        maxError = std::max(maxError, std::abs(vertex.TexIndex) +
+                                                          std::abs(vertex.TilingFactor - 1.0f));
+                    }
+                }
+                ASSERT(maxError < 1e-4f && "Quad vertices differ from the matrix path");
+                LOG_INFO_CONCAT("Quad vertices 1M - max error against the matrix path: ",
+                                maxError);
+                checked = true;
+            }
+        });
+
+        bench.Register("Renderer2D/Quad vertices rotated 1M", 10, [getScene] {
+            static std::vector<QuadInstance> rotated;
+            QuadScene& scene = getScene();
+            if (rotated.empty()) {
+                rotated = scene.quads;
+                for (size_t i = 0; i < rotated.size(); ++i) {
+                    rotated[i].Rotation = static_cast<float>(i % 360) * 0.0174533f + 0.01f;
+                }
+            }
+            for (size_t first = 0; first < QUAD_BENCH_QUADS; first += QUAD_BENCH_BATCH) {
+                Renderer2D::GenerateQuadVertices(&rotated[first], QUAD_BENCH_BATCH, 0.0f, 1.0f,
+                                                 scene.vertices.data());
+                Benchmark::DoNotOptimize(scene.vertices.data());
+            }
+        });
+    }
+
+    /**
+     * @brief Headless Renderer2D scene of 100K sprites with interleaved textures
+     * @details Sprite i uses texture i % 64 on layer i % 4, the worst case for
+     *          submission-order batching, which flushes each time the 31 texture
+     *          slots run out. A further case checks how quads split into draw
+     *          calls across batch capacity, texture slots, streams and layers.
+     *          Runs under RecordingRenderAPI and needs the batch shader from
+     *          assets/shaders; without it the cases do nothing.
+     */
+    void RegisterSpriteSortBenchmarks(Benchmark& bench) {
+        struct SpriteScene {
+            RecordingRenderAPI api;
+            std::shared_ptr<OrthographicCamera> camera;
+            std::vector<std::shared_ptr<Texture>> textures;
+            Renderer2D::StreamID overlayStream = Renderer2D::DEFAULT_STREAM;
+            bool ready = false;
+        };
+
+        // Built on first use and torn down after the run, under its recorder: Renderer2D
+        // and the scene's textures hold recorded names that must not reach a real context
+        static SpriteScene* scene = nullptr;
+        auto getScene = []() -> SpriteScene& {
+            if (!scene) {
+                scene = new SpriteScene();
+                scene->api.Init();
+                Renderer2D::Get().Initialize();
+                scene->ready = ShaderLibrary::Exists("batch_renderer_2d");
+                if (scene->ready) {
+                    auto material =
+                        std::make_shared<Material>(ShaderLibrary::Get("batch_renderer_2d"));
+                    scene->overlayStream = Renderer2D::Get().CreateStream(material);
+                } else {
+                    LOG_WARN("Sprite benchmarks skipped: no 2D batch shader");
+                }
+                scene->camera = std::make_shared<OrthographicCamera>(0.0f, 320.0f, 0.0f, 320.0f);
+                for (size_t i = 0; i < SPRITE_BENCH_TEXTURES; ++i) {
+                    scene->textures.push_back(Texture::Create(1, 1));
+                }
+                scene->api.Shutdown();
+            }
+            return *scene;
+        };
+
+        auto runScene = [getScene](bool sorted) {
+            SpriteScene& scene = getScene();
+            if (!scene.ready) return;
+            Renderer2D& renderer = Renderer2D::Get();
+            scene.api.Init();
+            renderer.ResetStats();
+            renderer.SetSpriteSorting(sorted);
+            renderer.BeginScene(scene.camera);
+            for (size_t i = 0; i < SPRITE_BENCH_SPRITES; ++i) {
+                renderer.SetLayer(static_cast<int32_t>(i) % SPRITE_BENCH_LAYERS);
+                const glm::vec3 position(static_cast<float>(i % 316), static_cast<float>(i / 316),
+                                         0.0f);
+                renderer.DrawQuad(position, {1.0f, 1.0f},
+                                  scene.textures[i % SPRITE_BENCH_TEXTURES]);
+            }
+            renderer.EndScene();
+            renderer.SetSpriteSorting(false);
+            renderer.SetLayer(0);
+            scene.api.Shutdown();
+
+            // Logged from the second run, once the scratch buffers are warm
+            static int runs[2] = {0, 0};
+            if (++runs[sorted] == 2) {
+                const Renderer2D::SortStatistics sortStats = renderer.GetSortStats();
+                if (sorted) {
+                    LOG_INFO_CONCAT("Sprites interleaved 100K sorted - draw calls ",
+                                    renderer.GetStats().DrawCalls, ", in submission order ",
+                                    sortStats.UnsortedDrawCalls, ", sort ", sortStats.SortMs,
+                                    " ms");
+                } else {
+                    LOG_INFO_CONCAT("Sprites interleaved 100K - draw calls ",
+                                    renderer.GetStats().DrawCalls);
+                }
+            }
+        };
+
+        bench.Register("Renderer2D/Batch splitting", 10, [getScene] {
+            SpriteScene& scene = getScene();
+            if (!scene.ready) return;
+            Renderer2D& renderer = Renderer2D::Get();
+            static std::vector<QuadInstance> quads(2 * QUAD_BENCH_BATCH + QUAD_BENCH_BATCH / 2);
+            scene.api.Init();
+
+            // Index counts of the scene's draw calls, in order
+            auto drawScene = [&](bool sorted, const std::function<void()>& draw) {
+                scene.api.ClearLog();
+                renderer.SetSpriteSorting(sorted);
+                renderer.BeginScene(scene.camera);
+                draw();
+                renderer.EndScene();
+                renderer.SetSpriteSorting(false);
+                renderer.SetStream(Renderer2D::DEFAULT_STREAM);
+                renderer.SetLayer(0);
+
+                std::vector<uint32_t> indexCounts;
+                for (const RecordingRenderAPI::Call& call : scene.api.GetCalls()) {
+                    if (std::string_view(call.function) == "glDrawElements") {
+                        indexCounts.push_back(static_cast<uint32_t>(call.args[1]));
+                    }
+                }
+                return indexCounts;
+            };
+
+            // The 100K-quad default stream splits 250K quads into three draws
+            const auto capacity = drawScene(false, [&] {
+                renderer.DrawQuads(quads.data(), quads.size());
+            });
+            size_t orphans = 0;
+            for (const RecordingRenderAPI::Call& call : scene.api.GetCalls()) {
+                orphans += std::string_view(call.function) == "glBufferData" &&
+                           call.args[2] == GL_STREAM_DRAW;
+            }
+
+            // 31 texture slots besides white: the 32nd texture starts a new draw
+            const auto slots = drawScene(false, [&] {
+                for (size_t i = 0; i < 40; ++i) {
+                    renderer.DrawQuad({0.0f, 0.0f}, {1.0f, 1.0f}, scene.textures[i]);
+                }
+            });
+
+            // Interleaved streams batch side by side: one draw each
+            const auto streams = drawScene(false, [&] {
+                for (size_t i = 0; i < 1000; ++i) {
+                    renderer.SetStream(i % 2 ? scene.overlayStream : Renderer2D::DEFAULT_STREAM);
+                    renderer.DrawQuad({0.0f, 0.0f}, {1.0f, 1.0f}, glm::vec4(1.0f));
+                }
+            });
+
+            // Sorted scenes draw a stream when the next layer moves to another
+            const auto layers = drawScene(true, [&] {
+                renderer.SetStream(scene.overlayStream);
+                renderer.SetLayer(2);
+                renderer.DrawQuads(quads.data(), 30);
+                renderer.SetStream(Renderer2D::DEFAULT_STREAM);
+                renderer.SetLayer(1);
+                renderer.DrawQuads(quads.data(), 20);
+                renderer.SetStream(scene.overlayStream);
+                renderer.SetLayer(0);
+                renderer.DrawQuads(quads.data(), 10);
+            });
+            scene.api.Shutdown();
+
+            static bool checked = false;
+            if (!checked) {
+                const bool valid = capacity == std::vector<uint32_t>{600000, 600000, 300000} &&
+                                   orphans == capacity.size() &&
+                                   slots == std::vector<uint32_t>{186, 54} &&
+                                   streams == std::vector<uint32_t>{3000, 3000} &&
+                                   layers == std::vector<uint32_t>{60, 120, 180};
+                ASSERT(valid && "Renderer2D batch splitting changed");
+                LOG_INFO_CONCAT("Batch splitting - draws for capacity ", capacity.size(),
+                                ", texture slots ", slots.size(), ", streams ", streams.size(),
+                                ", sorted layers ", layers.size(),
+                                valid ? ", as expected" : ", UNEXPECTED");
+                checked = true;
+            }
+        });
+
+        bench.Register("Renderer2D/Sprites interleaved 100K", 20, [runScene] { runScene(false); });
+        bench.Register("Renderer2D/Sprites interleaved 100K sorted", 20,
+                       [runScene] { runScene(true); });
+
+        bench.RegisterTeardown("Renderer2D/Sprites", [] {
+            if (!scene) return;
+            scene->api.Init();
+            Renderer2D::Get().Shutdown();
+            scene->textures.clear();
+            scene->api.Shutdown();
+            delete scene;
+            scene = nullptr;
+        });
+    }
+
+    void RegisterTextureLoadBenchmarks(Benchmark& bench) {
+        struct TextureScene {
+            RecordingRenderAPI api;
+            std::vector<std::string> paths;
+            float syncMs = 0.0f;                ///< Main-thread time of the last sync run
+        };
+
+        auto getScene = []() -> TextureScene& {
+            static TextureScene scene;
+            if (scene.paths.empty()) {
+                std::error_code error;
+                for (const auto& entry : std::filesystem::recursive_directory_iterator(
+                         "assets/textures/kenny_simple/PNG", error)) {
+                    if (entry.path().extension() == ".png") {
+                        scene.paths.push_back(entry.path().string());
+                    }
+                }
+                std::sort(scene.paths.begin(), scene.paths.end());
+                if (scene.paths.size() > TEXTURE_BENCH_FILES) {
+                    scene.paths.resize(TEXTURE_BENCH_FILES);
+                }
+                if (scene.paths.empty()) {
+                    LOG_WARN("Texture load benchmarks skipped: no PNGs in assets/textures");
+                }
+            }
+            return scene;
+        };
+
+        // Decode and upload on the calling thread, as Texture::Create(path) does
+        bench.Register("Texture/Load 16 sync", 5, [getScene] {
+            TextureScene& scene = getScene();
+            if (scene.paths.empty()) return;
+            scene.api.Init();
+            const auto start = std::chrono::steady_clock::now();
+            std::vector<std::shared_ptr<Texture>> textures;
+            for (const auto& path : scene.paths) {
+                textures.push_back(Texture::Create(path));
+            }
+            scene.syncMs = std::chrono::duration<float, std::milli>(
+                               std::chrono::steady_clock::now() - start)
+                               .count();
+            textures.clear();
+            scene.api.Shutdown();
+        });
+
+        // Decode on the I/O threads while the "main thread" pumps budgeted uploads per frame
+        bench.Register("Texture/Load 16 async", 5, [getScene] {
+            TextureScene& scene = getScene();
+            if (scene.paths.empty()) return;
+            TextureLoader& loader = TextureLoader::Get();
+            scene.api.Init();
+
+            using Clock = std::chrono::steady_clock;
+            Clock::duration mainThread{};
+            auto start = Clock::now();
+            std::vector<AsyncTexture> loads;
+            for (const auto& path : scene.paths) {
+                loads.push_back(loader.Load(path));
+            }
+            mainThread += Clock::now() - start;
+
+            uint32_t frames = 0;
+            float worstFrameMs = 0.0f;
+            while (!loader.IsIdle()) {
+                start = Clock::now();
+                if (loader.Update(TextureLoader::DEFAULT_UPLOAD_BUDGET) > 0) {
+                    ++frames;
+                    worstFrameMs =
+                        std::max(worstFrameMs, loader.GetStatistics().lastFrameUploadMs);
+                }
+                mainThread += Clock::now() - start;
+                std::this_thread::yield();
+            }
+
+            static int runs = 0;
+            if (++runs == 1) {
+                for (const auto& load : loads) {
+                    ASSERT(load.IsReady() && load.GetTexture()->GetWidth() > 1 &&
+                           "Async texture load did not complete");
+                }
+            } else if (runs == 2) {
+                LOG_INFO_CONCAT("Texture load async 16 - main thread ",
+                                std::chrono::duration<float, std::milli>(mainThread).count(),
+                                " ms (sync ", scene.syncMs, " ms), uploads over ", frames,
+                                " frames, worst frame ", worstFrameMs, " ms");
+            }
+
+            loads.clear();
+            loader.Shutdown();
+            scene.api.Shutdown();
+        });
+
+        // Packs the images into an atlas on an I/O thread, as the terrain does at startup;
+        // the main thread only creates the placeholder and pumps the upload
+        bench.Register("Texture/Atlas 16 async", 5, [getScene] {
+            TextureScene& scene = getScene();
+            if (scene.paths.empty()) return;
+            TextureLoader& loader = TextureLoader::Get();
+            scene.api.Init();
+
+            using Clock = std::chrono::steady_clock;
+            auto start = Clock::now();
+            auto regions = std::make_shared<std::vector<AtlasRegion>>();
+            bool applied = false;
+            const std::vector<std::string> paths = scene.paths;
+            AsyncTexture load = loader.Load(
+                "benchmark atlas",
+                [paths, regions] {
+                    TextureAtlasBuilder builder;
+                    for (const auto& path : paths) builder.AddFile(path, path);
+                    TextureAtlas atlas = builder.Build();
+                    *regions = atlas.regions;
+                    return std::move(atlas.image);
+                },
+                [&applied] { applied = true; });
+            const float startMs =
+                std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+
+            while (!loader.IsIdle()) {
+                loader.Update(TextureLoader::DEFAULT_UPLOAD_BUDGET);
+                std::this_thread::yield();
+            }
+
+            static int runs = 0;
+            if (++runs == 1) {
+                ASSERT(load.IsReady() && applied && load.GetTexture()->GetWidth() > 1 &&
+                       regions->size() == paths.size() && "Async atlas build did not complete");
+                LOG_INFO_CONCAT("Atlas 16 async - main thread to start ", startMs, " ms, atlas ",
+                                load.GetTexture()->GetWidth(), "x",
+                                load.GetTexture()->GetHeight());
+
+                // A throwing producer must fail the load rather than leave it decoding
+                const uint32_t failedBefore = loader.GetStatistics().failed;
+                AsyncTexture throwing = loader.Load(
+                    "throwing atlas",
+                    []() -> TextureImage { throw std::runtime_error("benchmark decode error"); },
+                    nullptr);
+                while (!loader.IsIdle()) {
+                    loader.Update(TextureLoader::DEFAULT_UPLOAD_BUDGET);
+                    std::this_thread::yield();
+                }
+                ASSERT(throwing.IsFailed() && loader.GetStatistics().failed == failedBefore + 1 &&
+                       "Throwing texture producer was not reported as failed");
+            }
+
+            load = AsyncTexture();
+            loader.Shutdown();
+            scene.api.Shutdown();
+        });
+
+        // Startup texture loads with mips through the decoded-texture cache: cold runs decode
+        // and write every entry, warm runs map the entries and upload without decoding
+        auto runCached = [getScene](bool warm) {
+            TextureScene& scene = getScene();
+            if (scene.paths.empty()) return;
+            TextureCache& cache = TextureCache::Get();
+            const TextureCacheConfig previous{cache.IsEnabled(), cache.GetDirectory()};
+            TextureCacheConfig config;
+            config.directory =
+                (std::filesystem::temp_directory_path() / "voxel_texture_cache_bench").string();
+            cache.Configure(config);
+            if (!cache.IsEnabled()) return;
+            if (!warm) cache.Clear();
+            cache.ResetStatistics();
+            scene.api.Init();
+
+            const auto start = std::chrono::steady_clock::now();
+            std::vector<std::shared_ptr<Texture>> textures;
+            for (const auto& path : scene.paths) {
+                auto texture = std::make_shared<Texture>();
+                texture->Upload(cache.Load(path, true));
+                textures.push_back(std::move(texture));
+            }
+            const float elapsedMs = std::chrono::duration<float, std::milli>(
+                                        std::chrono::steady_clock::now() - start)
+                                        .count();
+            const TextureCache::Statistics stats = cache.GetStatistics();
+
+            static int warmRuns = 0;
+            if (warm) ++warmRuns;
+            if (warm && warmRuns == 1) {
+                // Warm starts must serve every image, bit-exact with a fresh decode
+                ASSERT(stats.hits == scene.paths.size() && "Texture cache missed when warm");
+                for (const auto& path : scene.paths) {
+                    const TextureImage cached = cache.Load(path, true);
+                    const TextureImage decoded = Texture::Decode(path, true);
+                    ASSERT(cached.mapping && cached.levels.size() == decoded.levels.size() &&
+                           cached.GetByteSize() == decoded.GetByteSize() &&
+                           std::memcmp(cached.GetPixels(), decoded.GetPixels(),
+                                       decoded.GetByteSize()) == 0 &&
+                           "Texture cache entry differs from the decoded image");
+                }
+
+                // A touched source is rehashed once and its entry replaced, not patched in
+                // place, so an image still mapping the old entry keeps its pixels
+                const std::filesystem::path touched =
+                    std::filesystem::path(config.directory) / "touched.png";
+                std::filesystem::copy_file(scene.paths[0], touched,
+                                           std::filesystem::copy_options::overwrite_existing);
+                const TextureImage before = cache.Load(touched.string(), true);
+                std::filesystem::last_write_time(
+                    touched, std::filesystem::last_write_time(touched) + std::chrono::hours(1));
+                cache.ResetStatistics();
+                const TextureImage refreshed = cache.Load(touched.string(), true);
+                const TextureImage after = cache.Load(touched.string(), true);
+                const TextureCache::Statistics touchStats = cache.GetStatistics();
+                ASSERT(touchStats.rehashed == 1 && touchStats.hits == 2 && after.mapping &&
+                       std::memcmp(before.GetPixels(), refreshed.GetPixels(),
+                                   before.GetByteSize()) == 0 &&
+                       std::memcmp(before.GetPixels(), after.GetPixels(),
+                                   before.GetByteSize()) == 0 &&
+                       "Touched texture was not refreshed in the cache");
+                std::filesystem::remove(touched);
+
+                // An entry whose first level points past the file is a miss, even though its
+                // last level is intact; the miss decodes the image and writes a sound entry
+                const std::filesystem::path corrupt =
+                    std::filesystem::path(config.directory) / "corrupt.png";
+                std::filesystem::copy_file(scene.paths[0], corrupt,
+                                           std::filesystem::copy_options::overwrite_existing);
+                std::vector<std::filesystem::path> entries;
+                for (const auto& entry : std::filesystem::directory_iterator(config.directory)) {
+                    entries.push_back(entry.path());
+                }
+                ASSERT(cache.Load(corrupt.string(), true).levels.size() > 1 &&
+                       "Corrupt entry test needs a mip chain");
+                for (const auto& entry : std::filesystem::directory_iterator(config.directory)) {
+                    if (std::find(entries.begin(), entries.end(), entry.path()) != entries.end()) {
+                        continue;
+                    }
+                    // Level 0's offset, after the 40-byte header and its width and height
+                    std::fstream file(entry.path(),
+                                      std::ios::in | std::ios::out | std::ios::binary);
+                    const uint64_t offset = std::filesystem::file_size(entry.path());
+                    file.seekp(48);
+                    file.write(reinterpret_cast<const char*>(&offset), sizeof(offset));
+                }
+                cache.ResetStatistics();
+                const TextureImage rejected = cache.Load(corrupt.string(), true);
+                ASSERT(cache.GetStatistics().misses == 1 && rejected.IsValid() &&
+                       !rejected.mapping && "Corrupt texture cache entry was mapped");
+                std::filesystem::remove(corrupt);
+            } else if (warm && warmRuns == 2) {
+                LOG_INFO_CONCAT("Texture cache 16 warm - ", elapsedMs, " ms, ", stats.hits,
+                                " hits, ", stats.misses, " misses");
+            }
+
+            textures.clear();
+            scene.api.Shutdown();
+            cache.Configure(previous);
+        };
+
+        bench.Register("Texture/Load 16 cold cache", 5, [runCached] { runCached(false); });
+        bench.Register("Texture/Load 16 warm cache", 5, [runCached] { runCached(true); });
+    }
+
+    /** @brief Plain scalar 2x2 box filter of one level, the baseline for the mip kernel */
+    void BoxFilterLevel(const uint8_t* in, uint32_t width, uint32_t height, uint8_t* out) {
+        const uint32_t outWidth = std::max(width / 2, 1u), outHeight = std::max(height / 2, 1u);
+        for (uint32_t y = 0; y < outHeight; ++y) {
+            for (uint32_t x = 0; x < outWidth; ++x) {
+                for (uint32_t c = 0; c < 4; ++c) {
+                    uint32_t sum = 0;
+                    for (uint32_t dy = 0; dy < 2; ++dy) {
+                        for (uint32_t dx = 0; dx < 2; ++dx) {
+                            const size_t sx = std::min(2 * x + dx, width - 1);
+                            const size_t sy = std::min(2 * y + dy, height - 1);
+                            sum += in[(sy * width + sx) * 4 + c];
+                        }
+                    }
+                    out[(static_cast<size_t>(y) * outWidth + x) * 4 + c] =
+                        static_cast<uint8_t>((sum + 2) >> 2);
+                }
+            }
+        }
+    }
+
+    void RegisterTextureAtlasBenchmarks(Benchmark& bench) {
+        // 1000 block-sized images of mixed sizes, like a large modded block set
+        auto getBuilder = []() -> const TextureAtlasBuilder& {
+            static TextureAtlasBuilder builder;
+            if (builder.GetImageCount() == 0) {
+                std::mt19937 rng(42);
+                std::uniform_int_distribution<uint32_t> size(8, 64);
+                for (uint32_t i = 0; i < ATLAS_BENCH_IMAGES; ++i) {
+                    TextureImage image;
+                    const uint32_t width = size(rng), height = size(rng);
+                    image.levels.push_back({width, height, 0});
+                    image.pixels.resize(static_cast<size_t>(width) * height * 4);
+                    for (size_t p = 0; p < image.pixels.size(); ++p) {
+                        image.pixels[p] = static_cast<uint8_t>(p * 7 + i * 13);
+                    }
+                    builder.Add("block_" + std::to_string(i), std::move(image));
+                }
+            }
+            return builder;
+        };
+
+        bench.Register("Texture/Atlas pack 1K", 20, [getBuilder] {
+            const TextureAtlasBuilder::Layout layout = getBuilder().Pack();
+            Benchmark::DoNotOptimize(layout.cells.data());
+
+            static int runs = 0;
+            if (++runs == 1) {
+                ASSERT(layout.width > 0 && "Atlas benchmark images did not fit");
+                uint64_t area = 0;
+                for (size_t i = 0; i < layout.cells.size(); ++i) {
+                    const SkylinePacker::Rect& a = layout.cells[i];
+                    ASSERT(a.x + a.width <= layout.width && a.y + a.height <= layout.height &&
+                           a.x % layout.padding == 0 && a.y % layout.padding == 0 &&
+                           "Atlas cell out of bounds or unaligned");
+                    for (size_t j = i + 1; j < layout.cells.size(); ++j) {
+                        const SkylinePacker::Rect& b = layout.cells[j];
+                        ASSERT((a.x + a.width <= b.x || b.x + b.width <= a.x ||
+                                a.y + a.height <= b.y || b.y + b.height <= a.y) &&
+                               "Atlas cells overlap");
+                    }
+                    area += static_cast<uint64_t>(a.width) * a.height;
+                }
+                LOG_INFO_CONCAT("Atlas pack 1K - ", layout.width, "x", layout.height, ", ",
+                                100.0 * area / (static_cast<double>(layout.width) * layout.height),
+                                "% occupied");
+            }
+        });
+
+        bench.Register("Texture/Atlas build 1K", 10, [getBuilder] {
+            const TextureAtlas atlas = getBuilder().Build();
+            Benchmark::DoNotOptimize(atlas.image.pixels.data());
+
+            static int runs = 0;
+            if (++runs == 1) {
+                ASSERT(atlas.image.levels.size() == 3 && "Atlas with padding 4 keeps 3 levels");
+                const size_t stride = static_cast<size_t>(atlas.image.levels[0].width) * 4;
+                for (const AtlasRegion& region : atlas.regions) {
+                    // The texel left of the image repeats its first texel
+                    const uint8_t* first = atlas.image.pixels.data() + region.y * stride +
+                                           static_cast<size_t>(region.x) * 4;
+                    ASSERT(std::memcmp(first - 4, first, 4) == 0 && "Atlas padding not extruded");
+                }
+            }
+        });
+
+        // Full mip chain of an atlas-sized image, SSE2 kernel against the scalar baseline
+        auto getAtlas = [getBuilder]() -> TextureImage& {
+            static TextureImage image;
+            if (!image.IsValid()) {
+                TextureAtlasSettings settings;
+                settings.generateMips = false;
+                image = getBuilder().Build(settings).image;
+            }
+            return image;
+        };
+
+        bench.Register("Texture/Atlas mips 1K scalar", 10, [getAtlas] {
+            TextureImage& image = getAtlas();
+            static std::vector<uint8_t> mips;
+            uint32_t width = image.levels[0].width, height = image.levels[0].height;
+            mips.resize(image.pixels.size() / 2);
+            const uint8_t* in = image.pixels.data();
+            uint8_t* out = mips.data();
+            while (width > 1 || height > 1) {
+                BoxFilterLevel(in, width, height, out);
+                width = std::max(width / 2, 1u);
+                height = std::max(height / 2, 1u);
+                in = out;
+                out += static_cast<size_t>(width) * height * 4;
+            }
+            Benchmark::DoNotOptimize(mips.data());
+        });
+
+        bench.Register("Texture/Atlas mips 1K", 10, [getAtlas] {
+            TextureImage& image = getAtlas();
+            image.levels.resize(1);
+            Texture::GenerateMips(image);
+            Benchmark::DoNotOptimize(image.pixels.data());
+
+            static int runs = 0;
+            if (++runs == 1) {
+                // Every level must match the scalar filter of the level above exactly
+                std::vector<uint8_t> expected;
+                for (size_t level = 1; level < image.levels.size(); ++level) {
+                    const TextureImage::Level& src = image.levels[level - 1];
+                    const TextureImage::Level& dst = image.levels[level];
+                    expected.resize(static_cast<size_t>(dst.width) * dst.height * 4);
+                    BoxFilterLevel(image.pixels.data() + src.offset, src.width, src.height,
+                                   expected.data());
+                    ASSERT(std::memcmp(expected.data(), image.pixels.data() + dst.offset,
+                                       expected.size()) == 0 &&
+                           "Mip kernel differs from the scalar box filter");
+                }
+            }
+        });
+    }
+
+    void RegisterClusteredLightingBenchmarks(Benchmark& bench) {
+        // Lights scattered over a 500 m square around a 60 degree 16:9 camera
+        struct LightScene {
+            std::vector<PointLight> lights;
+            glm::mat4 view;
+            glm::mat4 projection;
+            LightClusterGrid grid;
+        };
+
+        auto makeScene = [](size_t count) {
+            auto scene = std::make_shared<LightScene>();
+            std::mt19937 rng(47);
+            std::uniform_real_distribution<float> horizontal(-250.0f, 250.0f);
+            std::uniform_real_distribution<float> height(0.0f, 60.0f);
+            std::uniform_real_distribution<float> radius(3.0f, 15.0f);
+            scene->lights.resize(count);
+            for (PointLight& light : scene->lights) {
+                light.position = {horizontal(rng), height(rng), horizontal(rng)};
+                light.radius = radius(rng);
+            }
+            scene->view = glm::lookAt(glm::vec3(0.0f, 20.0f, 0.0f),
+                                      glm::vec3(100.0f, 0.0f, 100.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+            scene->projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 500.0f);
+            scene->grid.SetProjection(scene->projection, 0.1f, 500.0f);
+            return scene;
+        };
+
+        auto registerCase = [&bench, makeScene](const std::string& name, size_t count) {
+            auto scene = makeScene(count);
+            bench.Register("Lighting/Cluster assign " + name, 20, [scene, name] {
+                LightClusterGrid& grid = scene->grid;
+                grid.Assign(scene->lights, scene->view);
+
+                static std::unordered_map<std::string, int> runs;
+                const int run = ++runs[name];
+                if (run == 1) {
+                    // Every cluster must list the lights the scalar test accepts, in light
+                    // order and clamped to the per-cluster limit
+                    const auto& clusters = grid.GetClusters();
+                    const auto& indices = grid.GetLightIndices();
+                    const uint32_t limit = grid.GetSettings().maxLightsPerCluster;
+                    bool valid = true;
+                    for (uint32_t c = 0; c < grid.GetClusterCount() && valid; ++c) {
+                        std::vector<uint32_t> expected;
+                        for (uint32_t i = 0; i < scene->lights.size(); ++i) {
+                            const glm::vec3 center = glm::vec3(
+                                scene->view * glm::vec4(scene->lights[i].position, 1.0f));
+                            if (grid.Intersects(c, center, scene->lights[i].radius)) {
+                                expected.push_back(i);
+                            }
+                        }
+                        if (expected.size() > limit) expected.resize(limit);
+                        valid = std::equal(expected.begin(), expected.end(),
+                                           indices.begin() + clusters[c].offset,
+                                           indices.begin() + clusters[c].offset +
+                                               clusters[c].count);
+                    }
+                    ASSERT(valid && "Clustered light assignment differs from the scalar test");
+                } else if (run == 2) {
+                    const LightClusterGrid::Statistics& stats = grid.GetStatistics();
+                    LOG_INFO_CONCAT("Cluster assign ", name, " - ", stats.indices,
+                                    " light references in ", stats.occupiedClusters, " of ",
+                                    grid.GetClusterCount(), " clusters, at most ",
+                                    stats.maxClusterLights, " per cluster, ",
+                                    stats.droppedIndices, " dropped");
+                }
+            });
+        };
+        registerCase("1K", 1000);
+        registerCase("10K", 10000);
+
+        // Uploads the 10K assignment and binds it for clustered_lit.frag on the recording
+        // backend. Never destroyed, like the headless render scene, since its objects carry
+        // recorded names
+        struct UploadScene {
+            RecordingRenderAPI api;
+            std::shared_ptr<LightScene> lights;
+            std::shared_ptr<Shader> shader;
+            ClusteredLightBuffers buffers;
+        };
+        auto getUploadScene = [makeScene]() -> UploadScene* {
+            static UploadScene* scene = nullptr;
+            static bool loaded = false;
+            if (!loaded) {
+                loaded = true;
+                std::ifstream vertexFile("assets/shaders/lit.vert");
+                std::ifstream fragmentFile("assets/shaders/clustered_lit.frag");
+                if (!vertexFile || !fragmentFile) {
+                    LOG_WARN("Clustered upload benchmark skipped: lit shaders not found");
+                    return nullptr;
+                }
+                std::stringstream vertexSource, fragmentSource;
+                vertexSource << vertexFile.rdbuf();
+                fragmentSource << fragmentFile.rdbuf();
+
+                scene = new UploadScene();
+                scene->lights = makeScene(10000);
+                scene->lights->grid.Assign(scene->lights->lights, scene->lights->view);
+                scene->api.Init();
+                scene->shader = Shader::CreateFromSource(vertexSource.str().c_str(),
+                                                         fragmentSource.str().c_str());
+                scene->buffers.Upload(scene->lights->lights, scene->lights->grid);
+                ASSERT(scene->api.CountCalls("glTexBuffer") == 3 &&
+                       "Clustered light buffers were not attached to their textures");
+                scene->api.Shutdown();
+            }
+            return scene;
+        };
+
+        bench.Register("Lighting/Cluster upload 10K headless", 50, [getUploadScene] {
+            UploadScene* scene = getUploadScene();
+            if (!scene) return;
+            scene->api.Init();
+            scene->api.ClearLog();
+            scene->buffers.Upload(scene->lights->lights, scene->lights->grid);
+            scene->shader->Bind();
+            scene->buffers.Bind(*scene->shader, glm::vec2(1920.0f, 1080.0f));
+
+            static bool checked = false;
+            if (!checked) {
+                // Refills orphan the existing buffers, and every sampler the shader declares
+                // is pointed at the units Bind() filled
+                checked = true;
+                std::vector<int> units;
+                for (const auto& call : scene->api.GetCalls()) {
+                    if (std::string_view(call.function) == "glUniform1i") {
+                        units.push_back(static_cast<int>(call.args[1]));
+                    }
+                }
+                bool resolved = true;
+                for (const char* name : {"u_LightData", "u_ClusterData", "u_LightIndices",
+                                         "u_ClusterTiles", "u_ClusterDepth", "u_ViewportSize"}) {
+                    resolved = resolved && scene->shader->GetUniformLocation(name) >= 0;
+                }
+                ASSERT(resolved && "clustered_lit.frag lacks a uniform ClusteredLightBuffers sets");
+                ASSERT(scene->api.CountCalls("glTexBuffer") == 0 &&
+                       scene->api.CountCalls("glBufferData") == 3 &&
+                       units == std::vector<int>({4, 5, 6}) &&
+                       "Clustered light buffers uploaded or bound unexpectedly");
+                LOG_INFO_CONCAT("Cluster upload 10K headless - ",
+                                scene->lights->grid.GetStatistics().indices, " light indices, ",
+                                scene->api.GetCalls().size(), " GL calls");
+            }
+            scene->api.Shutdown();
+        });
+    }
+
+    /**
+     * @brief Model matrices from position, rotation and scale, one at a time and batched
+     * @details The first batched run checks every matrix against Transform::GetModelMatrix(),
+     *          including all-zero scales and counts that leave a scalar remainder
+     */
+    void RegisterTransformBenchmarks(Benchmark& bench) {
+        struct Transforms {
+            std::vector<Transform> transforms;
+            std::vector<Transform::TransformData> data;
+            std::vector<float> positionX, positionY, positionZ;
+            std::vector<float> rotationX, rotationY, rotationZ, rotationW;
+            std::vector<float> scaleX, scaleY, scaleZ;
+            std::vector<glm::mat4> matrices;
+
+            TransformBatch::Input GetInput(size_t first = 0) const {
+                return {positionX.data() + first, positionY.data() + first,
+                        positionZ.data() + first, rotationX.data() + first,
+                        rotationY.data() + first, rotationZ.data() + first,
+                        rotationW.data() + first, scaleX.data() + first,
+                        scaleY.data() + first,    scaleZ.data() + first};
+            }
+        };
+
+        auto transforms = std::make_shared<Transforms>();
+        std::mt19937 rng(50);
+        std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+        std::uniform_real_distribution<float> angle(-360.0f, 360.0f);
+        std::uniform_real_distribution<float> scale(0.1f, 4.0f);
+        transforms->transforms.resize(TRANSFORM_BENCH_COUNT);
+        for (size_t i = 0; i < TRANSFORM_BENCH_COUNT; ++i) {
+            Transform& transform = transforms->transforms[i];
+            transform.SetPosition(position(rng), position(rng), position(rng));
+            transform.SetRotation(angle(rng), angle(rng), angle(rng));
+            transform.SetScale(i % 97 == 0 ? glm::vec3(0.0f)
+                                           : glm::vec3(scale(rng), scale(rng), scale(rng)));
+
+            const Transform::TransformData& data = transform.GetData();
+            transforms->data.push_back(data);
+            transforms->positionX.push_back(data.position.x);
+            transforms->positionY.push_back(data.position.y);
+            transforms->positionZ.push_back(data.position.z);
+            transforms->rotationX.push_back(data.rotation.x);
+            transforms->rotationY.push_back(data.rotation.y);
+            transforms->rotationZ.push_back(data.rotation.z);
+            transforms->rotationW.push_back(data.rotation.w);
+            transforms->scaleX.push_back(data.scale.x);
+            transforms->scaleY.push_back(data.scale.y);
+            transforms->scaleZ.push_back(data.scale.z);
+        }
+        transforms->matrices.resize(TRANSFORM_BENCH_COUNT);
+
+        // What the scene update did per object before the batch kernel
+        bench.Register("Transform/Model matrices scalar 100K", 20, [transforms] {
+            for (size_t i = 0; i < TRANSFORM_BENCH_COUNT; ++i) {
+                transforms->matrices[i] = Transform::ComputeModelMatrix(transforms->data[i]);
+            }
+            Benchmark::DoNotOptimize(transforms->matrices.data());
+        });
+
+        bench.Register("Transform/Model matrices batch 100K", 20, [transforms] {
+            static bool checked = false;
+            TransformBatch::ComputeModelMatrices(transforms->GetInput(), TRANSFORM_BENCH_COUNT,
+                                                 transforms->matrices.data());
+            Benchmark::DoNotOptimize(transforms->matrices.data());
+            if (checked) return;
+            checked = true;
+
+            // Also 13 from an odd offset: one step of each SIMD width plus a scalar tail
+            std::vector<glm::mat4> tail(13);
+            TransformBatch::ComputeModelMatrices(transforms->GetInput(3), tail.size(),
+                                                 tail.data());
+            float maxError = 0.0f;
+            auto compare = [&maxError](const glm::mat4& actual, const glm::mat4& expected) {
+                for (int c = 0; c < 4; ++c) {
+                    for (int r = 0; r < 4; ++r) {
+                        maxError = std::max(maxError, std::abs(actual[c][r] - expected[c][r]));
+                    }
+                }
+            };
+            for (size_t i = 0; i < TRANSFORM_BENCH_COUNT; ++i) {
+                compare(transforms->matrices[i], transforms->transforms[i].GetModelMatrix());
+            }
+            for (size_t i = 0; i < tail.size(); ++i) {
+                compare(tail[i], transforms->transforms[i + 3].GetModelMatrix());
+            }
+            ASSERT(maxError < 1e-4f && "Batched model matrices differ from GetModelMatrix");
+            LOG_INFO_CONCAT("Transform batch - ", TransformBatch::GetLaneCount(),
+                            " lanes, max error ", maxError);
+        });
+    }
+
+    template<typename Noise>
+    void RegisterHeightmapBenchmark(Benchmark& bench, const std::string& name) {
+        bench.Register("Noise/" + name + " heightmap 512x512", 10, [] {
+            static Noise noise(1234);
+            auto heightmap = noise.generateHeightmap(HEIGHTMAP_SIZE, HEIGHTMAP_SIZE, 4.0f);
+            Benchmark::DoNotOptimize(heightmap.data());
+        });
+    }
+}  // namespace
+
+void RegisterEngineBenchmarks() {
+    if (!TaskSystem::Get().IsInitialized()) {
+        TaskSystem::Get().Initialize();
+    }
+
+    auto& bench = Benchmark::Get();
+    RegisterTaskSystemBenchmarks(bench);
+    RegisterRenderSortBenchmarks(bench);
+    RegisterRenderSubmitBenchmarks(bench);
+    RegisterRenderContentionBenchmarks(bench);
+    RegisterRenderStateBenchmarks(bench);
+    RegisterMaterialBindBenchmarks(bench);
+    RegisterHeadlessRenderBenchmarks(bench);
+    RegisterRangeAllocatorBenchmarks(bench);
+    RegisterRenderer2DBenchmarks(bench);
+    RegisterSpriteSortBenchmarks(bench);
+    RegisterTextureLoadBenchmarks(bench);
+    RegisterTextureAtlasBenchmarks(bench);
+    RegisterClusteredLightingBenchmarks(bench);
+    RegisterTransformBenchmarks(bench);
+    RegisterHeightmapBenchmark<PerlinNoise>(bench, "Perlin");
+    RegisterHeightmapBenchmark<SimplexNoise>(bench, "Simplex");
+    RegisterHeightmapBenchmark<ValueNoise>(bench, "Value");
+    RegisterHeightmapBenchmark<VoidNoise>(bench, "Void");
+}
+
+}  // namespace Engine
@@ -7,6 +7,8 @@
  */
 
 #include "Application.h"
+#include "Debug/Benchmark.h"
+#include "Renderer/FrameCapture.h"
 #include <exception>
 #include <iostream>
 
@@ -14,6 +16,19 @@ extern Engine::Application* Engine::CreateApplication();
 
 int main(int argc, char** argv) {
     try {
+        // Headless benchmark run: sandbox --benchmark [filter]
+        if (argc > 1 && std::string(argv[1]) == "--benchmark") {
+            Engine::RegisterEngineBenchmarks();
+            Engine::Benchmark::Get().RunAll(argc > 2 ? argv[2] : "");
+            return 0;
+        }
+
+        // Headless replay of a frame capture: sandbox --replay <file> [iterations]
+        if (argc > 2 && std::string(argv[1]) == "--replay") {
+            const uint32_t iterations = argc > 3 ? static_cast<uint32_t>(std::stoul(argv[3])) : 1;
+            return Engine::FrameReplay::Run(argv[2], iterations);
+        }
+
         // Create application instance
         auto app = Engine::CreateApplication();
         if (!app) {
@@ -2,7 +2,6 @@
 
 #include <pch.h>
 #include "Event.h"
-#include "../Threading/ThreadPool.h"
 
 namespace Engine {
     /**
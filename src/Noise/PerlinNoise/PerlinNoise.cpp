@@ -1,6 +1,8 @@
 
 #include "PerlinNoise.h"
 
+#include "Core/TaskSystem.h"
+
 PerlinNoise::PerlinNoise(unsigned int seed) {
     // Initialize permutation table
     std::vector<int> perm(PERM_SIZE);
@@ -77,9 +79,12 @@ float PerlinNoise::noise(float x, float y) const {
 }
 
 std::vector<float> PerlinNoise::generateHeightmap(int width, int height, float scale) const {
+    PROFILE_FUNCTION();
     std::vector<float> heightmap(width * height);
 
-    for (int y = 0; y < height; y++) {
+    // Rows are independent, so generate them in parallel
+    Engine::TaskSystem::Get().ParallelFor(0, height, 0, [&](size_t row) {
+        const int y = static_cast<int>(row);
         for (int x = 0; x < width; x++) {
             float amplitude = 1.0f;
             float frequency = 1.0f;
@@ -99,7 +104,7 @@ std::vector<float> PerlinNoise::generateHeightmap(int width, int height, float s
 
             heightmap[y * width + x] = total / maxValue;
         }
-    }
+    });
 
     return heightmap;
 }
\ No newline at end of file
@@ -1,6 +1,8 @@
 #include <pch.h>
 #include "SimplexNoise.h"
 
+#include "Core/TaskSystem.h"
+
 // Initialize static constants
 const float SimplexNoise::F2 = 0.366025403784439f;  // (sqrt(3) - 1) / 2
 const float SimplexNoise::G2 = 0.211324865405187f;  // (3 - sqrt(3)) / 6
@@ -91,14 +93,17 @@ float SimplexNoise::noise(float x, float y) const {
 }
 
 std::vector<float> SimplexNoise::generateHeightmap(int width, int height, float scale) const {
+    PROFILE_FUNCTION();
     std::vector<float> heightmap(width * height);
     
-    for (int y = 0; y < height; y++) {
+    // Rows are independent, so generate them in parallel
+    Engine::TaskSystem::Get().ParallelFor(0, height, 0, [&](size_t row) {
+        const int y = static_cast<int>(row);
         for (int x = 0; x < width; x++) {
             float value = noise(x * scale, y * scale);
             heightmap[y * width + x] = (value + 1.0f) * 0.5f;
         }
-    }
+    });
     
     return heightmap;
 }
\ No newline at end of file
@@ -1,6 +1,8 @@
 #include <pch.h>
 #include "ValueNoise.h"
 
+#include "Core/TaskSystem.h"
+
 ValueNoise::ValueNoise(unsigned int seed) : m_Seed(seed) {
     // Initialize permutation table
     p.resize(PERMUTATION_SIZE);
@@ -45,13 +47,16 @@ float ValueNoise::noise(float x, float y) const {
 }
 
 std::vector<float> ValueNoise::generateHeightmap(int width, int height, float scale) const {
+    PROFILE_FUNCTION();
     std::vector<float> heightmap(width * height);
     
     const int OCTAVES = 6;
     const float PERSISTENCE = 0.5f;
     const float LACUNARITY = 2.0f;
 
-    for (int y = 0; y < height; y++) {
+    // Rows are independent, so generate them in parallel
+    Engine::TaskSystem::Get().ParallelFor(0, height, 0, [&](size_t row) {
+        const int y = static_cast<int>(row);
         for (int x = 0; x < width; x++) {
             float amplitude = 1.0f;
             float frequency = 1.0f;
@@ -71,7 +76,7 @@ std::vector<float> ValueNoise::generateHeightmap(int width, int height, float sc
 
             heightmap[y * width + x] = total / maxValue;
         }
-    }
+    });
     
     return heightmap;
 }
\ No newline at end of file
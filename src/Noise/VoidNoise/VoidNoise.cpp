@@ -1,6 +1,8 @@
 #include "Noise/VoidNoise/VoidNoise.h"
 #include <pch.h>
 
+#include "Core/TaskSystem.h"
+
 /**
  * @brief Initialize the Perlin noise generator
  * @param seed Random seed value for noise generation
@@ -90,12 +92,13 @@ float VoidNoise::noise(float x, float y) const {
     );
 
     // Debug output for first few calls
-    static int debugCount = 0;
-    if (debugCount < 5) {
+    // Atomic because heightmaps sample noise from several worker threads
+    static std::atomic<int> debugCount{0};
+    if (debugCount.load(std::memory_order_relaxed) < 5 &&
+        debugCount.fetch_add(1, std::memory_order_relaxed) < 5) {
         LOG_TRACE_CONCAT("VoidNoise - Input (",x,",",y,"):", 
                         " Corners: ", g00, ",", g10, ",", g01, ",", g11,
                         " Result: ", result);
-        debugCount++;
     }
 
     return result;
@@ -109,9 +112,12 @@ float VoidNoise::noise(float x, float y) const {
  * @return Vector containing heightmap values
  */
 std::vector<float> VoidNoise::generateHeightmap(int width, int height, float scale) const {
+    PROFILE_FUNCTION();
     std::vector<float> heightmap(width * height);
     
-    for (int y = 0; y < height; ++y) {
+    // Rows are independent, so generate them in parallel
+    Engine::TaskSystem::Get().ParallelFor(0, height, 0, [&](size_t row) {
+        const int y = static_cast<int>(row);
         for (int x = 0; x < width; ++x) {
             float nx = static_cast<float>(x) * scale / width;
             float ny = static_cast<float>(y) * scale / height;
@@ -137,7 +143,7 @@ std::vector<float> VoidNoise::generateHeightmap(int width, int height, float sca
                 LOG_TRACE_CONCAT("Heightmap value at (", x, ",", y, "): ", heightmap[y * width + x]);
             }
         }
-    }
+    });
     
     return heightmap;
 }
\ No newline at end of file
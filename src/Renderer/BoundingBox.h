@@ -0,0 +1,55 @@
+#pragma once
+#include <pch.h>
+
+#include "Buffer.h"
+
+namespace Engine {
+    /**
+     * @brief Axis-aligned bounding box in the space of its mesh
+     */
+    struct AABB {
+        glm::vec3 min = glm::vec3(std::numeric_limits<float>::max());
+        glm::vec3 max = glm::vec3(std::numeric_limits<float>::lowest());
+
+        /** @return false for a default-constructed box that encloses nothing */
+        bool IsValid() const { return min.x <= max.x && min.y <= max.y && min.z <= max.z; }
+
+        glm::vec3 GetCenter() const { return (min + max) * 0.5f; }
+        glm::vec3 GetExtents() const { return (max - min) * 0.5f; }
+
+        /** @brief Grows the box to enclose a point */
+        void Expand(const glm::vec3& point) {
+            min = glm::vec3(std::min(min.x, point.x), std::min(min.y, point.y),
+                            std::min(min.z, point.z));
+            max = glm::vec3(std::max(max.x, point.x), std::max(max.y, point.y),
+                            std::max(max.z, point.z));
+        }
+
+        /**
+         * @brief Computes the bounds of interleaved vertex data
+         * @param vertices Vertex data as uploaded to the vertex buffer
+         * @param size Size of the data in bytes
+         * @param layout Layout of the data; the first Float3 element is the position
+         * @return Bounds of all positions, or an invalid box if the layout has no Float3
+         */
+        static AABB FromVertices(const float* vertices, uint32_t size, const BufferLayout& layout) {
+            AABB bounds;
+            const BufferElement* position = nullptr;
+            for (const auto& element : layout) {
+                if (element.Type == ShaderDataType::Float3) {
+                    position = &element;
+                    break;
+                }
+            }
+            if (!position || layout.GetStride() == 0) return bounds;
+
+            const uint32_t strideFloats = layout.GetStride() / sizeof(float);
+            const uint32_t offsetFloats = position->Offset / sizeof(float);
+            const uint32_t floatCount = size / sizeof(float);
+            for (uint32_t i = offsetFloats; i + 2 < floatCount; i += strideFloats) {
+                bounds.Expand(glm::vec3(vertices[i], vertices[i + 1], vertices[i + 2]));
+            }
+            return bounds;
+        }
+    };
+}
@@ -94,6 +94,10 @@ namespace Engine {
             : m_Elements(elements) {
             CalculateOffsetsAndStride();
         }
+        explicit BufferLayout(std::vector<BufferElement> elements)
+            : m_Elements(std::move(elements)) {
+            CalculateOffsetsAndStride();
+        }
 
         uint32_t GetStride() const { return m_Stride; }
         const std::vector<BufferElement>& GetElements() const { return m_Elements; }
@@ -119,6 +123,27 @@ namespace Engine {
         uint32_t m_Stride = 0;
     };
 
+    /**
+     * @brief Hashes buffer contents so captures can identify them without storing them
+     * @details 64-bit FNV-1a over 8-byte words with a final avalanche; cheap next
+     *          to the upload it accompanies
+     */
+    inline uint64_t HashBufferContents(const void* data, size_t size) {
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        uint64_t hash = 0xcbf29ce484222325ull ^ size;
+        size_t i = 0;
+        for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+            uint64_t word;
+            std::memcpy(&word, bytes + i, sizeof(word));
+            hash = (hash ^ word) * 0x100000001b3ull;
+        }
+        for (; i < size; ++i) hash = (hash ^ bytes[i]) * 0x100000001b3ull;
+        hash ^= hash >> 33;
+        hash *= 0xff51afd7ed558ccdull;
+        hash ^= hash >> 33;
+        return hash;
+    }
+
     /**
      * @brief Abstract vertex buffer interface
      */
@@ -132,7 +157,33 @@ namespace Engine {
         virtual void SetLayout(const BufferLayout& layout) = 0;
         virtual const BufferLayout& GetLayout() const = 0;
 
+        /**
+         * @brief Overwrites part of the buffer
+         * @param data New contents
+         * @param offset Destination in bytes
+         * @param size Bytes to write; offset + size must not exceed GetSize()
+         */
+        virtual void SetData(const void* data, uint32_t offset, uint32_t size) = 0;
+
+        /**
+         * @brief Gives the buffer fresh storage and writes data to its start
+         * @details Orphaning lets the driver keep the old storage for draws still
+         *          reading it, so per-frame streaming never waits on the GPU. The
+         *          contents are not hashed; each call just changes GetContentHash().
+         * @param size Bytes to write; must not exceed GetSize()
+         */
+        virtual void Orphan(const void* data, uint32_t size) = 0;
+
+        /** @return Size of the uploaded data in bytes */
+        uint32_t GetSize() const { return m_Size; }
+        /** @return Hash of the uploaded data; SetData() folds in the hash of each update */
+        uint64_t GetContentHash() const { return m_ContentHash; }
+
         static VertexBuffer* Create(const float* vertices, uint32_t size);
+
+    protected:
+        uint32_t m_Size = 0;         ///< Uploaded bytes
+        uint64_t m_ContentHash = 0;  ///< Hash of the uploaded bytes
     };
 
     /**
@@ -147,6 +198,20 @@ namespace Engine {
         
         virtual uint32_t GetCount() const = 0;
 
+        /**
+         * @brief Overwrites part of the buffer
+         * @param indices New indices
+         * @param firstIndex Destination in indices
+         * @param count Indices to write; firstIndex + count must not exceed GetCount()
+         */
+        virtual void SetData(const uint32_t* indices, uint32_t firstIndex, uint32_t count) = 0;
+
+        /** @return Hash of the uploaded indices; SetData() folds in the hash of each update */
+        uint64_t GetContentHash() const { return m_ContentHash; }
+
         static IndexBuffer* Create(const uint32_t* indices, uint32_t count);
+
+    protected:
+        uint64_t m_ContentHash = 0;  ///< Hash of the uploaded indices
     };
 }
\ No newline at end of file
@@ -0,0 +1,344 @@
+/**
+ * @file ClusteredLighting.cpp
+ * @brief Froxel light binning with SSE sphere tests, and its texture buffer upload
+ */
+#include "ClusteredLighting.h"
+
+#include <cfloat>
+#include <glad/glad.h>
+
+#include "../Core/TaskSystem.h"
+#include "../Shader/Shader.h"
+#include "RenderState.h"
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+    #include <xmmintrin.h>
+    #define ENGINE_CLUSTERED_LIGHTING_SSE 1
+#endif
+
+namespace Engine {
+    namespace {
+        constexpr size_t LANES = 4;
+        /** @brief Coordinate of padding spheres; far enough to miss every cluster */
+        constexpr float FAR_AWAY = 1e18f;
+
+        static_assert(sizeof(PointLight) == 8 * sizeof(float),
+                      "PointLight must match the two RGBA32F texels of u_LightData");
+
+        float BoxDistanceSquared(float point, float center, float extent) {
+            const float distance = std::max(std::abs(point - center) - extent, 0.0f);
+            return distance * distance;
+        }
+    }
+
+    void LightClusterGrid::Spheres::Clear() {
+        x.clear();
+        y.clear();
+        z.clear();
+        radius.clear();
+        lights.clear();
+        count = 0;
+    }
+
+    void LightClusterGrid::Spheres::Push(float px, float py, float pz, float r, uint32_t light) {
+        x.push_back(px);
+        y.push_back(py);
+        z.push_back(pz);
+        radius.push_back(r);
+        lights.push_back(light);
+        ++count;
+    }
+
+    void LightClusterGrid::Spheres::Pad() {
+        while (x.size() % LANES != 0) {
+            x.push_back(FAR_AWAY);
+            y.push_back(FAR_AWAY);
+            z.push_back(FAR_AWAY);
+            radius.push_back(0.0f);
+            lights.push_back(0);
+        }
+    }
+
+    LightClusterGrid::LightClusterGrid(const LightClusterSettings& settings)
+        : m_Settings(settings) {
+        ASSERT(settings.tilesX > 0 && settings.tilesY > 0 && settings.depthSlices > 0 &&
+               "Light cluster grid needs at least one cluster");
+        m_Clusters.resize(GetClusterCount());
+        m_Scratch.resize(settings.depthSlices);
+    }
+
+    void LightClusterGrid::SetProjection(const glm::mat4& projection, float nearPlane,
+                                         float farPlane) {
+        if (projection == m_Projection && nearPlane == m_Near && farPlane == m_Far) return;
+        ASSERT(nearPlane > 0.0f && farPlane > nearPlane && "Invalid cluster depth range");
+        PROFILE_FUNCTION();
+        m_Projection = projection;
+        m_Near = nearPlane;
+        m_Far = farPlane;
+
+        // Point of a tile corner's view ray at a given depth
+        const glm::mat4 inverse = glm::inverse(projection);
+        auto corner = [&inverse](float ndcX, float ndcY, float depth) {
+            const glm::vec4 point = inverse * glm::vec4(ndcX, ndcY, -1.0f, 1.0f);
+            const glm::vec3 ray = glm::vec3(point) / point.w;
+            return ray * (depth / -ray.z);
+        };
+        auto toBounds = [](const glm::vec3& min, const glm::vec3& max) {
+            return Bounds{(min + max) * 0.5f, (max - min) * 0.5f};
+        };
+
+        const LightClusterSettings& grid = m_Settings;
+        m_ClusterBounds.resize(GetClusterCount());
+        m_RowBounds.resize(static_cast<size_t>(grid.depthSlices) * grid.tilesY);
+        m_SliceBounds.resize(grid.depthSlices);
+        const float ratio = farPlane / nearPlane;
+        for (uint32_t slice = 0; slice < grid.depthSlices; ++slice) {
+            const float depths[2] = {
+                nearPlane * std::pow(ratio, static_cast<float>(slice) / grid.depthSlices),
+                nearPlane * std::pow(ratio, static_cast<float>(slice + 1) / grid.depthSlices)};
+            glm::vec3 sliceMin(FLT_MAX), sliceMax(-FLT_MAX);
+            for (uint32_t y = 0; y < grid.tilesY; ++y) {
+                glm::vec3 rowMin(FLT_MAX), rowMax(-FLT_MAX);
+                for (uint32_t x = 0; x < grid.tilesX; ++x) {
+                    glm::vec3 min(FLT_MAX), max(-FLT_MAX);
+                    for (uint32_t i = 0; i < 8; ++i) {
+                        const float ndcX = -1.0f + 2.0f * (x + (i & 1)) / grid.tilesX;
+                        const float ndcY = -1.0f + 2.0f * (y + ((i >> 1) & 1)) / grid.tilesY;
+                        const glm::vec3 point = corner(ndcX, ndcY, depths[i >> 2]);
+                        min = glm::min(min, point);
+                        max = glm::max(max, point);
+                    }
+                    m_ClusterBounds[GetClusterIndex(x, y, slice)] = toBounds(min, max);
+                    rowMin = glm::min(rowMin, min);
+                    rowMax = glm::max(rowMax, max);
+                }
+                m_RowBounds[slice * grid.tilesY + y] = toBounds(rowMin, rowMax);
+                sliceMin = glm::min(sliceMin, rowMin);
+                sliceMax = glm::max(sliceMax, rowMax);
+            }
+            m_SliceBounds[slice] = toBounds(sliceMin, sliceMax);
+        }
+    }
+
+    uint32_t LightClusterGrid::GetDepthSlice(float depth) const {
+        const glm::vec2 parameters = GetDepthSliceParameters();
+        const float slice = std::floor(std::log(std::max(depth, m_Near)) * parameters.x +
+                                       parameters.y);
+        return std::min(static_cast<uint32_t>(std::max(slice, 0.0f)),
+                        m_Settings.depthSlices - 1);
+    }
+
+    glm::vec2 LightClusterGrid::GetDepthSliceParameters() const {
+        const float scale = m_Settings.depthSlices / std::log(m_Far / m_Near);
+        return {scale, -std::log(m_Near) * scale};
+    }
+
+    bool LightClusterGrid::Intersects(uint32_t cluster, const glm::vec3& center,
+                                      float radius) const {
+        const Bounds& box = m_ClusterBounds[cluster];
+        const float distance = BoxDistanceSquared(center.x, box.center.x, box.extents.x) +
+                               BoxDistanceSquared(center.y, box.center.y, box.extents.y) +
+                               BoxDistanceSquared(center.z, box.center.z, box.extents.z);
+        return distance <= radius * radius;
+    }
+
+#ifdef ENGINE_CLUSTERED_LIGHTING_SSE
+    void LightClusterGrid::Select(const Spheres& source, const Bounds& box, Spheres& target) {
+        target.Clear();
+        const __m128 sign = _mm_set1_ps(-0.0f);
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 centerX = _mm_set1_ps(box.center.x);
+        const __m128 centerY = _mm_set1_ps(box.center.y);
+        const __m128 centerZ = _mm_set1_ps(box.center.z);
+        const __m128 extentX = _mm_set1_ps(box.extents.x);
+        const __m128 extentY = _mm_set1_ps(box.extents.y);
+        const __m128 extentZ = _mm_set1_ps(box.extents.z);
+
+        for (size_t i = 0; i < source.count; i += LANES) {
+            // Per-axis distance from the box: max(|p - c| - e, 0)
+            const __m128 dx = _mm_max_ps(
+                _mm_sub_ps(_mm_andnot_ps(sign, _mm_sub_ps(_mm_loadu_ps(&source.x[i]), centerX)),
+                           extentX),
+                zero);
+            const __m128 dy = _mm_max_ps(
+                _mm_sub_ps(_mm_andnot_ps(sign, _mm_sub_ps(_mm_loadu_ps(&source.y[i]), centerY)),
+                           extentY),
+                zero);
+            const __m128 dz = _mm_max_ps(
+                _mm_sub_ps(_mm_andnot_ps(sign, _mm_sub_ps(_mm_loadu_ps(&source.z[i]), centerZ)),
+                           extentZ),
+                zero);
+            const __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)),
+                                               _mm_mul_ps(dz, dz));
+            const __m128 radius = _mm_loadu_ps(&source.radius[i]);
+            const int mask = _mm_movemask_ps(_mm_cmple_ps(distance, _mm_mul_ps(radius, radius)));
+            if (mask == 0) continue;
+            for (size_t lane = 0; lane < LANES; ++lane) {
+                if (mask & (1 << lane)) {
+                    target.Push(source.x[i + lane], source.y[i + lane], source.z[i + lane],
+                                source.radius[i + lane], source.lights[i + lane]);
+                }
+            }
+        }
+        target.Pad();
+    }
+#else
+    void LightClusterGrid::Select(const Spheres& source, const Bounds& box, Spheres& target) {
+        target.Clear();
+        for (size_t i = 0; i < source.count; ++i) {
+            const float distance = BoxDistanceSquared(source.x[i], box.center.x, box.extents.x) +
+                                   BoxDistanceSquared(source.y[i], box.center.y, box.extents.y) +
+                                   BoxDistanceSquared(source.z[i], box.center.z, box.extents.z);
+            if (distance <= source.radius[i] * source.radius[i]) {
+                target.Push(source.x[i], source.y[i], source.z[i], source.radius[i],
+                            source.lights[i]);
+            }
+        }
+        target.Pad();
+    }
+#endif
+
+    void LightClusterGrid::Assign(const PointLight* lights, size_t count, const glm::mat4& view) {
+        PROFILE_FUNCTION();
+        ASSERT(m_Far > m_Near && "SetProjection() must be called before Assign()");
+        ASSERT(count <= UINT32_MAX && "Too many lights");
+
+        m_ViewLights.Clear();
+        for (size_t i = 0; i < count; ++i) {
+            const glm::vec4 position = view * glm::vec4(lights[i].position, 1.0f);
+            m_ViewLights.Push(position.x, position.y, position.z, lights[i].radius,
+                              static_cast<uint32_t>(i));
+        }
+        m_ViewLights.Pad();
+
+        TaskSystem::Get().ParallelFor(0, m_Settings.depthSlices, 1, [this](size_t slice) {
+            AssignSlice(static_cast<uint32_t>(slice));
+        });
+
+        // Concatenate the slices' index lists and rebase their cluster offsets
+        size_t total = 0;
+        for (const SliceScratch& scratch : m_Scratch) total += scratch.indices.size();
+        m_LightIndices.resize(total);
+
+        m_Statistics = Statistics();
+        m_Statistics.lights = static_cast<uint32_t>(count);
+        m_Statistics.indices = static_cast<uint32_t>(total);
+        const uint32_t clustersPerSlice = m_Settings.tilesX * m_Settings.tilesY;
+        uint32_t base = 0;
+        for (uint32_t slice = 0; slice < m_Settings.depthSlices; ++slice) {
+            const SliceScratch& scratch = m_Scratch[slice];
+            std::copy(scratch.indices.begin(), scratch.indices.end(),
+                      m_LightIndices.begin() + base);
+            for (uint32_t i = 0; i < clustersPerSlice; ++i) {
+                Cluster& cluster = m_Clusters[slice * clustersPerSlice + i];
+                cluster.offset += base;
+                m_Statistics.occupiedClusters += cluster.count > 0;
+            }
+            base += static_cast<uint32_t>(scratch.indices.size());
+            m_Statistics.maxClusterLights =
+                std::max(m_Statistics.maxClusterLights, scratch.maxClusterLights);
+            m_Statistics.droppedIndices += scratch.droppedIndices;
+        }
+    }
+
+    void LightClusterGrid::AssignSlice(uint32_t slice) {
+        SliceScratch& scratch = m_Scratch[slice];
+        scratch.indices.clear();
+        scratch.maxClusterLights = 0;
+        scratch.droppedIndices = 0;
+
+        Select(m_ViewLights, m_SliceBounds[slice], scratch.slice);
+        for (uint32_t y = 0; y < m_Settings.tilesY; ++y) {
+            if (scratch.slice.count > 0) {
+                Select(scratch.slice, m_RowBounds[slice * m_Settings.tilesY + y], scratch.row);
+            } else {
+                scratch.row.Clear();
+            }
+            for (uint32_t x = 0; x < m_Settings.tilesX; ++x) {
+                const uint32_t index = GetClusterIndex(x, y, slice);
+                Cluster& cluster = m_Clusters[index];
+                cluster.offset = static_cast<uint32_t>(scratch.indices.size());
+                if (scratch.row.count == 0) {
+                    cluster.count = 0;
+                    continue;
+                }
+
+                Select(scratch.row, m_ClusterBounds[index], scratch.cluster);
+                const uint32_t found = static_cast<uint32_t>(scratch.cluster.count);
+                cluster.count = std::min(found, m_Settings.maxLightsPerCluster);
+                scratch.indices.insert(scratch.indices.end(), scratch.cluster.lights.begin(),
+                                       scratch.cluster.lights.begin() + cluster.count);
+                scratch.maxClusterLights = std::max(scratch.maxClusterLights, found);
+                scratch.droppedIndices += found - cluster.count;
+            }
+        }
+    }
+
+    ClusteredLightBuffers::~ClusteredLightBuffers() {
+        Release(m_Lights);
+        Release(m_Clusters);
+        Release(m_Indices);
+    }
+
+    void ClusteredLightBuffers::Upload(const std::vector<PointLight>& lights,
+                                       const LightClusterGrid& grid) {
+        PROFILE_FUNCTION();
+        Write(m_Lights, GL_RGBA32F, lights.data(), lights.size() * sizeof(PointLight));
+        Write(m_Clusters, GL_RG32UI, grid.GetClusters().data(),
+              grid.GetClusters().size() * sizeof(LightClusterGrid::Cluster));
+        Write(m_Indices, GL_R32UI, grid.GetLightIndices().data(),
+              grid.GetLightIndices().size() * sizeof(uint32_t));
+        m_Settings = grid.GetSettings();
+        m_DepthSlice = grid.GetDepthSliceParameters();
+    }
+
+    void ClusteredLightBuffers::Bind(Shader& shader, const glm::vec2& viewportSize,
+                                     uint32_t firstUnit) const {
+        RenderState& state = RenderState::Get();
+        state.BindTexture(firstUnit, GL_TEXTURE_BUFFER, m_Lights.texture);
+        state.BindTexture(firstUnit + 1, GL_TEXTURE_BUFFER, m_Clusters.texture);
+        state.BindTexture(firstUnit + 2, GL_TEXTURE_BUFFER, m_Indices.texture);
+        shader.SetInt("u_LightData", static_cast<int>(firstUnit));
+        shader.SetInt("u_ClusterData", static_cast<int>(firstUnit + 1));
+        shader.SetInt("u_LightIndices", static_cast<int>(firstUnit + 2));
+        shader.SetVector3("u_ClusterTiles", glm::vec3(m_Settings.tilesX, m_Settings.tilesY,
+                                                      m_Settings.depthSlices));
+        shader.SetVector2("u_ClusterDepth", m_DepthSlice);
+        shader.SetVector2("u_ViewportSize", viewportSize);
+    }
+
+    void ClusteredLightBuffers::Write(TextureBuffer& target, uint32_t format, const void* data,
+                                      size_t size) {
+        RenderState& state = RenderState::Get();
+        const bool created = target.buffer == 0;
+        if (created) {
+            glGenBuffers(1, &target.buffer);
+            glGenTextures(1, &target.texture);
+        }
+
+        // Orphan every frame; grow geometrically so the store is rarely reallocated larger
+        state.BindBuffer(GL_TEXTURE_BUFFER, target.buffer);
+        if (size > target.capacity) target.capacity = std::max(size, target.capacity * 2);
+        target.capacity = std::max<size_t>(target.capacity, 16);
+        glBufferData(GL_TEXTURE_BUFFER, static_cast<GLsizeiptr>(target.capacity), nullptr,
+                     GL_STREAM_DRAW);
+        if (size > 0) glBufferSubData(GL_TEXTURE_BUFFER, 0, static_cast<GLsizeiptr>(size), data);
+
+        if (created) {
+            state.BindTexture(0, GL_TEXTURE_BUFFER, target.texture);
+            glTexBuffer(GL_TEXTURE_BUFFER, format, target.buffer);
+        }
+    }
+
+    void ClusteredLightBuffers::Release(TextureBuffer& target) {
+        if (target.texture) {
+            RenderState::Get().OnTextureDeleted(target.texture);
+            glDeleteTextures(1, &target.texture);
+        }
+        if (target.buffer) {
+            RenderState::Get().OnBufferDeleted(target.buffer);
+            glDeleteBuffers(1, &target.buffer);
+        }
+        target = TextureBuffer();
+    }
+}
@@ -0,0 +1,191 @@
+#pragma once
+#include <pch.h>
+
+#include "Light.h"
+
+namespace Engine {
+    class Shader;
+
+    /** @brief Froxel grid dimensions of a LightClusterGrid */
+    struct LightClusterSettings {
+        uint32_t tilesX = 16;                ///< Screen-space columns
+        uint32_t tilesY = 9;                 ///< Screen-space rows
+        uint32_t depthSlices = 24;           ///< Exponentially spaced view depth slices
+        uint32_t maxLightsPerCluster = 256;  ///< Further lights of a cluster are dropped
+    };
+
+    /**
+     * @brief Per-frame binning of point lights into a view-space froxel grid
+     *
+     * The view frustum is split into tilesX x tilesY screen tiles and
+     * depthSlices exponentially spaced depth slices; each cluster is bounded by
+     * the view-space AABB of its frustum piece, which only changes with the
+     * projection. Assign() transforms the light spheres to view space and
+     * narrows them hierarchically: lights touching a depth slice, then a row
+     * of that slice, then each cluster of the row. Every level tests four
+     * spheres at a time against a box with SSE (scalar otherwise), and
+     * slices are processed in parallel on the TaskSystem.
+     *
+     * The result is one {offset, count} per cluster into a flat list of light
+     * indices, which ClusteredLightBuffers uploads for the clustered shader.
+     * Clusters are indexed x + tilesX * (y + tilesY * slice), with tile (0, 0)
+     * at the bottom left of the screen.
+     */
+    class LightClusterGrid {
+    public:
+        /** @brief Range of a cluster's lights in GetLightIndices() */
+        struct Cluster {
+            uint32_t offset = 0;
+            uint32_t count = 0;
+        };
+
+        /** @brief Totals of the last Assign() */
+        struct Statistics {
+            uint32_t lights = 0;             ///< Lights passed in
+            uint32_t indices = 0;            ///< Light references across all clusters
+            uint32_t occupiedClusters = 0;   ///< Clusters with at least one light
+            uint32_t maxClusterLights = 0;   ///< Largest cluster, before clamping
+            uint32_t droppedIndices = 0;     ///< References beyond maxLightsPerCluster
+        };
+
+        explicit LightClusterGrid(const LightClusterSettings& settings = LightClusterSettings());
+
+        /**
+         * @brief Rebuilds the cluster bounds for a perspective projection
+         * @details Cheap to call every frame; the bounds are only rebuilt when
+         *          the projection or depth range changes
+         */
+        void SetProjection(const glm::mat4& projection, float nearPlane, float farPlane);
+
+        /**
+         * @brief Bins lights into the clusters they overlap
+         * @param lights World-space lights; indices refer to this array
+         * @param count Number of lights
+         * @param view World-to-view matrix of the frame
+         */
+        void Assign(const PointLight* lights, size_t count, const glm::mat4& view);
+        void Assign(const std::vector<PointLight>& lights, const glm::mat4& view) {
+            Assign(lights.data(), lights.size(), view);
+        }
+
+        /**
+         * @brief Exact scalar sphere test against one cluster's bounds
+         * @param cluster Cluster index
+         * @param center View-space centre of the sphere
+         */
+        bool Intersects(uint32_t cluster, const glm::vec3& center, float radius) const;
+
+        uint32_t GetClusterIndex(uint32_t x, uint32_t y, uint32_t slice) const {
+            return x + m_Settings.tilesX * (y + m_Settings.tilesY * slice);
+        }
+        uint32_t GetClusterCount() const {
+            return m_Settings.tilesX * m_Settings.tilesY * m_Settings.depthSlices;
+        }
+        /** @return Slice of a positive view depth; the shader uses the same formula */
+        uint32_t GetDepthSlice(float depth) const;
+        /** @return Scale and bias turning log(depth) into a slice, as u_ClusterDepth */
+        glm::vec2 GetDepthSliceParameters() const;
+
+        const LightClusterSettings& GetSettings() const { return m_Settings; }
+        const std::vector<Cluster>& GetClusters() const { return m_Clusters; }
+        const std::vector<uint32_t>& GetLightIndices() const { return m_LightIndices; }
+        const Statistics& GetStatistics() const { return m_Statistics; }
+
+    private:
+        /** @brief View-space box as centre and half-extents */
+        struct Bounds {
+            glm::vec3 center;
+            glm::vec3 extents;
+        };
+
+        /** @brief View-space spheres in structure-of-arrays form, padded to four lanes */
+        struct Spheres {
+            std::vector<float> x, y, z, radius;
+            std::vector<uint32_t> lights;    ///< Index of each sphere's light
+            size_t count = 0;
+
+            /** @brief Empties the arrays, keeping their capacity */
+            void Clear();
+            void Push(float px, float py, float pz, float r, uint32_t light);
+            /** @brief Fills the last group of four with spheres that intersect nothing */
+            void Pad();
+        };
+
+        /** @brief Per-slice working set, reused across frames */
+        struct SliceScratch {
+            Spheres slice;                   ///< Lights touching the slice
+            Spheres row;                     ///< Of those, lights touching the current row
+            Spheres cluster;                 ///< Of those, lights touching the current cluster
+            std::vector<uint32_t> indices;   ///< Light indices of the slice's clusters
+            uint32_t maxClusterLights = 0;
+            uint32_t droppedIndices = 0;
+        };
+
+        /** @brief Copies the spheres of `source` that intersect a box into `target` */
+        static void Select(const Spheres& source, const Bounds& box, Spheres& target);
+        void AssignSlice(uint32_t slice);
+
+        LightClusterSettings m_Settings;
+        glm::mat4 m_Projection{0.0f};
+        float m_Near = 0.0f;
+        float m_Far = 0.0f;
+
+        std::vector<Bounds> m_ClusterBounds;
+        std::vector<Bounds> m_RowBounds;     ///< Per slice and row, union of its clusters
+        std::vector<Bounds> m_SliceBounds;
+
+        Spheres m_ViewLights;
+        std::vector<SliceScratch> m_Scratch;
+        std::vector<Cluster> m_Clusters;
+        std::vector<uint32_t> m_LightIndices;
+        Statistics m_Statistics;
+    };
+
+    /**
+     * @brief GPU copies of the lights and a LightClusterGrid, as texture buffers
+     *
+     * Three buffer textures, since the GL 3.3 context has no storage buffers:
+     * u_LightData (RGBA32F, two texels per PointLight), u_ClusterData (RG32UI,
+     * offset and count per cluster) and u_LightIndices (R32UI). Buffers are
+     * orphaned on every Upload() like InstanceBuffer. See clustered_lit.frag.
+     */
+    class ClusteredLightBuffers {
+    public:
+        /** @brief Texture units Bind() occupies, starting at its first unit */
+        static constexpr uint32_t TEXTURE_UNITS = 3;
+
+        ClusteredLightBuffers() = default;
+        ~ClusteredLightBuffers();
+
+        ClusteredLightBuffers(const ClusteredLightBuffers&) = delete;
+        ClusteredLightBuffers& operator=(const ClusteredLightBuffers&) = delete;
+
+        /** @brief Uploads the lights and the grid's last assignment */
+        void Upload(const std::vector<PointLight>& lights, const LightClusterGrid& grid);
+
+        /**
+         * @brief Binds the buffers and sets the clustered shader's uniforms
+         * @param shader Bound shader declaring the clustered lighting uniforms
+         * @param viewportSize Framebuffer size in pixels, for the tile lookup
+         * @param firstUnit First of TEXTURE_UNITS consecutive texture units
+         */
+        void Bind(Shader& shader, const glm::vec2& viewportSize, uint32_t firstUnit = 4) const;
+
+    private:
+        struct TextureBuffer {
+            uint32_t buffer = 0;
+            uint32_t texture = 0;
+            size_t capacity = 0;             ///< Bytes
+        };
+
+        /** @brief Orphans and refills a buffer, creating or growing it as needed */
+        static void Write(TextureBuffer& target, uint32_t format, const void* data, size_t size);
+        static void Release(TextureBuffer& target);
+
+        TextureBuffer m_Lights;
+        TextureBuffer m_Clusters;
+        TextureBuffer m_Indices;
+        LightClusterSettings m_Settings;
+        glm::vec2 m_DepthSlice{0.0f};
+    };
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include <pch.h>
+
+namespace Engine {
+    /**
+     * @brief Keeps GPU resources alive until the frames that may draw them are done
+     *
+     * Render commands hold raw VertexArray and Material pointers, so an object
+     * that drops its mesh or material must not destroy it while a recorded
+     * command list still refers to it. Owners hand the old reference to
+     * Retire() instead; it is released after FRAMES_IN_FLIGHT calls to EndFrame().
+     */
+    class DeferredRelease {
+    public:
+        /** @brief Frames a retired resource outlives: the recorded and the drawn list */
+        static constexpr size_t FRAMES_IN_FLIGHT = 2;
+
+        /**
+         * @return Reference to the singleton instance
+         * @note Intentionally never destroyed: scene objects retire resources from
+         *       static destructors, after the GL context is gone
+         */
+        static DeferredRelease& Get() {
+            static DeferredRelease* instance = new DeferredRelease();
+            return *instance;
+        }
+
+        /**
+         * @brief Defers dropping a reference until the in-flight frames have been drawn
+         * @param resource Reference to release; null is ignored. Thread-safe.
+         */
+        template<typename T>
+        void Retire(std::shared_ptr<T> resource) {
+            if (!resource) return;
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Frames[m_CurrentFrame].push_back(std::move(resource));
+        }
+
+        /**
+         * @brief Advances one frame, releasing resources retired FRAMES_IN_FLIGHT frames ago
+         * @details Call on the main thread once the frame's command list was drawn
+         */
+        void EndFrame() {
+            std::vector<std::shared_ptr<void>> expired;
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                m_CurrentFrame = (m_CurrentFrame + 1) % FRAMES_IN_FLIGHT;
+                expired.swap(m_Frames[m_CurrentFrame]);
+            }
+            // Destroy outside the lock; destructors may retire further resources
+            expired.clear();
+        }
+
+        /** @brief Releases everything immediately; call at shutdown while the context exists */
+        void ReleaseAll() {
+            for (size_t i = 0; i < FRAMES_IN_FLIGHT; ++i) EndFrame();
+        }
+
+    private:
+        DeferredRelease() = default;
+
+        std::mutex m_Mutex;
+        std::array<std::vector<std::shared_ptr<void>>, FRAMES_IN_FLIGHT> m_Frames;
+        size_t m_CurrentFrame = 0;
+    };
+}
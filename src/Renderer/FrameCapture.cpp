@@ -0,0 +1,671 @@
+/**
+ * @file FrameCapture.cpp
+ * @brief Capture of renderer submissions to a binary file and their replay
+ */
+#include "FrameCapture.h"
+
+#include <fstream>
+
+#include "InstanceBuffer.h"
+#include "RecordingRenderAPI.h"
+#include "RenderAPI.h"
+#include "Renderer.h"
+#include "Texture.h"
+#include "VertexArray.h"
+
+namespace Engine {
+    namespace {
+        /** @brief Appends values in host byte order to a byte vector */
+        class BinaryWriter {
+        public:
+            explicit BinaryWriter(std::vector<uint8_t>& out) : m_Out(out) {}
+
+            template <typename T>
+            void Write(const T& value) {
+                static_assert(std::is_trivially_copyable_v<T>, "Only plain values are written");
+                const auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+                m_Out.insert(m_Out.end(), bytes, bytes + sizeof(T));
+            }
+
+            void WriteString(const std::string& value) {
+                Write(static_cast<uint16_t>(value.size()));
+                m_Out.insert(m_Out.end(), value.begin(), value.end());
+            }
+
+            void WriteFloats(const std::vector<float>& values) {
+                Write(static_cast<uint32_t>(values.size()));
+                const auto* bytes = reinterpret_cast<const uint8_t*>(values.data());
+                m_Out.insert(m_Out.end(), bytes, bytes + values.size() * sizeof(float));
+            }
+
+        private:
+            std::vector<uint8_t>& m_Out;
+        };
+
+        /** @brief Reads what BinaryWriter wrote; every read fails once the data runs out */
+        class BinaryReader {
+        public:
+            BinaryReader(const uint8_t* data, size_t size) : m_Data(data), m_Size(size) {}
+
+            template <typename T>
+            bool Read(T& value) {
+                if (m_Size - m_Offset < sizeof(T)) return false;
+                std::memcpy(&value, m_Data + m_Offset, sizeof(T));
+                m_Offset += sizeof(T);
+                return true;
+            }
+
+            bool ReadString(std::string& value) {
+                uint16_t length = 0;
+                if (!Read(length) || m_Size - m_Offset < length) return false;
+                value.assign(reinterpret_cast<const char*>(m_Data + m_Offset), length);
+                m_Offset += length;
+                return true;
+            }
+
+            bool ReadFloats(std::vector<float>& values) {
+                uint32_t count = 0;
+                if (!Read(count) || (m_Size - m_Offset) / sizeof(float) < count) return false;
+                values.resize(count);
+                std::memcpy(values.data(), m_Data + m_Offset, count * sizeof(float));
+                m_Offset += count * sizeof(float);
+                return true;
+            }
+
+            /** @brief Guards container sizes against corrupt counts */
+            bool HasAtLeast(size_t bytes) const { return m_Size - m_Offset >= bytes; }
+
+        private:
+            const uint8_t* m_Data;
+            size_t m_Size;
+            size_t m_Offset = 0;
+        };
+
+        /** @return Whether a captured draw range stays inside its mesh's indices and vertices */
+        bool IsValidRange(const FrameCapture::MeshRecord& mesh, const DrawRange& range) {
+            if (static_cast<uint64_t>(range.firstIndex) + range.indexCount > mesh.indexCount ||
+                range.baseVertex < 0) {
+                return false;
+            }
+            uint32_t stride = 0;
+            for (const auto& element : mesh.layout) stride += ShaderDataTypeSize(element.type);
+            const uint32_t vertexCount = stride > 0 ? mesh.vertexBytes / stride : 0;
+            return range.baseVertex == 0 || static_cast<uint32_t>(range.baseVertex) < vertexCount;
+        }
+
+        /** @return Declared GLSL type of a replayed uniform */
+        const char* UniformTypeName(MaterialParameterType type) {
+            switch (type) {
+                case MaterialParameterType::Float:   return "float";
+                case MaterialParameterType::Int:     return "int";
+                case MaterialParameterType::Vector2: return "vec2";
+                case MaterialParameterType::Vector3: return "vec3";
+                case MaterialParameterType::Vector4: return "vec4";
+                case MaterialParameterType::Matrix4: return "mat4";
+            }
+            return "float";
+        }
+
+        float MillisecondsSince(std::chrono::steady_clock::time_point start) {
+            return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() -
+                                                            start).count();
+        }
+    }
+
+    void FrameCapture::RecordFrame(const std::vector<const RenderCommand*>& commands,
+                                   const glm::mat4& viewProjection, bool cullingEnabled,
+                                   bool instancingEnabled) {
+        PROFILE_FUNCTION();
+        FrameRecord& frame = m_Frames.emplace_back();
+        frame.viewProjection = viewProjection;
+        frame.cullingEnabled = cullingEnabled;
+        frame.instancingEnabled = instancingEnabled;
+        frame.commands.reserve(commands.size());
+        for (const RenderCommand* command : commands) {
+            CommandRecord record;
+            record.mesh = InternMesh(*command->vertexArray);
+            record.material = InternMaterial(*command->material, frame);
+            record.transform = command->transformMatrix;
+            record.primitiveType = command->primitiveType;
+            record.pass = command->pass;
+            record.range = command->range;
+            frame.commands.push_back(record);
+        }
+    }
+
+    uint32_t FrameCapture::InternShader(const Shader& shader) {
+        const ObjectKey key{&shader, shader.GetProgram()};
+        auto it = m_ShaderIndices.find(key);
+        if (it != m_ShaderIndices.end()) return it->second;
+
+        ShaderRecord record;
+        record.path = shader.GetPath();
+        for (const auto& [name, location] : shader.GetUniformLocations()) {
+            // Arrays are reflected with and without "[0]"; keep the suffixed name only
+            if (shader.GetUniformLocations().count(name + "[0]")) continue;
+            record.uniforms.push_back(name);
+        }
+        std::sort(record.uniforms.begin(), record.uniforms.end());
+        record.instanced = shader.GetAttributeLocation("a_InstanceModel") ==
+                           static_cast<GLint>(InstanceBuffer::MODEL_ATTRIBUTE_LOCATION);
+
+        const auto index = static_cast<uint32_t>(m_Shaders.size());
+        m_Shaders.push_back(std::move(record));
+        m_ShaderIndices.emplace(key, index);
+        return index;
+    }
+
+    uint32_t FrameCapture::InternMesh(const VertexArray& vertexArray) {
+        const auto& indexBuffer = vertexArray.GetIndexBuffer();
+        const ObjectKey key{&vertexArray,
+                            indexBuffer ? indexBuffer->GetContentHash() ^ indexBuffer->GetCount()
+                                        : 0};
+        auto it = m_MeshIndices.find(key);
+        if (it != m_MeshIndices.end()) return it->second;
+
+        MeshRecord record;
+        for (const auto& vertexBuffer : vertexArray.GetVertexBuffers()) {
+            if (record.layout.empty()) {
+                for (const auto& element : vertexBuffer->GetLayout()) {
+                    record.layout.push_back({element.Type, element.Name, element.Normalized});
+                }
+            }
+            record.vertexBytes += vertexBuffer->GetSize();
+            record.vertexHash = record.vertexHash * 31 + vertexBuffer->GetContentHash();
+        }
+        if (indexBuffer) {
+            record.indexCount = indexBuffer->GetCount();
+            record.indexHash = indexBuffer->GetContentHash();
+        }
+        record.bounds = vertexArray.GetBounds();
+
+        const auto index = static_cast<uint32_t>(m_Meshes.size());
+        m_Meshes.push_back(std::move(record));
+        m_MeshIndices.emplace(key, index);
+        return index;
+    }
+
+    uint32_t FrameCapture::InternMaterial(const Material& material, FrameRecord& frame) {
+        // Sort IDs are never reused, so they tell materials at a recycled address apart
+        const ObjectKey key{&material, material.GetSortID()};
+        auto it = m_MaterialIndices.find(key);
+        if (it != m_MaterialIndices.end()) {
+            std::vector<float>& last = m_LastMaterialData[it->second];
+            if (last != material.GetParameterData()) {
+                last = material.GetParameterData();
+                frame.materialUpdates.push_back({it->second, last});
+            }
+            return it->second;
+        }
+
+        MaterialRecord record;
+        record.shader = InternShader(*material.GetShader());
+        for (const auto& parameter : material.GetParameters()) {
+            record.parameters.push_back({parameter.name, parameter.type, parameter.offset});
+        }
+        record.data = material.GetParameterData();
+        for (const auto& binding : material.GetTextures()) {
+            const uint32_t width = binding.texture ? binding.texture->GetWidth() : 1;
+            const uint32_t height = binding.texture ? binding.texture->GetHeight() : 1;
+            record.textures.push_back({binding.name, width, height});
+        }
+
+        const auto index = static_cast<uint32_t>(m_Materials.size());
+        m_LastMaterialData.push_back(record.data);
+        m_Materials.push_back(std::move(record));
+        m_MaterialIndices.emplace(key, index);
+        return index;
+    }
+
+    std::vector<uint8_t> FrameCapture::Serialize() const {
+        std::vector<uint8_t> bytes;
+        BinaryWriter writer(bytes);
+        writer.Write(MAGIC);
+        writer.Write(VERSION);
+        writer.Write(static_cast<uint32_t>(m_Shaders.size()));
+        writer.Write(static_cast<uint32_t>(m_Meshes.size()));
+        writer.Write(static_cast<uint32_t>(m_Materials.size()));
+        writer.Write(static_cast<uint32_t>(m_Frames.size()));
+
+        for (const auto& shader : m_Shaders) {
+            writer.WriteString(shader.path);
+            writer.Write(static_cast<uint8_t>(shader.instanced));
+            writer.Write(static_cast<uint32_t>(shader.uniforms.size()));
+            for (const auto& uniform : shader.uniforms) writer.WriteString(uniform);
+        }
+        for (const auto& mesh : m_Meshes) {
+            writer.Write(static_cast<uint32_t>(mesh.layout.size()));
+            for (const auto& element : mesh.layout) {
+                writer.Write(static_cast<uint8_t>(element.type));
+                writer.Write(static_cast<uint8_t>(element.normalized));
+                writer.WriteString(element.name);
+            }
+            writer.Write(mesh.vertexBytes);
+            writer.Write(mesh.vertexHash);
+            writer.Write(mesh.indexCount);
+            writer.Write(mesh.indexHash);
+            writer.Write(mesh.bounds.min);
+            writer.Write(mesh.bounds.max);
+        }
+        for (const auto& material : m_Materials) {
+            writer.Write(material.shader);
+            writer.Write(static_cast<uint32_t>(material.parameters.size()));
+            for (const auto& parameter : material.parameters) {
+                writer.WriteString(parameter.name);
+                writer.Write(static_cast<uint8_t>(parameter.type));
+                writer.Write(parameter.offset);
+            }
+            writer.WriteFloats(material.data);
+            writer.Write(static_cast<uint32_t>(material.textures.size()));
+            for (const auto& texture : material.textures) {
+                writer.WriteString(texture.name);
+                writer.Write(texture.width);
+                writer.Write(texture.height);
+            }
+        }
+        for (const auto& frame : m_Frames) {
+            writer.Write(frame.viewProjection);
+            writer.Write(static_cast<uint8_t>(frame.cullingEnabled));
+            writer.Write(static_cast<uint8_t>(frame.instancingEnabled));
+            writer.Write(static_cast<uint32_t>(frame.materialUpdates.size()));
+            for (const auto& update : frame.materialUpdates) {
+                writer.Write(update.material);
+                writer.WriteFloats(update.data);
+            }
+            writer.Write(static_cast<uint32_t>(frame.commands.size()));
+            for (const auto& command : frame.commands) {
+                writer.Write(command.mesh);
+                writer.Write(command.material);
+                writer.Write(command.transform);
+                writer.Write(static_cast<uint16_t>(command.primitiveType));
+                writer.Write(static_cast<uint8_t>(command.pass));
+                writer.Write(command.range.firstIndex);
+                writer.Write(command.range.indexCount);
+                writer.Write(command.range.baseVertex);
+            }
+        }
+        return bytes;
+    }
+
+    bool FrameCapture::Deserialize(const uint8_t* data, size_t size) {
+        *this = FrameCapture();
+        BinaryReader reader(data, size);
+
+        uint32_t magic = 0, version = 0, shaderCount = 0, meshCount = 0, materialCount = 0,
+                 frameCount = 0;
+        if (!reader.Read(magic) || magic != MAGIC || !reader.Read(version) || version != VERSION) {
+            return false;
+        }
+        if (!reader.Read(shaderCount) || !reader.Read(meshCount) || !reader.Read(materialCount) ||
+            !reader.Read(frameCount)) {
+            return false;
+        }
+
+        // Smallest encoding of each table entry, so corrupt counts fail before allocating
+        constexpr size_t SHADER_BYTES = sizeof(uint16_t) + sizeof(uint8_t) + sizeof(uint32_t);
+        constexpr size_t MESH_BYTES =
+            3 * sizeof(uint32_t) + 2 * sizeof(uint64_t) + 2 * sizeof(glm::vec3);
+        constexpr size_t MATERIAL_BYTES = 4 * sizeof(uint32_t);
+        constexpr size_t FRAME_BYTES = sizeof(glm::mat4) + 2 + 2 * sizeof(uint32_t);
+
+        if (!reader.HasAtLeast(shaderCount * SHADER_BYTES)) return false;
+        m_Shaders.resize(shaderCount);
+        for (auto& shader : m_Shaders) {
+            uint8_t instanced = 0;
+            uint32_t uniformCount = 0;
+            if (!reader.ReadString(shader.path) || !reader.Read(instanced) ||
+                !reader.Read(uniformCount) || !reader.HasAtLeast(uniformCount * sizeof(uint16_t))) {
+                return false;
+            }
+            shader.instanced = instanced != 0;
+            shader.uniforms.resize(uniformCount);
+            for (auto& uniform : shader.uniforms) {
+                if (!reader.ReadString(uniform)) return false;
+            }
+        }
+
+        if (!reader.HasAtLeast(meshCount * MESH_BYTES)) return false;
+        m_Meshes.resize(meshCount);
+        for (auto& mesh : m_Meshes) {
+            uint32_t elementCount = 0;
+            if (!reader.Read(elementCount) || !reader.HasAtLeast(elementCount * 4)) return false;
+            mesh.layout.resize(elementCount);
+            for (auto& element : mesh.layout) {
+                uint8_t type = 0, normalized = 0;
+                if (!reader.Read(type) || type == static_cast<uint8_t>(ShaderDataType::None) ||
+                    type > static_cast<uint8_t>(ShaderDataType::Bool) ||
+                    !reader.Read(normalized) || !reader.ReadString(element.name)) {
+                    return false;
+                }
+                element.type = static_cast<ShaderDataType>(type);
+                element.normalized = normalized != 0;
+            }
+            if (!reader.Read(mesh.vertexBytes) || !reader.Read(mesh.vertexHash) ||
+                !reader.Read(mesh.indexCount) || !reader.Read(mesh.indexHash) ||
+                !reader.Read(mesh.bounds.min) || !reader.Read(mesh.bounds.max)) {
+                return false;
+            }
+        }
+
+        if (!reader.HasAtLeast(materialCount * MATERIAL_BYTES)) return false;
+        m_Materials.resize(materialCount);
+        for (auto& material : m_Materials) {
+            uint32_t parameterCount = 0, textureCount = 0;
+            if (!reader.Read(material.shader) || material.shader >= shaderCount ||
+                !reader.Read(parameterCount) || !reader.HasAtLeast(parameterCount * 7)) {
+                return false;
+            }
+            material.parameters.resize(parameterCount);
+            for (auto& parameter : material.parameters) {
+                uint8_t type = 0;
+                if (!reader.ReadString(parameter.name) || !reader.Read(type) ||
+                    type > static_cast<uint8_t>(MaterialParameterType::Matrix4) ||
+                    !reader.Read(parameter.offset)) {
+                    return false;
+                }
+                parameter.type = static_cast<MaterialParameterType>(type);
+            }
+            if (!reader.ReadFloats(material.data) || !reader.Read(textureCount) ||
+                !reader.HasAtLeast(textureCount * 10)) {
+                return false;
+            }
+            for (const auto& parameter : material.parameters) {
+                const uint32_t floats =
+                    parameter.type == MaterialParameterType::Matrix4
+                        ? 16
+                        : parameter.type == MaterialParameterType::Vector4 ? 4
+                        : parameter.type == MaterialParameterType::Vector3 ? 3
+                        : parameter.type == MaterialParameterType::Vector2 ? 2 : 1;
+                if (parameter.offset + floats > material.data.size()) return false;
+            }
+            material.textures.resize(textureCount);
+            for (auto& texture : material.textures) {
+                if (!reader.ReadString(texture.name) || !reader.Read(texture.width) ||
+                    !reader.Read(texture.height)) {
+                    return false;
+                }
+            }
+        }
+
+        if (!reader.HasAtLeast(frameCount * FRAME_BYTES)) return false;
+        m_Frames.resize(frameCount);
+        for (auto& frame : m_Frames) {
+            uint8_t cull = 0, instancing = 0;
+            uint32_t updateCount = 0, commandCount = 0;
+            if (!reader.Read(frame.viewProjection) || !reader.Read(cull) ||
+                !reader.Read(instancing) || !reader.Read(updateCount) ||
+                !reader.HasAtLeast(updateCount * 8)) {
+                return false;
+            }
+            frame.cullingEnabled = cull != 0;
+            frame.instancingEnabled = instancing != 0;
+            frame.materialUpdates.resize(updateCount);
+            for (auto& update : frame.materialUpdates) {
+                if (!reader.Read(update.material) || update.material >= materialCount ||
+                    !reader.ReadFloats(update.data) ||
+                    update.data.size() != m_Materials[update.material].data.size()) {
+                    return false;
+                }
+            }
+
+            constexpr size_t COMMAND_BYTES =
+                2 * sizeof(uint32_t) + sizeof(glm::mat4) + 3 + sizeof(DrawRange);
+            if (!reader.Read(commandCount) || !reader.HasAtLeast(commandCount * COMMAND_BYTES)) {
+                return false;
+            }
+            frame.commands.resize(commandCount);
+            for (auto& command : frame.commands) {
+                uint16_t primitiveType = 0;
+                uint8_t pass = 0;
+                if (!reader.Read(command.mesh) || command.mesh >= meshCount ||
+                    !reader.Read(command.material) || command.material >= materialCount ||
+                    !reader.Read(command.transform) || !reader.Read(primitiveType) ||
+                    !reader.Read(pass) || !reader.Read(command.range.firstIndex) ||
+                    !reader.Read(command.range.indexCount) ||
+                    !reader.Read(command.range.baseVertex)) {
+                    return false;
+                }
+                // Replay submits these as-is, so reject what Submit() would assert on
+                if ((primitiveType != GL_TRIANGLES && primitiveType != GL_LINES &&
+                     primitiveType != GL_POINTS) ||
+                    pass > static_cast<uint8_t>(RenderPass::Transparent) ||
+                    !IsValidRange(m_Meshes[command.mesh], command.range)) {
+                    return false;
+                }
+                command.primitiveType = primitiveType;
+                command.pass = static_cast<RenderPass>(pass);
+            }
+        }
+        return true;
+    }
+
+    bool FrameCapture::Save(const std::string& path) const {
+        const std::vector<uint8_t> bytes = Serialize();
+        std::ofstream file(path, std::ios::binary);
+        if (!file.write(reinterpret_cast<const char*>(bytes.data()),
+                        static_cast<std::streamsize>(bytes.size()))) {
+            LOG_ERROR_CONCAT("Failed to write frame capture: ", path);
+            return false;
+        }
+        LOG_INFO_CONCAT("Captured ", m_Frames.size(), " frame(s) to ", path, " (", bytes.size(),
+                        " bytes)");
+        return true;
+    }
+
+    bool FrameCapture::Load(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            LOG_ERROR_CONCAT("Failed to open frame capture: ", path);
+            return false;
+        }
+        const std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)),
+                                         std::istreambuf_iterator<char>());
+        if (!Deserialize(bytes.data(), bytes.size())) {
+            LOG_ERROR_CONCAT("Invalid or unsupported frame capture: ", path);
+            return false;
+        }
+        return true;
+    }
+
+    FrameReplay::FrameReplay(const FrameCapture& capture) : m_Capture(capture) {
+        PROFILE_FUNCTION();
+        for (const auto& record : capture.GetShaders()) {
+            std::shared_ptr<Shader> shader;
+            const size_t separator = record.path.find(';');
+            if (separator != std::string::npos &&
+                !Shader::ReadFile(record.path.substr(0, separator)).empty()) {
+                shader = Shader::CreateFromFiles(record.path.substr(0, separator),
+                                                 record.path.substr(separator + 1));
+            }
+            if (!shader) {
+                // Declare the captured uniforms with the types the materials use
+                std::unordered_map<std::string, const char*> types = {
+                    {"u_ViewProjection", "mat4"}, {"u_Model", "mat4"}, {"u_Instanced", "bool"}};
+                for (const auto& material : capture.GetMaterials()) {
+                    if (&capture.GetShaders()[material.shader] != &record) continue;
+                    for (const auto& parameter : material.parameters) {
+                        types.emplace(parameter.name, UniformTypeName(parameter.type));
+                    }
+                    for (const auto& texture : material.textures) types[texture.name] = "sampler2D";
+                }
+
+                std::string vertexSource = "#version 330 core\n"
+                                           "layout(location = 0) in vec3 a_Position;\n";
+                if (record.instanced) vertexSource += "layout(location = 8) in mat4 a_InstanceModel;\n";
+                for (const auto& uniform : record.uniforms) {
+                    const bool isArray = uniform.size() > 3 &&
+                                         uniform.compare(uniform.size() - 3, 3, "[0]") == 0;
+                    const std::string name = isArray ? uniform.substr(0, uniform.size() - 3) : uniform;
+                    auto type = types.find(name);
+                    vertexSource += std::string("uniform ") +
+                                    (type != types.end() ? type->second : "float") + " " + name +
+                                    (isArray ? "[1];\n" : ";\n");
+                }
+                vertexSource += "void main() { gl_Position = vec4(a_Position, 1.0); }\n";
+                shader = Shader::CreateFromSource(
+                    vertexSource.c_str(),
+                    "#version 330 core\nout vec4 color;\nvoid main() { color = vec4(1.0); }\n");
+            }
+            m_Shaders.push_back(shader);
+        }
+
+        for (const auto& record : capture.GetMeshes()) {
+            // Stand-in geometry of the captured size; only bounds and index count affect the CPU
+            std::vector<BufferElement> elements;
+            for (const auto& element : record.layout) {
+                elements.emplace_back(element.type, element.name, element.normalized);
+            }
+            const std::vector<float> vertices((record.vertexBytes + 3) / sizeof(float), 0.0f);
+            const std::vector<uint32_t> indices(std::max(record.indexCount, 1u), 0u);
+
+            auto vertexBuffer = std::shared_ptr<VertexBuffer>(VertexBuffer::Create(
+                vertices.data(), static_cast<uint32_t>(vertices.size() * sizeof(float))));
+            vertexBuffer->SetLayout(BufferLayout(std::move(elements)));
+            auto vertexArray = std::shared_ptr<VertexArray>(VertexArray::Create());
+            vertexArray->AddVertexBuffer(vertexBuffer);
+            vertexArray->SetIndexBuffer(std::shared_ptr<IndexBuffer>(
+                IndexBuffer::Create(indices.data(), static_cast<uint32_t>(indices.size()))));
+            vertexArray->SetBounds(record.bounds);
+            m_Meshes.push_back(vertexArray);
+        }
+
+        for (const auto& record : capture.GetMaterials()) {
+            auto material = std::make_shared<Material>(m_Shaders[record.shader]);
+            for (const auto& texture : record.textures) {
+                m_Textures.push_back(std::make_shared<Texture>(std::max(texture.width, 1u),
+                                                               std::max(texture.height, 1u)));
+                material->SetTexture(texture.name, m_Textures.back());
+            }
+            ApplyParameters(*material, record, record.data);
+            m_Materials.push_back(material);
+        }
+    }
+
+    FrameReplay::~FrameReplay() = default;
+
+    void FrameReplay::ApplyParameters(Material& material, const FrameCapture::MaterialRecord& record,
+                                      const std::vector<float>& data) {
+        for (const auto& parameter : record.parameters) {
+            const float* value = data.data() + parameter.offset;
+            switch (parameter.type) {
+                case MaterialParameterType::Float:
+                    material.SetFloat(parameter.name, value[0]);
+                    break;
+                case MaterialParameterType::Int: {
+                    int intValue;
+                    std::memcpy(&intValue, value, sizeof(int));
+                    material.SetInt(parameter.name, intValue);
+                    break;
+                }
+                case MaterialParameterType::Vector2:
+                    material.SetVector2(parameter.name, glm::vec2(value[0], value[1]));
+                    break;
+                case MaterialParameterType::Vector3:
+                    material.SetVector3(parameter.name, glm::vec3(value[0], value[1], value[2]));
+                    break;
+                case MaterialParameterType::Vector4:
+                    material.SetVector4(parameter.name,
+                                        glm::vec4(value[0], value[1], value[2], value[3]));
+                    break;
+                case MaterialParameterType::Matrix4: {
+                    glm::mat4 matrix;
+                    std::memcpy(&matrix, value, sizeof(glm::mat4));
+                    material.SetMatrix4(parameter.name, matrix);
+                    break;
+                }
+            }
+        }
+    }
+
+    FrameReplay::FrameTimings FrameReplay::ReplayFrame(Renderer& renderer, size_t frameIndex) {
+        PROFILE_FUNCTION();
+        const FrameCapture::FrameRecord& frame = m_Capture.GetFrames()[frameIndex];
+        FrameTimings timings;
+
+        for (const auto& update : frame.materialUpdates) {
+            ApplyParameters(*m_Materials[update.material],
+                            m_Capture.GetMaterials()[update.material], update.data);
+        }
+        renderer.SetViewProjectionOverride(frame.viewProjection);
+        renderer.SetFrustumCullingEnabled(frame.cullingEnabled);
+        renderer.SetInstancingEnabled(frame.instancingEnabled);
+
+        RecordingRenderAPI* recorder = RecordingRenderAPI::GetActive();
+        if (recorder) recorder->ClearLog();
+
+        auto start = std::chrono::steady_clock::now();
+        for (const auto& command : frame.commands) {
+            renderer.Submit(m_Meshes[command.mesh], m_Materials[command.material],
+                            command.transform, static_cast<GLenum>(command.primitiveType),
+                            command.pass, command.range);
+        }
+        renderer.SwapCommandBuffers();
+        timings.submitMs = MillisecondsSince(start);
+
+        start = std::chrono::steady_clock::now();
+        renderer.Flush();
+        timings.flushMs = MillisecondsSince(start);
+        renderer.ClearViewProjectionOverride();
+
+        const RenderStatistics& stats = renderer.GetStatistics();
+        timings.sortMs = stats.sortMs;
+        timings.materialMs = stats.materialMs;
+        timings.drawMs = std::max(0.0f, stats.submitMs - stats.sortMs - stats.materialMs);
+        timings.drawCalls = stats.drawCalls;
+        timings.culled = stats.culled;
+        timings.glCalls = recorder ? recorder->GetCalls().size() : 0;
+        return timings;
+    }
+
+    int FrameReplay::Run(const std::string& path, uint32_t iterations) {
+        FrameCapture capture;
+        if (!capture.Load(path)) return 1;
+        iterations = std::max(iterations, 1u);
+
+        const RenderAPI::API previousAPI = RenderAPI::GetAPI();
+        RenderAPI::SetAPI(RenderAPI::API::None);
+        RecordingRenderAPI api;
+        api.Init();
+        {
+            Renderer renderer;
+            renderer.Initialize();
+            FrameReplay replay(capture);
+            LOG_INFO_CONCAT("[Replay] ", path, ": ", capture.GetFrames().size(), " frame(s), ",
+                            capture.GetMeshes().size(), " meshes, ",
+                            capture.GetMaterials().size(), " materials, ",
+                            capture.GetShaders().size(), " shaders, ", iterations,
+                            " iteration(s)");
+
+            std::vector<FrameTimings> totals(replay.GetFrameCount());
+            for (uint32_t iteration = 0; iteration < iterations; ++iteration) {
+                for (size_t frame = 0; frame < replay.GetFrameCount(); ++frame) {
+                    const FrameTimings timings = replay.ReplayFrame(renderer, frame);
+                    FrameTimings& total = totals[frame];
+                    total.submitMs += timings.submitMs;
+                    total.sortMs += timings.sortMs;
+                    total.materialMs += timings.materialMs;
+                    total.drawMs += timings.drawMs;
+                    total.flushMs += timings.flushMs;
+                    total.drawCalls = timings.drawCalls;
+                    total.culled = timings.culled;
+                    total.glCalls = timings.glCalls;
+                }
+            }
+
+            const float scale = 1.0f / static_cast<float>(iterations);
+            for (size_t frame = 0; frame < totals.size(); ++frame) {
+                const FrameTimings& total = totals[frame];
+                LOG_INFO_CONCAT("[Replay] frame ", frame, ": ",
+                                capture.GetFrames()[frame].commands.size(), " commands, submit ",
+                                total.submitMs * scale, " ms, sort ", total.sortMs * scale,
+                                " ms, materials ", total.materialMs * scale, " ms, draw ",
+                                total.drawMs * scale, " ms, flush ", total.flushMs * scale,
+                                " ms, ", total.drawCalls, " draw calls, ", total.culled,
+                                " culled, ", total.glCalls, " GL calls");
+            }
+        }
+        api.Shutdown();
+        RenderAPI::SetAPI(previousAPI);
+        return 0;
+    }
+}
@@ -0,0 +1,206 @@
+#pragma once
+#include <pch.h>
+#include <glad/glad.h>
+
+#include "BoundingBox.h"
+#include "Buffer.h"
+#include "Material.h"
+#include "RenderCommandBuckets.h"
+#include "RenderSortKey.h"
+
+namespace Engine {
+    class Renderer;
+    class RecordingRenderAPI;
+
+    /**
+     * @brief Renderer submissions of one or more frames, serialisable to a compact binary file
+     *
+     * Renderer::CaptureFrames() feeds every flushed command list to RecordFrame().
+     * Shaders, vertex arrays and materials are stored once and referenced by index:
+     * shaders by source path and active uniforms, vertex arrays by layout, bounds and
+     * the content hashes of their buffers, materials by parameter block. Buffer
+     * contents are not stored; a replay draws stand-in geometry of the same size.
+     * Material values that change between captured frames are stored as per-frame
+     * updates, so a replay rebinds exactly as the captured frames did.
+     *
+     * File layout, in host byte order so captures only replay on a machine of the
+     * same endianness: header (magic, version, table sizes), shader, mesh and
+     * material tables, then each frame's view-projection, settings, material
+     * updates and commands.
+     */
+    class FrameCapture {
+    public:
+        static constexpr uint32_t MAGIC = 0x43465856;  ///< "VXFC"
+        static constexpr uint32_t VERSION = 2;
+
+        struct ShaderRecord {
+            std::string path;                   ///< "vertex;fragment", empty if built from source
+            std::vector<std::string> uniforms;  ///< Active uniforms, arrays with "[0]"
+            bool instanced = false;             ///< Declares a_InstanceModel at location 8
+        };
+
+        struct ElementRecord {
+            ShaderDataType type;
+            std::string name;
+            bool normalized;
+        };
+
+        struct MeshRecord {
+            std::vector<ElementRecord> layout;  ///< Layout of the first vertex buffer
+            uint32_t vertexBytes = 0;           ///< Bytes across all vertex buffers
+            uint64_t vertexHash = 0;            ///< Combined content hash of the vertex buffers
+            uint32_t indexCount = 0;
+            uint64_t indexHash = 0;
+            AABB bounds;                        ///< Invalid if the vertex array has none
+        };
+
+        struct ParameterRecord {
+            std::string name;
+            MaterialParameterType type;
+            uint32_t offset;                    ///< First float in MaterialRecord::data
+        };
+
+        struct TextureRecord {
+            std::string name;                   ///< Sampler uniform
+            uint32_t width;
+            uint32_t height;
+        };
+
+        struct MaterialRecord {
+            uint32_t shader = 0;                ///< Index into GetShaders()
+            std::vector<ParameterRecord> parameters;
+            std::vector<float> data;            ///< Values when first captured
+            std::vector<TextureRecord> textures;
+        };
+
+        /** @brief New parameter values a material had from this frame on */
+        struct MaterialUpdate {
+            uint32_t material;
+            std::vector<float> data;
+        };
+
+        struct CommandRecord {
+            uint32_t mesh;
+            uint32_t material;
+            glm::mat4 transform;
+            uint32_t primitiveType;
+            RenderPass pass;
+            DrawRange range;
+        };
+
+        struct FrameRecord {
+            glm::mat4 viewProjection = glm::mat4(1.0f);
+            bool cullingEnabled = true;
+            bool instancingEnabled = true;
+            std::vector<MaterialUpdate> materialUpdates;
+            std::vector<CommandRecord> commands;
+        };
+
+        /**
+         * @brief Appends one flushed frame
+         * @param commands Gathered command list, in submission order
+         * @details Main thread, inside Flush(): queries shaders for instancing support
+         */
+        void RecordFrame(const std::vector<const RenderCommand*>& commands,
+                         const glm::mat4& viewProjection, bool cullingEnabled,
+                         bool instancingEnabled);
+
+        /** @return The capture in the binary file format */
+        std::vector<uint8_t> Serialize() const;
+        /**
+         * @brief Replaces the contents with a serialised capture
+         * @return false if the data is truncated or not a capture of this version
+         */
+        bool Deserialize(const uint8_t* data, size_t size);
+
+        bool Save(const std::string& path) const;
+        bool Load(const std::string& path);
+
+        const std::vector<ShaderRecord>& GetShaders() const { return m_Shaders; }
+        const std::vector<MeshRecord>& GetMeshes() const { return m_Meshes; }
+        const std::vector<MaterialRecord>& GetMaterials() const { return m_Materials; }
+        const std::vector<FrameRecord>& GetFrames() const { return m_Frames; }
+
+    private:
+        uint32_t InternShader(const Shader& shader);
+        uint32_t InternMesh(const VertexArray& vertexArray);
+        uint32_t InternMaterial(const Material& material, FrameRecord& frame);
+
+        /** @brief Identity of a captured object; the hash tells reused addresses apart */
+        struct ObjectKey {
+            const void* object;
+            uint64_t hash;
+            bool operator==(const ObjectKey& other) const {
+                return object == other.object && hash == other.hash;
+            }
+        };
+        struct ObjectKeyHash {
+            size_t operator()(const ObjectKey& key) const {
+                return std::hash<const void*>()(key.object) ^ static_cast<size_t>(key.hash);
+            }
+        };
+
+        std::vector<ShaderRecord> m_Shaders;
+        std::vector<MeshRecord> m_Meshes;
+        std::vector<MaterialRecord> m_Materials;
+        std::vector<FrameRecord> m_Frames;
+        std::unordered_map<ObjectKey, uint32_t, ObjectKeyHash> m_ShaderIndices;
+        std::unordered_map<ObjectKey, uint32_t, ObjectKeyHash> m_MeshIndices;
+        std::unordered_map<ObjectKey, uint32_t, ObjectKeyHash> m_MaterialIndices;
+        std::vector<std::vector<float>> m_LastMaterialData;  ///< Latest values per material
+    };
+
+    /**
+     * @brief Re-executes a FrameCapture against a renderer and times each stage
+     *
+     * The constructor recreates the captured shaders, stand-in vertex arrays and
+     * materials on whichever GL backend is installed, so a replay runs equally on
+     * a real context and under RecordingRenderAPI. Shaders are reloaded from their
+     * captured paths when readable, otherwise rebuilt from the captured uniform list.
+     */
+    class FrameReplay {
+    public:
+        /** @brief CPU cost of replaying one frame */
+        struct FrameTimings {
+            float submitMs = 0.0f;     ///< Submit() of every command
+            float sortMs = 0.0f;       ///< Culling, key generation and sorting in Flush()
+            float materialMs = 0.0f;   ///< Material application in Flush()
+            float drawMs = 0.0f;       ///< Rest of Flush(): binds, uploads and draws
+            float flushMs = 0.0f;      ///< Whole Flush()
+            uint32_t drawCalls = 0;
+            uint32_t culled = 0;
+            size_t glCalls = 0;        ///< Calls logged by the recording backend, if installed
+        };
+
+        explicit FrameReplay(const FrameCapture& capture);
+        ~FrameReplay();
+
+        /**
+         * @brief Submits and flushes one captured frame
+         * @param renderer Initialised renderer; its camera is overridden by the captured matrix
+         * @param frameIndex Frame of the capture to replay
+         */
+        FrameTimings ReplayFrame(Renderer& renderer, size_t frameIndex);
+
+        size_t GetFrameCount() const { return m_Capture.GetFrames().size(); }
+
+        /**
+         * @brief Headless replay tool: sandbox --replay <file> [iterations]
+         * @details Installs RecordingRenderAPI, replays every frame of the file the given
+         *          number of times and logs per-frame stage timings averaged over them.
+         * @return Process exit code
+         */
+        static int Run(const std::string& path, uint32_t iterations);
+
+    private:
+        /** @brief Applies a parameter block to a material through its typed setters */
+        static void ApplyParameters(Material& material, const FrameCapture::MaterialRecord& record,
+                                    const std::vector<float>& data);
+
+        const FrameCapture& m_Capture;
+        std::vector<std::shared_ptr<Shader>> m_Shaders;
+        std::vector<std::shared_ptr<VertexArray>> m_Meshes;
+        std::vector<std::shared_ptr<Material>> m_Materials;
+        std::vector<std::shared_ptr<Texture>> m_Textures;
+    };
+}
@@ -0,0 +1,86 @@
+/**
+ * @file FrustumCulling.cpp
+ * @brief SSE and scalar implementations of batched frustum culling
+ */
+#include "FrustumCulling.h"
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+    #include <xmmintrin.h>
+    #define ENGINE_FRUSTUM_CULLING_SSE 1
+#endif
+
+namespace Engine {
+    namespace FrustumCulling {
+        void SetBox(BoxBatch& batch, size_t lane, const AABB& bounds, const glm::mat4& model) {
+            ASSERT(lane < BATCH_SIZE && "Lane out of range");
+            const glm::vec3 center = bounds.GetCenter();
+            const glm::vec3 extents = bounds.GetExtents();
+
+            // Centre transforms as a point; extents by the absolute rotation-scale part
+            const glm::vec4 worldCenter = model * glm::vec4(center, 1.0f);
+            batch.centerX[lane] = worldCenter.x;
+            batch.centerY[lane] = worldCenter.y;
+            batch.centerZ[lane] = worldCenter.z;
+            batch.extentX[lane] = std::abs(model[0].x) * extents.x +
+                                  std::abs(model[1].x) * extents.y +
+                                  std::abs(model[2].x) * extents.z;
+            batch.extentY[lane] = std::abs(model[0].y) * extents.x +
+                                  std::abs(model[1].y) * extents.y +
+                                  std::abs(model[2].y) * extents.z;
+            batch.extentZ[lane] = std::abs(model[0].z) * extents.x +
+                                  std::abs(model[1].z) * extents.y +
+                                  std::abs(model[2].z) * extents.z;
+        }
+
+        void ClearBox(BoxBatch& batch, size_t lane) {
+            ASSERT(lane < BATCH_SIZE && "Lane out of range");
+            batch.centerX[lane] = batch.centerY[lane] = batch.centerZ[lane] = 0.0f;
+            batch.extentX[lane] = batch.extentY[lane] = batch.extentZ[lane] = 0.0f;
+        }
+
+#ifdef ENGINE_FRUSTUM_CULLING_SSE
+        uint32_t TestBatch(const Frustum& frustum, const BoxBatch& batch) {
+            static_assert(BATCH_SIZE == 4, "SSE path tests four boxes per batch");
+            const __m128 centerX = _mm_load_ps(batch.centerX);
+            const __m128 centerY = _mm_load_ps(batch.centerY);
+            const __m128 centerZ = _mm_load_ps(batch.centerZ);
+            const __m128 extentX = _mm_load_ps(batch.extentX);
+            const __m128 extentY = _mm_load_ps(batch.extentY);
+            const __m128 extentZ = _mm_load_ps(batch.extentZ);
+            const __m128 zero = _mm_setzero_ps();
+
+            __m128 inside = _mm_cmpeq_ps(zero, zero);  // All lanes set
+            for (const glm::vec4& plane : frustum.planes) {
+                // Signed distance of the centre plus the box's projected radius
+                __m128 distance = _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.x), centerX),
+                               _mm_mul_ps(_mm_set1_ps(plane.y), centerY)),
+                    _mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.z), centerZ), _mm_set1_ps(plane.w)));
+                __m128 radius = _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(_mm_set1_ps(std::abs(plane.x)), extentX),
+                               _mm_mul_ps(_mm_set1_ps(std::abs(plane.y)), extentY)),
+                    _mm_mul_ps(_mm_set1_ps(std::abs(plane.z)), extentZ));
+                inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(distance, radius), zero));
+            }
+            return static_cast<uint32_t>(_mm_movemask_ps(inside));
+        }
+#else
+        uint32_t TestBatch(const Frustum& frustum, const BoxBatch& batch) {
+            uint32_t mask = 0;
+            for (size_t lane = 0; lane < BATCH_SIZE; ++lane) {
+                bool inside = true;
+                for (const glm::vec4& plane : frustum.planes) {
+                    float distance = plane.x * batch.centerX[lane] + plane.y * batch.centerY[lane] +
+                                     plane.z * batch.centerZ[lane] + plane.w;
+                    float radius = std::abs(plane.x) * batch.extentX[lane] +
+                                   std::abs(plane.y) * batch.extentY[lane] +
+                                   std::abs(plane.z) * batch.extentZ[lane];
+                    inside &= distance + radius >= 0.0f;
+                }
+                mask |= static_cast<uint32_t>(inside) << lane;
+            }
+            return mask;
+        }
+#endif
+    }
+}
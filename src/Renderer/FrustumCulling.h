@@ -0,0 +1,47 @@
+#pragma once
+#include <pch.h>
+
+#include "../Camera/Frustum.h"
+#include "BoundingBox.h"
+
+namespace Engine {
+    /**
+     * @brief Batched AABB-vs-frustum tests
+     *
+     * Boxes are tested FrustumCulling::BATCH_SIZE at a time in structure-of-arrays
+     * form so each plane test is a handful of SIMD multiply-adds (SSE where the
+     * target supports it, scalar otherwise). Boxes are conservative: a box
+     * is culled only if it lies entirely behind one plane.
+     */
+    namespace FrustumCulling {
+        constexpr size_t BATCH_SIZE = 4;
+
+        /** @brief World-space boxes as centres and half-extents, one lane per box */
+        struct BoxBatch {
+            alignas(16) float centerX[BATCH_SIZE];
+            alignas(16) float centerY[BATCH_SIZE];
+            alignas(16) float centerZ[BATCH_SIZE];
+            alignas(16) float extentX[BATCH_SIZE];
+            alignas(16) float extentY[BATCH_SIZE];
+            alignas(16) float extentZ[BATCH_SIZE];
+        };
+
+        /**
+         * @brief Transforms a local box to world space and stores it in a lane
+         * @param batch Batch to write to
+         * @param lane Lane index, less than BATCH_SIZE
+         * @param bounds Local-space bounds; must be valid
+         * @param model Local-to-world matrix
+         */
+        void SetBox(BoxBatch& batch, size_t lane, const AABB& bounds, const glm::mat4& model);
+
+        /** @brief Fills a lane with an empty box at the origin; mask its result out */
+        void ClearBox(BoxBatch& batch, size_t lane);
+
+        /**
+         * @brief Tests every lane of a batch against the frustum
+         * @return Bit i is set if box i intersects or is inside the frustum
+         */
+        uint32_t TestBatch(const Frustum& frustum, const BoxBatch& batch);
+    }
+}
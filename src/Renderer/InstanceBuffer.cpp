@@ -0,0 +1,63 @@
+/**
+ * @file InstanceBuffer.cpp
+ * @brief OpenGL implementation of the streaming instance buffer
+ */
+#include "InstanceBuffer.h"
+
+#include <glad/glad.h>
+
+#include "RenderState.h"
+
+namespace Engine {
+    InstanceBuffer::InstanceBuffer(uint32_t initialCapacity)
+        : m_Capacity(std::max(1u, initialCapacity)) {
+        glGenBuffers(1, &m_RendererID);
+        RenderState::Get().BindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+        glBufferData(GL_ARRAY_BUFFER, m_Capacity * sizeof(glm::mat4), nullptr, GL_STREAM_DRAW);
+    }
+
+    InstanceBuffer::~InstanceBuffer() {
+        RenderState::Get().OnBufferDeleted(m_RendererID);
+        glDeleteBuffers(1, &m_RendererID);
+    }
+
+    void InstanceBuffer::BeginFrame() {
+        if (m_Size == 0) return;
+        RenderState::Get().BindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+        glBufferData(GL_ARRAY_BUFFER, m_Capacity * sizeof(glm::mat4), nullptr, GL_STREAM_DRAW);
+        m_Size = 0;
+    }
+
+    uint32_t InstanceBuffer::Upload(const glm::mat4* matrices, uint32_t count) {
+        RenderState::Get().BindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+        if (m_Size + count > m_Capacity) {
+            // Reallocation orphans the old store; draws already issued keep reading it
+            m_Capacity = std::max(m_Capacity * 2, count);
+            glBufferData(GL_ARRAY_BUFFER, m_Capacity * sizeof(glm::mat4), nullptr, GL_STREAM_DRAW);
+            m_Size = 0;
+        }
+
+        const uint32_t byteOffset = m_Size * sizeof(glm::mat4);
+        glBufferSubData(GL_ARRAY_BUFFER, byteOffset, count * sizeof(glm::mat4), matrices);
+        m_Size += count;
+        return byteOffset;
+    }
+
+    void InstanceBuffer::BindAttributes(uint32_t byteOffset) const {
+        RenderState::Get().BindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+        for (uint32_t column = 0; column < 4; ++column) {
+            const uint32_t location = MODEL_ATTRIBUTE_LOCATION + column;
+            glEnableVertexAttribArray(location);
+            glVertexAttribPointer(
+                location, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4),
+                (const void*)(intptr_t)(byteOffset + column * sizeof(glm::vec4)));
+            glVertexAttribDivisor(location, 1);
+        }
+    }
+
+    void InstanceBuffer::UnbindAttributes() {
+        for (uint32_t column = 0; column < 4; ++column) {
+            glDisableVertexAttribArray(MODEL_ATTRIBUTE_LOCATION + column);
+        }
+    }
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <pch.h>
+
+namespace Engine {
+    /**
+     * @brief Streaming vertex buffer of per-instance model matrices
+     *
+     * Each frame's instanced draws append their matrices; the storage is
+     * orphaned at BeginFrame() so the driver never stalls on a buffer the GPU
+     * is still reading. Shaders opt in by declaring
+     * `layout(location = 8) in mat4 a_InstanceModel;` and a `u_Instanced` flag.
+     */
+    class InstanceBuffer {
+    public:
+        /** @brief First of the four attribute locations occupied by a_InstanceModel */
+        static constexpr uint32_t MODEL_ATTRIBUTE_LOCATION = 8;
+
+        /** @param initialCapacity Instances the buffer holds before it grows */
+        explicit InstanceBuffer(uint32_t initialCapacity = 4096);
+        ~InstanceBuffer();
+
+        InstanceBuffer(const InstanceBuffer&) = delete;
+        InstanceBuffer& operator=(const InstanceBuffer&) = delete;
+
+        /** @brief Orphans last frame's storage and restarts appending at offset 0 */
+        void BeginFrame();
+
+        /**
+         * @brief Appends matrices, growing (and orphaning) the buffer if needed
+         * @param matrices Model matrices, one per instance
+         * @param count Number of matrices
+         * @return Byte offset of the first uploaded matrix
+         */
+        uint32_t Upload(const glm::mat4* matrices, uint32_t count);
+
+        /**
+         * @brief Points the bound vertex array's instance attributes at uploaded data
+         * @param byteOffset Offset returned by Upload()
+         */
+        void BindAttributes(uint32_t byteOffset) const;
+
+        /** @brief Disables the instance attributes of the bound vertex array */
+        static void UnbindAttributes();
+
+    private:
+        uint32_t m_RendererID = 0;   ///< OpenGL buffer ID
+        uint32_t m_Capacity = 0;     ///< Capacity in instances
+        uint32_t m_Size = 0;         ///< Instances appended this frame
+    };
+}
@@ -84,4 +84,15 @@ namespace Engine {
         float m_SpecularStrength;    ///< Strength of specular highlights
         float m_Shininess;           ///< Shininess factor for specular calculations
     };
+
+    /** @brief Point light with a finite range, shaded through LightClusterGrid
+     *
+     *  Laid out as the two RGBA32F texels per light the clustered shader reads.
+     */
+    struct PointLight {
+        glm::vec3 position = glm::vec3(0.0f);  ///< World-space position
+        float radius = 10.0f;                  ///< Distance at which the light fades to zero
+        glm::vec3 color = glm::vec3(1.0f);
+        float intensity = 1.0f;
+    };
 }
\ No newline at end of file
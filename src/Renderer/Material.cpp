@@ -7,18 +7,28 @@
 #include "Material.h"
 #include "../Core/AssetManager.h"
 #include "../Shader/Shader.h"
+#include "RenderState.h"
 #include "Texture.h"
 
 namespace Engine {
     Material::Material(std::shared_ptr<Shader> shader)
-        : m_Shader(shader) {
+        : m_Shader(shader), m_SortID(s_NextSortID.fetch_add(1, std::memory_order_relaxed)) {
         // Use cached shader if available
-        std::string shaderPath = shader->GetPath(); // Need to add this getter
+        // Shaders built from source strings have no path and are not cached
+        std::string shaderPath = shader->GetPath();
+        if (shaderPath.empty()) return;
         if (auto cachedShader = AssetManager::Get().LoadResource<Shader>(shaderPath)) {
             m_Shader = cachedShader;
         }
     }
 
+    Material::~Material() {
+        // A later material allocated at this address must not inherit the uploaded state
+        if (m_Shader && m_Shader->GetUniformOwner() == this) {
+            m_Shader->SetUniformOwner(nullptr);
+        }
+    }
+
     /**
      * @brief Applies all material properties to the shader
      * 
@@ -26,27 +36,148 @@ namespace Engine {
      */
     void Material::Bind() {
         m_Shader->Bind();
-        
-        // Apply all properties
-        for (const auto& [name, value] : m_FloatProperties)
-            m_Shader->SetFloat(name, value);
-            
-        for (const auto& [name, value] : m_IntProperties)
-            m_Shader->SetInt(name, value);
-            
-        for (const auto& [name, value] : m_VectorProperties)
-            m_Shader->SetVector4(name, value);
-            
-        for (const auto& [name, value] : m_MatrixProperties)
-            m_Shader->SetMat4(name, value);
-            
-        // Bind textures
-        m_TextureSlot = 0;
-        for (const auto& [name, texture] : m_Textures) {
-            texture->Bind(m_TextureSlot);
-            m_Shader->SetInt(name, m_TextureSlot);
-            m_TextureSlot++;
+        ApplyProperties();
+    }
+
+    /**
+     * @brief Uploads dirty parameters and binds textures on the bound shader
+     * @details Locations are resolved again after a relink; values are uploaded
+     *          again when another material has applied its own to the program.
+     */
+    uint32_t Material::ApplyProperties() {
+        if (m_ResolvedGeneration != m_Shader->GetGeneration()) {
+            ResolveLocations();
+        }
+        if (m_Shader->GetUniformOwner() != this) {
+            for (auto& parameter : m_Parameters) parameter.dirty = true;
+            m_Shader->SetUniformOwner(this);
         }
+
+        uint32_t uploads = 0;
+        for (auto& parameter : m_Parameters) {
+            if (!parameter.dirty) continue;
+            parameter.dirty = false;
+            if (parameter.location < 0) continue;
+
+            const float* value = m_ParameterData.data() + parameter.offset;
+            switch (parameter.type) {
+                case MaterialParameterType::Float:
+                    m_Shader->SetFloat(parameter.location, value[0]);
+                    break;
+                case MaterialParameterType::Int: {
+                    int intValue;
+                    std::memcpy(&intValue, value, sizeof(int));
+                    m_Shader->SetInt(parameter.location, intValue);
+                    break;
+                }
+                case MaterialParameterType::Vector2:
+                    m_Shader->SetVector2(parameter.location, glm::vec2(value[0], value[1]));
+                    break;
+                case MaterialParameterType::Vector3:
+                    m_Shader->SetVector3(parameter.location,
+                                         glm::vec3(value[0], value[1], value[2]));
+                    break;
+                case MaterialParameterType::Vector4:
+                    m_Shader->SetVector4(parameter.location,
+                                         glm::vec4(value[0], value[1], value[2], value[3]));
+                    break;
+                case MaterialParameterType::Matrix4: {
+                    glm::mat4 matrix;
+                    std::memcpy(&matrix, value, sizeof(glm::mat4));
+                    m_Shader->SetMat4(parameter.location, matrix);
+                    break;
+                }
+            }
+            ++uploads;
+        }
+
+        // Texture units are global state, so they are bound on every apply. A unit
+        // without a texture is cleared so it does not sample the previous draw's.
+        for (uint32_t slot = 0; slot < m_Textures.size(); ++slot) {
+            if (m_Textures[slot].texture) {
+                m_Textures[slot].texture->Bind(slot);
+            } else {
+                RenderState::Get().BindTexture(slot, GL_TEXTURE_2D, 0);
+            }
+        }
+        return uploads;
+    }
+
+    void Material::ResolveLocations() {
+        for (auto& parameter : m_Parameters) {
+            parameter.location = m_Shader->GetUniformLocation(parameter.name);
+            parameter.dirty = true;
+        }
+        m_ResolvedGeneration = m_Shader->GetGeneration();
+    }
+
+    void Material::SetParameter(const std::string& name, MaterialParameterType type,
+                                const void* value, uint32_t floatCount) {
+        auto it = std::find_if(m_Parameters.begin(), m_Parameters.end(),
+                               [&](const MaterialParameter& parameter) {
+                                   return parameter.name == name;
+                               });
+
+        if (it != m_Parameters.end() && it->type == type) {
+            float* data = m_ParameterData.data() + it->offset;
+            if (std::memcmp(data, value, floatCount * sizeof(float)) != 0) {
+                std::memcpy(data, value, floatCount * sizeof(float));
+                it->dirty = true;
+            }
+            return;
+        }
+
+        if (it != m_Parameters.end()) {
+            // The type changed: reuse the storage if the size matches, else release it
+            const uint32_t oldCount = GetFloatCount(it->type);
+            if (oldCount == floatCount) {
+                std::memcpy(m_ParameterData.data() + it->offset, value,
+                            floatCount * sizeof(float));
+                it->type = type;
+                it->dirty = true;
+                return;
+            }
+            const uint32_t oldOffset = it->offset;
+            m_ParameterData.erase(m_ParameterData.begin() + oldOffset,
+                                  m_ParameterData.begin() + oldOffset + oldCount);
+            for (auto& parameter : m_Parameters) {
+                if (parameter.offset > oldOffset) parameter.offset -= oldCount;
+            }
+        }
+
+        // New parameter, or one whose storage was released: append fresh storage for it
+        const uint32_t offset = static_cast<uint32_t>(m_ParameterData.size());
+        m_ParameterData.resize(offset + floatCount);
+        std::memcpy(m_ParameterData.data() + offset, value, floatCount * sizeof(float));
+
+        if (it == m_Parameters.end()) {
+            MaterialParameter parameter{name, type, offset};
+            if (m_Shader && m_ResolvedGeneration == m_Shader->GetGeneration()) {
+                parameter.location = m_Shader->GetUniformLocation(name);
+            }
+            m_Parameters.push_back(std::move(parameter));
+        } else {
+            it->type = type;
+            it->offset = offset;
+            it->dirty = true;
+        }
+    }
+
+    uint32_t Material::GetFloatCount(MaterialParameterType type) {
+        switch (type) {
+            case MaterialParameterType::Float:
+            case MaterialParameterType::Int:
+                return 1;
+            case MaterialParameterType::Vector2:
+                return 2;
+            case MaterialParameterType::Vector3:
+                return 3;
+            case MaterialParameterType::Vector4:
+                return 4;
+            case MaterialParameterType::Matrix4:
+                return 16;
+        }
+        return 0;
     }
 
     /** @brief Unbinds the material's shader */
@@ -56,41 +187,54 @@ namespace Engine {
 
     /** @brief Sets a float property */
     void Material::SetFloat(const std::string& name, float value) {
-        m_FloatProperties[name] = value;
+        SetParameter(name, MaterialParameterType::Float, &value, 1);
     }
 
     /** @brief Sets an int property */
     void Material::SetInt(const std::string& name, int value) {
-        m_IntProperties[name] = value;
+        static_assert(sizeof(int) == sizeof(float), "Ints are stored in float slots");
+        SetParameter(name, MaterialParameterType::Int, &value, 1);
     }
 
     /** @brief Sets a bool property */
     void Material::SetBool(const std::string& name, bool value) {
-        m_IntProperties[name] = value ? 1 : 0;
+        SetInt(name, value ? 1 : 0);
     }
 
     /** @brief Sets a vec2 property */
     void Material::SetVector2(const std::string& name, const glm::vec2& value) {
-        m_VectorProperties[name] = glm::vec4(value.x, value.y, 0.0f, 0.0f);
+        const float data[2] = {value.x, value.y};
+        SetParameter(name, MaterialParameterType::Vector2, data, 2);
     }
 
     /** @brief Sets a vec3 property */
     void Material::SetVector3(const std::string& name, const glm::vec3& value) {
-        m_VectorProperties[name] = glm::vec4(value, 0.0f);
+        const float data[3] = {value.x, value.y, value.z};
+        SetParameter(name, MaterialParameterType::Vector3, data, 3);
     }
 
     /** @brief Sets a vec4 property */
     void Material::SetVector4(const std::string& name, const glm::vec4& value) {
-        m_VectorProperties[name] = value;
+        const float data[4] = {value.x, value.y, value.z, value.w};
+        SetParameter(name, MaterialParameterType::Vector4, data, 4);
     }
 
     /** @brief Sets a mat4 property */
     void Material::SetMatrix4(const std::string& name, const glm::mat4& value) {
-        m_MatrixProperties[name] = value;
+        static_assert(sizeof(glm::mat4) == 16 * sizeof(float), "mat4 must be 16 packed floats");
+        SetParameter(name, MaterialParameterType::Matrix4, &value, 16);
     }
 
-    /** @brief Sets a texture property */
+    /** @brief Sets a texture property, bound to a unit of its own */
     void Material::SetTexture(const std::string& name, const std::shared_ptr<Texture>& texture) {
-        m_Textures[name] = texture;
+        for (uint32_t slot = 0; slot < m_Textures.size(); ++slot) {
+            if (m_Textures[slot].name == name) {
+                m_Textures[slot].texture = texture;
+                return;
+            }
+        }
+        const int slot = static_cast<int>(m_Textures.size());
+        m_Textures.push_back({name, texture});
+        SetInt(name, slot);
     }
 }
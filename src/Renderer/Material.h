@@ -5,8 +5,36 @@
 #include "Texture.h"
 
 namespace Engine {
+    /** @brief Value types held by a material parameter block */
+    enum class MaterialParameterType : uint8_t {
+        Float,
+        Int,
+        Vector2,
+        Vector3,
+        Vector4,
+        Matrix4
+    };
+
+    /**
+     * @brief One entry of a material's parameter block
+     * @details The value lives in the material's flat data array; the location is
+     *          resolved once per shader link instead of by name on every bind.
+     */
+    struct MaterialParameter {
+        std::string name;                ///< Uniform name
+        MaterialParameterType type;      ///< Value type, selects the glUniform call
+        uint32_t offset;                 ///< First float of the value in the data block
+        GLint location = -1;             ///< Resolved uniform location
+        bool dirty = true;               ///< Value differs from what the program holds
+    };
+
     /**
      * @brief Manages shader parameters and textures for rendering
+     *
+     * Parameters are kept in a flat block with a dirty flag each, so applying a
+     * material uploads only values that changed since it last applied them. When
+     * another material used the shader in between, or the shader was relinked,
+     * every parameter is uploaded again.
      */
     class Material {
     public:
@@ -15,10 +43,18 @@ namespace Engine {
          * @param shader Shader program to use
          */
         Material(std::shared_ptr<Shader> shader);
-        ~Material() = default;
+        ~Material();
 
-        /** @brief Applies all material properties to the shader */
+        /** @brief Binds the shader and applies all material properties to it */
         void Bind();
+        /**
+         * @brief Applies the material properties to the already bound shader
+         * @details Lets the renderer skip rebinding a shader shared by consecutive materials.
+         *          Textures are always bound, a null one as texture 0; uniforms are
+         *          uploaded only when dirty.
+         * @return Number of uniform values uploaded
+         */
+        uint32_t ApplyProperties();
         /** @brief Unbinds the material's shader */
         void Unbind();
 
@@ -36,26 +72,64 @@ namespace Engine {
         void SetMatrix4(const std::string& name, const glm::mat4& value);
         void SetTexture(const std::string& name, const std::shared_ptr<Texture>& texture);
 
+        /** @return Small unique ID used to group draws in render sort keys */
+        uint32_t GetSortID() const { return m_SortID; }
+
         /** @return The shader used by this material */
         std::shared_ptr<Shader> GetShader() const { return m_Shader; }
 
-        /** @brief Sets the shader for this material */
-        void SetShader(const std::shared_ptr<Shader>& shader) { m_Shader = shader; }
+        /** @brief Sets the shader for this material; locations are resolved on next apply */
+        void SetShader(const std::shared_ptr<Shader>& shader) {
+            m_Shader = shader;
+            m_ResolvedGeneration = 0;
+        }
 
         // Add getter for textures
         std::shared_ptr<Texture> GetTexture(const std::string& name) const {
-            auto it = m_Textures.find(name);
-            return (it != m_Textures.end()) ? it->second : nullptr;
+            for (const auto& binding : m_Textures) {
+                if (binding.name == name) return binding.texture;
+            }
+            return nullptr;
         }
 
+        /** @brief Texture bound to the unit matching its index in GetTextures() */
+        struct TextureBinding {
+            std::string name;
+            std::shared_ptr<Texture> texture;
+        };
+
+        /** @return Parameters in the order they were first set */
+        const std::vector<MaterialParameter>& GetParameters() const { return m_Parameters; }
+        /** @return Flat parameter values, indexed by MaterialParameter::offset */
+        const std::vector<float>& GetParameterData() const { return m_ParameterData; }
+        /** @return Textures by unit */
+        const std::vector<TextureBinding>& GetTextures() const { return m_Textures; }
+
     private:
+        /**
+         * @brief Stores a value in the block, marking it dirty if it changed
+         * @param name Uniform name
+         * @param type Value type; a parameter set again with another type is replaced and
+         *             its old storage reused or released
+         * @param value Value to store
+         * @param floatCount Size of the value in floats
+         */
+        void SetParameter(const std::string& name, MaterialParameterType type, const void* value,
+                          uint32_t floatCount);
+
+        /** @return Size of a value of the given type, in floats */
+        static uint32_t GetFloatCount(MaterialParameterType type);
+
+        /** @brief Re-resolves every location against the shader's current link */
+        void ResolveLocations();
+
         std::shared_ptr<Shader> m_Shader;
-        std::unordered_map<std::string, glm::vec4> m_VectorProperties;
-        std::unordered_map<std::string, float> m_FloatProperties;
-        std::unordered_map<std::string, int> m_IntProperties;
-        std::unordered_map<std::string, bool> m_BoolProperties;
-        std::unordered_map<std::string, glm::mat4> m_MatrixProperties;
-        std::unordered_map<std::string, std::shared_ptr<Texture>> m_Textures;
-        uint32_t m_TextureSlot = 0;
+        std::vector<MaterialParameter> m_Parameters;  ///< Parameter descriptors
+        std::vector<float> m_ParameterData;           ///< Flat values of all parameters
+        std::vector<TextureBinding> m_Textures;       ///< Textures by unit
+        uint32_t m_ResolvedGeneration = 0;            ///< Shader link the locations belong to
+        uint32_t m_SortID = 0;
+
+        static inline std::atomic<uint32_t> s_NextSortID{1};
     };
 }
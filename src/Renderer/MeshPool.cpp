@@ -0,0 +1,155 @@
+/**
+ * @file MeshPool.cpp
+ * @brief Suballocation of meshes from shared vertex and index buffers
+ */
+#include "MeshPool.h"
+
+#include "DeferredRelease.h"
+
+namespace Engine {
+    MeshPool::MeshPool(const BufferLayout& layout, uint32_t vertexCapacity, uint32_t indexCapacity)
+        : m_Layout(layout),
+          m_FloatsPerVertex(layout.GetStride() / sizeof(float)),
+          m_VertexAllocator(std::max(vertexCapacity, 1u)),
+          m_IndexAllocator(std::max(indexCapacity, 1u)) {
+        ASSERT(m_FloatsPerVertex > 0 && layout.GetStride() % sizeof(float) == 0 &&
+               "MeshPool layout stride must be whole floats");
+        m_VertexData.resize(static_cast<size_t>(m_VertexAllocator.GetCapacity()) * m_FloatsPerVertex);
+        m_IndexData.resize(m_IndexAllocator.GetCapacity());
+        RebuildBuffers();
+    }
+
+    MeshPool::~MeshPool() {
+        // Commands recorded before the pool was dropped may still draw from it
+        DeferredRelease::Get().Retire(std::move(m_VertexArray));
+    }
+
+    MeshPool::Handle MeshPool::Allocate(const float* vertices, uint32_t vertexCount,
+                                        const uint32_t* indices, uint32_t indexCount,
+                                        const AABB& bounds) {
+        PROFILE_FUNCTION();
+        ASSERT(vertexCount > 0 && indexCount > 0 && "Empty mesh allocated from MeshPool");
+
+        auto vertexRange = m_VertexAllocator.Allocate(vertexCount);
+        auto indexRange = m_IndexAllocator.Allocate(indexCount);
+        bool rebuilt = false;
+        if (!vertexRange.IsValid() || !indexRange.IsValid()) {
+            if (vertexRange.IsValid()) m_VertexAllocator.Free(vertexRange);
+            if (indexRange.IsValid()) m_IndexAllocator.Free(indexRange);
+            Reserve(vertexCount, indexCount);
+            vertexRange = m_VertexAllocator.Allocate(vertexCount);
+            indexRange = m_IndexAllocator.Allocate(indexCount);
+            ASSERT(vertexRange.IsValid() && indexRange.IsValid() && "MeshPool failed to grow");
+            rebuilt = true;
+        }
+
+        const size_t firstFloat = static_cast<size_t>(vertexRange.offset) * m_FloatsPerVertex;
+        const size_t floatCount = static_cast<size_t>(vertexCount) * m_FloatsPerVertex;
+        std::memcpy(m_VertexData.data() + firstFloat, vertices, floatCount * sizeof(float));
+        std::memcpy(m_IndexData.data() + indexRange.offset, indices, indexCount * sizeof(uint32_t));
+
+        m_Bounds.Expand(bounds.min);
+        m_Bounds.Expand(bounds.max);
+        if (rebuilt) {
+            RebuildBuffers();
+        } else {
+            m_VertexBuffer->SetData(m_VertexData.data() + firstFloat,
+                                    static_cast<uint32_t>(firstFloat * sizeof(float)),
+                                    static_cast<uint32_t>(floatCount * sizeof(float)));
+            m_IndexBuffer->SetData(m_IndexData.data() + indexRange.offset, indexRange.offset,
+                                   indexCount);
+            m_VertexArray->SetBounds(m_Bounds);
+        }
+
+        Handle handle;
+        if (!m_FreeSlots.empty()) {
+            handle = m_FreeSlots.back();
+            m_FreeSlots.pop_back();
+        } else {
+            handle = static_cast<Handle>(m_Slots.size());
+            m_Slots.emplace_back();
+        }
+        m_Slots[handle] = {vertexRange, indexRange, bounds, true};
+        return handle;
+    }
+
+    void MeshPool::Free(Handle handle) {
+        ASSERT(handle < m_Slots.size() && m_Slots[handle].live && "Invalid MeshPool handle");
+        m_Slots[handle].live = false;
+
+        // The retired reference's deleter returns the ranges and keeps the pool alive until then
+        auto self = shared_from_this();
+        DeferredRelease::Get().Retire(std::shared_ptr<MeshPool>(
+            self.get(), [self, handle](MeshPool*) { self->ReleaseSlot(handle); }));
+    }
+
+    void MeshPool::ReleaseSlot(Handle handle) {
+        Slot& slot = m_Slots[handle];
+        m_VertexAllocator.Free(slot.vertices);
+        m_IndexAllocator.Free(slot.indices);
+        slot = Slot{};
+        m_FreeSlots.push_back(handle);
+    }
+
+    void MeshPool::Reserve(uint32_t vertexCount, uint32_t indexCount) {
+        const uint32_t vertexCapacity = std::max(m_VertexAllocator.GetCapacity() * 2,
+                                                 m_VertexAllocator.GetCapacity() + vertexCount);
+        const uint32_t indexCapacity = std::max(m_IndexAllocator.GetCapacity() * 2,
+                                                m_IndexAllocator.GetCapacity() + indexCount);
+        m_VertexAllocator.Grow(vertexCapacity);
+        m_IndexAllocator.Grow(indexCapacity);
+        m_VertexData.resize(static_cast<size_t>(vertexCapacity) * m_FloatsPerVertex);
+        m_IndexData.resize(indexCapacity);
+        LOG_TRACE_CONCAT("MeshPool grown to ", vertexCapacity, " vertices, ", indexCapacity,
+                         " indices");
+    }
+
+    void MeshPool::Defragment() {
+        PROFILE_FUNCTION();
+        std::unordered_map<uint32_t, Handle> vertexOwners, indexOwners;
+        for (Handle handle = 0; handle < m_Slots.size(); ++handle) {
+            if (!m_Slots[handle].vertices.IsValid()) continue;
+            vertexOwners[m_Slots[handle].vertices.node] = handle;
+            indexOwners[m_Slots[handle].indices.node] = handle;
+        }
+
+        // Moves go towards the front in ascending order, so memmove in order is safe
+        for (const auto& move : m_VertexAllocator.Defragment()) {
+            std::memmove(m_VertexData.data() + static_cast<size_t>(move.to) * m_FloatsPerVertex,
+                         m_VertexData.data() + static_cast<size_t>(move.from) * m_FloatsPerVertex,
+                         static_cast<size_t>(move.size) * m_FloatsPerVertex * sizeof(float));
+            m_Slots[vertexOwners[move.node]].vertices.offset = move.to;
+        }
+        for (const auto& move : m_IndexAllocator.Defragment()) {
+            std::memmove(m_IndexData.data() + move.to, m_IndexData.data() + move.from,
+                         move.size * sizeof(uint32_t));
+            m_Slots[indexOwners[move.node]].indices.offset = move.to;
+        }
+
+        // Ranges still waiting for release keep their bounds until they are freed
+        m_Bounds = AABB();
+        for (const auto& slot : m_Slots) {
+            if (!slot.vertices.IsValid()) continue;
+            m_Bounds.Expand(slot.bounds.min);
+            m_Bounds.Expand(slot.bounds.max);
+        }
+        RebuildBuffers();
+    }
+
+    void MeshPool::RebuildBuffers() {
+        PROFILE_FUNCTION();
+        DeferredRelease::Get().Retire(std::move(m_VertexArray));
+
+        m_VertexBuffer.reset(VertexBuffer::Create(
+            m_VertexData.data(), static_cast<uint32_t>(m_VertexData.size() * sizeof(float))));
+        m_VertexBuffer->SetLayout(m_Layout);
+        m_IndexBuffer.reset(
+            IndexBuffer::Create(m_IndexData.data(), static_cast<uint32_t>(m_IndexData.size())));
+
+        m_VertexArray.reset(VertexArray::Create());
+        m_VertexArray->AddVertexBuffer(m_VertexBuffer);
+        m_VertexArray->SetIndexBuffer(m_IndexBuffer);
+        m_VertexArray->SetBounds(m_Bounds);
+        m_VertexArray->Unbind();
+    }
+}
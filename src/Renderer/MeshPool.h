@@ -0,0 +1,118 @@
+#pragma once
+#include <pch.h>
+
+#include "../Core/RangeAllocator.h"
+#include "BoundingBox.h"
+#include "Buffer.h"
+#include "RenderCommandBuckets.h"
+#include "VertexArray.h"
+
+namespace Engine {
+    /**
+     * @brief Suballocates many small meshes of one vertex layout from a single vertex array
+     *
+     * Meshes get ranges of one large vertex buffer and one large index buffer,
+     * placed by a RangeAllocator counted in vertices and indices, and are drawn
+     * by submitting the shared vertex array with the mesh's DrawRange. Thousands
+     * of terrain chunks then cost one vertex array bind instead of one each, and
+     * no GL objects are created or deleted per mesh.
+     *
+     * Frustum culling uses the vertex array's bounds, the union of all meshes'
+     * bounds, with each command's transform; meshes should therefore share a
+     * local space, such as chunk-local coordinates placed by the transform.
+     *
+     * The pool keeps a CPU copy of both buffers, so growing and Defragment()
+     * rebuild the buffers from it instead of reading back or copying on the GPU.
+     * A rebuild creates a new vertex array and retires the old one through
+     * DeferredRelease, and Free() releases ranges only once the frames that
+     * may still draw them are done, so recorded commands stay valid.
+     *
+     * Create with std::make_shared; main thread only, except GetDrawRange() and
+     * GetVertexArray(), which recording threads may call while the pool is not
+     * modified.
+     */
+    class MeshPool : public std::enable_shared_from_this<MeshPool> {
+    public:
+        using Handle = uint32_t;
+        static constexpr Handle INVALID_HANDLE = ~0u;
+
+        /**
+         * @param layout Vertex layout of every mesh; its stride must be whole floats
+         * @param vertexCapacity Initial vertex capacity; the pool grows on demand
+         * @param indexCapacity Initial index capacity
+         */
+        explicit MeshPool(const BufferLayout& layout, uint32_t vertexCapacity = 1u << 16,
+                          uint32_t indexCapacity = 1u << 18);
+        ~MeshPool();
+
+        MeshPool(const MeshPool&) = delete;
+        MeshPool& operator=(const MeshPool&) = delete;
+
+        /**
+         * @brief Copies a mesh into the pool
+         * @param vertices Interleaved vertices in the pool's layout
+         * @param indices Indices relative to the mesh's first vertex
+         * @param bounds Bounds of the mesh's positions, merged into the pool's bounds
+         * @return Handle for GetDrawRange() and Free()
+         */
+        Handle Allocate(const float* vertices, uint32_t vertexCount, const uint32_t* indices,
+                        uint32_t indexCount, const AABB& bounds);
+
+        /** @brief Releases a mesh once the in-flight frames are drawn */
+        void Free(Handle handle);
+
+        /** @return Range to submit with GetVertexArray() to draw the mesh */
+        DrawRange GetDrawRange(Handle handle) const {
+            const Slot& slot = m_Slots[handle];
+            return {slot.indices.offset, slot.indices.size,
+                    static_cast<int32_t>(slot.vertices.offset)};
+        }
+
+        /** @return The vertex array every mesh of the pool is drawn from */
+        const std::shared_ptr<VertexArray>& GetVertexArray() const { return m_VertexArray; }
+
+        /**
+         * @brief Packs all meshes to the front of both buffers and recomputes the bounds
+         * @details Rebuilds the GL buffers; call when GetFragmentation() gets high
+         */
+        void Defragment();
+
+        /** @return Worst fragmentation of the vertex and index space, see RangeAllocator */
+        float GetFragmentation() const {
+            return std::max(m_VertexAllocator.GetFragmentation(),
+                            m_IndexAllocator.GetFragmentation());
+        }
+
+        uint32_t GetMeshCount() const { return m_VertexAllocator.GetAllocationCount(); }
+        const RangeAllocator& GetVertexAllocator() const { return m_VertexAllocator; }
+        const RangeAllocator& GetIndexAllocator() const { return m_IndexAllocator; }
+
+    private:
+        struct Slot {
+            RangeAllocator::Allocation vertices;
+            RangeAllocator::Allocation indices;
+            AABB bounds;
+            bool live = false;
+        };
+
+        /** @brief Returns a slot's ranges to the allocators; run by DeferredRelease */
+        void ReleaseSlot(Handle handle);
+        /** @brief Grows both spaces to fit the request, doubling at least */
+        void Reserve(uint32_t vertexCount, uint32_t indexCount);
+        /** @brief Recreates the GL objects from the CPU copy */
+        void RebuildBuffers();
+
+        BufferLayout m_Layout;
+        uint32_t m_FloatsPerVertex;
+        RangeAllocator m_VertexAllocator;
+        RangeAllocator m_IndexAllocator;
+        std::vector<float> m_VertexData;      ///< CPU copy of the vertex buffer
+        std::vector<uint32_t> m_IndexData;    ///< CPU copy of the index buffer
+        std::vector<Slot> m_Slots;
+        std::vector<Handle> m_FreeSlots;
+        AABB m_Bounds;                        ///< Union of the live meshes' bounds
+        std::shared_ptr<VertexArray> m_VertexArray;
+        std::shared_ptr<VertexBuffer> m_VertexBuffer;
+        std::shared_ptr<IndexBuffer> m_IndexBuffer;
+    };
+}
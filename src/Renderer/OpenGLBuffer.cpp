@@ -6,50 +6,94 @@
  */
 #include "OpenGLBuffer.h"
 #include <glad/glad.h>
+#include "RenderState.h"
 
 namespace Engine {
     OpenGLVertexBuffer::OpenGLVertexBuffer(const float* vertices, uint32_t size)
     {
         glGenBuffers(1, &m_RendererID);
-        glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+        RenderState::Get().BindBuffer(GL_ARRAY_BUFFER, m_RendererID);
         glBufferData(GL_ARRAY_BUFFER, size, vertices, GL_STATIC_DRAW);
+        m_Size = size;
+        if (vertices) m_ContentHash = HashBufferContents(vertices, size);
     }
 
     OpenGLVertexBuffer::~OpenGLVertexBuffer()
     {
+        RenderState::Get().OnBufferDeleted(m_RendererID);
         glDeleteBuffers(1, &m_RendererID);
     }
 
     void OpenGLVertexBuffer::Bind() const
     {
-        glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+        RenderState::Get().BindBuffer(GL_ARRAY_BUFFER, m_RendererID);
     }
 
     void OpenGLVertexBuffer::Unbind() const
     {
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        RenderState::Get().BindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    /**
+     * @brief Updates a byte range through the copy-write target
+     * @details Leaves GL_ARRAY_BUFFER and the bound vertex array's index buffer untouched
+     */
+    void OpenGLVertexBuffer::SetData(const void* data, uint32_t offset, uint32_t size)
+    {
+        ASSERT(offset + size <= m_Size && "Vertex buffer update out of range");
+        RenderState::Get().BindBuffer(GL_COPY_WRITE_BUFFER, m_RendererID);
+        glBufferSubData(GL_COPY_WRITE_BUFFER, offset, size, data);
+        m_ContentHash = m_ContentHash * 31 + (HashBufferContents(data, size) ^ offset);
+    }
+
+    /**
+     * @brief Respecifies the storage as GL_STREAM_DRAW, then uploads the used range
+     * @details Goes through the copy-write target like SetData()
+     */
+    void OpenGLVertexBuffer::Orphan(const void* data, uint32_t size)
+    {
+        ASSERT(size <= m_Size && "Vertex buffer upload larger than the buffer");
+        RenderState::Get().BindBuffer(GL_COPY_WRITE_BUFFER, m_RendererID);
+        glBufferData(GL_COPY_WRITE_BUFFER, m_Size, nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_COPY_WRITE_BUFFER, 0, size, data);
+        ++m_ContentHash;
     }
 
     OpenGLIndexBuffer::OpenGLIndexBuffer(const uint32_t* indices, uint32_t count)
         : m_Count(count)
     {
         glGenBuffers(1, &m_RendererID);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
+        RenderState::Get().BindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
         glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(uint32_t), indices, GL_STATIC_DRAW);
+        if (indices) m_ContentHash = HashBufferContents(indices, count * sizeof(uint32_t));
     }
 
     OpenGLIndexBuffer::~OpenGLIndexBuffer()
     {
+        RenderState::Get().OnBufferDeleted(m_RendererID);
         glDeleteBuffers(1, &m_RendererID);
     }
 
     void OpenGLIndexBuffer::Bind() const
     {
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
+        RenderState::Get().BindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
     }
 
     void OpenGLIndexBuffer::Unbind() const
     {
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        RenderState::Get().BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    }
+
+    /**
+     * @brief Updates a range of indices through the copy-write target
+     * @details Binding GL_ELEMENT_ARRAY_BUFFER would attach the buffer to the bound vertex array
+     */
+    void OpenGLIndexBuffer::SetData(const uint32_t* indices, uint32_t firstIndex, uint32_t count)
+    {
+        ASSERT(firstIndex + count <= m_Count && "Index buffer update out of range");
+        const uint32_t size = count * sizeof(uint32_t);
+        RenderState::Get().BindBuffer(GL_COPY_WRITE_BUFFER, m_RendererID);
+        glBufferSubData(GL_COPY_WRITE_BUFFER, firstIndex * sizeof(uint32_t), size, indices);
+        m_ContentHash = m_ContentHash * 31 + (HashBufferContents(indices, size) ^ firstIndex);
     }
-}
\ No newline at end of file
+}
@@ -23,6 +23,9 @@ namespace Engine {
         virtual void SetLayout(const BufferLayout& layout) override { m_Layout = layout; }
         virtual const BufferLayout& GetLayout() const override { return m_Layout; }
 
+        virtual void SetData(const void* data, uint32_t offset, uint32_t size) override;
+        virtual void Orphan(const void* data, uint32_t size) override;
+
     private:
         uint32_t m_RendererID;     ///< OpenGL buffer ID
         BufferLayout m_Layout;      ///< Buffer layout description
@@ -45,6 +48,8 @@ namespace Engine {
         virtual void Unbind() const override;
 
         virtual uint32_t GetCount() const override { return m_Count; }
+
+        virtual void SetData(const uint32_t* indices, uint32_t firstIndex, uint32_t count) override;
     private:
         uint32_t m_RendererID;     ///< OpenGL buffer ID
         uint32_t m_Count;          ///< Number of indices
@@ -4,6 +4,7 @@
  */
 #include "OpenGLVertexArray.h"
 #include <glad/glad.h>
+#include "RenderState.h"
 
 namespace Engine {
     /**
@@ -39,6 +40,7 @@ namespace Engine {
      * @brief Cleans up the OpenGL vertex array object
      */
     OpenGLVertexArray::~OpenGLVertexArray() {
+        RenderState::Get().OnVertexArrayDeleted(m_RendererID);
         glDeleteVertexArrays(1, &m_RendererID);
     }
 
@@ -46,14 +48,14 @@ namespace Engine {
      * @brief Binds this vertex array for rendering
      */
     void OpenGLVertexArray::Bind() const {
-        glBindVertexArray(m_RendererID);
+        RenderState::Get().BindVertexArray(m_RendererID);
     }
 
     /**
      * @brief Unbinds this vertex array
      */
     void OpenGLVertexArray::Unbind() const {
-        glBindVertexArray(0);
+        RenderState::Get().BindVertexArray(0);
     }
 
     /**
@@ -63,7 +65,7 @@ namespace Engine {
      * Sets up vertex attribute pointers based on the buffer's layout
      */
     void OpenGLVertexArray::AddVertexBuffer(const std::shared_ptr<VertexBuffer>& vertexBuffer) {
-        glBindVertexArray(m_RendererID);
+        RenderState::Get().BindVertexArray(m_RendererID);
         vertexBuffer->Bind();
 
         const auto& layout = vertexBuffer->GetLayout();
@@ -88,7 +90,7 @@ namespace Engine {
      * @param indexBuffer Buffer containing index data
      */
     void OpenGLVertexArray::SetIndexBuffer(const std::shared_ptr<IndexBuffer>& indexBuffer) {
-        glBindVertexArray(m_RendererID);
+        RenderState::Get().BindVertexArray(m_RendererID);
         indexBuffer->Bind();
         m_IndexBuffer = indexBuffer;
     }
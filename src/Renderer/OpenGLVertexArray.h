@@ -34,6 +34,8 @@ namespace Engine {
         virtual const std::vector<std::shared_ptr<VertexBuffer>>& GetVertexBuffers() const override { return m_VertexBuffers; }
         /** @return Current index buffer */
         virtual const std::shared_ptr<IndexBuffer>& GetIndexBuffer() const override { return m_IndexBuffer; }
+        /** @return OpenGL vertex array object ID */
+        virtual uint32_t GetRendererID() const override { return m_RendererID; }
 
     private:
         uint32_t m_RendererID;           ///< OpenGL vertex array object ID
@@ -0,0 +1,466 @@
+/**
+ * @file RecordingRenderAPI.cpp
+ * @brief GL call recorders installed in place of the glad function pointers
+ */
+#include "RecordingRenderAPI.h"
+
+#include <regex>
+
+#include "RenderState.h"
+
+/** @brief GL entry points the engine calls; each needs a recorder in RecordingGL */
+#define ENGINE_RECORDED_GL_FUNCTIONS(X) \
+    X(ActiveTexture)                    \
+    X(AttachShader)                     \
+    X(BindBuffer)                       \
+    X(BindTexture)                      \
+    X(BindVertexArray)                  \
+    X(BlendFunc)                        \
+    X(BufferData)                       \
+    X(BufferSubData)                    \
+    X(Clear)                            \
+    X(ClearColor)                       \
+    X(CompileShader)                    \
+    X(CreateProgram)                    \
+    X(CreateShader)                     \
+    X(CullFace)                         \
+    X(DeleteBuffers)                    \
+    X(DeleteProgram)                    \
+    X(DeleteShader)                     \
+    X(DeleteTextures)                   \
+    X(DeleteVertexArrays)               \
+    X(Disable)                          \
+    X(DisableVertexAttribArray)         \
+    X(DrawArrays)                       \
+    X(DrawElements)                     \
+    X(DrawElementsBaseVertex)           \
+    X(DrawElementsInstanced)            \
+    X(DrawElementsInstancedBaseVertex)  \
+    X(Enable)                           \
+    X(EnableVertexAttribArray)          \
+    X(FrontFace)                        \
+    X(GenBuffers)                       \
+    X(GenTextures)                      \
+    X(GenVertexArrays)                  \
+    X(GetActiveAttrib)                  \
+    X(GetActiveUniform)                 \
+    X(GetAttribLocation)                \
+    X(GetError)                         \
+    X(GetProgramInfoLog)                \
+    X(GetProgramiv)                     \
+    X(GetShaderInfoLog)                 \
+    X(GetShaderiv)                      \
+    X(GetUniformLocation)               \
+    X(IsEnabled)                        \
+    X(LinkProgram)                      \
+    X(PolygonMode)                      \
+    X(ShaderSource)                     \
+    X(TexBuffer)                        \
+    X(TexImage2D)                       \
+    X(TexParameteri)                    \
+    X(Uniform1f)                        \
+    X(Uniform1i)                        \
+    X(Uniform2f)                        \
+    X(Uniform3f)                        \
+    X(Uniform4f)                        \
+    X(UniformMatrix4fv)                 \
+    X(UseProgram)                       \
+    X(VertexAttribDivisor)              \
+    X(VertexAttribPointer)              \
+    X(Viewport)
+
+namespace Engine {
+    struct RecordingRenderAPI::FunctionPointers {
+#define ENGINE_DECLARE_POINTER(name) decltype(glad_gl##name) name;
+        ENGINE_RECORDED_GL_FUNCTIONS(ENGINE_DECLARE_POINTER)
+#undef ENGINE_DECLARE_POINTER
+    };
+
+    namespace {
+        /**
+         * @return Total bytes of an upload's pixel data, assuming one byte per channel;
+         *         0 when no data is passed. Logged with glTexImage2D calls.
+         */
+        double PixelDataSize(GLsizei width, GLsizei height, GLenum format, const void* data) {
+            if (!data) return 0.0;
+            const int channels = format == GL_RGBA ? 4 : format == GL_RGB ? 3 : 1;
+            return static_cast<double>(width) * height * channels;
+        }
+    }
+
+    /** @brief Recorders with the exact signatures of the GL functions they replace */
+    struct RecordingGL {
+        static RecordingRenderAPI& Api() { return *RecordingRenderAPI::s_Active; }
+
+        static void APIENTRY ActiveTexture(GLenum unit) { Api().Record("glActiveTexture", unit); }
+        static void APIENTRY AttachShader(GLuint program, GLuint shader) {
+            Api().m_Programs[program].shaders.push_back(shader);
+            Api().Record("glAttachShader", program, shader);
+        }
+        static void APIENTRY BindBuffer(GLenum target, GLuint buffer) {
+            Api().Record("glBindBuffer", target, buffer);
+        }
+        static void APIENTRY BindTexture(GLenum target, GLuint texture) {
+            Api().Record("glBindTexture", target, texture);
+        }
+        static void APIENTRY BindVertexArray(GLuint vertexArray) {
+            Api().Record("glBindVertexArray", vertexArray);
+        }
+        static void APIENTRY BlendFunc(GLenum source, GLenum destination) {
+            Api().Record("glBlendFunc", source, destination);
+        }
+        static void APIENTRY BufferData(GLenum target, GLsizeiptr size, const void*, GLenum usage) {
+            Api().Record("glBufferData", target, size, usage);
+        }
+        static void APIENTRY BufferSubData(GLenum target, GLintptr offset, GLsizeiptr size,
+                                           const void*) {
+            Api().Record("glBufferSubData", target, offset, size);
+        }
+        static void APIENTRY Clear(GLbitfield mask) { Api().Record("glClear", mask); }
+        static void APIENTRY ClearColor(GLfloat r, GLfloat g, GLfloat b, GLfloat a) {
+            Api().Record("glClearColor", r, g, b, a);
+        }
+        static void APIENTRY CompileShader(GLuint shader) { Api().Record("glCompileShader", shader); }
+        static GLuint APIENTRY CreateProgram() {
+            GLuint program = Api().CreateName();
+            Api().m_Programs[program];
+            Api().Record("glCreateProgram", program);
+            return program;
+        }
+        static GLuint APIENTRY CreateShader(GLenum type) {
+            GLuint shader = Api().CreateName();
+            Api().Record("glCreateShader", type, shader);
+            return shader;
+        }
+        static void APIENTRY CullFace(GLenum mode) { Api().Record("glCullFace", mode); }
+        static void APIENTRY DeleteBuffers(GLsizei count, const GLuint* buffers) {
+            for (GLsizei i = 0; i < count; ++i) Api().Record("glDeleteBuffers", buffers[i]);
+        }
+        static void APIENTRY DeleteProgram(GLuint program) {
+            Api().m_Programs.erase(program);
+            Api().Record("glDeleteProgram", program);
+        }
+        static void APIENTRY DeleteShader(GLuint shader) {
+            Api().m_ShaderSources.erase(shader);
+            Api().Record("glDeleteShader", shader);
+        }
+        static void APIENTRY DeleteTextures(GLsizei count, const GLuint* textures) {
+            for (GLsizei i = 0; i < count; ++i) Api().Record("glDeleteTextures", textures[i]);
+        }
+        static void APIENTRY DeleteVertexArrays(GLsizei count, const GLuint* vertexArrays) {
+            for (GLsizei i = 0; i < count; ++i) {
+                Api().Record("glDeleteVertexArrays", vertexArrays[i]);
+            }
+        }
+        static void APIENTRY Disable(GLenum capability) {
+            Api().m_EnabledCapabilities.erase(capability);
+            Api().Record("glDisable", capability);
+        }
+        static void APIENTRY DisableVertexAttribArray(GLuint index) {
+            Api().Record("glDisableVertexAttribArray", index);
+        }
+        static void APIENTRY DrawArrays(GLenum mode, GLint first, GLsizei count) {
+            Api().Record("glDrawArrays", mode, first, count);
+        }
+        static void APIENTRY DrawElements(GLenum mode, GLsizei count, GLenum type,
+                                          const void* offset) {
+            Api().Record("glDrawElements", mode, count, type, reinterpret_cast<uintptr_t>(offset));
+        }
+        static void APIENTRY DrawElementsBaseVertex(GLenum mode, GLsizei count, GLenum type,
+                                                    const void* offset, GLint baseVertex) {
+            Api().Record("glDrawElementsBaseVertex", mode, count, type,
+                         reinterpret_cast<uintptr_t>(offset), baseVertex);
+        }
+        static void APIENTRY DrawElementsInstanced(GLenum mode, GLsizei count, GLenum type,
+                                                   const void* offset, GLsizei instances) {
+            Api().Record("glDrawElementsInstanced", mode, count, type,
+                         reinterpret_cast<uintptr_t>(offset), instances);
+        }
+        static void APIENTRY DrawElementsInstancedBaseVertex(GLenum mode, GLsizei count,
+                                                             GLenum type, const void* offset,
+                                                             GLsizei instances, GLint baseVertex) {
+            Api().Record("glDrawElementsInstancedBaseVertex", mode, count, type,
+                         reinterpret_cast<uintptr_t>(offset), instances, baseVertex);
+        }
+        static void APIENTRY Enable(GLenum capability) {
+            Api().m_EnabledCapabilities.insert(capability);
+            Api().Record("glEnable", capability);
+        }
+        static void APIENTRY EnableVertexAttribArray(GLuint index) {
+            Api().Record("glEnableVertexAttribArray", index);
+        }
+        static void APIENTRY FrontFace(GLenum mode) { Api().Record("glFrontFace", mode); }
+        static void APIENTRY GenBuffers(GLsizei count, GLuint* buffers) {
+            for (GLsizei i = 0; i < count; ++i) {
+                buffers[i] = Api().CreateName();
+                Api().Record("glGenBuffers", buffers[i]);
+            }
+        }
+        static void APIENTRY GenTextures(GLsizei count, GLuint* textures) {
+            for (GLsizei i = 0; i < count; ++i) {
+                textures[i] = Api().CreateName();
+                Api().Record("glGenTextures", textures[i]);
+            }
+        }
+        static void APIENTRY GenVertexArrays(GLsizei count, GLuint* vertexArrays) {
+            for (GLsizei i = 0; i < count; ++i) {
+                vertexArrays[i] = Api().CreateName();
+                Api().Record("glGenVertexArrays", vertexArrays[i]);
+            }
+        }
+        static void APIENTRY GetActiveAttrib(GLuint program, GLuint index, GLsizei bufSize,
+                                             GLsizei* length, GLint* size, GLenum* type,
+                                             GLchar* name) {
+            const auto& attributes = Api().m_Programs[program].attributes;
+            const std::string& attribute =
+                index < attributes.size() ? attributes[index].first : std::string();
+            const GLsizei written =
+                std::min<GLsizei>(static_cast<GLsizei>(attribute.size()), std::max(bufSize - 1, 0));
+            if (bufSize > 0) {
+                std::copy_n(attribute.data(), written, name);
+                name[written] = '\0';
+            }
+            if (length) *length = written;
+            if (size) *size = 1;
+            if (type) *type = GL_FLOAT_VEC4;
+        }
+        static void APIENTRY GetActiveUniform(GLuint program, GLuint index, GLsizei bufSize,
+                                              GLsizei* length, GLint* size, GLenum* type,
+                                              GLchar* name) {
+            const auto& uniforms = Api().m_Programs[program].uniforms;
+            const std::string& uniform = index < uniforms.size() ? uniforms[index] : std::string();
+            const GLsizei written =
+                std::min<GLsizei>(static_cast<GLsizei>(uniform.size()), std::max(bufSize - 1, 0));
+            if (bufSize > 0) {
+                std::copy_n(uniform.data(), written, name);
+                name[written] = '\0';
+            }
+            if (length) *length = written;
+            if (size) *size = 1;
+            if (type) *type = GL_FLOAT;
+        }
+        static GLint APIENTRY GetAttribLocation(GLuint program, const GLchar* name) {
+            const auto& attributes = Api().m_Programs[program].attributes;
+            auto it = std::find_if(attributes.begin(), attributes.end(),
+                                   [name](const auto& attribute) { return attribute.first == name; });
+            return it != attributes.end() ? it->second : -1;
+        }
+        static GLenum APIENTRY GetError() { return GL_NO_ERROR; }
+        static void APIENTRY GetProgramInfoLog(GLuint, GLsizei bufSize, GLsizei* length,
+                                               GLchar* log) {
+            if (length) *length = 0;
+            if (bufSize > 0) log[0] = '\0';
+        }
+        static void APIENTRY GetProgramiv(GLuint program, GLenum name, GLint* value) {
+            const auto& uniforms = Api().m_Programs[program].uniforms;
+            const auto& attributes = Api().m_Programs[program].attributes;
+            switch (name) {
+                case GL_ACTIVE_UNIFORMS:
+                    *value = static_cast<GLint>(uniforms.size());
+                    break;
+                case GL_ACTIVE_UNIFORM_MAX_LENGTH: {
+                    size_t longest = 0;
+                    for (const auto& uniform : uniforms) longest = std::max(longest, uniform.size());
+                    *value = static_cast<GLint>(longest + 1);
+                    break;
+                }
+                case GL_ACTIVE_ATTRIBUTES:
+                    *value = static_cast<GLint>(attributes.size());
+                    break;
+                case GL_ACTIVE_ATTRIBUTE_MAX_LENGTH: {
+                    size_t longest = 0;
+                    for (const auto& attribute : attributes) {
+                        longest = std::max(longest, attribute.first.size());
+                    }
+                    *value = static_cast<GLint>(longest + 1);
+                    break;
+                }
+                default:
+                    *value = GL_TRUE;  // Link and validate status
+                    break;
+            }
+        }
+        static void APIENTRY GetShaderInfoLog(GLuint, GLsizei bufSize, GLsizei* length,
+                                              GLchar* log) {
+            if (length) *length = 0;
+            if (bufSize > 0) log[0] = '\0';
+        }
+        static void APIENTRY GetShaderiv(GLuint, GLenum, GLint* value) {
+            *value = GL_TRUE;  // Compile status
+        }
+        static GLint APIENTRY GetUniformLocation(GLuint program, const GLchar* name) {
+            const auto& uniforms = Api().m_Programs[program].uniforms;
+            auto it = std::find(uniforms.begin(), uniforms.end(), name);
+            return it != uniforms.end() ? static_cast<GLint>(it - uniforms.begin()) : -1;
+        }
+        static GLboolean APIENTRY IsEnabled(GLenum capability) {
+            return Api().m_EnabledCapabilities.count(capability) ? GL_TRUE : GL_FALSE;
+        }
+        static void APIENTRY LinkProgram(GLuint program) {
+            Api().LinkProgram(program);
+            Api().Record("glLinkProgram", program);
+        }
+        static void APIENTRY PolygonMode(GLenum face, GLenum mode) {
+            Api().Record("glPolygonMode", face, mode);
+        }
+        static void APIENTRY ShaderSource(GLuint shader, GLsizei count, const GLchar* const* sources,
+                                          const GLint* lengths) {
+            std::string& source = Api().m_ShaderSources[shader];
+            source.clear();
+            for (GLsizei i = 0; i < count; ++i) {
+                if (lengths && lengths[i] >= 0) {
+                    source.append(sources[i], lengths[i]);
+                } else {
+                    source.append(sources[i]);
+                }
+            }
+            Api().Record("glShaderSource", shader, source.size());
+        }
+        static void APIENTRY TexBuffer(GLenum target, GLenum internalFormat, GLuint buffer) {
+            Api().Record("glTexBuffer", target, internalFormat, buffer);
+        }
+        static void APIENTRY TexImage2D(GLenum target, GLint level, GLint internalFormat,
+                                        GLsizei width, GLsizei height, GLint, GLenum format,
+                                        GLenum type, const void* data) {
+            Api().Record("glTexImage2D", target, level, internalFormat, width, height, format,
+                         type, PixelDataSize(width, height, format, data));
+        }
+        static void APIENTRY TexParameteri(GLenum target, GLenum name, GLint value) {
+            Api().Record("glTexParameteri", target, name, value);
+        }
+        static void APIENTRY Uniform1f(GLint location, GLfloat x) {
+            Api().Record("glUniform1f", location, x);
+        }
+        static void APIENTRY Uniform1i(GLint location, GLint x) {
+            Api().Record("glUniform1i", location, x);
+        }
+        static void APIENTRY Uniform2f(GLint location, GLfloat x, GLfloat y) {
+            Api().Record("glUniform2f", location, x, y);
+        }
+        static void APIENTRY Uniform3f(GLint location, GLfloat x, GLfloat y, GLfloat z) {
+            Api().Record("glUniform3f", location, x, y, z);
+        }
+        static void APIENTRY Uniform4f(GLint location, GLfloat x, GLfloat y, GLfloat z, GLfloat w) {
+            Api().Record("glUniform4f", location, x, y, z, w);
+        }
+        static void APIENTRY UniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose,
+                                              const GLfloat* value) {
+            // The translation column identifies the matrix well enough for comparisons
+            Api().Record("glUniformMatrix4fv", location, count, transpose, value[12], value[13],
+                         value[14]);
+        }
+        static void APIENTRY UseProgram(GLuint program) { Api().Record("glUseProgram", program); }
+        static void APIENTRY VertexAttribDivisor(GLuint index, GLuint divisor) {
+            Api().Record("glVertexAttribDivisor", index, divisor);
+        }
+        static void APIENTRY VertexAttribPointer(GLuint index, GLint size, GLenum type,
+                                                 GLboolean normalized, GLsizei stride,
+                                                 const void* offset) {
+            Api().Record("glVertexAttribPointer", index, size, type, normalized, stride,
+                         reinterpret_cast<uintptr_t>(offset));
+        }
+        static void APIENTRY Viewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+            Api().Record("glViewport", x, y, width, height);
+        }
+    };
+
+    RecordingRenderAPI::RecordingRenderAPI() = default;
+
+    RecordingRenderAPI::~RecordingRenderAPI() {
+        Shutdown();
+    }
+
+    void RecordingRenderAPI::Init() {
+        if (IsInstalled()) return;
+        ASSERT(s_Active == nullptr && "Another RecordingRenderAPI is installed");
+
+        m_Saved = std::make_unique<FunctionPointers>();
+#define ENGINE_INSTALL_RECORDER(name)     \
+    m_Saved->name = glad_gl##name;        \
+    glad_gl##name = &RecordingGL::name;
+        ENGINE_RECORDED_GL_FUNCTIONS(ENGINE_INSTALL_RECORDER)
+#undef ENGINE_INSTALL_RECORDER
+
+        s_Active = this;
+        RenderState::Get().Invalidate();
+    }
+
+    void RecordingRenderAPI::Shutdown() {
+        if (!IsInstalled()) return;
+
+#define ENGINE_RESTORE_POINTER(name) glad_gl##name = m_Saved->name;
+        ENGINE_RECORDED_GL_FUNCTIONS(ENGINE_RESTORE_POINTER)
+#undef ENGINE_RESTORE_POINTER
+
+        m_Saved.reset();
+        s_Active = nullptr;
+        RenderState::Get().Invalidate();
+    }
+
+    void RecordingRenderAPI::SetViewport(int x, int y, int width, int height) {
+        glViewport(x, y, width, height);
+    }
+
+    void RecordingRenderAPI::SetClearColor(const glm::vec4& color) {
+        glClearColor(color.r, color.g, color.b, color.a);
+    }
+
+    void RecordingRenderAPI::Clear() {
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    }
+
+    void RecordingRenderAPI::DrawIndexed(uint32_t indexCount) {
+        glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, nullptr);
+    }
+
+    void RecordingRenderAPI::DrawArrays(uint32_t vertexCount) {
+        glDrawArrays(GL_TRIANGLES, 0, vertexCount);
+    }
+
+    size_t RecordingRenderAPI::CountCalls(std::string_view function) const {
+        return std::count_if(m_Calls.begin(), m_Calls.end(),
+                             [function](const Call& call) { return call.function == function; });
+    }
+
+    std::string RecordingRenderAPI::Dump() const {
+        std::ostringstream out;
+        for (const Call& call : m_Calls) {
+            out << call.function << '(';
+            for (uint8_t i = 0; i < call.argCount; ++i) {
+                out << (i ? ", " : "") << call.args[i];
+            }
+            out << ")\n";
+        }
+        return out.str();
+    }
+
+    /**
+     * @brief Reflects uniforms and attribute locations from the attached sources
+     * @details A lexical scan is enough for the engine's shaders: every declared
+     *          uniform and located attribute is reported active, in declaration order.
+     */
+    void RecordingRenderAPI::LinkProgram(GLuint program) {
+        static const std::regex uniformPattern(R"(\buniform\s+\w+\s+(\w+)\s*(\[)?)");
+        static const std::regex attributePattern(
+            R"(layout\s*\(\s*location\s*=\s*(\d+)\s*\)\s*in\s+\w+\s+(\w+))");
+
+        ProgramInfo& info = m_Programs[program];
+        info.uniforms.clear();
+        info.attributes.clear();
+        for (GLuint shader : info.shaders) {
+            const std::string& source = m_ShaderSources[shader];
+            for (std::sregex_iterator it(source.begin(), source.end(), uniformPattern), end;
+                 it != end; ++it) {
+                std::string name = (*it)[1].str() + ((*it)[2].matched ? "[0]" : "");
+                if (std::find(info.uniforms.begin(), info.uniforms.end(), name) ==
+                    info.uniforms.end()) {
+                    info.uniforms.push_back(std::move(name));
+                }
+            }
+            for (std::sregex_iterator it(source.begin(), source.end(), attributePattern), end;
+                 it != end; ++it) {
+                info.attributes.emplace_back((*it)[2].str(), std::stoi((*it)[1].str()));
+            }
+        }
+    }
+}
@@ -0,0 +1,98 @@
+#pragma once
+#include <pch.h>
+#include <glad/glad.h>
+#include <unordered_set>
+
+#include "RenderAPI.h"
+
+namespace Engine {
+    /**
+     * @brief Headless render backend that records GL calls instead of issuing them
+     *
+     * Init() swaps the glad function pointers the engine uses for recorders, so
+     * Renderer, Renderer2D, TerrainSystem and scenes run unchanged without a
+     * context or GPU. Object creation returns fresh names, shader sources are
+     * scanned for uniforms and attribute locations so reflection works, and
+     * queries report success. Shutdown() restores the previous pointers.
+     *
+     * Each state-changing call is appended to an in-memory log with its scalar
+     * arguments; data pointers are logged as byte counts, so Dump() is stable
+     * across runs and suitable for golden comparisons. Queries are not logged.
+     *
+     * Select it at startup with RenderAPI::SetAPI(RenderAPI::API::None) and
+     * RenderAPI::Create(), before Renderer::Initialize(). Main thread only;
+     * one instance may be installed at a time.
+     */
+    class RecordingRenderAPI : public RenderAPI {
+    public:
+        /** @brief Maximum scalar arguments kept per call */
+        static constexpr size_t MAX_ARGS = 8;
+
+        /** @brief One recorded GL call */
+        struct Call {
+            const char* function;                ///< GL entry point name
+            std::array<double, MAX_ARGS> args;   ///< Scalar arguments in order
+            uint8_t argCount;                    ///< Number of valid args
+        };
+
+        RecordingRenderAPI();
+        ~RecordingRenderAPI() override;
+
+        RecordingRenderAPI(const RecordingRenderAPI&) = delete;
+        RecordingRenderAPI& operator=(const RecordingRenderAPI&) = delete;
+
+        /** @brief Installs the recorders in place of the current GL function pointers */
+        void Init() override;
+        /** @brief Restores the function pointers saved by Init() */
+        void Shutdown();
+        bool IsInstalled() const { return s_Active == this; }
+
+        void SetViewport(int x, int y, int width, int height) override;
+        void SetClearColor(const glm::vec4& color) override;
+        void Clear() override;
+        void DrawIndexed(uint32_t indexCount) override;
+        void DrawArrays(uint32_t vertexCount) override;
+
+        /** @return Calls recorded since the last ClearLog() */
+        const std::vector<Call>& GetCalls() const { return m_Calls; }
+        /** @return Number of recorded calls to a function, e.g. "glDrawElements" */
+        size_t CountCalls(std::string_view function) const;
+        /** @brief Drops the log; created objects stay valid */
+        void ClearLog() { m_Calls.clear(); }
+
+        /** @return The log as one "glName(arg, ...)" line per call */
+        std::string Dump() const;
+
+        /** @return Installed instance, or null when GL calls reach the driver */
+        static RecordingRenderAPI* GetActive() { return s_Active; }
+
+    private:
+        struct FunctionPointers;
+        struct ProgramInfo {
+            std::vector<GLuint> shaders;                            ///< Attached shaders
+            std::vector<std::string> uniforms;                      ///< Location = index
+            std::vector<std::pair<std::string, GLint>> attributes;  ///< Declared locations
+        };
+
+        friend struct RecordingGL;
+
+        template<typename... Args>
+        void Record(const char* function, Args... args) {
+            static_assert(sizeof...(Args) <= MAX_ARGS, "Too many recorded arguments");
+            Call call{function, {static_cast<double>(args)...}, sizeof...(Args)};
+            m_Calls.push_back(call);
+        }
+
+        GLuint CreateName() { return m_NextName++; }
+        void LinkProgram(GLuint program);
+
+        std::unique_ptr<FunctionPointers> m_Saved;                 ///< Pointers replaced by Init()
+        std::vector<Call> m_Calls;
+        std::unordered_map<GLuint, std::string> m_ShaderSources;
+        std::unordered_map<GLuint, ProgramInfo> m_Programs;
+        std::unordered_set<GLenum> m_EnabledCapabilities;
+        GLuint m_NextName = 1;
+
+        static inline RecordingRenderAPI* s_Active = nullptr;
+    };
+}
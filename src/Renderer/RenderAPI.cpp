@@ -0,0 +1,28 @@
+/**
+ * @file RenderAPI.cpp
+ * @brief Render backend selection
+ */
+#include "RenderAPI.h"
+
+#include "RecordingRenderAPI.h"
+
+namespace Engine {
+    RenderAPI::API RenderAPI::s_API = RenderAPI::API::OpenGL;
+
+    /**
+     * @brief Creates the backend selected with SetAPI()
+     * @return New backend owned by the caller, or null for OpenGL, whose calls
+     *         go straight to the glad-loaded driver functions
+     */
+    RenderAPI* RenderAPI::Create() {
+        switch (s_API) {
+            case API::None:
+                return new RecordingRenderAPI();
+            case API::OpenGL:
+                return nullptr;
+            default:
+                ASSERT(false && "Render API not supported");
+                return nullptr;
+        }
+    }
+}
@@ -5,7 +5,7 @@ namespace Engine {
     class RenderAPI {
     public:
         enum class API {
-            None = 0,
+            None = 0,       ///< Headless: GL calls are recorded, see RecordingRenderAPI
             OpenGL,
             Vulkan,
             DirectX11,
@@ -0,0 +1,109 @@
+#pragma once
+#include <pch.h>
+#include <glad/glad.h>
+
+#include "../Core/FrameArena.h"
+#include "../Core/TaskSystem.h"
+#include "RenderSortKey.h"
+
+namespace Engine {
+    class VertexArray;
+    class Material;
+
+    /**
+     * @brief Part of a vertex array's index buffer drawn by a command
+     * @details The default draws the whole index buffer. Meshes suballocated from
+     *          a MeshPool share one vertex array and differ only in their range.
+     */
+    struct DrawRange {
+        uint32_t firstIndex = 0;   ///< First index drawn
+        uint32_t indexCount = 0;   ///< Indices drawn; 0 for the whole index buffer
+        int32_t baseVertex = 0;    ///< Added to every index
+
+        bool operator==(const DrawRange& other) const {
+            return firstIndex == other.firstIndex && indexCount == other.indexCount &&
+                   baseVertex == other.baseVertex;
+        }
+        bool operator!=(const DrawRange& other) const { return !(*this == other); }
+    };
+
+    /**
+     * @brief Structure containing information for a render command
+     * @details Holds raw handles: submitters keep the resources alive until the
+     *          frame is drawn, retiring replaced ones through DeferredRelease
+     */
+    struct RenderCommand {
+        VertexArray* vertexArray;                    ///< Vertex array to render
+        Material* material;                          ///< Material to use
+        GLenum primitiveType;                        ///< OpenGL primitive type
+        glm::mat4 transformMatrix;                   ///< Transform
+        RenderPass pass;                             ///< Pass the command is drawn in
+        DrawRange range;                             ///< Indices drawn
+    };
+
+    /**
+     * @brief One frame's render commands, split into a bucket per recording thread
+     *
+     * Each TaskSystem worker appends to its own FrameArena, so parallel scene
+     * traversal shares no cache lines while recording. Threads outside the
+     * pool share bucket 0, which stays correct because FrameArena appends are
+     * thread-safe. Gather() merges the buckets for sorting at Flush time.
+     */
+    class RenderCommandBuckets {
+    public:
+        /**
+         * @param bucketCount Number of buckets; use TaskSystem worker count + 1
+         *                    so every thread index gets its own
+         */
+        explicit RenderCommandBuckets(size_t bucketCount) {
+            m_Buckets.reserve(std::max<size_t>(1, bucketCount));
+            for (size_t i = 0; i < std::max<size_t>(1, bucketCount); ++i) {
+                m_Buckets.push_back(std::make_unique<FrameArena<RenderCommand>>());
+            }
+        }
+
+        /** @return Bucket for a thread index; out-of-range indices share bucket 0 */
+        FrameArena<RenderCommand>& GetBucket(size_t index) {
+            return *m_Buckets[index < m_Buckets.size() ? index : 0];
+        }
+
+        /** @return Bucket owned by the calling thread */
+        FrameArena<RenderCommand>& GetCurrentThreadBucket() {
+            return GetBucket(TaskSystem::GetCurrentThreadIndex());
+        }
+
+        size_t GetBucketCount() const { return m_Buckets.size(); }
+
+        /** @return Total commands across all buckets */
+        size_t Size() const {
+            size_t total = 0;
+            for (const auto& bucket : m_Buckets) total += bucket->Size();
+            return total;
+        }
+
+        /**
+         * @brief Collects pointers to every command, bucket by bucket
+         * @param commands Output list, resized to Size(); reuse it across frames
+         * @note Must not run concurrently with recording
+         */
+        void Gather(std::vector<const RenderCommand*>& commands) const {
+            commands.resize(Size());
+            size_t offset = 0;
+            for (const auto& bucket : m_Buckets) {
+                const size_t count = bucket->Size();
+                for (size_t i = 0; i < count; ++i) {
+                    commands[offset + i] = &(*bucket)[i];
+                }
+                offset += count;
+            }
+        }
+
+        /** @brief Drops all commands, keeping each bucket's blocks */
+        void Reset() {
+            for (auto& bucket : m_Buckets) bucket->Reset();
+        }
+
+    private:
+        std::vector<std::unique_ptr<FrameArena<RenderCommand>>> m_Buckets;
+    };
+}
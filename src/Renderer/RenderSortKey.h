@@ -0,0 +1,123 @@
+#pragma once
+#include <pch.h>
+
+namespace Engine {
+    /**
+     * @brief Render passes, drawn in enum order
+     */
+    enum class RenderPass : uint8_t {
+        Opaque = 0,       ///< Sorted by state, then front to back
+        Transparent = 1   ///< Sorted back to front, then by state
+    };
+
+    /**
+     * @brief Packs draw state into a 64-bit key so that sorting by key groups
+     *        draws that share a shader, material and vertex array
+     *
+     * Opaque layout (MSB to LSB):
+     *   pass:2 | shader:12 | material:16 | vertexArray:14 | depth:20
+     * Transparent layout:
+     *   pass:2 | ~depth:20 | shader:12 | material:16 | vertexArray:14
+     *
+     * IDs wider than their field are truncated. That only weakens grouping:
+     * the renderer compares the actual objects before skipping a bind.
+     */
+    namespace RenderSortKey {
+        constexpr uint32_t PASS_BITS = 2;
+        constexpr uint32_t SHADER_BITS = 12;
+        constexpr uint32_t MATERIAL_BITS = 16;
+        constexpr uint32_t VERTEX_ARRAY_BITS = 14;
+        constexpr uint32_t DEPTH_BITS = 20;
+        static_assert(PASS_BITS + SHADER_BITS + MATERIAL_BITS + VERTEX_ARRAY_BITS + DEPTH_BITS == 64,
+                      "Sort key fields must fill 64 bits");
+
+        constexpr uint64_t Mask(uint32_t bits) { return (uint64_t(1) << bits) - 1; }
+
+        /**
+         * @brief Quantises a normalised depth to the key's depth field
+         * @param depth01 Depth in [0, 1], 0 being nearest; clamped
+         */
+        inline uint64_t QuantizeDepth(float depth01) {
+            depth01 = std::clamp(depth01, 0.0f, 1.0f);
+            return static_cast<uint64_t>(depth01 * static_cast<float>(Mask(DEPTH_BITS)));
+        }
+
+        /**
+         * @brief Builds the sort key for a draw
+         * @param pass Render pass
+         * @param shaderID Shader program ID
+         * @param materialID Material sort ID
+         * @param vertexArrayID Vertex array ID
+         * @param depth01 Normalised depth, 0 being nearest
+         */
+        inline uint64_t Encode(RenderPass pass, uint32_t shaderID, uint32_t materialID,
+                               uint32_t vertexArrayID, float depth01) {
+            uint64_t key = static_cast<uint64_t>(pass) & Mask(PASS_BITS);
+            uint64_t depth = QuantizeDepth(depth01);
+            uint64_t state = ((shaderID & Mask(SHADER_BITS)) << (MATERIAL_BITS + VERTEX_ARRAY_BITS)) |
+                             ((materialID & Mask(MATERIAL_BITS)) << VERTEX_ARRAY_BITS) |
+                             (vertexArrayID & Mask(VERTEX_ARRAY_BITS));
+
+            if (pass == RenderPass::Transparent) {
+                // Back to front takes priority over state for correct blending
+                depth = Mask(DEPTH_BITS) - depth;
+                return (key << 62) | (depth << 42) | state;
+            }
+            return (key << 62) | (state << DEPTH_BITS) | depth;
+        }
+
+        /** @brief Key paired with the index of the command it belongs to */
+        struct Entry {
+            uint64_t key;
+            uint32_t index;
+        };
+
+        /**
+         * @brief Stable LSD radix sort of entries by key, 8 bits per pass
+         * @details Passes in which every key has the same digit are skipped, so
+         *          keys that differ only in a few fields sort in few passes.
+         * @param entries Entries to sort, sorted in place
+         * @param scratch Scratch buffer, resized as needed; reuse it across frames
+         */
+        inline void RadixSort(std::vector<Entry>& entries, std::vector<Entry>& scratch) {
+            constexpr uint32_t RADIX_BITS = 8;
+            constexpr uint32_t BUCKETS = 1u << RADIX_BITS;
+            constexpr uint32_t PASSES = 64 / RADIX_BITS;
+
+            const size_t count = entries.size();
+            if (count < 2) return;
+            scratch.resize(count);
+
+            // One histogram per digit, built in a single read of the keys
+            std::array<std::array<uint32_t, BUCKETS>, PASSES> histograms{};
+            for (const Entry& entry : entries) {
+                for (uint32_t pass = 0; pass < PASSES; ++pass) {
+                    ++histograms[pass][(entry.key >> (pass * RADIX_BITS)) & (BUCKETS - 1)];
+                }
+            }
+
+            Entry* source = entries.data();
+            Entry* destination = scratch.data();
+            for (uint32_t pass = 0; pass < PASSES; ++pass) {
+                auto& histogram = histograms[pass];
+                const uint32_t shift = pass * RADIX_BITS;
+                if (histogram[(source[0].key >> shift) & (BUCKETS - 1)] == count) continue;
+
+                uint32_t offset = 0;
+                for (uint32_t& bucket : histogram) {
+                    uint32_t bucketCount = bucket;
+                    bucket = offset;
+                    offset += bucketCount;
+                }
+                for (size_t i = 0; i < count; ++i) {
+                    destination[histogram[(source[i].key >> shift) & (BUCKETS - 1)]++] = source[i];
+                }
+                std::swap(source, destination);
+            }
+
+            if (source != entries.data()) {
+                std::copy(source, source + count, entries.data());
+            }
+        }
+    }
+}
@@ -0,0 +1,155 @@
+/**
+ * @file RenderState.cpp
+ * @brief Redundant GL call filtering
+ */
+#include "RenderState.h"
+
+namespace Engine {
+    GLFunctionTable GLFunctionTable::Native() {
+        // Forward at call time: glad's pointers are only loaded after the table is created
+        GLFunctionTable table;
+        table.useProgram = [](GLuint program) { glUseProgram(program); };
+        table.bindVertexArray = [](GLuint vertexArray) { glBindVertexArray(vertexArray); };
+        table.bindBuffer = [](GLenum target, GLuint buffer) { glBindBuffer(target, buffer); };
+        table.activeTexture = [](GLenum unit) { glActiveTexture(unit); };
+        table.bindTexture = [](GLenum target, GLuint texture) { glBindTexture(target, texture); };
+        table.enable = [](GLenum capability) { glEnable(capability); };
+        table.disable = [](GLenum capability) { glDisable(capability); };
+        return table;
+    }
+
+    RenderState::RenderState() : m_Functions(GLFunctionTable::Native()) {
+        Invalidate();
+    }
+
+    void RenderState::SetFunctionTable(const GLFunctionTable& functions) {
+        ASSERT(functions.useProgram && functions.bindVertexArray && functions.bindBuffer &&
+               functions.activeTexture && functions.bindTexture && functions.enable &&
+               functions.disable && "Incomplete GL function table");
+        m_Functions = functions;
+        Invalidate();
+    }
+
+    int RenderState::TextureTargetIndex(GLenum target) {
+        switch (target) {
+            case GL_TEXTURE_2D: return 0;
+            case GL_TEXTURE_2D_ARRAY: return 1;
+            case GL_TEXTURE_3D: return 2;
+            case GL_TEXTURE_CUBE_MAP: return 3;
+            default: return -1;
+        }
+    }
+
+    int RenderState::BufferTargetIndex(GLenum target) {
+        switch (target) {
+            case GL_ARRAY_BUFFER: return 0;
+            case GL_ELEMENT_ARRAY_BUFFER: return 1;
+            case GL_UNIFORM_BUFFER: return 2;
+            case GL_PIXEL_UNPACK_BUFFER: return 3;
+            case GL_COPY_WRITE_BUFFER: return 4;
+            default: return -1;
+        }
+    }
+
+    void RenderState::UseProgram(GLuint program) {
+        if (Filter(m_Program, program, Call::UseProgram)) {
+            m_Functions.useProgram(program);
+        }
+    }
+
+    void RenderState::BindVertexArray(GLuint vertexArray) {
+        if (Filter(m_VertexArray, vertexArray, Call::BindVertexArray)) {
+            m_Functions.bindVertexArray(vertexArray);
+            // The element array binding belongs to the vertex array just bound
+            m_Buffers[BufferTargetIndex(GL_ELEMENT_ARRAY_BUFFER)] = UNKNOWN;
+        }
+    }
+
+    void RenderState::BindBuffer(GLenum target, GLuint buffer) {
+        const int index = BufferTargetIndex(target);
+        if (index < 0) {
+            ++m_Current.issued[static_cast<size_t>(Call::BindBuffer)];
+            m_Functions.bindBuffer(target, buffer);
+            return;
+        }
+        if (Filter(m_Buffers[index], buffer, Call::BindBuffer)) {
+            m_Functions.bindBuffer(target, buffer);
+        }
+    }
+
+    void RenderState::ActiveTexture(uint32_t unit) {
+        if (Filter(m_ActiveUnit, unit, Call::ActiveTexture)) {
+            m_Functions.activeTexture(GL_TEXTURE0 + unit);
+        }
+    }
+
+    void RenderState::BindTexture(uint32_t unit, GLenum target, GLuint texture) {
+        const int index = TextureTargetIndex(target);
+        if (index >= 0 && unit < MAX_TEXTURE_UNITS) {
+            GLuint& cached = m_Textures[unit][index];
+            if (cached == texture) {
+                ++m_Current.skipped[static_cast<size_t>(Call::BindTexture)];
+                return;
+            }
+            ActiveTexture(unit);
+            cached = texture;
+        } else {
+            ActiveTexture(unit);
+        }
+        ++m_Current.issued[static_cast<size_t>(Call::BindTexture)];
+        m_Functions.bindTexture(target, texture);
+    }
+
+    void RenderState::SetEnabled(GLenum capability, bool enabled) {
+        auto it = std::find_if(m_Capabilities.begin(), m_Capabilities.end(),
+                               [capability](const auto& entry) { return entry.first == capability; });
+        if (it == m_Capabilities.end()) {
+            m_Capabilities.emplace_back(capability, UNKNOWN);
+            it = std::prev(m_Capabilities.end());
+        }
+        if (Filter(it->second, enabled ? 1u : 0u, Call::Capability)) {
+            enabled ? m_Functions.enable(capability) : m_Functions.disable(capability);
+        }
+    }
+
+    void RenderState::OnProgramDeleted(GLuint program) {
+        // A program in use stays alive until replaced, but its name may be reused after
+        if (m_Program == program) m_Program = UNKNOWN;
+    }
+
+    void RenderState::OnVertexArrayDeleted(GLuint vertexArray) {
+        if (m_VertexArray == vertexArray) {
+            m_VertexArray = 0;
+            m_Buffers[BufferTargetIndex(GL_ELEMENT_ARRAY_BUFFER)] = UNKNOWN;
+        }
+    }
+
+    void RenderState::OnBufferDeleted(GLuint buffer) {
+        for (GLuint& bound : m_Buffers) {
+            if (bound == buffer) bound = 0;
+        }
+    }
+
+    void RenderState::OnTextureDeleted(GLuint texture) {
+        for (auto& unit : m_Textures) {
+            for (GLuint& bound : unit) {
+                if (bound == texture) bound = 0;
+            }
+        }
+    }
+
+    void RenderState::Invalidate() {
+        m_Program = UNKNOWN;
+        m_VertexArray = UNKNOWN;
+        m_Buffers.fill(UNKNOWN);
+        m_ActiveUnit = UNKNOWN;
+        for (auto& unit : m_Textures) unit.fill(UNKNOWN);
+        for (auto& capability : m_Capabilities) capability.second = UNKNOWN;
+    }
+
+    void RenderState::EndFrame() {
+        m_LastFrame = m_Current;
+        m_Current = Counters{};
+        Invalidate();
+    }
+}
@@ -0,0 +1,161 @@
+#pragma once
+#include <pch.h>
+#include <glad/glad.h>
+
+namespace Engine {
+    /**
+     * @brief OpenGL entry points used by RenderState
+     * @details Native() forwards to the loaded driver. Tools and headless
+     *          benchmarks install their own table to run without a GPU.
+     */
+    struct GLFunctionTable {
+        void (*useProgram)(GLuint program);
+        void (*bindVertexArray)(GLuint vertexArray);
+        void (*bindBuffer)(GLenum target, GLuint buffer);
+        void (*activeTexture)(GLenum unit);
+        void (*bindTexture)(GLenum target, GLuint texture);
+        void (*enable)(GLenum capability);
+        void (*disable)(GLenum capability);
+
+        /** @return Table calling the glad-loaded functions at call time */
+        static GLFunctionTable Native();
+    };
+
+    /**
+     * @brief Cache of bound GL objects and enable flags that filters redundant calls
+     *
+     * Engine code binds programs, vertex arrays, buffers and textures through
+     * this class instead of calling GL directly, so binding what is already
+     * bound costs a comparison instead of a driver call. Element array buffer
+     * bindings are vertex array state and are forgotten on every vertex array
+     * change. Texture targets other than 2D, 2D array, 3D and cube maps are
+     * passed through uncached.
+     *
+     * Main (GL) thread only. GL calls made around the tracker leave the cache
+     * stale; call Invalidate() after them. EndFrame() invalidates as well, which
+     * bounds the damage of an untracked call to a single frame.
+     */
+    class RenderState {
+    public:
+        /** @brief Kinds of state changes counted per frame */
+        enum class Call : uint8_t {
+            UseProgram,
+            BindVertexArray,
+            BindBuffer,
+            ActiveTexture,
+            BindTexture,
+            Capability,
+            Count
+        };
+
+        /** @brief Issued and skipped calls, per Call kind */
+        struct Counters {
+            std::array<uint32_t, static_cast<size_t>(Call::Count)> issued{};
+            std::array<uint32_t, static_cast<size_t>(Call::Count)> skipped{};
+
+            uint32_t TotalIssued() const { return Sum(issued); }
+            uint32_t TotalSkipped() const { return Sum(skipped); }
+
+        private:
+            template<typename Array>
+            static uint32_t Sum(const Array& values) {
+                uint32_t total = 0;
+                for (uint32_t value : values) total += value;
+                return total;
+            }
+        };
+
+        /** @brief Texture units tracked; higher units are passed through */
+        static constexpr uint32_t MAX_TEXTURE_UNITS = 32;
+
+        /** @return Reference to the singleton instance */
+        static RenderState& Get() {
+            static RenderState instance;
+            return instance;
+        }
+
+        /**
+         * @brief Routes all calls to another function table and forgets cached state
+         * @param functions Table to call; every entry must be non-null
+         */
+        void SetFunctionTable(const GLFunctionTable& functions);
+        const GLFunctionTable& GetFunctionTable() const { return m_Functions; }
+
+        void UseProgram(GLuint program);
+        void BindVertexArray(GLuint vertexArray);
+        void BindBuffer(GLenum target, GLuint buffer);
+
+        /** @brief Makes a texture unit active, for calls that act on the active unit */
+        void ActiveTexture(uint32_t unit);
+
+        /**
+         * @brief Binds a texture to a unit, activating the unit first if needed
+         * @param unit Texture unit index, not GL_TEXTURE0-based
+         * @param target Texture target such as GL_TEXTURE_2D
+         * @param texture Texture name, 0 to unbind
+         */
+        void BindTexture(uint32_t unit, GLenum target, GLuint texture);
+
+        /** @brief Enables or disables a capability such as GL_DEPTH_TEST */
+        void SetEnabled(GLenum capability, bool enabled);
+        void Enable(GLenum capability) { SetEnabled(capability, true); }
+        void Disable(GLenum capability) { SetEnabled(capability, false); }
+
+        /** @return Active texture unit as last set through the tracker */
+        uint32_t GetActiveTextureUnit() const { return m_ActiveUnit == UNKNOWN ? 0 : m_ActiveUnit; }
+
+        /** @name Deletion notifications; GL resets bindings of deleted objects to 0 */
+        ///@{
+        void OnProgramDeleted(GLuint program);
+        void OnVertexArrayDeleted(GLuint vertexArray);
+        void OnBufferDeleted(GLuint buffer);
+        void OnTextureDeleted(GLuint texture);
+        ///@}
+
+        /** @brief Forgets all cached state so the next call of each kind is issued */
+        void Invalidate();
+
+        /** @brief Publishes this frame's counters, resets them and invalidates the cache */
+        void EndFrame();
+
+        /** @return Counters of the last completed frame */
+        const Counters& GetFrameCounters() const { return m_LastFrame; }
+
+        /** @return Counters accumulated since the last EndFrame() */
+        const Counters& GetCurrentCounters() const { return m_Current; }
+
+    private:
+        RenderState();
+
+        static constexpr GLuint UNKNOWN = ~0u;
+        static constexpr size_t TEXTURE_TARGETS = 4;
+        static constexpr size_t BUFFER_TARGETS = 5;
+
+        /** @return Cache slot of a texture target, or -1 if it is not cached */
+        static int TextureTargetIndex(GLenum target);
+        /** @return Cache slot of a buffer target, or -1 if it is not cached */
+        static int BufferTargetIndex(GLenum target);
+
+        /** @brief Counts a call and reports whether it must reach GL */
+        bool Filter(GLuint& cached, GLuint value, Call call) {
+            auto index = static_cast<size_t>(call);
+            if (cached == value) {
+                ++m_Current.skipped[index];
+                return false;
+            }
+            cached = value;
+            ++m_Current.issued[index];
+            return true;
+        }
+
+        GLFunctionTable m_Functions;
+        GLuint m_Program = UNKNOWN;
+        GLuint m_VertexArray = UNKNOWN;
+        std::array<GLuint, BUFFER_TARGETS> m_Buffers{};
+        GLuint m_ActiveUnit = UNKNOWN;
+        std::array<std::array<GLuint, TEXTURE_TARGETS>, MAX_TEXTURE_UNITS> m_Textures{};
+        std::vector<std::pair<GLenum, GLuint>> m_Capabilities;  ///< Capability, 0/1/UNKNOWN
+        Counters m_Current;
+        Counters m_LastFrame;
+    };
+}
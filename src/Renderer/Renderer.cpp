@@ -7,36 +7,53 @@
 #include "../Camera/OrthographicCamera.h"
 #include "../Core/TaskSystem.h"
 #include "../Shader/Shader.h"
+#include "FrustumCulling.h"
 #include "Material.h"
+#include "RecordingRenderAPI.h"
+#include "RenderState.h"
 #include "VertexArray.h"
 
 namespace Engine {
+/** @return Command buckets needed for every TaskSystem thread index to get its own */
+static size_t GetCommandBucketCount() { return TaskSystem::Get().GetWorkerCount() + 1; }
+
 /**
  * @brief The Renderer class handles all rendering operations in the engine
+ * @details Creates one command bucket per TaskSystem thread index for each command list.
+ *          A renderer built before the TaskSystem starts gets a single shared bucket;
+ *          SwapCommandBuffers() resizes the lists once the workers exist.
  */
-Renderer::Renderer() {}
+Renderer::Renderer() {
+    const size_t bucketCount = GetCommandBucketCount();
+    for (auto& commandList : m_CommandLists) {
+        commandList = std::make_unique<RenderCommandBuckets>(bucketCount);
+    }
+}
 
 Renderer::~Renderer() {}
 
 /**
  * @brief Initialize the renderer and graphics context
- * @details Sets up GLAD and creates camera instances
+ * @details Sets up GLAD, unless the headless RenderAPI is selected, and creates camera instances
  */
 void Renderer::Initialize() {
-    // Initialize OpenGL
-    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+    // Initialize OpenGL; headless runs have the recording backend installed instead
+    if (RenderAPI::GetAPI() == RenderAPI::API::None) {
+        ASSERT(RecordingRenderAPI::GetActive() && "Headless renderer needs RecordingRenderAPI::Init");
+    } else if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
         ASSERT(false && "Failed to initialize GLAD");
         return;
     }
 
     // Setup OpenGL state
-    glEnable(GL_DEPTH_TEST);
-    glEnable(GL_BLEND);
+    RenderState::Get().Enable(GL_DEPTH_TEST);
+    RenderState::Get().Enable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
     // Initialize cameras
     m_Camera = std::make_shared<OrthographicCamera>(-1.6f, 1.6f, -0.9f, 0.9f);
     m_PerspectiveCamera = std::make_shared<PerspectiveCamera>(45.0f, 1280.0f / 720.0f);
+    m_InstanceBuffer = std::make_unique<InstanceBuffer>();
 
     ASSERT(m_Camera != nullptr && "Failed to create orthographic camera");
     ASSERT(m_PerspectiveCamera != nullptr && "Failed to create perspective camera");
@@ -48,33 +65,60 @@ void Renderer::Initialize() {
  * @param material The material to use for rendering
  * @param transformMatrix The transform matrix for the object
  * @param primitiveType The OpenGL primitive type to render
+ * @param pass The render pass the command belongs to
  */
 void Renderer::Submit(const std::shared_ptr<VertexArray>& vertexArray,
                       const std::shared_ptr<Material>& material, const glm::mat4& transformMatrix,
-                      GLenum primitiveType) {
+                      GLenum primitiveType, RenderPass pass, const DrawRange& range) {
     // Assert valid parameters
     ASSERT(vertexArray != nullptr && "Null vertex array submitted");
     ASSERT(material != nullptr && "Null material submitted");
     ASSERT(material->GetShader() != nullptr && "Material has null shader");
 
     // Assert valid primitive type
-    ASSERT(primitiveType == GL_TRIANGLES || primitiveType == GL_LINES ||
-           primitiveType == GL_POINTS && "Invalid primitive type");
-
-    // Don't bind or set uniforms here, just submit the command
-    RenderCommand command;
-    command.vertexArray = vertexArray;
-    command.material = material;
-    command.primitiveType = primitiveType;
-    command.transformMatrix = transformMatrix;
-
-    std::lock_guard<std::mutex> lock(m_QueueMutex);
-    m_CommandQueue.push(command);
+    ASSERT((primitiveType == GL_TRIANGLES || primitiveType == GL_LINES ||
+            primitiveType == GL_POINTS) &&
+           "Invalid primitive type");
+
+    // Don't bind or set uniforms here, just append the command to this thread's bucket
+    m_CommandLists[m_SubmitListIndex]->GetCurrentThreadBucket().Emplace(
+        vertexArray.get(), material.get(), primitiveType, transformMatrix, pass, range);
+}
+
+/**
+ * @brief Make the recorded command list the one drawn by the next Flush()
+ * @details The previous front list was reset by Flush(), so the new back list
+ *          starts empty but keeps its blocks. It is rebuilt instead if the
+ *          TaskSystem worker count changed since it was created. No Submit() may
+ *          run concurrently.
+ */
+void Renderer::SwapCommandBuffers() {
+    ASSERT(!m_ProcessingFrame && "Swapping command buffers during Flush");
+    m_SubmitListIndex ^= 1;
+    auto& commandList = m_CommandLists[m_SubmitListIndex];
+    const size_t bucketCount = GetCommandBucketCount();
+    if (commandList->GetBucketCount() != bucketCount) {
+        commandList = std::make_unique<RenderCommandBuckets>(bucketCount);
+    } else {
+        commandList->Reset();
+    }
 }
 
 /**
- * @brief Process and execute all queued render commands
- * @details Processes commands in parallel using the TaskSystem and renders on the main thread
+ * @brief Normalised depth of an object's origin for sort keys
+ * @return 0 at the near plane, 1 at the far plane or behind the camera
+ */
+static float ComputeSortDepth(const glm::mat4& viewProjection, const glm::mat4& model) {
+    glm::vec4 clip = viewProjection * model[3];
+    if (clip.w <= 0.0f) return 1.0f;
+    return clip.z / clip.w * 0.5f + 0.5f;
+}
+
+/**
+ * @brief Process and execute the published render commands
+ * @details Processes commands and builds sort keys in parallel using the TaskSystem, radix
+ *          sorts them, then renders on the main thread skipping redundant state changes.
+ *          Reads only the front command list, so workers may keep submitting meanwhile.
  */
 void Renderer::Flush() {
     // Assert we're not recursively processing frames
@@ -83,69 +127,222 @@ void Renderer::Flush() {
         return;  // Already processing a frame
     }
 
-    std::vector<PreprocessedRenderCommand> commands;
-    {
-        std::lock_guard<std::mutex> lock(m_QueueMutex);
-        while (!m_CommandQueue.empty()) {
-            auto cmd = m_CommandQueue.front();
-            commands.push_back(
-                {cmd.vertexArray, cmd.material, cmd.primitiveType, cmd.transformMatrix});
-            m_CommandQueue.pop();
+    const auto flushStart = std::chrono::steady_clock::now();
+    RenderStatistics stats;
+
+    RenderCommandBuckets& buckets = *m_CommandLists[m_SubmitListIndex ^ 1];
+    const glm::mat4 viewProjection = m_ViewProjectionOverride ? *m_ViewProjectionOverride
+                                     : m_CameraType == CameraType::Orthographic
+                                         ? m_Camera->GetViewProjectionMatrix()
+                                         : m_PerspectiveCamera->GetViewProjectionMatrix();
+
+    // Merge the per-thread buckets, then cull and build sort keys in parallel, reusing
+    // last frame's buffers
+    auto& commands = m_DrawList;
+    buckets.Gather(commands);
+    const size_t commandCount = commands.size();
+    m_SortEntries.resize(commandCount);
+    m_Visibility.resize(commandCount);
+
+    if (m_Capture) {
+        m_Capture->RecordFrame(commands, viewProjection, m_FrustumCullingEnabled,
+                               m_InstancingEnabled);
+        if (--m_CaptureFramesLeft == 0) {
+            m_Capture->Save(m_CapturePath);
+            m_Capture.reset();
         }
     }
 
-    static bool taskSystemInitialized = false;
-    if (!taskSystemInitialized) {
-        TaskSystem::Get().Initialize();
-        taskSystemInitialized = true;
-    }
+    const bool cull = m_FrustumCullingEnabled;
+    const Frustum frustum = m_CameraType == CameraType::Perspective && !m_ViewProjectionOverride
+                                ? m_PerspectiveCamera->GetFrustum()
+                                : Frustum::FromViewProjection(viewProjection);
+    {
+        PROFILE_SCOPE("Renderer::Flush::Preprocess");
+        constexpr size_t BATCH_SIZE = FrustumCulling::BATCH_SIZE;
+        const size_t batchCount = (commandCount + BATCH_SIZE - 1) / BATCH_SIZE;
+        TaskSystem::Get().ParallelFor(0, batchCount, 0, [&](size_t batchIndex) {
+            const size_t first = batchIndex * BATCH_SIZE;
+            const size_t count = std::min(BATCH_SIZE, commandCount - first);
+
+            FrustumCulling::BoxBatch boxes;
+            uint32_t unbounded = 0;  // Lanes without bounds are always visible
+            for (size_t lane = 0; lane < BATCH_SIZE; ++lane) {
+                if (lane >= count) {
+                    FrustumCulling::ClearBox(boxes, lane);
+                    continue;
+                }
 
-    // Process commands in parallel using TaskSystem
-    std::vector<std::future<void>> futures;
-    const size_t batchSize = 64;  // Number of commands to process per task
+                const auto& cmd = *commands[first + lane];
+                uint64_t key = RenderSortKey::Encode(
+                    cmd.pass, cmd.material->GetShader()->GetProgram(), cmd.material->GetSortID(),
+                    cmd.vertexArray->GetRendererID(),
+                    ComputeSortDepth(viewProjection, cmd.transformMatrix));
+                m_SortEntries[first + lane] = {key, static_cast<uint32_t>(first + lane)};
 
-    for (size_t i = 0; i < commands.size(); i += batchSize) {
-        size_t end = std::min(i + batchSize, commands.size());
-        futures.push_back(TaskSystem::Get().EnqueueTask([this, &commands, i, end]() {
-            for (size_t j = i; j < end; j++) {
-                auto& cmd = commands[j];
-                // Do CPU-intensive work here (transformations, frustum culling, etc.)
+                const AABB& bounds = cmd.vertexArray->GetBounds();
+                if (cull && bounds.IsValid()) {
+                    FrustumCulling::SetBox(boxes, lane, bounds, cmd.transformMatrix);
+                } else {
+                    FrustumCulling::ClearBox(boxes, lane);
+                    unbounded |= 1u << lane;
+                }
             }
-        }));
-    }
 
-    for (auto& future : futures) {
-        future.wait();
+            const uint32_t visible = cull ? FrustumCulling::TestBatch(frustum, boxes) | unbounded
+                                          : ~0u;
+            for (size_t lane = 0; lane < count; ++lane) {
+                m_Visibility[first + lane] = static_cast<uint8_t>((visible >> lane) & 1u);
+            }
+        });
+
+        // Drop culled commands before sorting
+        size_t visibleCount = 0;
+        for (size_t i = 0; i < commandCount; ++i) {
+            if (m_Visibility[i]) m_SortEntries[visibleCount++] = m_SortEntries[i];
+        }
+        m_SortEntries.resize(visibleCount);
+        stats.submitted = static_cast<uint32_t>(commandCount);
+        stats.culled = static_cast<uint32_t>(commandCount - visibleCount);
+    }
+    {
+        PROFILE_SCOPE("Renderer::Flush::Sort");
+        RenderSortKey::RadixSort(m_SortEntries, m_SortScratch);
     }
+    stats.sortMs = std::chrono::duration<float, std::milli>(
+        std::chrono::steady_clock::now() - flushStart).count();
+
+    // Execute render commands on main thread in key order, skipping redundant binds.
+    // Sorting places draws sharing a vertex array and material next to each other, so
+    // each such run is drawn with one instanced call where the shader supports it.
+    const Shader* boundShader = nullptr;
+    const Material* boundMaterial = nullptr;
+    const VertexArray* boundVertexArray = nullptr;
+    bool shaderInstanced = false;
+    GLint modelLocation = -1;
+    GLint instancedLocation = -1;
+    if (m_InstanceBuffer) m_InstanceBuffer->BeginFrame();
+
+    const size_t drawCount = m_SortEntries.size();
+    for (size_t i = 0; i < drawCount;) {
+        const auto& command = *commands[m_SortEntries[i].index];
 
-    // Execute render commands on main thread
-    for (const auto& command : commands) {
         // Assert required components are valid before rendering
         ASSERT(command.vertexArray->GetIndexBuffer() != nullptr && "Null index buffer");
         ASSERT(command.vertexArray->GetIndexBuffer()->GetCount() > 0 && "Empty index buffer");
 
-        command.material->Bind();
-        auto shader = command.material->GetShader();
+        const auto& shader = command.material->GetShader();
         ASSERT(shader != nullptr && "Null shader in material");
 
-        if (m_CameraType == CameraType::Orthographic) {
-            shader->SetMat4("u_ViewProjection", m_Camera->GetViewProjectionMatrix());
-        } else {
-            shader->SetMat4("u_ViewProjection", m_PerspectiveCamera->GetViewProjectionMatrix());
+        if (shader.get() != boundShader) {
+            shader->Bind();
+            shader->SetMat4("u_ViewProjection", viewProjection);
+            modelLocation = shader->GetUniformLocation("u_Model");
+            instancedLocation = shader->GetUniformLocation("u_Instanced");
+            shaderInstanced = m_InstanceBuffer &&
+                              shader->GetAttributeLocation("a_InstanceModel") ==
+                                  static_cast<GLint>(InstanceBuffer::MODEL_ATTRIBUTE_LOCATION);
+            boundShader = shader.get();
+            boundMaterial = nullptr;  // Uniforms belong to the program, reapply them
+            ++stats.shaderBinds;
+        }
+        if (command.material != boundMaterial) {
+            const auto applyStart = std::chrono::steady_clock::now();
+            stats.uniformUploads += command.material->ApplyProperties();
+            stats.materialMs += std::chrono::duration<float, std::milli>(
+                std::chrono::steady_clock::now() - applyStart).count();
+            boundMaterial = command.material;
+            ++stats.materialBinds;
+        }
+        if (command.vertexArray != boundVertexArray) {
+            command.vertexArray->Bind();
+            boundVertexArray = command.vertexArray;
+            ++stats.vertexArrayBinds;
+        }
+
+        // Extent of the run of draws identical to this one except for the transform
+        size_t runEnd = i + 1;
+        if (m_InstancingEnabled && shaderInstanced) {
+            while (runEnd < drawCount) {
+                const auto& next = *commands[m_SortEntries[runEnd].index];
+                if (next.vertexArray != command.vertexArray || next.material != command.material ||
+                    next.primitiveType != command.primitiveType || next.range != command.range) {
+                    break;
+                }
+                ++runEnd;
+            }
         }
-        shader->SetMat4("u_Model", command.modelMatrix);
 
-        command.vertexArray->Bind();
-        glDrawElements(command.primitiveType, command.vertexArray->GetIndexBuffer()->GetCount(),
-                       GL_UNSIGNED_INT, nullptr);
+        const DrawRange& range = command.range;
+        const uint32_t indexCount =
+            range.indexCount ? range.indexCount : command.vertexArray->GetIndexBuffer()->GetCount();
+        const void* firstIndex =
+            reinterpret_cast<const void*>(static_cast<uintptr_t>(range.firstIndex) * sizeof(uint32_t));
+        if (runEnd - i >= MIN_INSTANCED_RUN) {
+            const uint32_t instanceCount = static_cast<uint32_t>(runEnd - i);
+            m_InstanceData.resize(instanceCount);
+            for (size_t k = i; k < runEnd; ++k) {
+                m_InstanceData[k - i] = commands[m_SortEntries[k].index]->transformMatrix;
+            }
 
-        command.vertexArray->Unbind();
-        command.material->Unbind();
+            const uint32_t offset = m_InstanceBuffer->Upload(m_InstanceData.data(), instanceCount);
+            m_InstanceBuffer->BindAttributes(offset);
+            shader->SetInt(instancedLocation, 1);
+            if (range.baseVertex) {
+                glDrawElementsInstancedBaseVertex(command.primitiveType, indexCount,
+                                                  GL_UNSIGNED_INT, firstIndex, instanceCount,
+                                                  range.baseVertex);
+            } else {
+                glDrawElementsInstanced(command.primitiveType, indexCount, GL_UNSIGNED_INT,
+                                        firstIndex, instanceCount);
+            }
+            shader->SetInt(instancedLocation, 0);
+            InstanceBuffer::UnbindAttributes();
+
+            ++stats.drawCalls;
+            ++stats.instancedDraws;
+            stats.instances += instanceCount;
+        } else {
+            for (size_t k = i; k < runEnd; ++k) {
+                shader->SetMat4(modelLocation, commands[m_SortEntries[k].index]->transformMatrix);
+                if (range.baseVertex) {
+                    glDrawElementsBaseVertex(command.primitiveType, indexCount, GL_UNSIGNED_INT,
+                                             firstIndex, range.baseVertex);
+                } else {
+                    glDrawElements(command.primitiveType, indexCount, GL_UNSIGNED_INT, firstIndex);
+                }
+                ++stats.drawCalls;
+            }
+        }
+        i = runEnd;
     }
 
+    // The program may stay bound, RenderState filters the next frame's rebind. The
+    // vertex array may not: index buffers created later would attach to it.
+    if (boundVertexArray) boundVertexArray->Unbind();
+
+    // Drop this frame's commands but keep the arena blocks for the next frame
+    buckets.Reset();
+
+    stats.submitMs = std::chrono::duration<float, std::milli>(
+        std::chrono::steady_clock::now() - flushStart).count();
+    m_Statistics = stats;
     m_ProcessingFrame = false;
 }
 
+/**
+ * @brief Arms a capture of the next frameCount flushed frames
+ * @details The file is written from the Flush() that records the last frame
+ */
+bool Renderer::CaptureFrames(uint32_t frameCount, const std::string& path) {
+    if (m_Capture || frameCount == 0) return false;
+    m_Capture = std::make_unique<FrameCapture>();
+    m_CaptureFramesLeft = frameCount;
+    m_CapturePath = path;
+    LOG_INFO_CONCAT("Capturing ", frameCount, " frame(s) to ", path);
+    return true;
+}
+
 /**
  * @brief Trigger a draw operation by flushing the command queue
  */
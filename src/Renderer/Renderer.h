@@ -2,8 +2,13 @@
 #include "../pch.h"
 #include <glad/glad.h>
 #include <atomic>
+#include <optional>
 #include "Buffer.h"
+#include "FrameCapture.h"
 #include "Material.h"
+#include "InstanceBuffer.h"
+#include "RenderCommandBuckets.h"
+#include "RenderSortKey.h"
 #include "../Shader/Shader.h"
 #include "../Camera/OrthographicCamera.h"
 #include "../Camera/PerspectiveCamera.h"
@@ -16,23 +21,21 @@ namespace Engine {
     class Material;
 
     /**
-     * @brief Structure containing information for a render command
+     * @brief Per-frame counters of the last Flush()
      */
-    struct RenderCommand {
-        std::shared_ptr<VertexArray> vertexArray;    ///< Vertex array to render
-        std::shared_ptr<Material> material;          ///< Material to use
-        GLenum primitiveType;                        ///< OpenGL primitive type
-        glm::mat4 transformMatrix;                   ///< Transform
-    };
-
-    /**
-     * @brief Preprocessed version of render command with computed model matrix
-     */
-    struct PreprocessedRenderCommand {
-        std::shared_ptr<VertexArray> vertexArray;    ///< Vertex array to render
-        std::shared_ptr<Material> material;          ///< Material to use
-        GLenum primitiveType;                        ///< OpenGL primitive type
-        glm::mat4 modelMatrix;                       ///< Pre-computed model matrix
+    struct RenderStatistics {
+        uint32_t submitted = 0;          ///< Commands in the drawn list
+        uint32_t culled = 0;             ///< Commands rejected by frustum culling
+        uint32_t drawCalls = 0;          ///< Draw calls issued
+        uint32_t shaderBinds = 0;        ///< Shader program changes
+        uint32_t materialBinds = 0;      ///< Material applications
+        uint32_t uniformUploads = 0;     ///< Material uniform values actually uploaded
+        uint32_t vertexArrayBinds = 0;   ///< Vertex array changes
+        uint32_t instancedDraws = 0;     ///< Draw calls that drew a run of instances
+        uint32_t instances = 0;          ///< Commands drawn through instanced draws
+        float materialMs = 0.0f;         ///< Time spent applying materials
+        float sortMs = 0.0f;             ///< Culling, key generation and sorting
+        float submitMs = 0.0f;           ///< Whole Flush() on the CPU, including sorting
     };
 
     /**
@@ -90,17 +93,38 @@ namespace Engine {
          * @param material Material to use for rendering
          * @param transformMatrix Transform matrix of the object
          * @param primitiveType Type of primitives to render
+         * @param pass Render pass; transparent commands are drawn back to front after opaque ones
+         * @param range Indices to draw; the whole index buffer by default
+         * @details Lock-free and refcount-free append to the calling thread's command
+         *          bucket; may be called from any thread between SwapCommandBuffers() calls
          */
         void Submit(const std::shared_ptr<VertexArray>& vertexArray,
                     const std::shared_ptr<Material>& material,
                     const glm::mat4& transformMatrix = glm::mat4(1.0f),
-                    GLenum primitiveType = GL_TRIANGLES);
+                    GLenum primitiveType = GL_TRIANGLES,
+                    RenderPass pass = RenderPass::Opaque,
+                    const DrawRange& range = DrawRange());
 
         /**
-         * @brief Process and execute all queued render commands
+         * @brief Draw the published command list
+         * @details Only commands made visible by SwapCommandBuffers() are drawn.
+         *          The per-thread buckets are merged and the commands are sorted by RenderSortKey and shader, material and
+         *          vertex array binds shared by consecutive draws are skipped. Runs of
+         *          commands sharing a vertex array and material become one instanced
+         *          draw when the shader declares a_InstanceModel (see InstanceBuffer).
          */
         void Flush();
 
+        /**
+         * @brief Publish the commands submitted so far for drawing
+         *
+         * Command lists are double-buffered: Submit() records into the back list
+         * while Flush() draws the front one, so the next frame can be recorded on
+         * a worker while the current one is drawn. Must not be called while a
+         * Flush() is in progress.
+         */
+        void SwapCommandBuffers();
+
         /**
          * @brief Get the singleton instance of the renderer
          * @return Reference to the renderer instance
@@ -163,14 +187,64 @@ namespace Engine {
 
         void Render();
 
+        /**
+         * @brief Enables culling of commands whose bounds lie outside the camera frustum
+         * @param enabled Whether Flush() culls; vertex arrays without bounds are always drawn
+         */
+        void SetFrustumCullingEnabled(bool enabled) { m_FrustumCullingEnabled = enabled; }
+        bool IsFrustumCullingEnabled() const { return m_FrustumCullingEnabled; }
+
+        /**
+         * @brief Enables drawing runs of identical mesh and material as one instanced draw
+         * @param enabled Whether Flush() instances; shaders without a_InstanceModel never are
+         */
+        void SetInstancingEnabled(bool enabled) { m_InstancingEnabled = enabled; }
+        bool IsInstancingEnabled() const { return m_InstancingEnabled; }
+
+        /** @brief Shortest run of identical draws worth an instanced draw */
+        static constexpr size_t MIN_INSTANCED_RUN = 4;
+
+        /** @return Counters of the last Flush() */
+        const RenderStatistics& GetStatistics() const { return m_Statistics; }
+
+        /**
+         * @brief Records the submissions of the next flushed frames to a capture file
+         * @param frameCount Frames to capture
+         * @param path File written once the last frame is flushed; see FrameCapture
+         * @return false if a capture is already in progress or frameCount is 0
+         */
+        bool CaptureFrames(uint32_t frameCount, const std::string& path);
+        bool IsCapturing() const { return m_Capture != nullptr; }
+
+        /**
+         * @brief Draws with a fixed view-projection instead of the active camera's
+         * @details Used by FrameReplay to reproduce captured frames; culling uses the
+         *          frustum of the same matrix
+         */
+        void SetViewProjectionOverride(const glm::mat4& viewProjection) {
+            m_ViewProjectionOverride = viewProjection;
+        }
+        void ClearViewProjectionOverride() { m_ViewProjectionOverride.reset(); }
+
        private:
-        std::mutex m_QueueMutex;                     ///< Mutex for command queue access
         std::mutex m_RenderMutex;                    ///< Mutex for render queue access
         std::shared_ptr<Shader> m_Shader;            ///< Current active shader
         std::shared_ptr<VertexArray> m_VertexArray;  ///< Current vertex array
-        std::queue<RenderCommand> m_CommandQueue;     ///< Queue of pending render commands
-        std::vector<PreprocessedRenderCommand> m_ProcessingQueue;  ///< Commands being processed
-        std::vector<PreprocessedRenderCommand> m_RenderQueue;      ///< Commands ready to render
+        std::array<std::unique_ptr<RenderCommandBuckets>, 2> m_CommandLists;  ///< Double-buffered, per thread
+        uint32_t m_SubmitListIndex = 0;              ///< List currently receiving Submit() calls
+        std::vector<const RenderCommand*> m_DrawList;              ///< Merged commands of the frame
+        std::vector<RenderSortKey::Entry> m_SortEntries;           ///< Draw order of the frame
+        std::vector<RenderSortKey::Entry> m_SortScratch;           ///< Radix sort scratch buffer
+        std::vector<uint8_t> m_Visibility;                         ///< Culling result per command
+        RenderStatistics m_Statistics;                             ///< Counters of the last Flush()
+        bool m_FrustumCullingEnabled = true;                       ///< Cull commands in Flush()
+        bool m_InstancingEnabled = true;                           ///< Instance runs in Flush()
+        std::unique_ptr<InstanceBuffer> m_InstanceBuffer;          ///< Per-instance model matrices
+        std::vector<glm::mat4> m_InstanceData;                     ///< Staging for one run
+        std::unique_ptr<FrameCapture> m_Capture;                   ///< Capture in progress
+        uint32_t m_CaptureFramesLeft = 0;                          ///< Frames still to record
+        std::string m_CapturePath;                                 ///< Destination of m_Capture
+        std::optional<glm::mat4> m_ViewProjectionOverride;         ///< Set during replays
         std::shared_ptr<Engine::OrthographicCamera> m_Camera;      ///< Orthographic camera
         CameraType m_CameraType = CameraType::Orthographic;        ///< Current camera type
         std::shared_ptr<PerspectiveCamera> m_PerspectiveCamera;    ///< Perspective camera
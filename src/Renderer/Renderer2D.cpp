@@ -2,62 +2,93 @@
 
 #include <GLFW/glfw3.h>
 
+#include <cstddef>
+
 #include "../Camera/OrthographicCamera.h"
 #include "../Shader/Shader.h"
 #include "Material.h"
+#include "RenderSortKey.h"
 #include "Shader/ShaderLibrary.h"
 #include "VertexArray.h"
 
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+    #include <xmmintrin.h>
+    #define ENGINE_RENDERER2D_SSE 1
+#endif
+
 namespace Engine {
-struct QuadVertex {
-    glm::vec3 Position;
-    glm::vec4 Color;
-    glm::vec2 TexCoord;
-    float TexIndex;
-    float TilingFactor;
-};
+// GenerateQuadVertices() writes vertices as three 4-float stores at these offsets
+static_assert(sizeof(QuadVertex) == 11 * sizeof(float), "QuadVertex must be 11 packed floats");
+static_assert(offsetof(QuadVertex, Color) == 3 * sizeof(float) &&
+                  offsetof(QuadVertex, TexCoord) == 7 * sizeof(float) &&
+                  offsetof(QuadVertex, TexIndex) == 9 * sizeof(float),
+              "Unexpected QuadVertex layout");
 
 struct Renderer2DData {
     static const uint32_t MaxQuads = 100000;
     static const uint32_t MaxVertices = MaxQuads * 4;
     static const uint32_t MaxIndices = MaxQuads * 6;
     static const uint32_t MaxTextureSlots = 32;
-
-    std::shared_ptr<VertexArray> QuadVertexArray;
-    std::shared_ptr<VertexBuffer> QuadVertexBuffer;
-    std::shared_ptr<Material> TextureMaterial;
+    static const uint32_t SlotTableBits = 6;  // Twice MaxTextureSlots keeps probes short
+    static const uint32_t SlotTableSize = 1u << SlotTableBits;
+    static const uint32_t MaxStreams = 256;   // Sort keys hold the stream in 8 bits
+    static const uint32_t TextureIDBits = 24;
+
+    /** @brief One material's batch */
+    struct BatchStream {
+        std::shared_ptr<Material> StreamMaterial;
+        uint32_t MaxQuads = 0;
+        std::shared_ptr<VertexArray> QuadVertexArray;
+        std::shared_ptr<VertexBuffer> QuadVertexBuffer;
+        std::unique_ptr<QuadVertex[]> Vertices;  // CPU side of the batch, MaxQuads * 4
+        uint32_t QuadCount = 0;
+
+        std::array<std::shared_ptr<Texture>, MaxTextureSlots> TextureSlots;
+        uint32_t TextureSlotIndex = 1;  // 0 = white texture
+
+        // Open-addressed texture -> slot table of the current batch
+        std::array<const Texture*, SlotTableSize> SlotTableKeys{};
+        std::array<uint8_t, SlotTableSize> SlotTableSlots{};
+    };
+
+    std::vector<std::unique_ptr<BatchStream>> Streams;
+    std::shared_ptr<IndexBuffer> QuadIndexBuffer;  // Shared by every stream
     std::shared_ptr<Texture> WhiteTexture;
-
-    uint32_t QuadIndexCount = 0;
-    QuadVertex* QuadVertexBufferBase = nullptr;
-    QuadVertex* QuadVertexBufferPtr = nullptr;
-
-    std::array<std::shared_ptr<Texture>, MaxTextureSlots> TextureSlots;
-    uint32_t TextureSlotIndex = 1;  // 0 = white texture
-
-    glm::vec4 QuadVertexPositions[4];
+    std::shared_ptr<Shader> BatchShader;  // Shader of the default stream's material
+    glm::mat4 ViewProjection = glm::mat4(1.0f);
+
+    // Quads of a sorted scene, keyed by (layer, stream, scene texture ID) in submission order
+    bool SortingScene = false;
+    std::vector<QuadInstance> SpriteQuads;
+    std::vector<float> SpriteTilingFactors;
+    std::vector<RenderSortKey::Entry> SpriteKeys;
+    std::vector<RenderSortKey::Entry> SpriteKeyScratch;
+    std::vector<QuadInstance> SortedQuads;
+    std::vector<std::shared_ptr<Texture>> SceneTextures;  // By scene texture ID; 0 = white
+    std::unordered_map<const Texture*, uint32_t> SceneTextureIDs;
+    const Texture* LastSceneTexture = nullptr;
+    uint32_t LastSceneTextureID = 0;
+
+    // Scratch of CountUnsortedDrawCalls()
+    struct SimulatedBatch {
+        uint32_t Batch;
+        uint32_t Quads;
+        uint32_t Slots;
+    };
+    std::vector<SimulatedBatch> SimulatedBatches;  // Per stream
+    std::vector<uint32_t> TextureBatches;          // Per stream and scene texture
 };
 
+static uint32_t SlotTableBucket(const Texture* texture) {
+    const uint64_t hash = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(texture)) *
+                          0x9E3779B97F4A7C15ull;
+    return static_cast<uint32_t>(hash >> (64 - Renderer2DData::SlotTableBits));
+}
+
 static Renderer2DData s_Data;
 
 void Renderer2D::Initialize() {
-    // Create vertex array
-    s_Data.QuadVertexArray = std::shared_ptr<VertexArray>(VertexArray::Create());
-
-    // Create vertex buffer
-    s_Data.QuadVertexBuffer = std::shared_ptr<VertexBuffer>(
-        VertexBuffer::Create(nullptr, s_Data.MaxVertices * sizeof(QuadVertex)));
-
-    // Set buffer layout
-    BufferLayout layout = {{ShaderDataType::Float3, "a_Position"},
-                           {ShaderDataType::Float4, "a_Color"},
-                           {ShaderDataType::Float2, "a_TexCoord"},
-                           {ShaderDataType::Float, "a_TexIndex"},
-                           {ShaderDataType::Float, "a_TilingFactor"}};
-    s_Data.QuadVertexBuffer->SetLayout(layout);
-    s_Data.QuadVertexArray->AddVertexBuffer(s_Data.QuadVertexBuffer);
-
-    // Create and set index buffer
+    // One index buffer covers the largest batch of every stream
     uint32_t* quadIndices = new uint32_t[s_Data.MaxIndices];
     uint32_t offset = 0;
     for (uint32_t i = 0; i < s_Data.MaxIndices; i += 6) {
@@ -69,11 +100,15 @@ void Renderer2D::Initialize() {
         quadIndices[i + 5] = offset + 0;
         offset += 4;
     }
-
-    auto quadIB = std::shared_ptr<IndexBuffer>(IndexBuffer::Create(quadIndices, s_Data.MaxIndices));
-    s_Data.QuadVertexArray->SetIndexBuffer(quadIB);
+    s_Data.QuadIndexBuffer =
+        std::shared_ptr<IndexBuffer>(IndexBuffer::Create(quadIndices, s_Data.MaxIndices));
     delete[] quadIndices;
 
+    // Create white texture
+    s_Data.WhiteTexture = std::make_shared<Texture>(1, 1);
+    uint8_t whiteTextureData[4] = {255, 255, 255, 255};
+    s_Data.WhiteTexture->SetData(whiteTextureData, sizeof(whiteTextureData));
+
     // Get the batch renderer shader
     auto shader = ShaderLibrary::CreateBatchRenderer2DShader();
     if (!shader) {
@@ -81,78 +116,127 @@ void Renderer2D::Initialize() {
         return;
     }
 
-    // Create material with shader
-    s_Data.TextureMaterial = std::make_shared<Material>(shader);
-
-    // Configure texture sampling properties
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-
-    // Create white texture
-    s_Data.WhiteTexture = std::make_shared<Texture>(1, 1);
-    uint8_t whiteTextureData[4] = {255, 255, 255, 255};
-    s_Data.WhiteTexture->SetData(whiteTextureData, sizeof(whiteTextureData));
+    // The default stream draws with the built-in material
+    s_Data.BatchShader = shader;
+    CreateStream(std::make_shared<Material>(shader), Renderer2DData::MaxQuads);
+}
 
-    // Initialize texture slots
-    s_Data.TextureSlots[0] = s_Data.WhiteTexture;
+void Renderer2D::Shutdown() {
+    s_Data.Streams.clear();
+    s_Data.QuadIndexBuffer.reset();
+    s_Data.WhiteTexture.reset();
+    s_Data.SortingScene = false;
+    s_Data.SpriteQuads.clear();
+    s_Data.SpriteTilingFactors.clear();
+    s_Data.SortedQuads.clear();
+    s_Data.SceneTextures.clear();
+    s_Data.SceneTextureIDs.clear();
+    s_Data.LastSceneTexture = nullptr;
+    s_Data.LastSceneTextureID = 0;
+
+    // The shader library and asset cache share the batch shader and are destroyed after
+    // main, so its program is deleted here; the next Initialize() loads it again
+    if (s_Data.BatchShader) {
+        s_Data.BatchShader->Unload();
+        s_Data.BatchShader.reset();
+    }
+    m_Stream = DEFAULT_STREAM;
+}
 
-    // Create quad vertices
-    s_Data.QuadVertexPositions[0] = {-0.5f, -0.5f, 0.0f, 1.0f};
-    s_Data.QuadVertexPositions[1] = {0.5f, -0.5f, 0.0f, 1.0f};
-    s_Data.QuadVertexPositions[2] = {0.5f, 0.5f, 0.0f, 1.0f};
-    s_Data.QuadVertexPositions[3] = {-0.5f, 0.5f, 0.0f, 1.0f};
+Renderer2D::StreamID Renderer2D::CreateStream(const std::shared_ptr<Material>& material,
+                                              uint32_t maxQuads) {
+    ASSERT(s_Data.QuadIndexBuffer && "Renderer2D::Initialize() must run before CreateStream()");
+    ASSERT(material && material->GetShader() && "Batch stream needs a material with a shader");
+    ASSERT(s_Data.Streams.size() < Renderer2DData::MaxStreams && "Too many batch streams");
+    maxQuads = std::clamp(maxQuads, 1u, Renderer2DData::MaxQuads);
+
+    auto stream = std::make_unique<Renderer2DData::BatchStream>();
+    stream->StreamMaterial = material;
+    stream->MaxQuads = maxQuads;
+    stream->Vertices.reset(new QuadVertex[maxQuads * 4]);
+    stream->QuadVertexBuffer = std::shared_ptr<VertexBuffer>(
+        VertexBuffer::Create(nullptr, maxQuads * 4 * sizeof(QuadVertex)));
+    stream->QuadVertexBuffer->SetLayout({{ShaderDataType::Float3, "a_Position"},
+                                         {ShaderDataType::Float4, "a_Color"},
+                                         {ShaderDataType::Float2, "a_TexCoord"},
+                                         {ShaderDataType::Float, "a_TexIndex"},
+                                         {ShaderDataType::Float, "a_TilingFactor"}});
+    stream->QuadVertexArray = std::shared_ptr<VertexArray>(VertexArray::Create());
+    stream->QuadVertexArray->AddVertexBuffer(stream->QuadVertexBuffer);
+    stream->QuadVertexArray->SetIndexBuffer(s_Data.QuadIndexBuffer);
+    stream->QuadVertexArray->Unbind();
+    stream->TextureSlots[0] = s_Data.WhiteTexture;
+
+    s_Data.Streams.push_back(std::move(stream));
+    return static_cast<StreamID>(s_Data.Streams.size() - 1);
+}
 
-    // Allocate vertex buffer
-    s_Data.QuadVertexBufferBase = new QuadVertex[s_Data.MaxVertices];
+void Renderer2D::SetStream(StreamID stream) {
+    ASSERT(stream < s_Data.Streams.size() && "Unknown batch stream");
+    m_Stream = stream;
 }
 
-void Renderer2D::Shutdown() { delete[] s_Data.QuadVertexBufferBase; }
+size_t Renderer2D::GetStreamCount() const { return s_Data.Streams.size(); }
 
 void Renderer2D::BeginScene() {
     // Default implementation for IRenderer interface
 }
 
 void Renderer2D::BeginScene(const std::shared_ptr<OrthographicCamera>& camera) {
-    // Ensure material and shader exist
-    if (!s_Data.TextureMaterial || !s_Data.TextureMaterial->GetShader()) {
+    // Ensure the default stream exists
+    if (s_Data.Streams.empty()) {
         return;
     }
 
-    s_Data.TextureMaterial->GetShader()->Bind();
-    s_Data.TextureMaterial->GetShader()->SetMat4("u_ViewProjection",
-                                                 camera->GetViewProjectionMatrix());
-    StartBatch();
+    s_Data.ViewProjection = camera->GetViewProjectionMatrix();
+    for (StreamID stream = 0; stream < s_Data.Streams.size(); ++stream) StartBatch(stream);
+
+    s_Data.SortingScene = m_SpriteSorting;
+    s_Data.SpriteQuads.clear();
+    s_Data.SpriteTilingFactors.clear();
+    s_Data.SpriteKeys.clear();
+    s_Data.SceneTextures.assign(1, nullptr);
+    s_Data.SceneTextureIDs.clear();
+    s_Data.LastSceneTexture = nullptr;
 }
 
-void Renderer2D::EndScene() { Flush(); }
+void Renderer2D::EndScene() {
+    if (s_Data.SortingScene) FlushSprites();
+    Flush();
+}
 
-void Renderer2D::StartBatch() {
-    s_Data.QuadIndexCount = 0;
-    s_Data.QuadVertexBufferPtr = s_Data.QuadVertexBufferBase;
-    s_Data.TextureSlotIndex = 1;
+void Renderer2D::StartBatch(StreamID stream) {
+    Renderer2DData::BatchStream& batch = *s_Data.Streams[stream];
+    batch.QuadCount = 0;
+    batch.TextureSlotIndex = 1;
+    batch.SlotTableKeys.fill(nullptr);
 }
 
 void Renderer2D::Flush() {
-    if (s_Data.QuadIndexCount == 0) return;
+    for (StreamID stream = 0; stream < s_Data.Streams.size(); ++stream) NextBatch(stream);
+}
+
+void Renderer2D::FlushStream(StreamID stream) {
+    Renderer2DData::BatchStream& batch = *s_Data.Streams[stream];
+    if (batch.QuadCount == 0) return;
 
-    uint32_t dataSize =
-        (uint32_t)((uint8_t*)s_Data.QuadVertexBufferPtr - (uint8_t*)s_Data.QuadVertexBufferBase);
-    s_Data.QuadVertexBuffer->Bind();
-    glBufferSubData(GL_ARRAY_BUFFER, 0, dataSize, s_Data.QuadVertexBufferBase);
+    // Fresh storage each flush: the previous batch may still be drawing from the old one
+    const uint32_t vertexCount = batch.QuadCount * 4;
+    batch.QuadVertexBuffer->Orphan(batch.Vertices.get(), vertexCount * sizeof(QuadVertex));
 
     // Bind textures
-    for (uint32_t i = 0; i < s_Data.TextureSlotIndex; i++) s_Data.TextureSlots[i]->Bind(i);
+    for (uint32_t i = 0; i < batch.TextureSlotIndex; i++) batch.TextureSlots[i]->Bind(i);
 
-    s_Data.TextureMaterial->Bind();
-    s_Data.QuadVertexArray->Bind();
-    glDrawElements(GL_TRIANGLES, s_Data.QuadIndexCount, GL_UNSIGNED_INT, nullptr);
+    static const std::string viewProjection = "u_ViewProjection";  // Allocated once
+    batch.StreamMaterial->Bind();
+    batch.StreamMaterial->GetShader()->SetMat4(viewProjection, s_Data.ViewProjection);
+    batch.QuadVertexArray->Bind();
+    glDrawElements(GL_TRIANGLES, batch.QuadCount * 6, GL_UNSIGNED_INT, nullptr);
 
     // Update stats
     m_Stats.DrawCalls++;
-    m_Stats.IndexCount += s_Data.QuadIndexCount;
-    m_Stats.VertexCount += s_Data.QuadIndexCount * 4 / 6;  // Convert indices to vertices
+    m_Stats.IndexCount += batch.QuadCount * 6;
+    m_Stats.VertexCount += vertexCount;
 }
 
 void Renderer2D::DrawQuad(const glm::vec2& position, const glm::vec2& size,
@@ -162,26 +246,8 @@ void Renderer2D::DrawQuad(const glm::vec2& position, const glm::vec2& size,
 
 void Renderer2D::DrawQuad(const glm::vec3& position, const glm::vec2& size,
                           const glm::vec4& color) {
-    if (s_Data.QuadIndexCount >= Renderer2DData::MaxIndices) NextBatch();
-
-    const float texIndex = 0.0f;  // White Texture
-    const float tilingFactor = 1.0f;
-
-    glm::mat4 transform = glm::translate(glm::mat4(1.0f), position) *
-                          glm::scale(glm::mat4(1.0f), {size.x, size.y, 1.0f});
-
-    // Add vertices to buffer
-    for (size_t i = 0; i < 4; i++) {
-        s_Data.QuadVertexBufferPtr->Position = transform * s_Data.QuadVertexPositions[i];
-        s_Data.QuadVertexBufferPtr->Color = color;
-        s_Data.QuadVertexBufferPtr->TexCoord = {(i == 1 || i == 2) ? 1.0f : 0.0f,
-                                                (i == 2 || i == 3) ? 1.0f : 0.0f};
-        s_Data.QuadVertexBufferPtr->TexIndex = texIndex;
-        s_Data.QuadVertexBufferPtr->TilingFactor = tilingFactor;
-        s_Data.QuadVertexBufferPtr++;
-    }
-
-    s_Data.QuadIndexCount += 6;
+    const QuadInstance quad{position, size, 0.0f, color};
+    SubmitQuads(&quad, 1, nullptr, 1.0f);
 }
 
 void Renderer2D::DrawQuad(const glm::vec2& position, const glm::vec2& size,
@@ -193,42 +259,272 @@ void Renderer2D::DrawQuad(const glm::vec2& position, const glm::vec2& size,
 void Renderer2D::DrawQuad(const glm::vec3& position, const glm::vec2& size,
                           const std::shared_ptr<Texture>& texture, float tilingFactor,
                           const glm::vec4& tintColor) {
-    if (s_Data.QuadIndexCount >= Renderer2DData::MaxIndices) NextBatch();
+    const QuadInstance quad{position, size, 0.0f, tintColor};
+    SubmitQuads(&quad, 1, texture, tilingFactor);
+}
+
+void Renderer2D::DrawRotatedQuad(const glm::vec3& position, const glm::vec2& size,
+                                 float rotation, const glm::vec4& color) {
+    const QuadInstance quad{position, size, rotation, color};
+    SubmitQuads(&quad, 1, nullptr, 1.0f);
+}
+
+void Renderer2D::DrawRotatedQuad(const glm::vec3& position, const glm::vec2& size,
+                                 float rotation, const std::shared_ptr<Texture>& texture,
+                                 float tilingFactor, const glm::vec4& tintColor) {
+    const QuadInstance quad{position, size, rotation, tintColor};
+    SubmitQuads(&quad, 1, texture, tilingFactor);
+}
 
-    float textureIndex = 0.0f;
-    for (uint32_t i = 1; i < s_Data.TextureSlotIndex; i++) {
-        if (s_Data.TextureSlots[i] == texture) {
-            textureIndex = (float)i;
-            break;
+void Renderer2D::DrawQuads(const QuadInstance* quads, size_t count) {
+    PROFILE_FUNCTION();
+    SubmitQuads(quads, count, nullptr, 1.0f);
+}
+
+void Renderer2D::DrawQuads(const QuadInstance* quads, size_t count,
+                           const std::shared_ptr<Texture>& texture, float tilingFactor) {
+    PROFILE_FUNCTION();
+    SubmitQuads(quads, count, texture, tilingFactor);
+}
+
+void Renderer2D::SubmitQuads(const QuadInstance* quads, size_t count,
+                             const std::shared_ptr<Texture>& texture, float tilingFactor) {
+    if (!s_Data.SortingScene) {
+        AppendQuads(m_Stream, quads, count, texture, tilingFactor);
+        return;
+    }
+
+    uint32_t textureID = 0;
+    if (texture && texture.get() == s_Data.LastSceneTexture) {
+        textureID = s_Data.LastSceneTextureID;
+    } else if (texture) {
+        auto it = s_Data.SceneTextureIDs.find(texture.get());
+        if (it == s_Data.SceneTextureIDs.end()) {
+            ASSERT(s_Data.SceneTextures.size() < (1u << Renderer2DData::TextureIDBits) &&
+                   "Too many textures in one sorted scene");
+            it = s_Data.SceneTextureIDs
+                     .emplace(texture.get(), static_cast<uint32_t>(s_Data.SceneTextures.size()))
+                     .first;
+            s_Data.SceneTextures.push_back(texture);
         }
+        textureID = it->second;
+        s_Data.LastSceneTexture = texture.get();
+        s_Data.LastSceneTextureID = textureID;
     }
 
-    if (textureIndex == 0.0f) {
-        if (s_Data.TextureSlotIndex >= Renderer2DData::MaxTextureSlots) NextBatch();
+    // Layer flipped to unsigned order in the high half; stream and scene texture ID below
+    const uint64_t key =
+        (static_cast<uint64_t>(static_cast<uint32_t>(m_Layer) ^ 0x80000000u) << 32) |
+        (m_Stream << Renderer2DData::TextureIDBits) | textureID;
+    for (size_t i = 0; i < count; ++i) {
+        s_Data.SpriteKeys.push_back({key, static_cast<uint32_t>(s_Data.SpriteQuads.size())});
+        s_Data.SpriteQuads.push_back(quads[i]);
+        s_Data.SpriteTilingFactors.push_back(tilingFactor);
+    }
+}
 
-        textureIndex = (float)s_Data.TextureSlotIndex;
-        s_Data.TextureSlots[s_Data.TextureSlotIndex] = texture;
-        s_Data.TextureSlotIndex++;
+void Renderer2D::FlushSprites() {
+    PROFILE_FUNCTION();
+    const size_t count = s_Data.SpriteKeys.size();
+    if (count == 0) return;
+    m_SortStats.UnsortedDrawCalls += CountUnsortedDrawCalls();
+
+    const auto sortStart = std::chrono::steady_clock::now();
+    RenderSortKey::RadixSort(s_Data.SpriteKeys, s_Data.SpriteKeyScratch);
+    s_Data.SortedQuads.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        s_Data.SortedQuads[i] = s_Data.SpriteQuads[s_Data.SpriteKeys[i].index];
     }
+    m_SortStats.SortMs += std::chrono::duration<float, std::milli>(
+                              std::chrono::steady_clock::now() - sortStart)
+                              .count();
+    m_SortStats.SortedQuads += static_cast<uint32_t>(count);
+
+    // Runs sharing a stream, texture and tiling factor are appended in one call
+    const uint32_t textureMask = (1u << Renderer2DData::TextureIDBits) - 1;
+    StreamID previousStream = static_cast<StreamID>(s_Data.SpriteKeys[0].key) >>
+                              Renderer2DData::TextureIDBits;
+    size_t first = 0;
+    while (first < count) {
+        const uint32_t streamTexture = static_cast<uint32_t>(s_Data.SpriteKeys[first].key);
+        const float tilingFactor = s_Data.SpriteTilingFactors[s_Data.SpriteKeys[first].index];
+        size_t last = first + 1;
+        while (last < count &&
+               static_cast<uint32_t>(s_Data.SpriteKeys[last].key) == streamTexture &&
+               s_Data.SpriteTilingFactors[s_Data.SpriteKeys[last].index] == tilingFactor) {
+            ++last;
+        }
 
-    glm::mat4 transform = glm::translate(glm::mat4(1.0f), position) *
-                          glm::scale(glm::mat4(1.0f), {size.x, size.y, 1.0f});
-
-    for (size_t i = 0; i < 4; i++) {
-        s_Data.QuadVertexBufferPtr->Position = transform * s_Data.QuadVertexPositions[i];
-        s_Data.QuadVertexBufferPtr->Color = tintColor;
-        s_Data.QuadVertexBufferPtr->TexCoord = {(i == 1 || i == 2) ? 1.0f : 0.0f,
-                                                (i == 2 || i == 3) ? 1.0f : 0.0f};
-        s_Data.QuadVertexBufferPtr->TexIndex = textureIndex;
-        s_Data.QuadVertexBufferPtr->TilingFactor = tilingFactor;
-        s_Data.QuadVertexBufferPtr++;
+        // Leaving a stream draws it, so layers keep their order across streams
+        const StreamID stream = streamTexture >> Renderer2DData::TextureIDBits;
+        if (stream != previousStream) NextBatch(previousStream);
+        previousStream = stream;
+
+        AppendQuads(stream, &s_Data.SortedQuads[first], last - first,
+                    s_Data.SceneTextures[streamTexture & textureMask], tilingFactor);
+        first = last;
     }
 
-    s_Data.QuadIndexCount += 6;
+    s_Data.SpriteQuads.clear();
+    s_Data.SpriteTilingFactors.clear();
+    s_Data.SpriteKeys.clear();
 }
 
-void Renderer2D::NextBatch() {
-    Flush();
-    StartBatch();
+uint32_t Renderer2D::CountUnsortedDrawCalls() {
+    // Replays AppendQuads()'s flush decisions over the quads in submission order
+    const size_t textureCount = s_Data.SceneTextures.size();
+    s_Data.SimulatedBatches.assign(s_Data.Streams.size(), {~0u, 0, 1});
+    s_Data.TextureBatches.assign(s_Data.Streams.size() * textureCount, ~0u);
+
+    const uint32_t textureMask = (1u << Renderer2DData::TextureIDBits) - 1;
+    uint32_t draws = 0;
+    for (const RenderSortKey::Entry& entry : s_Data.SpriteKeys) {
+        const uint32_t stream = static_cast<uint32_t>(entry.key) >> Renderer2DData::TextureIDBits;
+        const uint32_t textureID = static_cast<uint32_t>(entry.key) & textureMask;
+        Renderer2DData::SimulatedBatch& batch = s_Data.SimulatedBatches[stream];
+        if (batch.Batch == ~0u || batch.Quads == s_Data.Streams[stream]->MaxQuads) {
+            batch = {draws++, 0, 1};
+        }
+        uint32_t& textureBatch = s_Data.TextureBatches[stream * textureCount + textureID];
+        if (textureID != 0 && textureBatch != batch.Batch) {
+            if (batch.Slots == Renderer2DData::MaxTextureSlots) batch = {draws++, 0, 1};
+            textureBatch = batch.Batch;
+            ++batch.Slots;
+        }
+        ++batch.Quads;
+    }
+    return draws;
+}
+
+void Renderer2D::AppendQuads(StreamID stream, const QuadInstance* quads, size_t count,
+                             const std::shared_ptr<Texture>& texture, float tilingFactor) {
+    Renderer2DData::BatchStream& batch = *s_Data.Streams[stream];
+    while (count > 0) {
+        if (batch.QuadCount >= batch.MaxQuads) NextBatch(stream);
+
+        // Looked up per batch, as a flush releases the texture slots
+        const float textureIndex = texture ? GetTextureIndex(stream, texture) : 0.0f;
+        const size_t quadCount = std::min<size_t>(count, batch.MaxQuads - batch.QuadCount);
+
+        GenerateQuadVertices(quads, quadCount, textureIndex, tilingFactor,
+                             batch.Vertices.get() + batch.QuadCount * 4);
+        batch.QuadCount += static_cast<uint32_t>(quadCount);
+        quads += quadCount;
+        count -= quadCount;
+    }
+}
+
+float Renderer2D::GetTextureIndex(StreamID stream, const std::shared_ptr<Texture>& texture) {
+    Renderer2DData::BatchStream& batch = *s_Data.Streams[stream];
+    const uint32_t mask = Renderer2DData::SlotTableSize - 1;
+    uint32_t bucket = SlotTableBucket(texture.get());
+    for (; batch.SlotTableKeys[bucket]; bucket = (bucket + 1) & mask) {
+        if (batch.SlotTableKeys[bucket] == texture.get()) {
+            return (float)batch.SlotTableSlots[bucket];
+        }
+    }
+
+    if (batch.TextureSlotIndex >= Renderer2DData::MaxTextureSlots) {
+        NextBatch(stream);
+        bucket = SlotTableBucket(texture.get());
+    }
+
+    const uint32_t slot = batch.TextureSlotIndex++;
+    batch.TextureSlots[slot] = texture;
+    batch.SlotTableKeys[bucket] = texture.get();
+    batch.SlotTableSlots[bucket] = static_cast<uint8_t>(slot);
+    return (float)slot;
+}
+
+#if ENGINE_RENDERER2D_SSE
+void Renderer2D::GenerateQuadVertices(const QuadInstance* quads, size_t count, float textureIndex,
+                                      float tilingFactor, QuadVertex* out) {
+    // Corner order 0..3: (-,-) (+,-) (+,+) (-,+), matching the batch index pattern
+    const __m128 cornerX = _mm_setr_ps(-0.5f, 0.5f, 0.5f, -0.5f);
+    const __m128 cornerY = _mm_setr_ps(-0.5f, -0.5f, 0.5f, 0.5f);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    // Third store of a vertex: (v, texIndex, tiling, next vertex's x, rewritten next)
+    const __m128 tailV0 = _mm_setr_ps(0.0f, textureIndex, tilingFactor, 0.0f);
+    const __m128 tailV1 = _mm_setr_ps(1.0f, textureIndex, tilingFactor, 0.0f);
+    // The last vertex ends the quad, so its tail is stored one float earlier: (u, v, ...)
+    const __m128 lastTail = _mm_setr_ps(0.0f, 1.0f, textureIndex, tilingFactor);
+
+    for (size_t i = 0; i < count; ++i) {
+        const QuadInstance& quad = quads[i];
+        float cosine = 1.0f, sine = 0.0f;
+        if (quad.Rotation != 0.0f) {
+            cosine = std::cos(quad.Rotation);
+            sine = std::sin(quad.Rotation);
+        }
+
+        // Corner offsets scaled by size, then rotated: p + R * (cx * w, cy * h)
+        const __m128 offsetX = _mm_mul_ps(cornerX, _mm_set1_ps(quad.Size.x));
+        const __m128 offsetY = _mm_mul_ps(cornerY, _mm_set1_ps(quad.Size.y));
+        const __m128 c = _mm_set1_ps(cosine);
+        const __m128 s = _mm_set1_ps(sine);
+        const __m128 x = _mm_add_ps(_mm_set1_ps(quad.Position.x),
+                                    _mm_sub_ps(_mm_mul_ps(offsetX, c), _mm_mul_ps(offsetY, s)));
+        const __m128 y = _mm_add_ps(_mm_set1_ps(quad.Position.y),
+                                    _mm_add_ps(_mm_mul_ps(offsetX, s), _mm_mul_ps(offsetY, c)));
+        const __m128 xy01 = _mm_unpacklo_ps(x, y);  // x0 y0 x1 y1
+        const __m128 xy23 = _mm_unpackhi_ps(x, y);  // x2 y2 x3 y3
+
+        // (z, r) completes the position store; (g, b, a, u) is the second store
+        const __m128 color = _mm_loadu_ps(&quad.Color.x);
+        const __m128 zr = _mm_unpacklo_ps(_mm_set1_ps(quad.Position.z), color);
+        const __m128 colorU0 =
+            _mm_shuffle_ps(color, _mm_unpackhi_ps(color, zero), _MM_SHUFFLE(3, 2, 2, 1));
+        const __m128 colorU1 =
+            _mm_shuffle_ps(color, _mm_unpackhi_ps(color, one), _MM_SHUFFLE(3, 2, 2, 1));
+
+        float* dst = reinterpret_cast<float*>(out + i * 4);
+        _mm_storeu_ps(dst + 0, _mm_movelh_ps(xy01, zr));
+        _mm_storeu_ps(dst + 4, colorU0);
+        _mm_storeu_ps(dst + 8, tailV0);
+        _mm_storeu_ps(dst + 11, _mm_shuffle_ps(xy01, zr, _MM_SHUFFLE(1, 0, 3, 2)));
+        _mm_storeu_ps(dst + 15, colorU1);
+        _mm_storeu_ps(dst + 19, tailV0);
+        _mm_storeu_ps(dst + 22, _mm_movelh_ps(xy23, zr));
+        _mm_storeu_ps(dst + 26, colorU1);
+        _mm_storeu_ps(dst + 30, tailV1);
+        _mm_storeu_ps(dst + 33, _mm_shuffle_ps(xy23, zr, _MM_SHUFFLE(1, 0, 3, 2)));
+        _mm_storeu_ps(dst + 37, colorU0);
+        _mm_storeu_ps(dst + 40, lastTail);
+    }
+}
+#else
+void Renderer2D::GenerateQuadVertices(const QuadInstance* quads, size_t count, float textureIndex,
+                                      float tilingFactor, QuadVertex* out) {
+    static const float cornerX[4] = {-0.5f, 0.5f, 0.5f, -0.5f};
+    static const float cornerY[4] = {-0.5f, -0.5f, 0.5f, 0.5f};
+
+    for (size_t i = 0; i < count; ++i) {
+        const QuadInstance& quad = quads[i];
+        float cosine = 1.0f, sine = 0.0f;
+        if (quad.Rotation != 0.0f) {
+            cosine = std::cos(quad.Rotation);
+            sine = std::sin(quad.Rotation);
+        }
+
+        for (size_t corner = 0; corner < 4; ++corner) {
+            const float offsetX = cornerX[corner] * quad.Size.x;
+            const float offsetY = cornerY[corner] * quad.Size.y;
+            QuadVertex& vertex = out[i * 4 + corner];
+            vertex.Position = {quad.Position.x + offsetX * cosine - offsetY * sine,
+                               quad.Position.y + offsetX * sine + offsetY * cosine,
+                               quad.Position.z};
+            vertex.Color = quad.Color;
+            vertex.TexCoord = {cornerX[corner] + 0.5f, cornerY[corner] + 0.5f};
+            vertex.TexIndex = textureIndex;
+            vertex.TilingFactor = tilingFactor;
+        }
+    }
+}
+#endif
+
+void Renderer2D::NextBatch(StreamID stream) {
+    FlushStream(stream);
+    StartBatch(stream);
 }
 }  // namespace Engine
@@ -8,8 +8,32 @@
 
 namespace Engine {
 
+/** @brief Vertex of the 2D batch, laid out as in the batch vertex buffer */
+struct QuadVertex {
+    glm::vec3 Position;
+    glm::vec4 Color;
+    glm::vec2 TexCoord;
+    float TexIndex;
+    float TilingFactor;
+};
+
+/** @brief One quad of a Renderer2D::DrawQuads() call */
+struct QuadInstance {
+    glm::vec3 Position = glm::vec3(0.0f);  ///< Centre
+    glm::vec2 Size = glm::vec2(1.0f);
+    float Rotation = 0.0f;                 ///< Radians, counter-clockwise about the centre
+    glm::vec4 Color = glm::vec4(1.0f);     ///< Colour, or tint of textured quads
+};
+
 /**
  * @brief Specialized renderer for 2D graphics with batching support
+ *
+ * Quads are batched into streams. Each stream has its own material, vertex
+ * buffer and texture slots, so quads for different materials batch side by
+ * side instead of flushing each other. A stream draws only when it fills or
+ * when the scene ends. All streams share one static quad index buffer. Each
+ * flush uploads through an orphaned vertex buffer, so the CPU never waits on
+ * a draw that is still reading the previous batch.
  */
 class Renderer2D : public IRenderer {
    public:
@@ -20,12 +44,30 @@ class Renderer2D : public IRenderer {
 
     // IRenderer interface implementation
     void Initialize() override;
+    /**
+     * @brief Releases every GL object the renderer owns, its batch shader included
+     * @details Call while the context (or recording backend) is still current; the
+     *          renderer's static state holds no GL objects afterwards, so nothing is
+     *          deleted after main. Initialize() may be called again.
+     */
     void Shutdown() override;
     void BeginScene() override;
     void EndScene() override;
+    /** @brief Draws and restarts every stream's batch; EndScene() calls it */
     void Flush() override;
     Statistics GetStats() const override { return m_Stats; }
-    void ResetStats() override { m_Stats.Reset(); }
+    void ResetStats() override {
+        m_Stats.Reset();
+        m_SortStats = SortStatistics();
+    }
+
+    /** @brief Sprite sorting results since ResetStats() */
+    struct SortStatistics {
+        uint32_t SortedQuads = 0;
+        uint32_t UnsortedDrawCalls = 0;  ///< Draw calls the sorted scenes take in submission order
+        float SortMs = 0.0f;             ///< Key sorting and gathering of the sorted scenes
+    };
+    SortStatistics GetSortStats() const { return m_SortStats; }
 
     // 2D-specific methods
     void BeginScene(const std::shared_ptr<OrthographicCamera>& camera);
@@ -37,13 +79,91 @@ class Renderer2D : public IRenderer {
     void DrawQuad(const glm::vec3& position, const glm::vec2& size,
                   const std::shared_ptr<Texture>& texture, float tilingFactor = 1.0f,
                   const glm::vec4& tintColor = glm::vec4(1.0f));
+    void DrawRotatedQuad(const glm::vec3& position, const glm::vec2& size, float rotation,
+                         const glm::vec4& color);
+    void DrawRotatedQuad(const glm::vec3& position, const glm::vec2& size, float rotation,
+                         const std::shared_ptr<Texture>& texture, float tilingFactor = 1.0f,
+                         const glm::vec4& tintColor = glm::vec4(1.0f));
+
+    /**
+     * @brief Batches many untextured quads in one call
+     * @details Vertices are generated straight into the batch, four quads' corners at
+     *          a time with SSE; the batch is flushed whenever it fills up.
+     */
+    void DrawQuads(const QuadInstance* quads, size_t count);
+    /** @brief Batches many quads sharing one texture; each quad's colour tints it */
+    void DrawQuads(const QuadInstance* quads, size_t count,
+                   const std::shared_ptr<Texture>& texture, float tilingFactor = 1.0f);
+
+    /**
+     * @brief Writes the four corner vertices of each quad, in batch index order
+     * @param out Room for count * 4 vertices
+     * @details Corners are computed directly from centre, half size and rotation
+     *          instead of through a transform matrix. Needs no GL context, so the
+     *          vertex generation cost can be benchmarked on its own.
+     */
+    static void GenerateQuadVertices(const QuadInstance* quads, size_t count, float textureIndex,
+                                     float tilingFactor, QuadVertex* out);
+
+    /** @brief Identifies a batch stream; stream 0 draws with the built-in batch material */
+    using StreamID = uint32_t;
+    static constexpr StreamID DEFAULT_STREAM = 0;
+    static constexpr uint32_t DEFAULT_STREAM_QUADS = 16384;
+
+    /**
+     * @brief Adds a batch stream that draws with its own material
+     * @param material Material whose shader takes the QuadVertex attributes and
+     *        u_ViewProjection, like batch_renderer_2d
+     * @param maxQuads Quads per draw call, capped at the default stream's 100K;
+     *        sizes the stream's CPU and GPU vertex buffers
+     * @details Unsorted scenes flush the remaining streams in StreamID order at the
+     *          end of the scene. Requires Initialize().
+     */
+    StreamID CreateStream(const std::shared_ptr<Material>& material,
+                          uint32_t maxQuads = DEFAULT_STREAM_QUADS);
+    /** @brief Sends the following quads to a stream */
+    void SetStream(StreamID stream);
+    StreamID GetStream() const { return m_Stream; }
+    size_t GetStreamCount() const;
+
+    /**
+     * @brief Buffers each scene's quads and draws them sorted by (layer, stream, texture)
+     * @details Takes effect at the next BeginScene(). A sorted scene only flushes
+     *          when the batch or its texture slots are full, so interleaved textures
+     *          cost a few large draws instead of many small ones. Within a layer,
+     *          draw order across textures is not kept; sprites that must overlap in
+     *          a given order belong on separate layers.
+     */
+    void SetSpriteSorting(bool enabled) { m_SpriteSorting = enabled; }
+    bool IsSpriteSorting() const { return m_SpriteSorting; }
+    /** @brief Layer of the following quads in sorted scenes; lower layers draw first */
+    void SetLayer(int32_t layer) { m_Layer = layer; }
+    int32_t GetLayer() const { return m_Layer; }
 
    private:
     Renderer2D() = default;  // Private constructor
-    void StartBatch();
-    void NextBatch();
+    void StartBatch(StreamID stream);
+    /** @brief Uploads and draws a stream's batch */
+    void FlushStream(StreamID stream);
+    void NextBatch(StreamID stream);
+    /** @return Texture slot in the stream's batch, flushing first if the slots are full */
+    float GetTextureIndex(StreamID stream, const std::shared_ptr<Texture>& texture);
+    /** @brief Buffers quads in sorted scenes, appends them to the current stream otherwise */
+    void SubmitQuads(const QuadInstance* quads, size_t count,
+                     const std::shared_ptr<Texture>& texture, float tilingFactor);
+    /** @brief Appends quads to a stream, flushing its batch as it fills */
+    void AppendQuads(StreamID stream, const QuadInstance* quads, size_t count,
+                     const std::shared_ptr<Texture>& texture, float tilingFactor);
+    /** @brief Sorts the buffered quads of a sorted scene and appends them */
+    void FlushSprites();
+    /** @return Draw calls the buffered quads would take in submission order */
+    uint32_t CountUnsortedDrawCalls();
 
     Statistics m_Stats;  // Added statistics member
+    SortStatistics m_SortStats;
+    bool m_SpriteSorting = false;
+    int32_t m_Layer = 0;
+    StreamID m_Stream = DEFAULT_STREAM;
     std::shared_ptr<Material> m_Material;  // Material reference
 };
 }  // namespace Engine
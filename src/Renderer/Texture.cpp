@@ -1,5 +1,12 @@
 #include "Texture.h"
+#include "TextureCache.h"
 #include "stb_image.h"
+#include "RenderState.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define ENGINE_TEXTURE_SSE2 1
+#endif
 
 namespace Engine {
     /** @brief Creates a texture from an image file
@@ -24,38 +31,15 @@ namespace Engine {
      */
     Texture::Texture(const std::string& path) 
         : m_Path(path) {
-        stbi_set_flip_vertically_on_load(1);
-        
-        int width, height, channels;
-        unsigned char* data = stbi_load(path.c_str(), &width, &height, &channels, 0);
-        
-        m_Width = width;
-        m_Height = height;
-
-        GLenum internalFormat = 0, dataFormat = 0;
-        if (channels == 4) {
-            internalFormat = GL_RGBA8;
-            dataFormat = GL_RGBA;
-        }
-        else if (channels == 3) {
-            internalFormat = GL_RGB8;
-            dataFormat = GL_RGB;
-        }
-
-        glGenTextures(1, &m_RendererID);
-        glBindTexture(GL_TEXTURE_2D, m_RendererID);
-
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-
-        if (data) {
-            glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, m_Width, m_Height, 0, dataFormat, GL_UNSIGNED_BYTE, data);
-            stbi_image_free(data);
+        m_Type = ResourceType::Texture;
+        const TextureImage image = TextureCache::Get().Load(path);
+        if (image.IsValid()) {
+            Upload(image);
+        } else {
+            LOG_ERROR_CONCAT("Failed to decode texture: ", path);
+            CreateGLTexture();
+            RenderState::Get().BindTexture(0, GL_TEXTURE_2D, 0);
         }
-        
-        glBindTexture(GL_TEXTURE_2D, 0);
     }
 
     /** @brief Constructor that creates an empty texture
@@ -64,35 +48,180 @@ namespace Engine {
      */
     Texture::Texture(uint32_t width, uint32_t height)
         : m_Width(width), m_Height(height) {
-        glGenTextures(1, &m_RendererID);
-        glBindTexture(GL_TEXTURE_2D, m_RendererID);
+        m_Type = ResourceType::Texture;
+        CreateGLTexture();
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+                     nullptr);
+        RenderState::Get().BindTexture(0, GL_TEXTURE_2D, 0);
+    }
 
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    /** @brief Destructor that cleans up OpenGL resources */
+    Texture::~Texture() {
+        RenderState::Get().OnTextureDeleted(m_RendererID);
+        glDeleteTextures(1, &m_RendererID);
+    }
+
+    /** @brief Generates the GL texture and sets its sampling state; leaves it bound to unit 0 */
+    void Texture::CreateGLTexture() {
+        glGenTextures(1, &m_RendererID);
+        RenderState::Get().BindTexture(0, GL_TEXTURE_2D, m_RendererID);
 
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    }
+
+    /** @brief Decodes an image file to RGBA8 on the calling thread
+     *  @param path Path to the image file
+     *  @param generateMips Also build the mip chain
+     *  @return Decoded image, invalid on failure
+     */
+    TextureImage Texture::Decode(const std::string& path, bool generateMips) {
+        PROFILE_FUNCTION();
+        TextureImage image;
+
+        // The per-thread flag, as decodes run concurrently on the I/O threads
+        stbi_set_flip_vertically_on_load_thread(1);
 
-        glBindTexture(GL_TEXTURE_2D, 0);
+        // Always expand to RGBA: rows stay 4-byte aligned and mips need one pixel format
+        int width, height, channels;
+        unsigned char* data = stbi_load(path.c_str(), &width, &height, &channels, STBI_rgb_alpha);
+        if (!data) {
+            return image;
+        }
+
+        const size_t size = static_cast<size_t>(width) * height * 4;
+        image.pixels.reserve(generateMips ? size + size / 3 + 4 * 32 : size);
+        image.pixels.assign(data, data + size);
+        stbi_image_free(data);
+        image.levels.push_back({static_cast<uint32_t>(width), static_cast<uint32_t>(height), 0});
+
+        if (generateMips) {
+            GenerateMips(image);
+        }
+        return image;
     }
 
-    /** @brief Destructor that cleans up OpenGL resources */
-    Texture::~Texture() {
-        glDeleteTextures(1, &m_RendererID);
+    namespace {
+        /** @brief Averages 2x2 RGBA8 blocks of two source rows into one destination row */
+        void DownsampleRow(const uint8_t* row0, const uint8_t* row1, uint32_t srcWidth,
+                           uint8_t* out, uint32_t dstWidth) {
+            uint32_t x = 0;
+#if ENGINE_TEXTURE_SSE2
+            // Four output pixels per step, widened to 16 bits so the rounding matches the
+            // scalar loop exactly. Columns only clamp when srcWidth is 1, which never
+            // reaches a full step.
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i round = _mm_set1_epi16(2);
+            const auto averagePair = [&](const uint8_t* top, const uint8_t* bottom) {
+                const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(top));
+                const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bottom));
+                const __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(a, zero),
+                                                 _mm_unpacklo_epi8(b, zero));
+                const __m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(a, zero),
+                                                 _mm_unpackhi_epi8(b, zero));
+                const __m128i sum = _mm_add_epi16(_mm_unpacklo_epi64(lo, hi),
+                                                  _mm_unpackhi_epi64(lo, hi));
+                return _mm_srli_epi16(_mm_add_epi16(sum, round), 2);
+            };
+            for (; x + 4 <= dstWidth; x += 4) {
+                const size_t offset = static_cast<size_t>(x) * 8;
+                const __m128i first = averagePair(row0 + offset, row1 + offset);
+                const __m128i second = averagePair(row0 + offset + 16, row1 + offset + 16);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + static_cast<size_t>(x) * 4),
+                                 _mm_packus_epi16(first, second));
+            }
+#endif
+            for (; x < dstWidth; ++x) {
+                const size_t x0 = static_cast<size_t>(std::min(2 * x, srcWidth - 1)) * 4;
+                const size_t x1 = static_cast<size_t>(std::min(2 * x + 1, srcWidth - 1)) * 4;
+                for (size_t c = 0; c < 4; ++c) {
+                    const uint32_t sum = row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c];
+                    out[x * 4 + c] = static_cast<uint8_t>((sum + 2) >> 2);
+                }
+            }
+        }
+    }
+
+    /** @brief Box-filters level 0 down, clamping at odd edges
+     *  @param image Image holding only level 0
+     *  @param maxLevels Levels to end up with including level 0; 0 for the full chain
+     */
+    void Texture::GenerateMips(TextureImage& image, uint32_t maxLevels) {
+        PROFILE_FUNCTION();
+        ASSERT(image.levels.size() == 1 && "GenerateMips expects a single level image");
+        ASSERT(!image.mapping && "GenerateMips cannot extend a cache-mapped image");
+        if (maxLevels == 0) maxLevels = ~0u;
+
+        size_t total = 0;
+        uint32_t levelCount = 0;
+        for (uint32_t w = image.levels[0].width, h = image.levels[0].height;
+             levelCount < maxLevels; w = std::max(w / 2, 1u), h = std::max(h / 2, 1u)) {
+            total += static_cast<size_t>(w) * h * 4;
+            ++levelCount;
+            if (w == 1 && h == 1) break;
+        }
+        image.pixels.resize(total);
+
+        while (image.levels.size() < levelCount) {
+            const TextureImage::Level src = image.levels.back();
+            const size_t srcStride = static_cast<size_t>(src.width) * 4;
+            const TextureImage::Level dst{std::max(src.width / 2, 1u),
+                                          std::max(src.height / 2, 1u),
+                                          src.offset + srcStride * src.height};
+            const uint8_t* in = image.pixels.data() + src.offset;
+            uint8_t* out = image.pixels.data() + dst.offset;
+
+            for (uint32_t y = 0; y < dst.height; ++y) {
+                DownsampleRow(in + std::min(2 * y, src.height - 1) * srcStride,
+                              in + std::min(2 * y + 1, src.height - 1) * srcStride, src.width,
+                              out + static_cast<size_t>(y) * dst.width * 4, dst.width);
+            }
+            image.levels.push_back(dst);
+        }
+    }
+
+    /** @brief Uploads every level of a decoded image into this texture
+     *  @param image Valid decoded image
+     */
+    void Texture::Upload(const TextureImage& image) {
+        PROFILE_FUNCTION();
+        ASSERT(image.IsValid() && "Uploading an image that failed to decode");
+        if (m_RendererID) {
+            RenderState::Get().BindTexture(0, GL_TEXTURE_2D, m_RendererID);
+        } else {
+            CreateGLTexture();
+        }
+
+        const GLint levelCount = static_cast<GLint>(image.levels.size());
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
+                        levelCount > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levelCount - 1);
+        for (GLint level = 0; level < levelCount; ++level) {
+            const TextureImage::Level& mip = image.levels[level];
+            glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA8, mip.width, mip.height, 0, GL_RGBA,
+                         GL_UNSIGNED_BYTE, image.GetPixels() + mip.offset);
+        }
+        RenderState::Get().BindTexture(0, GL_TEXTURE_2D, 0);
+
+        m_Width = static_cast<int>(image.levels[0].width);
+        m_Height = static_cast<int>(image.levels[0].height);
+        m_BPP = 32;
+        m_IsLoaded = true;
     }
 
     /** @brief Binds the texture to a specific texture slot
      *  @param slot The texture unit slot to bind to
      */
     void Texture::Bind(uint32_t slot) const {
-        glActiveTexture(GL_TEXTURE0 + slot);
-        glBindTexture(GL_TEXTURE_2D, m_RendererID);
+        RenderState::Get().BindTexture(slot, GL_TEXTURE_2D, m_RendererID);
     }
 
     /** @brief Unbinds the texture */
     void Texture::Unbind() const {
-        glBindTexture(GL_TEXTURE_2D, 0);
+        RenderState& state = RenderState::Get();
+        state.BindTexture(state.GetActiveTextureUnit(), GL_TEXTURE_2D, 0);
     }
 
     /** @brief Default constructor */
@@ -107,48 +236,18 @@ namespace Engine {
      */
     bool Texture::Load(const std::string& path) {
         m_Path = path;
-        stbi_set_flip_vertically_on_load(1);
-        
-        int width, height, channels;
-        unsigned char* data = stbi_load(path.c_str(), &width, &height, &channels, 0);
-        
-        if (!data) {
+        const TextureImage image = TextureCache::Get().Load(path);
+        if (!image.IsValid()) {
             return false;
         }
-        
-        m_Width = width;
-        m_Height = height;
-
-        GLenum internalFormat = 0, dataFormat = 0;
-        if (channels == 4) {
-            internalFormat = GL_RGBA8;
-            dataFormat = GL_RGBA;
-        }
-        else if (channels == 3) {
-            internalFormat = GL_RGB8;
-            dataFormat = GL_RGB;
-        }
-
-        glGenTextures(1, &m_RendererID);
-        glBindTexture(GL_TEXTURE_2D, m_RendererID);
-
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-
-        glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, m_Width, m_Height, 0, dataFormat, GL_UNSIGNED_BYTE, data);
-        stbi_image_free(data);
-        
-        glBindTexture(GL_TEXTURE_2D, 0);
-        m_IsLoaded = true;
-        
+        Upload(image);
         return true;
     }
 
     /** @brief Unloads the texture and frees GPU resources */
     void Texture::Unload() {
         if (m_RendererID) {
+            RenderState::Get().OnTextureDeleted(m_RendererID);
             glDeleteTextures(1, &m_RendererID);
             m_RendererID = 0;
         }
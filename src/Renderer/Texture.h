@@ -7,10 +7,44 @@
 
 #include <stb_image.h>
 
+#include "../Core/MappedFile.h"
 #include "../Core/Resource.h"
 
 namespace Engine {
 
+/**
+ * @brief Decoded RGBA8 pixels of a texture and optionally its mip chain
+ * @details Produced by Texture::Decode() or TextureCache::Load() on any thread and
+ *          consumed by Texture::Upload() on the main thread. Images loaded from the
+ *          texture cache read their pixels from the mapped cache file instead of
+ *          owning them; those are read-only.
+ */
+struct TextureImage {
+    /** @brief One mip level inside the pixel data */
+    struct Level {
+        uint32_t width;
+        uint32_t height;
+        size_t offset;  ///< Byte offset of the level from GetPixels()
+    };
+
+    std::vector<uint8_t> pixels;          ///< Every level, tightly packed, level 0 first
+    std::vector<Level> levels;            ///< Empty if decoding failed
+    std::shared_ptr<MappedFile> mapping;  ///< Holds the pixels instead when set
+    size_t mappingOffset = 0;             ///< Offset of level 0 in the mapping
+
+    bool IsValid() const { return !levels.empty(); }
+    /** @return Level 0, followed by the other levels */
+    const uint8_t* GetPixels() const {
+        return mapping ? mapping->GetData() + mappingOffset : pixels.data();
+    }
+    /** @return Bytes Upload() sends to the GPU */
+    size_t GetByteSize() const {
+        if (levels.empty()) return 0;
+        const Level& last = levels.back();
+        return last.offset + static_cast<size_t>(last.width) * last.height * 4;
+    }
+};
+
 /**
  * @class Texture
  * @brief Represents a 2D texture resource that can be loaded from file or created empty
@@ -67,6 +101,32 @@ public:
      * @return Shared pointer to the new texture
      */
     static std::shared_ptr<Texture> Create(uint32_t width, uint32_t height);
+
+    /**
+     * @brief Decodes an image file to RGBA8 without touching GL
+     * @param path Path to the image file
+     * @param generateMips Also build the mip chain on the CPU
+     * @return The decoded image; invalid if the file could not be read
+     * @note Thread-safe; TextureLoader runs it on the I/O threads
+     */
+    static TextureImage Decode(const std::string& path, bool generateMips = false);
+
+    /**
+     * @brief Appends the mip chain of level 0 to an image with a 2x2 box filter
+     * @param image Image with exactly one level
+     * @param maxLevels Levels to end up with including level 0; 0 builds down to 1x1.
+     *                  Atlases stop early so their padding keeps tiles from bleeding.
+     * @note Uses SSE2 where available; the result is identical to the scalar path
+     */
+    static void GenerateMips(TextureImage& image, uint32_t maxLevels = 0);
+
+    /**
+     * @brief Replaces the texture's contents and size with a decoded image
+     * @details Keeps the GL name, so materials and batches referring to a placeholder
+     *          texture show the image once it is uploaded. Main thread only.
+     * @param image Valid image from Decode()
+     */
+    void Upload(const TextureImage& image);
     
     /**
      * @brief Binds the texture to a specific texture unit
@@ -118,6 +178,9 @@ public:
     }
 
 private:
+    /** @brief Generates the GL name with default sampling; leaves it bound to unit 0 */
+    void CreateGLTexture();
+
     uint32_t m_RendererID = 0;          ///< OpenGL texture handle
     int m_Width = 0, m_Height = 0;      ///< Texture dimensions
     int m_BPP = 0;                      ///< Bits per pixel
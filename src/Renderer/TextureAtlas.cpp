@@ -0,0 +1,239 @@
+/**
+ * @file TextureAtlas.cpp
+ * @brief Skyline packing and padded, mipmapped atlas assembly
+ */
+#include "TextureAtlas.h"
+
+#include "TextureCache.h"
+
+namespace Engine {
+    namespace {
+        uint32_t NextPowerOfTwo(uint32_t value) {
+            uint32_t result = 1;
+            while (result < value) result <<= 1;
+            return result;
+        }
+
+        uint32_t RoundUp(uint32_t value, uint32_t multiple) {
+            return (value + multiple - 1) / multiple * multiple;
+        }
+    }
+
+    void SkylinePacker::Reset(uint32_t width, uint32_t height) {
+        m_Width = width;
+        m_Height = height;
+        m_UsedArea = 0;
+        m_Skyline.clear();
+        if (width > 0) m_Skyline.push_back({0, 0, width});
+    }
+
+    uint32_t SkylinePacker::Fit(size_t index, uint32_t width, uint32_t height) const {
+        if (m_Skyline[index].x + width > m_Width) return NO_FIT;
+        uint32_t y = 0;
+        uint32_t remaining = width;
+        for (size_t i = index; remaining > 0; ++i) {
+            y = std::max(y, m_Skyline[i].y);
+            if (y + height > m_Height) return NO_FIT;
+            remaining -= std::min(remaining, m_Skyline[i].width);
+        }
+        return y;
+    }
+
+    bool SkylinePacker::Insert(uint32_t width, uint32_t height, Rect& out) {
+        size_t bestIndex = m_Skyline.size();
+        uint32_t bestTop = NO_FIT, bestWidth = NO_FIT, bestY = 0;
+        for (size_t i = 0; i < m_Skyline.size(); ++i) {
+            const uint32_t y = Fit(i, width, height);
+            if (y == NO_FIT) continue;
+            const uint32_t top = y + height;
+            if (top < bestTop || (top == bestTop && m_Skyline[i].width < bestWidth)) {
+                bestIndex = i;
+                bestTop = top;
+                bestWidth = m_Skyline[i].width;
+                bestY = y;
+            }
+        }
+        if (bestIndex == m_Skyline.size()) return false;
+
+        out = {m_Skyline[bestIndex].x, bestY, width, height};
+        AddLevel(bestIndex, out);
+        m_UsedArea += static_cast<uint64_t>(width) * height;
+        return true;
+    }
+
+    void SkylinePacker::AddLevel(size_t index, const Rect& rect) {
+        m_Skyline.insert(m_Skyline.begin() + index, {rect.x, rect.y + rect.height, rect.width});
+
+        // Trim the segments the new one covers
+        for (size_t i = index + 1; i < m_Skyline.size();) {
+            const Segment& previous = m_Skyline[i - 1];
+            Segment& segment = m_Skyline[i];
+            const uint32_t previousEnd = previous.x + previous.width;
+            if (segment.x >= previousEnd) break;
+            const uint32_t overlap = previousEnd - segment.x;
+            if (segment.width <= overlap) {
+                m_Skyline.erase(m_Skyline.begin() + i);
+                continue;
+            }
+            segment.x += overlap;
+            segment.width -= overlap;
+            break;
+        }
+
+        // Merge neighbours at the same height
+        for (size_t i = 0; i + 1 < m_Skyline.size();) {
+            if (m_Skyline[i].y == m_Skyline[i + 1].y) {
+                m_Skyline[i].width += m_Skyline[i + 1].width;
+                m_Skyline.erase(m_Skyline.begin() + i + 1);
+            } else {
+                ++i;
+            }
+        }
+    }
+
+    float SkylinePacker::GetOccupancy() const {
+        const uint64_t area = static_cast<uint64_t>(m_Width) * m_Height;
+        return area ? static_cast<float>(m_UsedArea) / static_cast<float>(area) : 0.0f;
+    }
+
+    uint32_t TextureAtlasBuilder::Add(const std::string& name, TextureImage image) {
+        ASSERT(image.IsValid() && "Adding an invalid image to an atlas");
+        const TextureImage::Level& level = image.levels[0];
+        const size_t size = static_cast<size_t>(level.width) * level.height * 4;
+        if (image.mapping) {
+            // Cached images are read-only views; the builder keeps its own copy
+            image.pixels.assign(image.GetPixels(), image.GetPixels() + size);
+            image.mapping.reset();
+        }
+        image.pixels.resize(size);
+        image.levels.resize(1);
+        m_Images.push_back({name, std::move(image)});
+        return static_cast<uint32_t>(m_Images.size() - 1);
+    }
+
+    uint32_t TextureAtlasBuilder::AddFile(const std::string& name, const std::string& path) {
+        TextureImage image = TextureCache::Get().Load(path);
+        if (!image.IsValid()) {
+            LOG_ERROR_CONCAT("Failed to decode atlas image: ", path);
+            return INVALID_REGION;
+        }
+        return Add(name, std::move(image));
+    }
+
+    TextureAtlasBuilder::Layout TextureAtlasBuilder::Pack(
+        const TextureAtlasSettings& settings) const {
+        PROFILE_FUNCTION();
+        Layout layout;
+        if (m_Images.empty()) return layout;
+
+        // Mipmapped atlases align cells to the padding so each protected level stays whole
+        const bool aligned = settings.generateMips && settings.padding > 0;
+        layout.padding = aligned ? NextPowerOfTwo(settings.padding) : settings.padding;
+        const uint32_t alignment = aligned ? layout.padding : 1;
+
+        layout.cells.resize(m_Images.size());
+        std::vector<uint32_t> order(m_Images.size());
+        uint64_t area = 0;
+        uint32_t largest = 1;
+        for (uint32_t i = 0; i < m_Images.size(); ++i) {
+            const TextureImage::Level& level = m_Images[i].image.levels[0];
+            SkylinePacker::Rect& cell = layout.cells[i];
+            cell.width = RoundUp(level.width + 2 * layout.padding, alignment);
+            cell.height = RoundUp(level.height + 2 * layout.padding, alignment);
+            area += static_cast<uint64_t>(cell.width) * cell.height;
+            largest = std::max({largest, cell.width, cell.height});
+            order[i] = i;
+        }
+        std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+            const auto& cellA = layout.cells[a];
+            const auto& cellB = layout.cells[b];
+            return cellA.height != cellB.height ? cellA.height > cellB.height
+                                                : cellA.width > cellB.width;
+        });
+
+        // Smallest power-of-two square covering the area, then grow one side at a time
+        uint32_t side = NextPowerOfTwo(std::max(
+            largest, static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<double>(area))))));
+        uint32_t width = side, height = side;
+        SkylinePacker packer;
+        while (width <= settings.maxSize && height <= settings.maxSize) {
+            packer.Reset(width, height);
+            bool packed = true;
+            for (uint32_t index : order) {
+                SkylinePacker::Rect& cell = layout.cells[index];
+                if (!packer.Insert(cell.width, cell.height, cell)) {
+                    packed = false;
+                    break;
+                }
+            }
+            if (packed) {
+                layout.width = width;
+                layout.height = height;
+                return layout;
+            }
+            if (height < width) {
+                height *= 2;
+            } else {
+                width *= 2;
+            }
+        }
+
+        LOG_ERROR_CONCAT("Texture atlas of ", m_Images.size(), " images exceeds ",
+                         settings.maxSize, "x", settings.maxSize);
+        return Layout();
+    }
+
+    TextureAtlas TextureAtlasBuilder::Build(const TextureAtlasSettings& settings) const {
+        PROFILE_FUNCTION();
+        TextureAtlas atlas;
+        const Layout layout = Pack(settings);
+        if (layout.width == 0) return atlas;
+
+        const size_t atlasStride = static_cast<size_t>(layout.width) * 4;
+        const uint32_t padding = layout.padding;
+        atlas.image.pixels.assign(atlasStride * layout.height, 0);
+        atlas.image.levels.push_back({layout.width, layout.height, 0});
+        atlas.regions.resize(m_Images.size());
+
+        for (uint32_t i = 0; i < m_Images.size(); ++i) {
+            const TextureImage& image = m_Images[i].image;
+            const uint32_t width = image.levels[0].width;
+            const uint32_t height = image.levels[0].height;
+            const uint32_t x = layout.cells[i].x + padding;
+            const uint32_t y = layout.cells[i].y + padding;
+
+            // Copy the image and extrude its edge texels into the padding
+            for (int64_t row = -static_cast<int64_t>(padding); row < height + padding; ++row) {
+                const int64_t sourceRow = std::clamp<int64_t>(row, 0, height - 1);
+                const uint8_t* source = image.pixels.data() + sourceRow * width * 4;
+                uint8_t* destination = atlas.image.pixels.data() + (y + row) * atlasStride +
+                                       static_cast<size_t>(x - padding) * 4;
+                for (uint32_t column = 0; column < padding; ++column) {
+                    std::memcpy(destination + column * 4, source, 4);
+                    std::memcpy(destination + (padding + width + column) * 4,
+                                source + (width - 1) * 4, 4);
+                }
+                std::memcpy(destination + padding * 4, source, static_cast<size_t>(width) * 4);
+            }
+
+            AtlasRegion& region = atlas.regions[i];
+            region.x = x;
+            region.y = y;
+            region.width = width;
+            region.height = height;
+            region.uvMin = {static_cast<float>(x) / layout.width,
+                            static_cast<float>(y) / layout.height};
+            region.uvMax = {static_cast<float>(x + width) / layout.width,
+                            static_cast<float>(y + height) / layout.height};
+            atlas.names[m_Images[i].name] = i;
+        }
+
+        // Levels up to log2(padding) keep at least one padding texel around every image
+        if (settings.generateMips && padding > 0) {
+            uint32_t levels = 1;
+            while ((1u << levels) <= padding) ++levels;
+            Texture::GenerateMips(atlas.image, levels);
+        }
+        return atlas;
+    }
+}
@@ -0,0 +1,145 @@
+#pragma once
+#include <pch.h>
+
+#include "Texture.h"
+
+namespace Engine {
+    /**
+     * @brief Skyline bottom-left packer of rectangles into a fixed area
+     *
+     * Keeps the top edge of the packed area as a list of horizontal segments
+     * and places each rectangle where its top ends lowest, preferring the
+     * narrower segment on ties. Insert() is O(segments); packing rectangles
+     * sorted by decreasing height keeps the skyline short and the area dense.
+     */
+    class SkylinePacker {
+    public:
+        struct Rect {
+            uint32_t x = 0;
+            uint32_t y = 0;
+            uint32_t width = 0;
+            uint32_t height = 0;
+        };
+
+        SkylinePacker(uint32_t width = 0, uint32_t height = 0) { Reset(width, height); }
+
+        /** @brief Empties the packer and sets its size */
+        void Reset(uint32_t width, uint32_t height);
+
+        /**
+         * @brief Places a rectangle
+         * @param out Position of the rectangle, set on success
+         * @return false if it does not fit anywhere
+         */
+        bool Insert(uint32_t width, uint32_t height, Rect& out);
+
+        uint32_t GetWidth() const { return m_Width; }
+        uint32_t GetHeight() const { return m_Height; }
+        /** @return Fraction of the area covered by inserted rectangles */
+        float GetOccupancy() const;
+
+    private:
+        struct Segment {
+            uint32_t x;
+            uint32_t y;
+            uint32_t width;
+        };
+
+        static constexpr uint32_t NO_FIT = ~0u;
+
+        /** @return Height a rectangle starting at segment index rests on, or NO_FIT */
+        uint32_t Fit(size_t index, uint32_t width, uint32_t height) const;
+        /** @brief Raises the skyline over a placed rectangle */
+        void AddLevel(size_t index, const Rect& rect);
+
+        std::vector<Segment> m_Skyline;
+        uint32_t m_Width = 0;
+        uint32_t m_Height = 0;
+        uint64_t m_UsedArea = 0;
+    };
+
+    /** @brief Placement of one image in a TextureAtlas */
+    struct AtlasRegion {
+        glm::vec2 uvMin{0.0f};   ///< UV of the image's first texel corner, padding excluded
+        glm::vec2 uvMax{0.0f};   ///< UV of the image's opposite corner
+        uint32_t x = 0;          ///< First texel of the image in level 0
+        uint32_t y = 0;
+        uint32_t width = 0;
+        uint32_t height = 0;
+    };
+
+    /** @brief Images packed into one texture, with their UV rectangles */
+    struct TextureAtlas {
+        TextureImage image;                               ///< Level 0 and its unbled mips
+        std::vector<AtlasRegion> regions;                 ///< In TextureAtlasBuilder::Add() order
+        std::unordered_map<std::string, uint32_t> names;  ///< Region index by image name
+
+        /** @return Region of a named image, null if the atlas does not contain it */
+        const AtlasRegion* Find(const std::string& name) const {
+            auto it = names.find(name);
+            return it != names.end() ? &regions[it->second] : nullptr;
+        }
+    };
+
+    /** @brief Settings of TextureAtlasBuilder::Build() */
+    struct TextureAtlasSettings {
+        uint32_t padding = 4;        ///< Edge texels around each image, a power of two with mips
+        bool generateMips = true;    ///< Build the levels the padding protects
+        uint32_t maxSize = 8192;     ///< Largest atlas side
+    };
+
+    /**
+     * @brief Assembles individual images into a padded, mipmapped atlas at runtime
+     *
+     * Every image is surrounded by `padding` texels copied from its edges and
+     * placed on a grid of 2^L texels, where L = log2(padding). Mip levels up
+     * to L then never average texels of two images, so Build() stops the
+     * chain there instead of letting distant levels bleed.
+     *
+     * The atlas is the smallest power-of-two size, up to the settings' maxSize,
+     * that the skyline packer fits every image into.
+     */
+    class TextureAtlasBuilder {
+    public:
+        static constexpr uint32_t INVALID_REGION = ~0u;
+
+        /** @brief Packed atlas size and each image's padded rectangle, in Add() order */
+        struct Layout {
+            uint32_t width = 0;
+            uint32_t height = 0;
+            uint32_t padding = 0;
+            std::vector<SkylinePacker::Rect> cells;
+        };
+
+        /**
+         * @brief Adds a decoded image; only level 0 is used
+         * @return Index of its region in the built atlas
+         */
+        uint32_t Add(const std::string& name, TextureImage image);
+
+        /**
+         * @brief Loads an image file through the TextureCache and adds it
+         * @return Index of its region, INVALID_REGION if the file could not be decoded
+         */
+        uint32_t AddFile(const std::string& name, const std::string& path);
+
+        /** @return Placement of every image, empty if they do not fit in maxSize */
+        Layout Pack(const TextureAtlasSettings& settings = TextureAtlasSettings()) const;
+
+        /**
+         * @brief Packs, copies the images with extruded padding and generates the mips
+         * @return The atlas; its image is invalid if packing failed
+         */
+        TextureAtlas Build(const TextureAtlasSettings& settings = TextureAtlasSettings()) const;
+
+        size_t GetImageCount() const { return m_Images.size(); }
+
+    private:
+        struct Entry {
+            std::string name;
+            TextureImage image;
+        };
+
+        std::vector<Entry> m_Images;
+    };
+}
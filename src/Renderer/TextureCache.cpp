@@ -0,0 +1,225 @@
+/**
+ * @file TextureCache.cpp
+ * @brief Memory-mapped cache of decoded texture levels
+ */
+#include "TextureCache.h"
+
+#include <filesystem>
+
+#include "Buffer.h"
+
+namespace Engine {
+    namespace {
+        /** @brief Fixed part of an entry, followed by levelCount LevelRecords */
+        struct EntryHeader {
+            uint32_t magic;
+            uint32_t version;
+            int64_t sourceTime;    ///< Source modification time, filesystem clock ticks
+            uint64_t sourceSize;
+            uint64_t sourceHash;   ///< HashBufferContents() of the source file
+            uint32_t levelCount;
+            uint32_t reserved;
+        };
+
+        struct LevelRecord {
+            uint32_t width;
+            uint32_t height;
+            uint64_t offset;       ///< From the start of the level data
+        };
+
+        constexpr size_t DATA_ALIGNMENT = 64;
+        constexpr uint32_t MAX_LEVELS = 32;
+
+        size_t GetDataOffset(uint32_t levelCount) {
+            const size_t tableEnd = sizeof(EntryHeader) + levelCount * sizeof(LevelRecord);
+            return (tableEnd + DATA_ALIGNMENT - 1) / DATA_ALIGNMENT * DATA_ALIGNMENT;
+        }
+
+        /** @return Whether a mapped file is a complete entry of this version */
+        bool ReadHeader(const MappedFile& file, EntryHeader& header) {
+            if (file.GetSize() < sizeof(EntryHeader)) return false;
+            std::memcpy(&header, file.GetData(), sizeof(header));
+            if (header.magic != TextureCache::MAGIC || header.version != TextureCache::VERSION ||
+                header.levelCount == 0 || header.levelCount > MAX_LEVELS) {
+                return false;
+            }
+            return file.GetSize() >= GetDataOffset(header.levelCount);
+        }
+
+        /**
+         * @return Image viewing the levels of a mapped entry; invalid if a level overruns
+         *         the file or does not start after the previous one, as Write() lays them out
+         */
+        TextureImage MapImage(std::shared_ptr<MappedFile> file, const EntryHeader& header) {
+            TextureImage image;
+            const size_t dataOffset = GetDataOffset(header.levelCount);
+            const uint64_t available = file->GetSize() - dataOffset;  // ReadHeader() checked
+            const uint8_t* table = file->GetData() + sizeof(EntryHeader);
+            image.levels.resize(header.levelCount);
+            uint64_t previousEnd = 0;
+            for (uint32_t i = 0; i < header.levelCount; ++i) {
+                LevelRecord record;
+                std::memcpy(&record, table + i * sizeof(LevelRecord), sizeof(record));
+                // Each bound is checked without overflow: the offset first, then the size
+                // against what is left after it
+                const uint64_t pixels = static_cast<uint64_t>(record.width) * record.height;
+                if (record.offset < previousEnd || record.offset > available ||
+                    pixels > (available - record.offset) / 4) {
+                    return TextureImage();
+                }
+                previousEnd = record.offset + pixels * 4;
+                image.levels[i] = {record.width, record.height, static_cast<size_t>(record.offset)};
+            }
+            image.mapping = std::move(file);
+            image.mappingOffset = dataOffset;
+            return image;
+        }
+
+        /** @return Modification time of a file in filesystem clock ticks */
+        int64_t GetModificationTime(const std::string& path, std::error_code& error) {
+            const auto time = std::filesystem::last_write_time(path, error);
+            return static_cast<int64_t>(time.time_since_epoch().count());
+        }
+
+        uint64_t HashFile(const std::string& path) {
+            const auto file = MappedFile::Open(path);
+            return file ? HashBufferContents(file->GetData(), file->GetSize()) : 0;
+        }
+    }
+
+    void TextureCache::Configure(const TextureCacheConfig& config) {
+        m_Enabled = config.enabled;
+        m_Directory = config.directory;
+        if (!m_Enabled) return;
+
+        std::error_code error;
+        std::filesystem::create_directories(m_Directory, error);
+        if (error) {
+            LOG_WARN_CONCAT("Texture cache disabled, cannot create ", m_Directory, ": ",
+                            error.message());
+            m_Enabled = false;
+        }
+    }
+
+    TextureImage TextureCache::Load(const std::string& path, bool generateMips) {
+        PROFILE_FUNCTION();
+        if (!m_Enabled) return Texture::Decode(path, generateMips);
+
+        std::error_code error;
+        const int64_t sourceTime = GetModificationTime(path, error);
+        const uint64_t sourceSize = error ? 0 : std::filesystem::file_size(path, error);
+        if (error) return Texture::Decode(path, generateMips);
+
+        const std::string entryPath = GetEntryPath(path, generateMips);
+        auto file = MappedFile::Open(entryPath);
+        EntryHeader header;
+        if (file && ReadHeader(*file, header) && header.sourceSize == sourceSize) {
+            if (header.sourceTime == sourceTime) {
+                TextureImage image = MapImage(std::move(file), header);
+                if (image.IsValid()) {
+                    m_Hits.fetch_add(1, std::memory_order_relaxed);
+                    return image;
+                }
+            } else if (header.sourceHash == HashFile(path)) {
+                // Touched but unchanged: keep the pixels and replace the entry with one
+                // recording the new time. Write() renames a temporary file into place, so
+                // threads and processes mapping the old entry keep reading it intact. The
+                // pixels are copied out first since Windows cannot replace a mapped file
+                TextureImage image = MapImage(std::move(file), header);
+                if (image.IsValid()) {
+                    const uint8_t* pixels = image.GetPixels();
+                    image.pixels.assign(pixels, pixels + image.GetByteSize());
+                    image.mapping.reset();
+                    image.mappingOffset = 0;
+                    Write(entryPath, image, sourceTime, sourceSize, header.sourceHash);
+
+                    m_Hits.fetch_add(1, std::memory_order_relaxed);
+                    m_Rehashed.fetch_add(1, std::memory_order_relaxed);
+                    return image;
+                }
+            }
+        }
+        file.reset();
+
+        m_Misses.fetch_add(1, std::memory_order_relaxed);
+        TextureImage image = Texture::Decode(path, generateMips);
+        if (image.IsValid()) Write(entryPath, image, sourceTime, sourceSize, HashFile(path));
+        return image;
+    }
+
+    void TextureCache::Write(const std::string& entryPath, const TextureImage& image,
+                             int64_t sourceTime, uint64_t sourceSize, uint64_t sourceHash) const {
+        PROFILE_FUNCTION();
+        const uint32_t levelCount = static_cast<uint32_t>(image.levels.size());
+        if (levelCount > MAX_LEVELS) return;
+
+        const EntryHeader header{MAGIC, VERSION, sourceTime, sourceSize, sourceHash, levelCount, 0};
+        std::vector<LevelRecord> table(levelCount);
+        for (uint32_t i = 0; i < levelCount; ++i) {
+            const TextureImage::Level& level = image.levels[i];
+            table[i] = {level.width, level.height, static_cast<uint64_t>(level.offset)};
+        }
+        const size_t padding =
+            GetDataOffset(levelCount) - sizeof(header) - table.size() * sizeof(LevelRecord);
+        const char zeros[DATA_ALIGNMENT] = {};
+
+        // A per-thread temporary name keeps concurrent writers of one entry apart
+        const size_t threadId = std::hash<std::thread::id>()(std::this_thread::get_id());
+        const std::string temporaryPath = entryPath + "." + std::to_string(threadId) + ".tmp";
+        {
+            std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(reinterpret_cast<const char*>(table.data()),
+                       static_cast<std::streamsize>(table.size() * sizeof(LevelRecord)));
+            file.write(zeros, static_cast<std::streamsize>(padding));
+            file.write(reinterpret_cast<const char*>(image.GetPixels()),
+                       static_cast<std::streamsize>(image.GetByteSize()));
+            file.close();  // Flushes, so a full disk shows in the stream state
+            if (!file) {
+                std::error_code error;
+                std::filesystem::remove(temporaryPath, error);
+                LOG_WARN_CONCAT("Failed to write texture cache entry: ", entryPath);
+                return;
+            }
+        }
+
+        std::error_code error;
+        std::filesystem::rename(temporaryPath, entryPath, error);
+        if (error) {
+            // Another thread or process holds the entry; it serves the next start instead
+            std::filesystem::remove(temporaryPath, error);
+        }
+    }
+
+    std::string TextureCache::GetEntryPath(const std::string& path, bool generateMips) const {
+        const std::string key = path + (generateMips ? "|mips" : "|base");
+        char name[17];
+        std::snprintf(name, sizeof(name), "%016llx",
+                      static_cast<unsigned long long>(HashBufferContents(key.data(), key.size())));
+        return (std::filesystem::path(m_Directory) / (name + std::string(EXTENSION))).string();
+    }
+
+    void TextureCache::Clear() {
+        std::error_code error;
+        for (const auto& entry : std::filesystem::directory_iterator(m_Directory, error)) {
+            if (entry.path().extension() == EXTENSION) {
+                std::error_code removeError;
+                std::filesystem::remove(entry.path(), removeError);
+            }
+        }
+    }
+
+    TextureCache::Statistics TextureCache::GetStatistics() const {
+        Statistics stats;
+        stats.hits = m_Hits.load(std::memory_order_relaxed);
+        stats.rehashed = m_Rehashed.load(std::memory_order_relaxed);
+        stats.misses = m_Misses.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    void TextureCache::ResetStatistics() {
+        m_Hits.store(0, std::memory_order_relaxed);
+        m_Rehashed.store(0, std::memory_order_relaxed);
+        m_Misses.store(0, std::memory_order_relaxed);
+    }
+}
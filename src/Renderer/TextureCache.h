@@ -0,0 +1,101 @@
+#pragma once
+#include <pch.h>
+#include <atomic>
+
+#include "../Core/Config.h"
+#include "Texture.h"
+
+namespace Engine {
+    /** @brief Location and switch of the TextureCache */
+    struct TextureCacheConfig {
+        bool enabled = true;
+        std::string directory = ".texture_cache";  ///< Created on first use
+
+        /**
+         * @brief Reads the [TextureCache] section of the engine config
+         * @details Keys: enabled, directory
+         */
+        static TextureCacheConfig FromConfig(const Config& config) {
+            TextureCacheConfig result;
+            result.enabled = config.GetBool("TextureCache", "enabled", true);
+            result.directory = config.GetString("TextureCache", "directory", ".texture_cache");
+            return result;
+        }
+    };
+
+    /**
+     * @brief On-disk cache of decoded textures, so warm starts skip PNG decoding
+     *
+     * Every source image decoded through Load() is written once as its final
+     * RGBA8 levels, mips included, to one file per source path and mip setting.
+     * Later loads memory-map that file and hand the mapped levels straight to
+     * Texture::Upload(), so a warm load is a page-cache read with no decode,
+     * no CPU mip generation and no pixel copy.
+     *
+     * An entry is used while the source's modification time and size match the
+     * ones it recorded. If only the time differs, the source is hashed and the
+     * entry is kept, with its time refreshed, when the content is unchanged
+     * (checkouts and copies touch files without editing them). Anything else
+     * re-decodes the source and replaces the entry.
+     *
+     * Entry layout, little-endian: header (magic, version, source time, size
+     * and hash, level count), level table, then the levels from a 64-byte
+     * aligned offset. Entries are written to a temporary file and renamed into
+     * place, so a crashed or concurrent writer never leaves a torn entry.
+     *
+     * Disabled until Configure() is called; Load() then decodes directly.
+     * Load() is thread-safe and runs on the TextureLoader I/O threads.
+     */
+    class TextureCache {
+    public:
+        static constexpr uint32_t MAGIC = 0x43545856;  ///< "VXTC"
+        static constexpr uint32_t VERSION = 1;
+        static constexpr const char* EXTENSION = ".vxtex";
+
+        /** @brief Outcomes of Load() since the last ResetStatistics() */
+        struct Statistics {
+            uint32_t hits = 0;      ///< Served from a mapped entry
+            uint32_t rehashed = 0;  ///< Hits whose source was touched but not changed
+            uint32_t misses = 0;    ///< Decoded, and written unless decoding failed
+        };
+
+        static TextureCache& Get() {
+            static TextureCache instance;
+            return instance;
+        }
+
+        /** @brief Enables or disables the cache and sets its directory; not thread-safe */
+        void Configure(const TextureCacheConfig& config);
+        bool IsEnabled() const { return m_Enabled; }
+        const std::string& GetDirectory() const { return m_Directory; }
+
+        /**
+         * @brief Loads an image through the cache
+         * @param path Source image file
+         * @param generateMips Whether the image carries its full mip chain
+         * @return The image, mapped from the cache on a hit; invalid if the source cannot be read
+         */
+        TextureImage Load(const std::string& path, bool generateMips = false);
+
+        /** @brief Deletes every entry in the cache directory */
+        void Clear();
+
+        Statistics GetStatistics() const;
+        void ResetStatistics();
+
+    private:
+        TextureCache() = default;
+
+        /** @return Path of the entry caching a source */
+        std::string GetEntryPath(const std::string& path, bool generateMips) const;
+        /** @brief Writes an entry; failures only cost the next start a decode */
+        void Write(const std::string& entryPath, const TextureImage& image, int64_t sourceTime,
+                   uint64_t sourceSize, uint64_t sourceHash) const;
+
+        bool m_Enabled = false;
+        std::string m_Directory;
+        std::atomic<uint32_t> m_Hits{0};
+        std::atomic<uint32_t> m_Rehashed{0};
+        std::atomic<uint32_t> m_Misses{0};
+    };
+}
@@ -0,0 +1,157 @@
+/**
+ * @file TextureLoader.cpp
+ * @brief Background texture decoding with budgeted main-thread uploads
+ */
+#include "TextureLoader.h"
+
+#include "TextureCache.h"
+
+namespace Engine {
+    AsyncTexture TextureLoader::Load(const std::string& path, const TextureLoadOptions& options) {
+        auto request = std::make_shared<TextureLoadRequest>();
+        request->path = path;
+        request->options = options;
+        return Start(std::move(request));
+    }
+
+    AsyncTexture TextureLoader::Load(const std::string& name,
+                                     std::function<TextureImage()> produce,
+                                     std::function<void()> onReady,
+                                     const TextureLoadOptions& options) {
+        auto request = std::make_shared<TextureLoadRequest>();
+        request->path = name;
+        request->options = options;
+        request->produce = std::move(produce);
+        request->onReady = std::move(onReady);
+        return Start(std::move(request));
+    }
+
+    AsyncTexture TextureLoader::Start(std::shared_ptr<TextureLoadRequest> request) {
+        PROFILE_FUNCTION();
+        request->texture = Texture::Create(1, 1);
+        uint32_t placeholder = request->options.placeholderColor;
+        request->texture->SetData(&placeholder, sizeof(placeholder));
+
+        TaskSystem& tasks = TaskSystem::Get();
+        if (tasks.IsInitialized()) {
+            request->decodeTask = tasks.EnqueueIOTask([this, request] { DecodeRequest(request); });
+            m_InFlight.push_back(request);
+        } else {
+            DecodeRequest(request);
+        }
+        return AsyncTexture(std::move(request));
+    }
+
+    void TextureLoader::DecodeRequest(const std::shared_ptr<TextureLoadRequest>& request) {
+        // A throwing decoder fails the load; Update() reports it like an invalid image
+        try {
+            if (request->produce) {
+                request->image = request->produce();
+            } else {
+                request->image =
+                    TextureCache::Get().Load(request->path, request->options.generateMips);
+            }
+        } catch (const std::exception& e) {
+            request->image = TextureImage();
+            request->error = e.what();
+        } catch (...) {
+            request->image = TextureImage();
+            request->error = "unknown exception";
+        }
+        request->produce = nullptr;
+        // Publish under the lock so IsIdle() never sees a decoded image in neither place
+        std::lock_guard<std::mutex> lock(m_DecodedMutex);
+        m_Decoded.push_back(request);
+        request->state.store(TextureLoadState::Uploading, std::memory_order_release);
+    }
+
+    size_t TextureLoader::Update(size_t budgetBytes) {
+        PROFILE_FUNCTION();
+        const auto start = std::chrono::steady_clock::now();
+
+        // Forget finished decode tasks; their futures are already satisfied
+        m_InFlight.erase(std::remove_if(m_InFlight.begin(), m_InFlight.end(),
+                                        [](const std::shared_ptr<TextureLoadRequest>& request) {
+                                            return request->state.load(
+                                                       std::memory_order_acquire) !=
+                                                   TextureLoadState::Decoding;
+                                        }),
+                         m_InFlight.end());
+
+        size_t uploadedBytes = 0;
+        while (uploadedBytes == 0 || uploadedBytes < budgetBytes) {
+            std::shared_ptr<TextureLoadRequest> request;
+            {
+                std::lock_guard<std::mutex> lock(m_DecodedMutex);
+                if (m_Decoded.empty()) break;
+                request = std::move(m_Decoded.front());
+                m_Decoded.pop_front();
+            }
+
+            if (!request->image.IsValid()) {
+                if (request->error.empty()) {
+                    LOG_ERROR_CONCAT("Failed to decode texture: ", request->path);
+                } else {
+                    LOG_ERROR_CONCAT("Failed to decode texture: ", request->path, " (",
+                                     request->error, ")");
+                }
+                request->state.store(TextureLoadState::Failed, std::memory_order_release);
+                ++m_Failed;
+                continue;
+            }
+
+            request->texture->Upload(request->image);
+            uploadedBytes += request->image.GetByteSize();
+            request->image = TextureImage();
+            request->state.store(TextureLoadState::Ready, std::memory_order_release);
+            ++m_Uploaded;
+            if (request->onReady) {
+                const std::function<void()> onReady = std::move(request->onReady);
+                request->onReady = nullptr;
+                onReady();
+            }
+        }
+
+        m_LastFrameUploadBytes = uploadedBytes;
+        m_LastFrameUploadMs = std::chrono::duration<float, std::milli>(
+                                  std::chrono::steady_clock::now() - start)
+                                  .count();
+        return uploadedBytes;
+    }
+
+    bool TextureLoader::IsIdle() const {
+        std::lock_guard<std::mutex> lock(m_DecodedMutex);
+        return m_Decoded.empty() &&
+               std::none_of(m_InFlight.begin(), m_InFlight.end(), [](const auto& request) {
+                   return request->state.load(std::memory_order_acquire) ==
+                          TextureLoadState::Decoding;
+               });
+    }
+
+    void TextureLoader::Shutdown() {
+        for (auto& request : m_InFlight) {
+            if (request->decodeTask.valid()) request->decodeTask.wait();
+        }
+        m_InFlight.clear();
+        std::lock_guard<std::mutex> lock(m_DecodedMutex);
+        m_Decoded.clear();
+    }
+
+    TextureLoader::Statistics TextureLoader::GetStatistics() const {
+        Statistics stats;
+        for (const auto& request : m_InFlight) {
+            if (request->state.load(std::memory_order_acquire) == TextureLoadState::Decoding) {
+                ++stats.decoding;
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_DecodedMutex);
+            stats.pendingUploads = static_cast<uint32_t>(m_Decoded.size());
+        }
+        stats.uploaded = m_Uploaded;
+        stats.failed = m_Failed;
+        stats.lastFrameUploadBytes = m_LastFrameUploadBytes;
+        stats.lastFrameUploadMs = m_LastFrameUploadMs;
+        return stats;
+    }
+}
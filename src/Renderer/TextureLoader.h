@@ -0,0 +1,161 @@
+#pragma once
+#include <pch.h>
+
+#include "../Core/TaskSystem.h"
+#include "Texture.h"
+
+namespace Engine {
+    /** @brief Progress of an asynchronous texture load */
+    enum class TextureLoadState : uint8_t {
+        Decoding,   ///< Queued or decoding on an I/O thread
+        Uploading,  ///< Decoded, waiting for upload budget on the main thread
+        Ready,      ///< Uploaded; the texture shows the image
+        Failed      ///< The file could not be decoded, or decoding threw; the placeholder stays
+    };
+
+    /** @brief Per-load settings of TextureLoader::Load() */
+    struct TextureLoadOptions {
+        bool generateMips = false;           ///< Build the mip chain on the decode thread
+        uint32_t placeholderColor = ~0u;     ///< RGBA8 (0xAABBGGRR) shown until the upload
+    };
+
+    /** @brief State shared between a load's handles, its decode task and the upload queue */
+    struct TextureLoadRequest {
+        std::string path;
+        TextureLoadOptions options;
+        std::shared_ptr<Texture> texture;
+        std::atomic<TextureLoadState> state{TextureLoadState::Decoding};
+        TextureImage image;                  ///< Written by the decode task, freed after upload
+        std::function<TextureImage()> produce;  ///< Builds the image instead of loading path
+        std::function<void()> onReady;       ///< Runs on the main thread after the upload
+        std::string error;                   ///< Message of an exception thrown while decoding
+        std::future<void> decodeTask;
+    };
+
+    /**
+     * @brief Handle to a texture that is loading in the background
+     *
+     * GetTexture() is usable immediately: it is a 1x1 placeholder that the
+     * upload later fills in place, keeping its GL name, so materials and 2D
+     * batches can hold it from the start. Copies share the same load.
+     */
+    class AsyncTexture {
+    public:
+        AsyncTexture() = default;
+        explicit AsyncTexture(std::shared_ptr<TextureLoadRequest> request)
+            : m_Request(std::move(request)) {}
+
+        bool IsValid() const { return m_Request != nullptr; }
+        TextureLoadState GetState() const {
+            return m_Request->state.load(std::memory_order_acquire);
+        }
+        bool IsReady() const { return GetState() == TextureLoadState::Ready; }
+        bool IsFailed() const { return GetState() == TextureLoadState::Failed; }
+        /** @return Whether the load has finished, successfully or not */
+        bool IsDone() const { return IsReady() || IsFailed(); }
+
+        /** @return The texture, a placeholder until IsReady() */
+        const std::shared_ptr<Texture>& GetTexture() const { return m_Request->texture; }
+        const std::string& GetPath() const { return m_Request->path; }
+
+    private:
+        std::shared_ptr<TextureLoadRequest> m_Request;
+    };
+
+    /**
+     * @brief Two-stage texture loading: decode on the I/O threads, upload on the main thread
+     *
+     * Load() creates the placeholder and queues TextureCache::Load() (a mapped
+     * cache entry, or stb_image and optional CPU mips) on the TaskSystem I/O
+     * pool, so file reads and decoding never block the frame; the overload taking
+     * a function runs it there instead, for images assembled from several files.
+     * Decoded images wait in a queue until Update(), called once per frame on
+     * the main thread, uploads them in completion order until the frame's byte
+     * budget is used; at least one image is uploaded per call so images larger
+     * than the budget still progress.
+     *
+     * Without an initialised TaskSystem the decode runs inline and only the
+     * upload is deferred. Load() and Update() are main thread only.
+     */
+    class TextureLoader {
+    public:
+        /** @brief Upload budget per frame unless configured otherwise */
+        static constexpr size_t DEFAULT_UPLOAD_BUDGET = 4u << 20;
+
+        /** @brief Counters of the loads so far */
+        struct Statistics {
+            uint32_t decoding = 0;             ///< Loads not decoded yet
+            uint32_t pendingUploads = 0;       ///< Decoded images waiting for budget
+            uint32_t uploaded = 0;             ///< Images uploaded since startup
+            uint32_t failed = 0;               ///< Loads that could not be decoded
+            size_t lastFrameUploadBytes = 0;   ///< Bytes uploaded by the last Update()
+            float lastFrameUploadMs = 0.0f;    ///< Main-thread time of the last Update()
+        };
+
+        static TextureLoader& Get() {
+            static TextureLoader instance;
+            return instance;
+        }
+
+        /**
+         * @brief Starts loading an image file
+         * @param path Path to the image file
+         * @param options Mip generation and placeholder colour
+         * @return Handle whose texture is a placeholder until the upload
+         * @note Does not cache; AssetManager::LoadTextureAsync() shares loads by path
+         */
+        AsyncTexture Load(const std::string& path,
+                          const TextureLoadOptions& options = TextureLoadOptions());
+
+        /**
+         * @brief Starts building an image in the background, such as an atlas of several files
+         * @param name Name of the image in logs
+         * @param produce Runs on an I/O thread; an invalid image fails the load
+         * @param onReady Runs on the main thread in Update() once the image is uploaded; may be null
+         * @param options Placeholder colour; mips are up to produce
+         * @return Handle whose texture is a placeholder until the upload
+         */
+        AsyncTexture Load(const std::string& name, std::function<TextureImage()> produce,
+                          std::function<void()> onReady,
+                          const TextureLoadOptions& options = TextureLoadOptions());
+
+        /**
+         * @brief Uploads decoded images until the byte budget is used
+         * @param budgetBytes Upload bytes allowed this call; at least one image is uploaded
+         * @return Bytes uploaded
+         */
+        size_t Update(size_t budgetBytes);
+
+        /** @brief Upload budget used by Application each frame */
+        void SetUploadBudget(size_t budgetBytes) { m_UploadBudget = budgetBytes; }
+        size_t GetUploadBudget() const { return m_UploadBudget; }
+
+        /** @return Whether no load is decoding or waiting for upload */
+        bool IsIdle() const;
+
+        /**
+         * @brief Waits for every decode in flight and drops the upload queue
+         * @details Call at shutdown, before the TaskSystem and GL context go away
+         */
+        void Shutdown();
+
+        Statistics GetStatistics() const;
+
+    private:
+        TextureLoader() = default;
+
+        /** @brief Creates the placeholder and queues the decode stage */
+        AsyncTexture Start(std::shared_ptr<TextureLoadRequest> request);
+        /** @brief Decode stage; runs on an I/O thread */
+        void DecodeRequest(const std::shared_ptr<TextureLoadRequest>& request);
+
+        mutable std::mutex m_DecodedMutex;
+        std::deque<std::shared_ptr<TextureLoadRequest>> m_Decoded;      ///< Awaiting upload
+        std::vector<std::shared_ptr<TextureLoadRequest>> m_InFlight;    ///< Decode tasks to join
+        size_t m_UploadBudget = DEFAULT_UPLOAD_BUDGET;
+        uint32_t m_Uploaded = 0;
+        uint32_t m_Failed = 0;
+        size_t m_LastFrameUploadBytes = 0;
+        float m_LastFrameUploadMs = 0.0f;
+    };
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "BoundingBox.h"
 #include "Buffer.h"
 
 namespace Engine {
@@ -52,5 +53,26 @@ namespace Engine {
          * @return Reference to index buffer
          */
         virtual const std::shared_ptr<IndexBuffer>& GetIndexBuffer() const = 0;
+
+        /**
+         * @brief Get the backend object ID
+         * @return Renderer ID of the vertex array
+         */
+        virtual uint32_t GetRendererID() const = 0;
+
+        /**
+         * @brief Set the local-space bounds of the geometry, used for frustum culling
+         * @param bounds Bounds of all vertex positions; see AABB::FromVertices
+         */
+        void SetBounds(const AABB& bounds) { m_Bounds = bounds; }
+
+        /**
+         * @brief Get the local-space bounds
+         * @return Bounds, invalid if never set; such arrays are never culled
+         */
+        const AABB& GetBounds() const { return m_Bounds; }
+
+    private:
+        AABB m_Bounds;
     };
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include <pch.h>
 
+#include "Core/TaskSystem.h"
 #include "TerrainSystem/TerrainSystem.h"
 
 namespace Engine {
@@ -55,39 +56,33 @@ namespace Engine {
  * @note Logs a trace message with the scene name upon creation
  */
 
-Scene::Scene(const std::string &name) : m_Name(name) {
-    m_RootObject = std::make_shared<SceneObject>("Root");
+Scene::Scene(const std::string &name)
+    : m_Name(name), m_Registry(std::make_shared<SceneRegistry>()) {
+    m_RootObject = std::make_shared<SceneObject>(m_Registry, "Root");
     LOG_TRACE_CONCAT("Created scene: ", m_Name);  // Fix: Use _CONCAT for string concatenation
 }
 
 /**
  * @brief Creates a new scene object and adds it to the scene.
  *
- * This method instantiates a new SceneObject with the specified name, adds it to
- * the scene's managed objects list, and optionally sets it as the root object if
- * no root has been established.
+ * This method instantiates a new SceneObject with the specified name in the
+ * scene's registry, parents it to the root object and adds it to the scene's
+ * managed objects list. AddChild() can move it elsewhere in the hierarchy.
  *
  * @param name The name to assign to the newly created scene object.
  * @return std::shared_ptr<SceneObject> A shared pointer to the newly created scene object.
  *
- * @note If no root object exists when this method is called, the created object
- * becomes the scene's root object.
- *
  * @see SceneObject
  * @see m_Objects
  * @see m_RootObject
  */
 std::shared_ptr<SceneObject> Scene::CreateObject(const std::string &name) {
     // Create a new scene object with the given name
-    auto object = std::make_shared<SceneObject>(name);
+    auto object = std::make_shared<SceneObject>(m_Registry, name);
 
-    // Add to managed objects container
+    // Add to managed objects container first: the hierarchy does not own it
     m_Objects.push_back(object);
-
-    // If there's no root object, set this as the root
-    if (!m_RootObject) {
-        m_RootObject = object;
-    }
+    m_RootObject->AddChild(object);
 
     LOG_TRACE("Created scene object: ", name);
     return object;
@@ -154,10 +149,11 @@ void Scene::OnDeactivate() {
 }
 
 /**
- * @brief Updates the terrain system with the given delta time.
+ * @brief Updates the terrain system and the objects' world matrices.
  *
- * This method checks if a terrain system is present and calls its update method.
- * If no terrain system is initialized, no action is taken.
+ * This method checks if a terrain system is present and calls its update method,
+ * then recomputes the world matrices of objects that moved, or whose ancestors
+ * moved, since the last update; OnRender() submits those matrices.
  *
  * @param deltaTime The time elapsed since the last update, used for time-dependent terrain modifications.
  */
@@ -165,6 +161,7 @@ void Scene::OnUpdate(float deltaTime) {
     if (m_TerrainSystem) {
         m_TerrainSystem->Update(deltaTime);
     }
+    m_Registry->UpdateWorldMatrices();
 }
 
 /**
@@ -173,58 +170,39 @@ void Scene::OnUpdate(float deltaTime) {
  * This method manages the rendering process for the scene. It first ensures the renderer
  * is initialized by storing its reference and calling OnCreate if not already done.
  * Then it renders the terrain system (if present) followed by rendering the root scene object
- * and its entire hierarchy.
+ * in one linear pass over the registry's component arrays.
  *
  * @param renderer Reference to the rendering system used to draw scene elements.
  *
  * @note If no renderer was previously set, this method will trigger scene initialization.
  * @note Terrain is rendered before scene objects to establish background rendering.
+ * @note Objects are submitted with the world matrices of the last OnUpdate().
  */
 void Scene::OnRender(Renderer &renderer) {
     // Store renderer reference and initialize if needed
-    if (!m_Renderer) {
-        m_Renderer = &renderer;
-        OnCreate();
-    }
+    EnsureCreated(renderer);
 
     // Render terrain first
     if (m_TerrainSystem) {
         m_TerrainSystem->Render(renderer);
     }
 
-    // Then render scene objects
-    if (m_RootObject) {
-        RenderObject(m_RootObject, renderer);
-    }
+    // Then record every drawable object; ranges of the dense arrays are split
+    // across the workers, each of which submits into its own command bucket
+    const auto &meshes = m_Registry->GetMeshes();
+    const auto &materials = m_Registry->GetMaterials();
+    const auto &worldMatrices = m_Registry->GetWorldMatrices();
+    TaskSystem::Get().ParallelFor(0, meshes.size(), RENDER_GRAIN_SIZE, [&](size_t i) {
+        if (meshes[i] && materials[i]) {
+            renderer.Submit(meshes[i], materials[i], worldMatrices[i]);
+        }
+    });
 }
 
-/**
- * @brief Recursively renders a scene object and its children.
- *
- * This method traverses the scene graph, rendering each object with a valid vertex array and material.
- * It prepares a render command with the object's world transformation matrix and submits it to the renderer.
- * The method then recursively renders all child objects of the current object.
- *
- * @param object A shared pointer to the SceneObject to be rendered.
- * @param renderer The Renderer instance used to submit rendering commands.
- *
- * @note If the object is null or lacks a vertex array or material, it will be skipped.
- * @note The rendering is performed using the object's world transformation matrix.
- */
-void Scene::RenderObject(const std::shared_ptr<SceneObject> &object, Renderer &renderer) {
-    if (object->GetMesh() && object->GetMaterial()) {
-        RenderCommand cmd;
-        cmd.vertexArray = object->GetMesh();
-        cmd.material = object->GetMaterial();
-        cmd.transformMatrix = object->GetWorldTransform();
-        cmd.primitiveType = GL_TRIANGLES;
-        renderer.Submit(cmd.vertexArray, cmd.material, cmd.transformMatrix);
-    }
-
-    for (const auto &child : object->children) {
-        if (child) {
-            RenderObject(child, renderer);
-        }
+void Scene::EnsureCreated(Renderer &renderer) {
+    if (!m_Renderer) {
+        m_Renderer = &renderer;
+        OnCreate();
     }
 }
 
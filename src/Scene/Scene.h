@@ -39,12 +39,28 @@ class Scene {
     virtual void OnRender(Renderer &renderer);  // Declaration only
 
     /**
-     * @brief Creates a new object in the scene
+     * @brief Runs deferred OnCreate() with the renderer if it has not run yet
+     * @details Creates GPU resources, so call it on the main thread before
+     *          OnRender() is recorded on a worker
+     */
+    void EnsureCreated(Renderer &renderer);
+
+    /**
+     * @brief Creates a new object in the scene, as a child of the root
      * @param name Object identifier
      * @return Pointer to created object
      */
     std::shared_ptr<SceneObject> CreateObject(const std::string &name = "Object");
 
+    /** @brief Reserves component storage for a further `count` objects */
+    void ReserveObjects(size_t count) { m_Registry->Reserve(m_Registry->GetSize() + count); }
+
+    /** @return Root of the object hierarchy */
+    const std::shared_ptr<SceneObject> &GetRootObject() const { return m_RootObject; }
+
+    /** @return Component storage of the scene's objects */
+    const SceneRegistry &GetRegistry() const { return *m_Registry; }
+
     /** @return Scene name */
     const std::string &GetName() const { return m_Name; }
 
@@ -85,22 +101,24 @@ class Scene {
         return nullptr;
     }
 
+    /**
+     * @brief Adds an object created outside the scene, as a child of the root
+     * @details The object moves into the scene's registry; one that already has
+     *          a parent or children elsewhere is rejected
+     */
     void AddObject(const std::shared_ptr<SceneObject> &object) {
-        if (object) {
-            m_Objects.push_back(object);
-        }
+        if (!object) return;
+        m_Objects.push_back(object);
+        if (!m_RootObject->AddChild(object)) m_Objects.pop_back();
     }
 
    protected:
-    /**
-     * @brief Renders an object and its children
-     * @param object Object to render
-     * @param renderer Renderer to use
-     */
-    void RenderObject(const std::shared_ptr<SceneObject> &object, Renderer &renderer);
+    /** @brief Objects per task of the parallel render pass */
+    static constexpr size_t RENDER_GRAIN_SIZE = 1024;
 
    private:
     std::string m_Name;                                   ///< Scene identifier
+    std::shared_ptr<SceneRegistry> m_Registry;            ///< Components of all scene objects
     std::shared_ptr<SceneObject> m_RootObject;            ///< Root of scene hierarchy
     std::unique_ptr<TerrainSystem> m_TerrainSystem;       ///< Terrain management system
     std::vector<std::shared_ptr<SceneObject>> m_Objects;  // Container for all scene objects
@@ -61,6 +61,14 @@ class SceneManager {
         }
     }
 
+    /** @brief Prepares the active scene for rendering; call on the main thread */
+    void PrepareRender(Renderer& renderer) {
+        std::lock_guard<std::mutex> lock(sceneMutex);
+        if (activeScene) {
+            activeScene->EnsureCreated(renderer);
+        }
+    }
+
     void Render(Renderer& renderer) {
         std::lock_guard<std::mutex> lock(sceneMutex);
         if (activeScene) {
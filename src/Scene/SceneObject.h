@@ -5,45 +5,116 @@
 #include "../Renderer/Material.h"
 #include "../Renderer/RenderableObject.h"
 #include "../Renderer/VertexArray.h"
+#include "SceneRegistry.h"
 
 namespace Engine {
 
+/**
+ * @brief Named handle to an entity of a SceneRegistry
+ *
+ * The object's components live in its registry's dense arrays; the accessors
+ * look them up through the entity handle. References returned by
+ * GetTransform() are only valid until an object of the same registry is
+ * created or destroyed. Objects made by Scene::CreateObject() share the
+ * scene's registry; a standalone object gets its own and moves into a
+ * scene's registry when added to it.
+ */
 class SceneObject : public RenderableObject {
    public:
-    SceneObject(const std::string& objectName = "Object") : name(objectName) {}
-    virtual ~SceneObject() = default;
+    SceneObject(const std::string& objectName = "Object")
+        : SceneObject(std::make_shared<SceneRegistry>(), objectName) {}
+    SceneObject(std::shared_ptr<SceneRegistry> registry, const std::string& objectName)
+        : name(objectName), m_Registry(std::move(registry)) {
+        m_Entity = m_Registry->Create(this);
+    }
+    virtual ~SceneObject() { m_Registry->Destroy(m_Entity); }
 
-    void OnRender(Renderer& renderer) override {
-        if (m_Mesh && m_Material) {
-            renderer.Submit(m_Mesh, m_Material, m_Transform.GetModelMatrix());
-        }
-        // Render children
-        for (const auto& child : children) {
-            if (child) child->OnRender(renderer);
+    SceneObject(const SceneObject&) = delete;
+    SceneObject& operator=(const SceneObject&) = delete;
+
+    /** @brief Submits this object and its subtree with their current world matrices */
+    void OnRender(Renderer& renderer) override { RenderSubtree(renderer, GetWorldTransform()); }
+
+    /**
+     * @brief Moves an object under this one, after its existing children
+     * @details A child from another registry moves into this one if it has no
+     *          hierarchy of its own. The hierarchy only links handles and does not
+     *          own the child: it must be kept alive by its Scene (CreateObject() or
+     *          AddObject()) or by the caller, and destroying it detaches its subtree.
+     * @return false if the child could not be attached
+     */
+    bool AddChild(const std::shared_ptr<SceneObject>& child) {
+        ASSERT((!child || child.use_count() > 1) &&
+               "Child is not owned by a Scene or the caller and would be destroyed");
+        if (!child || (child->m_Registry != m_Registry && !child->MoveToRegistry(m_Registry))) {
+            LOG_ERROR("Cannot add a child that belongs to another scene's hierarchy");
+            return false;
         }
+        return m_Registry->SetParent(child->m_Entity, m_Entity);
     }
 
-    void AddChild(const std::shared_ptr<SceneObject>& child) { children.push_back(child); }
+    /** @brief Calls fn(SceneObject&) for each direct child, in the order they were added */
+    template<typename F>
+    void ForEachChild(F&& fn) const {
+        m_Registry->ForEachChild(m_Entity, [&fn, this](Entity child) {
+            if (SceneObject* object = m_Registry->GetObject(child)) fn(*object);
+        });
+    }
+    size_t GetChildCount() const { return m_Registry->GetHierarchy(m_Entity).childCount; }
+
+    /** @return Local matrix composed with those of all ancestors */
+    glm::mat4 GetWorldTransform() const { return m_Registry->ComputeWorldMatrix(m_Entity); }
 
-    // Fix: Return by value instead of reference
-    glm::mat4 GetWorldTransform() const { return m_Transform.GetModelMatrix(); }
+    void SetMesh(const std::shared_ptr<VertexArray>& mesh) { m_Registry->SetMesh(m_Entity, mesh); }
+    void SetMaterial(const std::shared_ptr<Material>& material) {
+        m_Registry->SetMaterial(m_Entity, material);
+    }
 
-    void SetMesh(const std::shared_ptr<VertexArray>& mesh) { m_Mesh = mesh; }
-    void SetMaterial(const std::shared_ptr<Material>& material) { m_Material = material; }
+    const std::shared_ptr<VertexArray>& GetMesh() const { return m_Registry->GetMesh(m_Entity); }
+    const std::shared_ptr<Material>& GetMaterial() const {
+        return m_Registry->GetMaterial(m_Entity);
+    }
 
-    const std::shared_ptr<VertexArray>& GetMesh() const { return m_Mesh; }
-    const std::shared_ptr<Material>& GetMaterial() const { return m_Material; }
+    Transform& GetTransform() { return m_Registry->GetTransform(m_Entity); }
+    const Transform& GetTransform() const { return m_Registry->GetTransform(m_Entity); }
 
-    Transform& GetTransform() { return m_Transform; }
-    const Transform& GetTransform() const { return m_Transform; }
+    Entity GetEntity() const { return m_Entity; }
+    const std::shared_ptr<SceneRegistry>& GetRegistry() const { return m_Registry; }
 
     std::string name;
-    std::vector<std::shared_ptr<SceneObject>> children;
 
-   protected:
-    Transform m_Transform;
-    std::shared_ptr<VertexArray> m_Mesh;
-    std::shared_ptr<Material> m_Material;
+   private:
+    friend class Scene;
+
+    void RenderSubtree(Renderer& renderer, const glm::mat4& world) const {
+        if (GetMesh() && GetMaterial()) {
+            renderer.Submit(GetMesh(), GetMaterial(), world);
+        }
+        ForEachChild([&renderer, &world](const SceneObject& child) {
+            child.RenderSubtree(renderer, world * child.GetTransform().GetModelMatrix());
+        });
+    }
+
+    /**
+     * @brief Recreates this object's entity, with its components, in another registry
+     * @return false if the object has a parent or children, which cannot move with it
+     */
+    bool MoveToRegistry(const std::shared_ptr<SceneRegistry>& registry) {
+        const HierarchyComponent& links = m_Registry->GetHierarchy(m_Entity);
+        if (links.parent.IsValid() || links.childCount > 0) return false;
+
+        const Entity entity = registry->Create(this);
+        registry->GetTransform(entity) = GetTransform();
+        registry->SetMesh(entity, GetMesh());
+        registry->SetMaterial(entity, GetMaterial());
+        m_Registry->Destroy(m_Entity);
+        m_Registry = registry;
+        m_Entity = entity;
+        return true;
+    }
+
+    std::shared_ptr<SceneRegistry> m_Registry;
+    Entity m_Entity;
 };
 
-}  // namespace Engine
\ No newline at end of file
+}  // namespace Engine
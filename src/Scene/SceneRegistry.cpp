@@ -0,0 +1,245 @@
+/**
+ * @file SceneRegistry.cpp
+ * @brief Dense component storage and hierarchy links of scene entities
+ */
+#include "SceneRegistry.h"
+
+#include "../Core/TaskSystem.h"
+#include "../Core/TransformBatch.h"
+#include "../Renderer/DeferredRelease.h"
+
+namespace Engine {
+    SceneRegistry::~SceneRegistry() {
+        for (auto& mesh : m_Meshes) DeferredRelease::Get().Retire(std::move(mesh));
+        for (auto& material : m_Materials) DeferredRelease::Get().Retire(std::move(material));
+    }
+
+    Entity SceneRegistry::Create(SceneObject* object) {
+        uint32_t index;
+        if (!m_FreeSlots.empty()) {
+            index = m_FreeSlots.back();
+            m_FreeSlots.pop_back();
+        } else {
+            index = static_cast<uint32_t>(m_Slots.size());
+            m_Slots.emplace_back();
+        }
+
+        Slot& slot = m_Slots[index];
+        slot.dense = static_cast<uint32_t>(m_Entities.size());
+        const Entity entity{index, slot.generation};
+
+        m_Entities.push_back(entity);
+        m_Objects.push_back(object);
+        m_Transforms.emplace_back();
+        m_WorldMatrices.emplace_back(1.0f);
+        m_Meshes.emplace_back();
+        m_Materials.emplace_back();
+        m_Hierarchy.emplace_back();
+        m_WorldDirty.push_back(1);
+        return entity;
+    }
+
+    void SceneRegistry::Destroy(Entity entity) {
+        if (!IsAlive(entity)) return;
+
+        Unlink(entity);
+        for (Entity child = GetHierarchy(entity).firstChild; child.IsValid();) {
+            HierarchyComponent& links = Hierarchy(child);
+            const Entity next = links.nextSibling;
+            links.parent = links.previousSibling = links.nextSibling = Entity();
+            m_WorldDirty[GetDenseIndex(child)] = 1;
+            child = next;
+        }
+
+        // Recorded command lists may still point at these
+        const uint32_t dense = GetDenseIndex(entity);
+        DeferredRelease::Get().Retire(std::move(m_Meshes[dense]));
+        DeferredRelease::Get().Retire(std::move(m_Materials[dense]));
+
+        // Move the last entity into the hole
+        const uint32_t last = static_cast<uint32_t>(m_Entities.size() - 1);
+        if (dense != last) {
+            m_Entities[dense] = m_Entities[last];
+            m_Objects[dense] = m_Objects[last];
+            m_Transforms[dense] = m_Transforms[last];
+            m_WorldMatrices[dense] = m_WorldMatrices[last];
+            m_Meshes[dense] = std::move(m_Meshes[last]);
+            m_Materials[dense] = std::move(m_Materials[last]);
+            m_Hierarchy[dense] = m_Hierarchy[last];
+            m_WorldDirty[dense] = m_WorldDirty[last];
+            m_Slots[m_Entities[dense].index].dense = dense;
+        }
+        m_Entities.pop_back();
+        m_Objects.pop_back();
+        m_Transforms.pop_back();
+        m_WorldMatrices.pop_back();
+        m_Meshes.pop_back();
+        m_Materials.pop_back();
+        m_Hierarchy.pop_back();
+        m_WorldDirty.pop_back();
+
+        Slot& slot = m_Slots[entity.index];
+        slot.dense = Entity::INVALID_INDEX;
+        ++slot.generation;
+        m_FreeSlots.push_back(entity.index);
+    }
+
+    void SceneRegistry::Reserve(size_t count) {
+        m_Slots.reserve(count);
+        m_Entities.reserve(count);
+        m_Objects.reserve(count);
+        m_Transforms.reserve(count);
+        m_WorldMatrices.reserve(count);
+        m_Meshes.reserve(count);
+        m_Materials.reserve(count);
+        m_Hierarchy.reserve(count);
+        m_WorldDirty.reserve(count);
+    }
+
+    void SceneRegistry::SetMesh(Entity entity, const std::shared_ptr<VertexArray>& mesh) {
+        std::shared_ptr<VertexArray>& current = m_Meshes[GetDenseIndex(entity)];
+        if (mesh != current) DeferredRelease::Get().Retire(std::exchange(current, mesh));
+    }
+
+    void SceneRegistry::SetMaterial(Entity entity, const std::shared_ptr<Material>& material) {
+        std::shared_ptr<Material>& current = m_Materials[GetDenseIndex(entity)];
+        if (material != current) DeferredRelease::Get().Retire(std::exchange(current, material));
+    }
+
+    bool SceneRegistry::SetParent(Entity child, Entity parent) {
+        ASSERT(IsAlive(child) && (!parent.IsValid() || IsAlive(parent)) &&
+               "Stale or invalid entity");
+        for (Entity ancestor = parent; ancestor.IsValid();
+             ancestor = GetHierarchy(ancestor).parent) {
+            if (ancestor == child) return false;
+        }
+
+        Unlink(child);
+        m_WorldDirty[GetDenseIndex(child)] = 1;
+        if (!parent.IsValid()) return true;
+
+        HierarchyComponent& parentLinks = Hierarchy(parent);
+        HierarchyComponent& links = Hierarchy(child);
+        links.parent = parent;
+        links.previousSibling = parentLinks.lastChild;
+        if (parentLinks.lastChild.IsValid()) {
+            Hierarchy(parentLinks.lastChild).nextSibling = child;
+        } else {
+            parentLinks.firstChild = child;
+        }
+        parentLinks.lastChild = child;
+        ++parentLinks.childCount;
+        return true;
+    }
+
+    void SceneRegistry::Unlink(Entity child) {
+        HierarchyComponent& links = Hierarchy(child);
+        if (!links.parent.IsValid()) return;
+
+        HierarchyComponent& parentLinks = Hierarchy(links.parent);
+        if (links.previousSibling.IsValid()) {
+            Hierarchy(links.previousSibling).nextSibling = links.nextSibling;
+        } else {
+            parentLinks.firstChild = links.nextSibling;
+        }
+        if (links.nextSibling.IsValid()) {
+            Hierarchy(links.nextSibling).previousSibling = links.previousSibling;
+        } else {
+            parentLinks.lastChild = links.previousSibling;
+        }
+        --parentLinks.childCount;
+        links.parent = links.previousSibling = links.nextSibling = Entity();
+    }
+
+    glm::mat4 SceneRegistry::ComputeWorldMatrix(Entity entity) const {
+        glm::mat4 world = GetTransform(entity).GetModelMatrix();
+        for (Entity parent = GetHierarchy(entity).parent; parent.IsValid();
+             parent = GetHierarchy(parent).parent) {
+            world = GetTransform(parent).GetModelMatrix() * world;
+        }
+        return world;
+    }
+
+    size_t SceneRegistry::UpdateWorldMatrices() {
+        PROFILE_FUNCTION();
+        TaskSystem& tasks = TaskSystem::Get();
+        const size_t count = m_Entities.size();
+        const size_t batches = (count + PASS_GRAIN_SIZE - 1) / PASS_GRAIN_SIZE;
+        if (m_BatchLists.size() < batches) m_BatchLists.resize(batches);
+
+        // Flag the entities whose own transform changed
+        tasks.ParallelFor(0, count, PASS_GRAIN_SIZE, [this](size_t i) {
+            if (m_Transforms[i].IsDirty()) m_WorldDirty[i] = 1;
+        });
+
+        // Start from the topmost flagged entities; flagged descendants are reached
+        // through them, so every entity is recomputed at most once
+        tasks.ParallelFor(0, batches, 1, [this, count](size_t batch) {
+            std::vector<uint32_t>& roots = m_BatchLists[batch];
+            roots.clear();
+            const size_t end = std::min(count, (batch + 1) * PASS_GRAIN_SIZE);
+            for (size_t i = batch * PASS_GRAIN_SIZE; i < end; ++i) {
+                if (!m_WorldDirty[i]) continue;
+                Entity ancestor = m_Hierarchy[i].parent;
+                while (ancestor.IsValid() && !m_WorldDirty[GetDenseIndex(ancestor)]) {
+                    ancestor = GetHierarchy(ancestor).parent;
+                }
+                if (!ancestor.IsValid()) roots.push_back(static_cast<uint32_t>(i));
+            }
+        });
+        GatherBatches(batches, m_Level);
+
+        // One depth at a time: parents of the level are final, so its batches
+        // are independent. Each batch collects its children as the next level
+        size_t updated = 0;
+        while (!m_Level.empty()) {
+            updated += m_Level.size();
+            const size_t levelBatches = (m_Level.size() + PASS_GRAIN_SIZE - 1) / PASS_GRAIN_SIZE;
+            if (m_BatchLists.size() < levelBatches) m_BatchLists.resize(levelBatches);
+
+            tasks.ParallelFor(0, levelBatches, 1, [this](size_t batch) {
+                std::vector<uint32_t>& children = m_BatchLists[batch];
+                children.clear();
+                const size_t end = std::min(m_Level.size(), (batch + 1) * PASS_GRAIN_SIZE);
+
+                // Local matrices come from the SIMD kernel, a chunk of gathered
+                // transforms at a time
+                TransformBatch::Chunk chunk;
+                glm::mat4 locals[TransformBatch::Chunk::SIZE];
+                for (size_t first = batch * PASS_GRAIN_SIZE; first < end;
+                     first += TransformBatch::Chunk::SIZE) {
+                    const size_t count = std::min(TransformBatch::Chunk::SIZE, end - first);
+                    for (size_t k = 0; k < count; ++k) {
+                        chunk.Set(k, m_Transforms[m_Level[first + k]].GetData());
+                    }
+                    TransformBatch::ComputeModelMatrices(chunk.GetInput(), count, locals);
+
+                    for (size_t k = 0; k < count; ++k) {
+                        const uint32_t i = m_Level[first + k];
+                        const HierarchyComponent& links = m_Hierarchy[i];
+                        m_WorldMatrices[i] =
+                            links.parent.IsValid()
+                                ? m_WorldMatrices[GetDenseIndex(links.parent)] * locals[k]
+                                : locals[k];
+                        m_Transforms[i].ClearDirty();
+                        m_WorldDirty[i] = 0;
+
+                        for (Entity child = links.firstChild; child.IsValid();
+                             child = GetHierarchy(child).nextSibling) {
+                            children.push_back(GetDenseIndex(child));
+                        }
+                    }
+                }
+            });
+            GatherBatches(levelBatches, m_Level);
+        }
+        return updated;
+    }
+
+    void SceneRegistry::GatherBatches(size_t count, std::vector<uint32_t>& target) {
+        target.clear();
+        for (size_t batch = 0; batch < count; ++batch) {
+            target.insert(target.end(), m_BatchLists[batch].begin(), m_BatchLists[batch].end());
+        }
+    }
+}
@@ -0,0 +1,184 @@
+#pragma once
+#include <pch.h>
+
+#include "../Core/Transform.h"
+#include "../Renderer/Material.h"
+#include "../Renderer/VertexArray.h"
+
+namespace Engine {
+    class SceneObject;
+
+    /**
+     * @brief Generational handle of an entity in a SceneRegistry
+     * @details A destroyed entity's slot is reused with the next generation, so a
+     *          stale handle is detected instead of aliasing the new entity.
+     */
+    struct Entity {
+        static constexpr uint32_t INVALID_INDEX = ~0u;
+
+        uint32_t index = INVALID_INDEX;   ///< Slot in the registry
+        uint32_t generation = 0;
+
+        bool IsValid() const { return index != INVALID_INDEX; }
+        bool operator==(const Entity& other) const {
+            return index == other.index && generation == other.generation;
+        }
+        bool operator!=(const Entity& other) const { return !(*this == other); }
+    };
+
+    /** @brief Parent and sibling links of an entity; siblings form a doubly linked list */
+    struct HierarchyComponent {
+        Entity parent;
+        Entity firstChild;
+        Entity lastChild;
+        Entity previousSibling;
+        Entity nextSibling;
+        uint32_t childCount = 0;
+    };
+
+    /**
+     * @brief Entity storage of a Scene: one dense array per component
+     *
+     * Every live entity has a transform, world matrix, mesh, material and
+     * hierarchy link, stored at the same position of parallel vectors, so
+     * update and render passes are linear scans over contiguous memory rather
+     * than walks over a pointer tree. Handles are mapped to that position
+     * through a slot table; destroying an entity moves the last one into its
+     * place, so positions are only stable until the next Create() or Destroy().
+     *
+     * World matrices are cached. UpdateWorldMatrices() recomputes them only
+     * for subtrees whose root moved, was created or was reparented since the
+     * last update, visiting those subtrees breadth first so each level is one
+     * parallel batch whose parents are already final. Local matrices are built
+     * by the TransformBatch SIMD kernel.
+     *
+     * Create(), Destroy() and SetParent() must not run during a pass. Passes may
+     * read the columns from any thread.
+     */
+    class SceneRegistry {
+    public:
+        SceneRegistry() = default;
+        ~SceneRegistry();
+
+        SceneRegistry(const SceneRegistry&) = delete;
+        SceneRegistry& operator=(const SceneRegistry&) = delete;
+
+        /**
+         * @brief Creates an entity with default components and no parent
+         * @param object Scene object fronting the entity, returned by GetObject()
+         */
+        Entity Create(SceneObject* object = nullptr);
+
+        /**
+         * @brief Destroys an entity; its children become roots
+         * @details The mesh and material are retired through DeferredRelease, since
+         *          recorded command lists may still point at them
+         */
+        void Destroy(Entity entity);
+
+        bool IsAlive(Entity entity) const {
+            if (entity.index >= m_Slots.size()) return false;
+            const Slot& slot = m_Slots[entity.index];
+            return slot.generation == entity.generation && slot.dense != Entity::INVALID_INDEX;
+        }
+
+        /** @return Number of live entities, the length of every column */
+        size_t GetSize() const { return m_Entities.size(); }
+        void Reserve(size_t count);
+
+        /** @return Position of a live entity in the columns */
+        uint32_t GetDenseIndex(Entity entity) const {
+            ASSERT(IsAlive(entity) && "Stale or invalid entity");
+            return m_Slots[entity.index].dense;
+        }
+
+        Transform& GetTransform(Entity entity) { return m_Transforms[GetDenseIndex(entity)]; }
+        const Transform& GetTransform(Entity entity) const {
+            return m_Transforms[GetDenseIndex(entity)];
+        }
+        /** @return World matrix as of the last UpdateWorldMatrices() */
+        const glm::mat4& GetWorldMatrix(Entity entity) const {
+            return m_WorldMatrices[GetDenseIndex(entity)];
+        }
+        /** @return Current world matrix, composed from the local matrices up to the root */
+        glm::mat4 ComputeWorldMatrix(Entity entity) const;
+        const std::shared_ptr<VertexArray>& GetMesh(Entity entity) const {
+            return m_Meshes[GetDenseIndex(entity)];
+        }
+        const std::shared_ptr<Material>& GetMaterial(Entity entity) const {
+            return m_Materials[GetDenseIndex(entity)];
+        }
+        void SetMesh(Entity entity, const std::shared_ptr<VertexArray>& mesh);
+        void SetMaterial(Entity entity, const std::shared_ptr<Material>& material);
+
+        SceneObject* GetObject(Entity entity) const { return m_Objects[GetDenseIndex(entity)]; }
+        const HierarchyComponent& GetHierarchy(Entity entity) const {
+            return m_Hierarchy[GetDenseIndex(entity)];
+        }
+
+        /**
+         * @brief Moves an entity under a new parent, appended after its siblings
+         * @param child Entity to move
+         * @param parent New parent, or an invalid entity to make the child a root
+         * @return false if the parent is the child or one of its descendants
+         */
+        bool SetParent(Entity child, Entity parent);
+
+        /** @brief Calls fn(Entity) for each direct child, in the order they were added */
+        template<typename F>
+        void ForEachChild(Entity parent, F&& fn) const {
+            for (Entity child = GetHierarchy(parent).firstChild; child.IsValid();
+                 child = GetHierarchy(child).nextSibling) {
+                fn(child);
+            }
+        }
+
+        /**
+         * @brief Recomputes the world matrices of changed subtrees
+         * @return Number of world matrices recomputed
+         */
+        size_t UpdateWorldMatrices();
+
+        // Columns, index-aligned with GetEntities()
+        const std::vector<Entity>& GetEntities() const { return m_Entities; }
+        const std::vector<Transform>& GetTransforms() const { return m_Transforms; }
+        const std::vector<glm::mat4>& GetWorldMatrices() const { return m_WorldMatrices; }
+        const std::vector<std::shared_ptr<VertexArray>>& GetMeshes() const { return m_Meshes; }
+        const std::vector<std::shared_ptr<Material>>& GetMaterials() const {
+            return m_Materials;
+        }
+
+    private:
+        /** @brief Entities per task of the parallel passes */
+        static constexpr size_t PASS_GRAIN_SIZE = 1024;
+
+        struct Slot {
+            uint32_t dense = Entity::INVALID_INDEX;   ///< Column position, invalid when free
+            uint32_t generation = 0;
+        };
+
+        HierarchyComponent& Hierarchy(Entity entity) {
+            return m_Hierarchy[GetDenseIndex(entity)];
+        }
+        /** @brief Removes an entity from its parent's child list */
+        void Unlink(Entity child);
+        /** @brief Concatenates the first `count` batch lists into `target` */
+        void GatherBatches(size_t count, std::vector<uint32_t>& target);
+
+        std::vector<Slot> m_Slots;
+        std::vector<uint32_t> m_FreeSlots;
+
+        std::vector<Entity> m_Entities;
+        std::vector<SceneObject*> m_Objects;
+        std::vector<Transform> m_Transforms;
+        std::vector<glm::mat4> m_WorldMatrices;
+        std::vector<std::shared_ptr<VertexArray>> m_Meshes;
+        std::vector<std::shared_ptr<Material>> m_Materials;
+        std::vector<HierarchyComponent> m_Hierarchy;
+        std::vector<uint8_t> m_WorldDirty;   ///< Set when the world matrix must be rebuilt
+
+        // Scratch of UpdateWorldMatrices(), reused across frames
+        std::vector<uint32_t> m_Level;       ///< Column positions of the current depth
+        std::vector<std::vector<uint32_t>> m_BatchLists;
+    };
+}
@@ -512,6 +512,42 @@ void LuaScriptSystem::RegisterEngineAPI() {
         return cube;
     });
 
+    // Grid of cubes sharing one mesh and one material, drawn as instanced runs
+    engine.set_function(
+        "createCubeField",
+        [](const std::string& name, int count, float spacing) -> std::shared_ptr<SceneObject> {
+            auto scene = SceneManager::Get().GetActiveScene();
+            if (!scene) {
+                LOG_ERROR("No active scene to create cube field in");
+                return nullptr;
+            }
+            auto shader = ShaderLibrary::CreateBasicShader();
+            if (!shader || count <= 0) return nullptr;
+
+            auto root = scene->GetRootObject();
+            auto field = scene->CreateObject(name);
+            if (root) root->AddChild(field);
+
+            auto mesh = AssetManager::Get().GetOrCreateCubeMesh();
+            auto material = std::make_shared<Material>(shader);
+            material->SetVector4("u_Color", glm::vec4(1.0f));
+
+            const int side = static_cast<int>(std::ceil(std::sqrt(static_cast<float>(count))));
+            const float origin = -0.5f * static_cast<float>(side - 1) * spacing;
+            scene->ReserveObjects(static_cast<size_t>(count));
+            for (int i = 0; i < count; ++i) {
+                auto cube = scene->CreateObject(name + "_" + std::to_string(i));
+                cube->SetMesh(mesh);
+                cube->SetMaterial(material);
+                cube->GetTransform().SetPosition(origin + static_cast<float>(i % side) * spacing,
+                                                 0.0f,
+                                                 origin + static_cast<float>(i / side) * spacing);
+                field->AddChild(cube);
+            }
+            LOG_INFO_CONCAT("Created cube field ", name, " with ", count, " cubes");
+            return field;
+        });
+
     // Fix getObject function
     engine.set_function("getObject", [](const std::string& name) -> std::shared_ptr<SceneObject> {
         auto scene = SceneManager::Get().GetActiveScene();
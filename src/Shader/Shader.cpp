@@ -8,6 +8,7 @@
 #include <pch.h>
 #include "Shader.h"
 #include "../Core/AssetManager.h"
+#include "../Renderer/RenderState.h"
 #include "ShaderHotReload.h"
 #include <glad/glad.h>
 
@@ -34,6 +35,8 @@ namespace Engine {
         if (!success) {
             glGetProgramInfoLog(m_Program, 512, NULL, infoLog);
             std::cout << "Shader program linking failed:\n" << infoLog << std::endl;
+        } else {
+            ReflectUniforms();
         }
 
         glDeleteShader(vertexShader);
@@ -41,15 +44,16 @@ namespace Engine {
     }
 
     Shader::~Shader() {
-        glDeleteProgram(m_Program);
+        // A program already deleted by Unload() must not reach GL again
+        Unload();
     }
 
     void Shader::Bind() const {
-        glUseProgram(m_Program);
+        RenderState::Get().UseProgram(m_Program);
     }
 
     void Shader::Unbind() const {
-        glUseProgram(0);
+        RenderState::Get().UseProgram(0);
     }
 
     bool Shader::CompileShader(const char* source, uint32_t type, uint32_t& shader) {
@@ -68,33 +72,103 @@ namespace Engine {
         return true;
     }
 
+    /**
+     * @brief Records the location of every active uniform and attribute of the linked program
+     * @details Called once per link so that setters and the renderer never query the
+     *          driver by name. Uniforms inside uniform blocks and built-in attributes
+     *          have no location and are skipped.
+     */
+    void Shader::ReflectUniforms() {
+        m_UniformLocations.clear();
+
+        GLint count = 0, maxLength = 0;
+        glGetProgramiv(m_Program, GL_ACTIVE_UNIFORMS, &count);
+        glGetProgramiv(m_Program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+
+        std::vector<char> buffer(std::max(maxLength, 1));
+        for (GLint i = 0; i < count; ++i) {
+            GLsizei length = 0;
+            GLint size = 0;
+            GLenum type = 0;
+            glGetActiveUniform(m_Program, static_cast<GLuint>(i), maxLength, &length, &size, &type,
+                               buffer.data());
+
+            std::string name(buffer.data(), length);
+            GLint location = glGetUniformLocation(m_Program, name.c_str());
+            if (location < 0) continue;
+
+            // Arrays are reported as "name[0]"; accept the bare name as well
+            if (name.size() > 3 && name.compare(name.size() - 3, 3, "[0]") == 0) {
+                m_UniformLocations[name.substr(0, name.size() - 3)] = location;
+            }
+            m_UniformLocations[std::move(name)] = location;
+        }
+
+        m_AttributeLocations.clear();
+        glGetProgramiv(m_Program, GL_ACTIVE_ATTRIBUTES, &count);
+        glGetProgramiv(m_Program, GL_ACTIVE_ATTRIBUTE_MAX_LENGTH, &maxLength);
+        buffer.assign(std::max(maxLength, 1), '\0');
+        for (GLint i = 0; i < count; ++i) {
+            GLsizei length = 0;
+            GLint size = 0;
+            GLenum type = 0;
+            glGetActiveAttrib(m_Program, static_cast<GLuint>(i), maxLength, &length, &size, &type,
+                              buffer.data());
+
+            std::string name(buffer.data(), length);
+            GLint location = glGetAttribLocation(m_Program, name.c_str());
+            if (location >= 0) m_AttributeLocations[std::move(name)] = location;
+        }
+
+        ++m_Generation;
+        m_UniformOwner = nullptr;
+    }
+
     void Shader::SetMat4(const std::string& name, const glm::mat4& matrix) {
-        GLint location = glGetUniformLocation(m_Program, name.c_str());
-        glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(matrix));
+        SetMat4(GetUniformLocation(name), matrix);
     }
 
     void Shader::SetInt(const std::string& name, int value) {
-        GLint location = glGetUniformLocation(m_Program, name.c_str());
-        glUniform1i(location, value);
+        SetInt(GetUniformLocation(name), value);
     }
 
     void Shader::SetFloat(const std::string& name, float value) {
-        GLint location = glGetUniformLocation(m_Program, name.c_str());
-        glUniform1f(location, value);
+        SetFloat(GetUniformLocation(name), value);
     }
 
     void Shader::SetVector2(const std::string& name, const glm::vec2& value) {
-        GLint location = glGetUniformLocation(m_Program, name.c_str());
-        glUniform2f(location, value.x, value.y);
+        SetVector2(GetUniformLocation(name), value);
     }
 
     void Shader::SetVector3(const std::string& name, const glm::vec3& value) {
-        GLint location = glGetUniformLocation(m_Program, name.c_str());
-        glUniform3f(location, value.x, value.y, value.z);
+        SetVector3(GetUniformLocation(name), value);
     }
 
     void Shader::SetVector4(const std::string& name, const glm::vec4& value) {
-        GLint location = glGetUniformLocation(m_Program, name.c_str());
+        SetVector4(GetUniformLocation(name), value);
+    }
+
+    void Shader::SetMat4(GLint location, const glm::mat4& matrix) {
+        glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(matrix));
+    }
+
+    void Shader::SetInt(GLint location, int value) {
+        glUniform1i(location, value);
+    }
+
+    void Shader::SetFloat(GLint location, float value) {
+        glUniform1f(location, value);
+    }
+
+    void Shader::SetVector2(GLint location, const glm::vec2& value) {
+        glUniform2f(location, value.x, value.y);
+    }
+
+    void Shader::SetVector3(GLint location, const glm::vec3& value) {
+        glUniform3f(location, value.x, value.y, value.z);
+    }
+
+    void Shader::SetVector4(GLint location, const glm::vec4& value) {
         glUniform4f(location, value.x, value.y, value.z, value.w);
     }
 
@@ -139,6 +213,7 @@ namespace Engine {
         glDeleteShader(vertexShader);
         glDeleteShader(fragmentShader);
 
+        ReflectUniforms();
         m_IsLoaded = true;
         return true;
     }
@@ -195,6 +270,7 @@ namespace Engine {
 
         // Delete old program only after successful reload
         if (oldProgram) {
+            RenderState::Get().OnProgramDeleted(oldProgram);
             glDeleteProgram(oldProgram);
         }
 
@@ -3,6 +3,7 @@
 #include <glad/glad.h>  // Add glad include first
 #include <glm/gtc/type_ptr.hpp>
 #include "../Core/Resource.h"
+#include "../Renderer/RenderState.h"
 
 // Forward declare
 namespace Engine {
@@ -32,6 +33,55 @@ namespace Engine {
         void Unbind() const;
         /** @return OpenGL program ID */
         uint32_t GetProgram() const { return m_Program; }
+
+        /**
+         * @brief Looks up a uniform in the table reflected at link time
+         * @param name Uniform name; arrays are also found without their "[0]" suffix
+         * @return Location, or -1 if the program has no such active uniform
+         */
+        GLint GetUniformLocation(const std::string& name) const {
+            auto it = m_UniformLocations.find(name);
+            return it != m_UniformLocations.end() ? it->second : -1;
+        }
+
+        /**
+         * @brief Looks up a vertex attribute location from the table built at link time
+         * @param name Attribute name
+         * @return Location, or -1 if the program has no such active attribute
+         */
+        GLint GetAttributeLocation(const std::string& name) const {
+            auto it = m_AttributeLocations.find(name);
+            return it != m_AttributeLocations.end() ? it->second : -1;
+        }
+
+        /** @return Every active uniform by name, as reflected at link time */
+        const std::unordered_map<std::string, GLint>& GetUniformLocations() const {
+            return m_UniformLocations;
+        }
+
+        /**
+         * @return Number of times the program was (re)linked; cached locations
+         *         resolved against an older generation are stale
+         */
+        uint32_t GetGeneration() const { return m_Generation; }
+
+        /**
+         * @brief Material whose parameters the program's uniforms currently hold
+         * @details Lets a material skip uploading values it already uploaded while
+         *          no other material used the program. Reset by every relink.
+         */
+        const void* GetUniformOwner() const { return m_UniformOwner; }
+        void SetUniformOwner(const void* owner) { m_UniformOwner = owner; }
+
+        /** @name Uniform setters by pre-resolved location; -1 is ignored */
+        ///@{
+        void SetMat4(GLint location, const glm::mat4& matrix);
+        void SetInt(GLint location, int value);
+        void SetFloat(GLint location, float value);
+        void SetVector2(GLint location, const glm::vec2& value);
+        void SetVector3(GLint location, const glm::vec3& value);
+        void SetVector4(GLint location, const glm::vec4& value);
+        ///@}
         
         /**
          * @brief Sets a 4x4 matrix uniform
@@ -109,6 +159,7 @@ namespace Engine {
         // Implement pure virtual method
         virtual void Unload() override {
             if (m_Program) {
+                RenderState::Get().OnProgramDeleted(m_Program);
                 glDeleteProgram(m_Program);
                 m_Program = 0;
             }
@@ -117,6 +168,14 @@ namespace Engine {
 
     private:
         uint32_t m_Program = 0;  ///< OpenGL program ID
+        std::unordered_map<std::string, GLint> m_UniformLocations;  ///< Active uniforms by name
+        std::unordered_map<std::string, GLint> m_AttributeLocations;  ///< Active attributes by name
+        uint32_t m_Generation = 0;                                 ///< Successful links so far
+        const void* m_UniformOwner = nullptr;                      ///< Material that last applied
+
+        /** @brief Rebuilds the uniform and attribute location tables after a successful link */
+        void ReflectUniforms();
+
         /**
          * @brief Compiles a shader
          * @param source Shader source code
@@ -42,7 +42,8 @@ std::shared_ptr<Shader> ShaderLibrary::CreateTextureShader() {
 
 std::shared_ptr<Shader> ShaderLibrary::CreateBatchRenderer2DShader() {
     const std::string name = "batch_renderer_2d";
-    if (Exists(name)) return Get(name);
+    // Renderer2D::Shutdown() unloads it; loading again reuses the cached object
+    if (Exists(name) && Get(name)->IsLoaded()) return Get(name);
 
     auto shader = Load(name, "assets/shaders/batch_renderer_2d.vert",
                        "assets/shaders/batch_renderer_2d.frag");
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <pch.h>
+
 /**
  * @enum BlockType
  * @brief Defines different types of blocks available in the terrain
@@ -14,45 +16,35 @@ enum class BlockType {
 };
 
 /**
- * @struct BlockTexture
- * @brief Holds UV coordinates for different faces of a block
+ * @struct BlockFaceTextures
+ * @brief Names of the images a block's faces use, as added to the terrain atlas
+ * @details Each name is loaded from assets/textures/blocks/<name>.png; adding a
+ *          block type only needs its images and a row in BLOCK_FACE_TEXTURES.
  */
-struct BlockTexture {
-    float topU, topV;           ///< Top face UV coordinates
-    float sideU, sideV;         ///< Side faces UV coordinates
-    float bottomU, bottomV;     ///< Bottom face UV coordinates
-    
-    // Each texture is 16x16 in a 32x48 atlas
-    static constexpr float TEXTURE_SIZE = 0.5f;      ///< 16/32 = 0.5 for horizontal
-    static constexpr float TEXTURE_V_SIZE = 0.333f;  ///< 16/48 ≈ 0.333 for vertical
+struct BlockFaceTextures {
+    const char* top;      ///< Top face image
+    const char* side;     ///< Side faces image
+    const char* bottom;   ///< Bottom face image
+};
+
+constexpr BlockFaceTextures BLOCK_FACE_TEXTURES[] = {
+    { nullptr, nullptr, nullptr },                // Air (unused)
+    { "grass_top", "grass_side", "dirt" },        // Grass
+    { "dirt", "dirt", "dirt" },                   // Dirt
+    { "stone", "stone", "stone" },                // Stone
+    { "snow", "snow", "snow" }                    // Snow
 };
 
-// Texture atlas layout:
-// [snow (0,0)]    [stone (0.5,0)]
-// [dirt (0,0.333)]  [grass_side (0.5,0.333)]
-// [grass_top (0,0.666)]  [empty (0.5,0.666)]
+static_assert(std::size(BLOCK_FACE_TEXTURES) == static_cast<size_t>(BlockType::COUNT),
+              "Every block type needs face textures");
 
-constexpr BlockTexture BLOCK_TEXTURES[] = {
-    // Air (unused)
-    { 0.0f, 0.0f,      0.0f, 0.0f,       0.0f, 0.0f },
-    
-    // Grass
-    { 0.0f, 0.666f,    // top (grass_top)
-      0.5f, 0.333f,    // side (grass_side)
-      0.0f, 0.333f },  // bottom (dirt)
-    
-    // Dirt (all dirt texture)
-    { 0.0f, 0.333f,    // top
-      0.0f, 0.333f,    // side
-      0.0f, 0.333f },  // bottom
-    
-    // Stone (all stone texture)
-    { 0.5f, 0.0f,      // top
-      0.5f, 0.0f,      // side
-      0.5f, 0.0f },    // bottom
-    
-    // Snow (all snow texture)
-    { 0.0f, 0.0f,      // top
-      0.0f, 0.0f,      // side
-      0.0f, 0.0f }     // bottom
-};
\ No newline at end of file
+/**
+ * @struct BlockTexture
+ * @brief Atlas UV rectangles of a block's faces, generated when the atlas is built
+ * @details Each rectangle is (uMin, vMin, uMax, vMax) and excludes the atlas padding
+ */
+struct BlockTexture {
+    glm::vec4 top{0.0f};      ///< Top face UV rectangle
+    glm::vec4 side{0.0f};     ///< Side faces UV rectangle
+    glm::vec4 bottom{0.0f};   ///< Bottom face UV rectangle
+};
@@ -22,8 +22,9 @@ namespace Engine {
      * and generates initial terrain mesh.
      */
 TerrainSystem::TerrainSystem() : m_NoiseGen(std::random_device{}()) {
-    // Load terrain texture
-    m_TerrainTexture = Texture::Create("assets/textures/terrain_atlas.png");
+    // Pack the block textures into the terrain atlas in the background; the
+    // terrain is remeshed with the atlas UVs once it is uploaded
+    BuildBlockAtlas();
 
     // Get shader with proper error handling
 
@@ -49,6 +50,78 @@ TerrainSystem::TerrainSystem() : m_NoiseGen(std::random_device{}()) {
     GenerateMesh();
 }
 
+    TerrainSystem::~TerrainSystem() {
+        // The last recorded command lists may still draw the terrain; the pool
+        // defers releasing its ranges and vertex array itself
+        ReleaseChunks();
+        if (m_AtlasBuild) m_AtlasBuild->owner = nullptr;
+        DeferredRelease::Get().Retire(std::move(m_TerrainMaterial));
+    }
+
+    /**
+     * @brief Decodes the block face images and packs them into the terrain atlas on the I/O pool
+     * @details The images go through the TextureCache, so warm starts skip PNG decoding.
+     *          The atlas uploads within TextureLoader's frame budget and the UV table is
+     *          filled on the main thread after that.
+     */
+    void TerrainSystem::BuildBlockAtlas() {
+        PROFILE_FUNCTION();
+        auto build = std::make_shared<BlockAtlasBuild>();
+        build->owner = this;
+        m_AtlasBuild = build;
+
+        const auto produce = [build] {
+            TextureAtlasBuilder builder;
+            std::unordered_set<std::string> added;
+            for (const BlockFaceTextures& faces : BLOCK_FACE_TEXTURES) {
+                for (const char* name : {faces.top, faces.side, faces.bottom}) {
+                    if (name && added.insert(name).second) {
+                        builder.AddFile(name, std::string(BLOCK_TEXTURE_DIRECTORY) + name + ".png");
+                    }
+                }
+            }
+            build->atlas = builder.Build();
+            return std::move(build->atlas.image);
+        };
+        const auto onReady = [build] {
+            if (build->owner) build->owner->ApplyBlockAtlas(build->atlas);
+        };
+        m_TerrainTexture = TextureLoader::Get().Load("terrain atlas", produce, onReady).GetTexture();
+    }
+
+    /**
+     * @brief Fills the UV table from the uploaded atlas and rebuilds the chunk meshes
+     * @details Faces whose image is missing keep an empty UV rectangle
+     */
+    void TerrainSystem::ApplyBlockAtlas(const TextureAtlas& atlas) {
+        PROFILE_FUNCTION();
+        const auto faceRect = [&atlas](const char* name) {
+            const AtlasRegion* region = name ? atlas.Find(name) : nullptr;
+            return region ? glm::vec4(region->uvMin.x, region->uvMin.y, region->uvMax.x,
+                                      region->uvMax.y)
+                          : glm::vec4(0.0f);
+        };
+        for (size_t type = 0; type < m_BlockTextures.size(); ++type) {
+            const BlockFaceTextures& faces = BLOCK_FACE_TEXTURES[type];
+            m_BlockTextures[type] = {faceRect(faces.top), faceRect(faces.side),
+                                     faceRect(faces.bottom)};
+        }
+        LOG_TRACE_CONCAT("Applied terrain atlas with ", atlas.regions.size(), " images");
+        GenerateMesh();
+    }
+
+    BlockType TerrainSystem::GetSurfaceBlock(float noise, float drop) {
+        if (noise > SNOW_LINE) return BlockType::Snow;
+        if (noise > ROCK_LINE) return BlockType::Stone;
+        if (drop > STEEP_DROP) return BlockType::Dirt;
+        return BlockType::Grass;
+    }
+
+    void TerrainSystem::ReleaseChunks() {
+        for (const auto& chunk : m_Chunks) m_ChunkPool->Free(chunk.mesh);
+        m_Chunks.clear();
+    }
+
     // Core functionality
     void TerrainSystem::Initialize(Renderer& renderer) {
         // Already initialized in constructor, but could be used for renderer-specific setup
@@ -76,9 +149,18 @@ TerrainSystem::TerrainSystem() : m_NoiseGen(std::random_device{}()) {
         }
     }
 
+    /**
+     * @brief Submits every chunk from the shared pool vertex array
+     * @details Chunks differ only in draw range and transform, so they are culled
+     *          individually but share one vertex array bind
+     */
     void TerrainSystem::Render(Renderer& renderer) {
-        if (m_TerrainVA && m_TerrainMaterial) {
-            renderer.Submit(m_TerrainVA, m_TerrainMaterial, m_TerrainTransform.GetModelMatrix());
+        if (m_Chunks.empty() || !m_TerrainMaterial) return;
+        const glm::mat4 model = m_TerrainTransform.GetModelMatrix();
+        const auto& vertexArray = m_ChunkPool->GetVertexArray();
+        for (const auto& chunk : m_Chunks) {
+            renderer.Submit(vertexArray, m_TerrainMaterial, model * chunk.offset, GL_TRIANGLES,
+                            RenderPass::Opaque, m_ChunkPool->GetDrawRange(chunk.mesh));
         }
     }
 
@@ -88,91 +170,115 @@ TerrainSystem::TerrainSystem() : m_NoiseGen(std::random_device{}()) {
     }
 
     /**
-     * @brief Generates a terrain mesh using procedural noise
+     * @brief Generates the terrain meshes using procedural noise
      * 
-     * Creates a detailed terrain mesh by generating vertex and index buffers
+     * Creates the terrain as a grid of chunks of CHUNK_QUADS x CHUNK_QUADS quads
      * based on a heightmap. The method uses noise generation to create terrain
      * geometry with configurable base height, height scale, and noise scale.
      * 
-     * The terrain is constructed as a grid of quads, with each vertex having
-     * a calculated height based on the noise generator. Texture coordinates
-     * are also generated for proper mapping.
+     * Each chunk's vertices are relative to the chunk origin and suballocated
+     * from one MeshPool; the chunk offset is applied by its transform, so all
+     * chunks share the pool's local bounds for culling.
      * 
      * @details The method performs the following key steps:
      * - Generates a heightmap using the noise generator
      * - Calculates vertex heights based on base height and height scale
-     * - Creates vertices with 3D positions and 2D texture coordinates
+     * - Creates chunk-local vertices with 3D positions and 2D texture coordinates
      * - Generates indices to form triangles for rendering
-     * - Creates a vertex array with vertex and index buffers
+     * - Copies each chunk into the pool, compacting it first when fragmented
      * 
      * @note The terrain size is determined by m_ChunkRange, with a default
      * map size of (m_ChunkRange * 2 + 1) * 16
      * 
-     * @warning Modifies the internal terrain vertex array (m_TerrainVA)
+     * @warning Replaces the chunk list (m_Chunks); the old meshes are released
+     *          once the frames that may draw them are done
      * 
      * @see TerrainSystem::SetBaseHeight
      * @see TerrainSystem::SetHeightScale
      * @see TerrainSystem::SetNoiseScale
      */
     void TerrainSystem::GenerateMesh() {
-        std::vector<float> vertices;
-        std::vector<uint32_t> indices;
-        uint32_t currentIndex = 0;
-
+        PROFILE_FUNCTION();
         // Increase map size for better visibility
         int mapSize = (m_ChunkRange * 2 + 1) * 16;
         auto heightmap = m_NoiseGen.getHeightmap(mapSize, mapSize, m_NoiseScale);
 
-        // Generate quad mesh with proper UVs
-        for (int z = 0; z < mapSize - 1; z++) {
-            for (int x = 0; x < mapSize - 1; x++) {
-                float height00 = m_BaseHeight + heightmap[z * mapSize + x] * m_HeightScale;
-                float height10 = m_BaseHeight + heightmap[z * mapSize + (x + 1)] * m_HeightScale;
-                float height01 = m_BaseHeight + heightmap[(z + 1) * mapSize + x] * m_HeightScale;
-                float height11 = m_BaseHeight + heightmap[(z + 1) * mapSize + (x + 1)] * m_HeightScale;
-
-                // Add vertices for this quad
-                vertices.insert(vertices.end(), {
-                    static_cast<float>(x), height00, static_cast<float>(z),         0.0f, 0.0f,
-                    static_cast<float>(x + 1), height10, static_cast<float>(z),     1.0f, 0.0f,
-                    static_cast<float>(x + 1), height11, static_cast<float>(z + 1), 1.0f, 1.0f,
-                    static_cast<float>(x), height01, static_cast<float>(z + 1),     0.0f, 1.0f
-                });
-
-                // Add indices for the quad (two triangles)
-                indices.insert(indices.end(), {
-                    currentIndex, currentIndex + 1, currentIndex + 2,
-                    currentIndex, currentIndex + 2, currentIndex + 3
-                });
-
-                currentIndex += 4;
+        BufferLayout layout = {
+            { ShaderDataType::Float3, "aPosition" },
+            { ShaderDataType::Float2, "aTexCoord" }
+        };
+        if (!m_ChunkPool) {
+            m_ChunkPool = std::make_shared<MeshPool>(layout);
+        } else {
+            ReleaseChunks();
+            if (m_ChunkPool->GetFragmentation() > MAX_POOL_FRAGMENTATION) {
+                m_ChunkPool->Defragment();
             }
         }
 
-        // Create vertex array with mesh data
-        m_TerrainVA.reset(VertexArray::Create());
-        
-        if (!vertices.empty()) {
-            std::shared_ptr<VertexBuffer> vertexBuffer(
-                VertexBuffer::Create(vertices.data(), 
-                vertices.size() * sizeof(float)));
-            
-            BufferLayout layout = {
-                { ShaderDataType::Float3, "aPosition" },
-                { ShaderDataType::Float2, "aTexCoord" }
-            };
-            
-            vertexBuffer->SetLayout(layout);
-            m_TerrainVA->AddVertexBuffer(vertexBuffer);
-
-            std::shared_ptr<IndexBuffer> indexBuffer(
-                IndexBuffer::Create(indices.data(), indices.size()));
-            m_TerrainVA->SetIndexBuffer(indexBuffer);
+        std::vector<float> vertices;
+        std::vector<uint32_t> indices;
+        size_t totalVertices = 0, totalIndices = 0;
+        const int quadCount = mapSize - 1;
+        for (int chunkZ = 0; chunkZ < quadCount; chunkZ += CHUNK_QUADS) {
+            for (int chunkX = 0; chunkX < quadCount; chunkX += CHUNK_QUADS) {
+                vertices.clear();
+                indices.clear();
+                uint32_t currentIndex = 0;
+
+                // Generate quads relative to the chunk origin, textured with the top face
+                // of the block their height and slope select
+                const int endZ = std::min(chunkZ + CHUNK_QUADS, quadCount);
+                const int endX = std::min(chunkX + CHUNK_QUADS, quadCount);
+                for (int z = chunkZ; z < endZ; z++) {
+                    for (int x = chunkX; x < endX; x++) {
+                        float height00 = m_BaseHeight + heightmap[z * mapSize + x] * m_HeightScale;
+                        float height10 = m_BaseHeight + heightmap[z * mapSize + (x + 1)] * m_HeightScale;
+                        float height01 = m_BaseHeight + heightmap[(z + 1) * mapSize + x] * m_HeightScale;
+                        float height11 = m_BaseHeight + heightmap[(z + 1) * mapSize + (x + 1)] * m_HeightScale;
+
+                        const float noise = 0.25f * (heightmap[z * mapSize + x] +
+                                                     heightmap[z * mapSize + (x + 1)] +
+                                                     heightmap[(z + 1) * mapSize + x] +
+                                                     heightmap[(z + 1) * mapSize + (x + 1)]);
+                        const float drop = std::max({height00, height10, height01, height11}) -
+                                           std::min({height00, height10, height01, height11});
+                        const glm::vec4& uv = GetBlockTexture(GetSurfaceBlock(noise, drop)).top;
+
+                        const float localX = static_cast<float>(x - chunkX);
+                        const float localZ = static_cast<float>(z - chunkZ);
+                        vertices.insert(vertices.end(), {
+                            localX, height00, localZ,                uv.x, uv.y,
+                            localX + 1.0f, height10, localZ,         uv.z, uv.y,
+                            localX + 1.0f, height11, localZ + 1.0f,  uv.z, uv.w,
+                            localX, height01, localZ + 1.0f,         uv.x, uv.w
+                        });
+
+                        // Add indices for the quad (two triangles)
+                        indices.insert(indices.end(), {
+                            currentIndex, currentIndex + 1, currentIndex + 2,
+                            currentIndex, currentIndex + 2, currentIndex + 3
+                        });
+
+                        currentIndex += 4;
+                    }
+                }
+
+                const auto vertexBytes = static_cast<uint32_t>(vertices.size() * sizeof(float));
+                const MeshPool::Handle mesh = m_ChunkPool->Allocate(
+                    vertices.data(), static_cast<uint32_t>(vertices.size() / 5), indices.data(),
+                    static_cast<uint32_t>(indices.size()),
+                    AABB::FromVertices(vertices.data(), vertexBytes, layout));
+                m_Chunks.push_back({mesh, glm::translate(glm::mat4(1.0f),
+                                                         glm::vec3(chunkX, 0.0f, chunkZ))});
+                totalVertices += vertices.size() / 5;
+                totalIndices += indices.size();
+            }
         }
 
         // Debug output
-        LOG_TRACE_CONCAT("Generated terrain mesh with ", vertices.size() / 5, " vertices and ",
-                         indices.size(), " indicies.");
+        LOG_TRACE_CONCAT("Generated terrain mesh with ", m_Chunks.size(), " chunks, ",
+                         totalVertices, " vertices and ", totalIndices, " indicies.");
     }
 
     /**
@@ -8,9 +8,13 @@
 #include "Noise/SimplexNoise/SimplexNoise.h"
 #include "Noise/ValueNoise/ValueNoise.h"
 #include "Noise/VoidNoise/VoidNoise.h"
+#include "Renderer/DeferredRelease.h"
 #include "Renderer/Material.h"
+#include "Renderer/MeshPool.h"
 #include "Renderer/RenderObject.h"
 #include "Renderer/Renderer.h"
+#include "Renderer/TextureAtlas.h"
+#include "Renderer/TextureLoader.h"
 #include "Renderer/VertexArray.h"
 #include "VoxelTerrain.h"
 
@@ -24,7 +28,7 @@ namespace Engine {
     class TerrainSystem {
     public:
         TerrainSystem();
-        ~TerrainSystem() = default;
+        ~TerrainSystem();
 
         /** @brief Initializes terrain system with renderer */
         void Initialize(Renderer& renderer);
@@ -77,16 +81,73 @@ namespace Engine {
         void Shutdown() {
             // Clean up terrain resources
             m_TerrainMesh.reset();
-            m_TerrainMaterial.reset();
+            ReleaseChunks();
+            m_ChunkPool.reset();
+            if (m_AtlasBuild) m_AtlasBuild->owner = nullptr;
+            DeferredRelease::Get().Retire(std::move(m_TerrainMaterial));
             m_IsInitialized = false;
         }
 
+        /** @return Atlas UV rectangles of a block type's faces, empty until the atlas is ready */
+        const BlockTexture& GetBlockTexture(BlockType type) const {
+            return m_BlockTextures[static_cast<size_t>(type)];
+        }
+
+        /** @return Pool holding the chunk meshes, null before the first GenerateMesh() */
+        const MeshPool* GetChunkPool() const { return m_ChunkPool.get(); }
+
+        /** @brief Quads along each side of a terrain chunk */
+        static constexpr int CHUNK_QUADS = 16;
+        /** @brief Chunk pool fragmentation above which GenerateMesh() compacts it */
+        static constexpr float MAX_POOL_FRAGMENTATION = 0.5f;
+        /** @brief Directory of the block face images named in BLOCK_FACE_TEXTURES */
+        static constexpr const char* BLOCK_TEXTURE_DIRECTORY = "assets/textures/blocks/";
+        /** @brief Noise height above which terrain is snow */
+        static constexpr float SNOW_LINE = 0.7f;
+        /** @brief Noise height above which terrain is bare stone */
+        static constexpr float ROCK_LINE = 0.6f;
+        /** @brief Height difference across a quad above which grass gives way to dirt */
+        static constexpr float STEEP_DROP = 1.5f;
+
        private:
+        /** @brief A chunk's mesh in the pool and its offset from the terrain origin */
+        struct TerrainChunk {
+            MeshPool::Handle mesh;
+            glm::mat4 offset;
+        };
+
+        /** @brief Returns every chunk mesh to the pool */
+        void ReleaseChunks();
+        /** @brief Atlas packed by the build task, handed to the main thread with the upload */
+        struct BlockAtlasBuild {
+            TerrainSystem* owner = nullptr;  ///< Cleared when the terrain system shuts down
+            TextureAtlas atlas;              ///< Regions only; the image goes to the upload
+        };
+
+        /**
+         * @brief Starts packing the block face images into m_TerrainTexture on the I/O pool
+         * @details m_TerrainTexture is a placeholder until TextureLoader::Update()
+         *          uploads the atlas and ApplyBlockAtlas() runs
+         */
+        void BuildBlockAtlas();
+        /** @brief Fills m_BlockTextures from a packed atlas and remeshes with its UVs */
+        void ApplyBlockAtlas(const TextureAtlas& atlas);
+        /**
+         * @brief Block covering a terrain quad
+         * @param noise Average heightmap value of the quad's corners
+         * @param drop Height difference across the quad in world units
+         */
+        static BlockType GetSurfaceBlock(float noise, float drop);
+
         std::unique_ptr<VoxelTerrain> m_Terrain;      ///< Voxel data container
-        std::shared_ptr<VertexArray> m_TerrainVA;     ///< Terrain vertex array
+        std::shared_ptr<MeshPool> m_ChunkPool;        ///< Meshes of all chunks, one vertex array
+        std::vector<TerrainChunk> m_Chunks;           ///< Chunks drawn by Render()
         std::shared_ptr<Shader> m_TerrainShader;      ///< Terrain shader
         std::shared_ptr<Material> m_TerrainMaterial;  ///< Terrain material
-        std::shared_ptr<Texture> m_TerrainTexture;    ///< Terrain texture
+        std::shared_ptr<Texture> m_TerrainTexture;    ///< Atlas of the block face images
+        std::shared_ptr<BlockAtlasBuild> m_AtlasBuild;  ///< Atlas build in flight or done
+        /** @brief Face UV rectangles per block type, filled by ApplyBlockAtlas() */
+        std::array<BlockTexture, static_cast<size_t>(BlockType::COUNT)> m_BlockTextures;
         Transform m_TerrainTransform;                 ///< Terrain transformation
         int m_ChunkRange = 1;                         ///< Chunk generation range
 
@@ -0,0 +1,56 @@
+/**
+ * @file ThreadUtils.cpp
+ * @brief Platform implementations of thread naming and affinity
+ */
+#include "ThreadUtils.h"
+
+#ifdef PLATFORM_WINDOWS
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#elif defined(PLATFORM_LINUX)
+    #include <pthread.h>
+    #include <sched.h>
+#elif defined(PLATFORM_MAC)
+    #include <pthread.h>
+#endif
+
+namespace Engine {
+    namespace ThreadUtils {
+        void SetCurrentThreadName(const std::string& name) {
+#ifdef PLATFORM_WINDOWS
+            std::wstring wideName(name.begin(), name.end());
+            SetThreadDescription(GetCurrentThread(), wideName.c_str());
+#elif defined(PLATFORM_LINUX)
+            // Linux limits thread names to 15 characters plus the terminator
+            pthread_setname_np(pthread_self(), name.substr(0, 15).c_str());
+#elif defined(PLATFORM_MAC)
+            pthread_setname_np(name.c_str());
+#else
+            (void)name;
+#endif
+        }
+
+        void SetCurrentThreadAffinity(size_t core) {
+            const size_t coreCount = std::max(1u, std::thread::hardware_concurrency());
+            core %= coreCount;
+
+#ifdef PLATFORM_WINDOWS
+            if (SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << core) == 0) {
+                LOG_WARN_CONCAT("Failed to pin thread to core ", core);
+            }
+#elif defined(PLATFORM_LINUX)
+            cpu_set_t cpuSet;
+            CPU_ZERO(&cpuSet);
+            CPU_SET(core, &cpuSet);
+            if (pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) != 0) {
+                LOG_WARN_CONCAT("Failed to pin thread to core ", core);
+            }
+#else
+            // macOS only supports affinity hints through thread_policy_set; not worth it here
+            (void)core;
+#endif
+        }
+    }
+}
@@ -0,0 +1,25 @@
+#pragma once
+#include "../pch.h"
+
+namespace Engine {
+    /**
+     * @brief Platform helpers for configuring the calling thread
+     *
+     * Kept out of line so platform headers do not leak into the rest of the
+     * engine. Failures are logged and otherwise ignored; neither setting is
+     * required for correctness.
+     */
+    namespace ThreadUtils {
+        /**
+         * @brief Names the calling thread for debuggers and profilers
+         * @param name Thread name (truncated to 15 characters on Linux)
+         */
+        void SetCurrentThreadName(const std::string& name);
+
+        /**
+         * @brief Restricts the calling thread to a single logical core
+         * @param core Zero-based logical core index, wrapped to the core count
+         */
+        void SetCurrentThreadAffinity(size_t core);
+    }
+}
@@ -5,16 +5,19 @@
 #include <imgui.h>
 
 #include "../Scene/SceneManager.h"
+#include "Core/TaskSystem.h"
 #include "Debug/Profiler.h"
+#include "Renderer/RenderState.h"
 #include "ImGuiFlameGraph.h"
 
 namespace Engine {
     /**
      * @brief Constructor for ImGui overlay
      * @param window Pointer to the window instance
+     * @param renderer Renderer that draws the application's frames
      */
-    ImGuiOverlay::ImGuiOverlay(Window* window) 
-        : m_Window(window), m_Renderer(&Renderer::Get()) {
+    ImGuiOverlay::ImGuiOverlay(Window* window, Renderer& renderer)
+        : m_Window(window), m_Renderer(&renderer) {
         // Initialize flame graph settings with defaults
         m_FlameGraphSettings = ImGuiWidgetFlameGraph::FlameGraphSettings();
     }
@@ -137,16 +140,18 @@ namespace Engine {
      * @param renderObject Reference to the RenderObject whose transform will be manipulated
      * 
      * @note Controls use ImGui drag float widgets with a sensitivity of 0.1 units per drag
-     * @note Position, rotation, and scale are modified directly on the object's transform
+     * @note Edits go through the transform's setters so its cached matrix is rebuilt
      */
     void ImGuiOverlay::RenderTransformControls(Engine::RenderObject& object) {
         auto& transform = object.GetTransform();
-        auto& data = transform.GetData();  // Get mutable reference to transform data
 
         if (ImGui::CollapsingHeader("Transform")) {
-            ImGui::DragFloat3("Position", &data.position[0], 0.1f);
-            ImGui::DragFloat3("Rotation", &data.rotation[0], 0.1f);
-            ImGui::DragFloat3("Scale", &data.scale[0], 0.1f);
+            glm::vec3 position = transform.GetPosition();
+            glm::vec3 rotation = transform.GetRotation();
+            glm::vec3 scale = transform.GetScale();
+            if (ImGui::DragFloat3("Position", &position[0], 0.1f)) transform.SetPosition(position);
+            if (ImGui::DragFloat3("Rotation", &rotation[0], 0.1f)) transform.SetRotation(rotation);
+            if (ImGui::DragFloat3("Scale", &scale[0], 0.1f)) transform.SetScale(scale);
         }
     }
 
@@ -196,6 +201,23 @@ namespace Engine {
 
         ImGui::Separator();
 
+        if (ImGui::TreeNode("Task System")) {
+            const auto taskStats = TaskSystem::Get().GetStatistics();
+            for (size_t i = 0; i < taskStats.size(); ++i) {
+                const auto& stats = taskStats[i];
+                ImGui::Text("%s:", TaskPriorityToString(static_cast<TaskPriority>(i)));
+                ImGui::Text("  Queued: %lld", static_cast<long long>(stats.queued));
+                ImGui::Text("  Completed: %llu  Cancelled: %llu",
+                    static_cast<unsigned long long>(stats.completed),
+                    static_cast<unsigned long long>(stats.cancelled));
+            }
+            if (ImGui::Button("Reset Task Statistics")) {
+                TaskSystem::Get().ResetStatistics();
+            }
+            ImGui::TreePop();
+        }
+        ImGui::Separator();
+
         for (const auto& [name, timings] : Profiler::Get().GetProfiles()) {
             if (timings.empty()) continue;
             
@@ -218,6 +240,55 @@ namespace Engine {
         ImGui::End();
     }
 
+    /**
+     * @brief Renders per-stage frame timings and the frame pipelining toggle
+     * @param timings Timings of the last completed frame
+     * @param pipelineFrames Pipelining flag, modified when the checkbox is toggled
+     */
+    void ImGuiOverlay::RenderFrameTimings(const FrameTimings& timings, bool& pipelineFrames) {
+        if (!m_ShowProfiler) return;
+        ImGui::Begin("Frame Timings", nullptr, ImGuiWindowFlags_AlwaysAutoResize);
+        ImGui::Checkbox("Pipeline Frames", &pipelineFrames);
+        ImGui::Separator();
+
+        ImGui::Text("Events/Input:   %.3f ms", timings.eventsMs);
+        ImGui::Text("Main Update:    %.3f ms", timings.mainUpdateMs);
+        ImGui::Text("Simulation:     %.3f ms", timings.simulationMs);
+        ImGui::Text("Simulation Wait: %.3f ms", timings.simulationWaitMs);
+        ImGui::Text("Render Submit:  %.3f ms", timings.renderSubmitMs);
+        ImGui::Text("Present:        %.3f ms", timings.presentMs);
+        ImGui::Separator();
+        ImGui::Text("Frame Total:    %.3f ms", timings.totalMs);
+        if (timings.pipelined) {
+            ImGui::Text("Overlapped:     %.3f ms", timings.GetOverlapMs());
+        }
+        ImGui::End();
+    }
+
+    /**
+     * @brief Renders draw call and state change counters of the last frame
+     * @param stats Counters of the renderer that drew the last frame
+     */
+    void ImGuiOverlay::RenderRenderStatistics(const RenderStatistics& stats) {
+        if (!m_ShowProfiler) return;
+        ImGui::Begin("Render Statistics", nullptr, ImGuiWindowFlags_AlwaysAutoResize);
+        ImGui::Text("Draw Calls:        %u", stats.drawCalls);
+        ImGui::Text("Shader Binds:      %u", stats.shaderBinds);
+        ImGui::Text("Material Binds:    %u", stats.materialBinds);
+        ImGui::Text("Uniform Uploads:   %u", stats.uniformUploads);
+        ImGui::Text("Vertex Array Binds: %u", stats.vertexArrayBinds);
+        ImGui::Text("Instanced Draws:   %u (%u instances)", stats.instancedDraws, stats.instances);
+        const RenderState::Counters& glCalls = RenderState::Get().GetFrameCounters();
+        ImGui::Text("GL State Calls:    %u issued, %u skipped", glCalls.TotalIssued(),
+                    glCalls.TotalSkipped());
+        ImGui::Separator();
+        ImGui::Text("Sort:   %.3f ms", stats.sortMs);
+        ImGui::Text("Material: %.3f ms (%.2f us per bind)", stats.materialMs,
+                    stats.materialBinds ? stats.materialMs * 1000.0f / stats.materialBinds : 0.0f);
+        ImGui::Text("Submit: %.3f ms", stats.submitMs);
+        ImGui::End();
+    }
+
     /**
      * @brief Renders the renderer settings window with back-face culling controls
      * 
@@ -235,14 +306,24 @@ namespace Engine {
         ImGui::Begin("Renderer");
         bool cullingEnabled = glIsEnabled(GL_CULL_FACE);
         if (ImGui::Checkbox("Enable Back-face Culling", &cullingEnabled)) {
+            RenderState::Get().SetEnabled(GL_CULL_FACE, cullingEnabled);
             if (cullingEnabled) {
-                glEnable(GL_CULL_FACE);
                 glCullFace(GL_BACK);
                 glFrontFace(GL_CCW);
-            } else {
-                glDisable(GL_CULL_FACE);
             }
         }
+
+        bool frustumCulling = m_Renderer->IsFrustumCullingEnabled();
+        if (ImGui::Checkbox("Enable Frustum Culling", &frustumCulling)) {
+            m_Renderer->SetFrustumCullingEnabled(frustumCulling);
+        }
+        bool instancing = m_Renderer->IsInstancingEnabled();
+        if (ImGui::Checkbox("Enable Instancing", &instancing)) {
+            m_Renderer->SetInstancingEnabled(instancing);
+        }
+        const RenderStatistics& stats = m_Renderer->GetStatistics();
+        ImGui::Text("Visible: %u / %u", stats.submitted - stats.culled, stats.submitted);
+        ImGui::Text("Culled:  %u", stats.culled);
         ImGui::End();
     }
 
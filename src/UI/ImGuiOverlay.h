@@ -8,6 +8,7 @@
 #include "../Events/EventDebugger.h"
 #include "../TerrainSystem/TerrainSystem.h"
 #include "../Core/FPSCounter.h"
+#include "../Core/FrameTimings.h"
 #include "ImGuiFlameGraph.h"
 
 namespace Engine {
@@ -22,8 +23,9 @@ namespace Engine {
         /**
          * @brief Constructs the ImGui overlay
          * @param window Pointer to the application window
+         * @param renderer Renderer whose settings and statistics are shown
          */
-        ImGuiOverlay(Window* window);
+        ImGuiOverlay(Window* window, Renderer& renderer);
         ~ImGuiOverlay() = default;
 
         /**
@@ -44,6 +46,10 @@ namespace Engine {
         void RenderTransformControls(RenderObject& renderObject);
         /** @brief Renders profiler information window */
         void RenderProfiler() const;
+        /** @brief Renders per-stage frame timings and the pipelining toggle */
+        void RenderFrameTimings(const FrameTimings& timings, bool& pipelineFrames);
+        /** @brief Renders draw call and state change counters of the last frame */
+        void RenderRenderStatistics(const RenderStatistics& stats);
         /** @brief Renders renderer settings panel */
         void RenderRendererSettings();
         /** @brief Renders event debugging window */
@@ -5,6 +5,7 @@
 #include "../Events/KeyEvent.h"
 #include "../Events/MouseEvent.h"
 #include "../Events/WindowEvent.h"
+#include "../Renderer/RenderState.h"
 
 namespace Engine {
 
@@ -218,15 +219,18 @@ namespace Engine {
      * @details Enables depth testing, blending, and face culling
      */
     void OpenGLWindow::SetContext() {
+        // Capabilities go through the state cache so it matches GL from the first frame
+        RenderState& state = RenderState::Get();
+
         // Enable depth testing
-        glEnable(GL_DEPTH_TEST);
+        state.Enable(GL_DEPTH_TEST);
         
         // Enable blending for transparency
-        glEnable(GL_BLEND);
+        state.Enable(GL_BLEND);
         glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
         
         // Enable face culling
-        glEnable(GL_CULL_FACE);
+        state.Enable(GL_CULL_FACE);
         glCullFace(GL_BACK);
         
         glfwMakeContextCurrent(m_Window);
@@ -1,7 +1,10 @@
 #pragma once
 #include <pch.h>
 #include "Window.h"
+// clang-format off
+#include <glad/glad.h>
 #include <GLFW/glfw3.h>
+// clang-format on
 
 namespace Engine {
     /**